@@ -79,11 +79,12 @@ public:
     void addHandlebarTemplates(std::vector<HandlebarTemplate> templates);
 
     /**
-     * Returns a list of all registered Documentation%s.
+     * Returns a list of all registered Documentation%s. Documentation%s are only
+     * registered during startup, so the list is not modified afterwards.
      *
      * \return A list of all registered Documentation%s
      */
-    std::vector<Documentation> documentations() const;
+    const std::vector<Documentation>& documentations() const;
 
     static void initialize();
     static void deinitialize();
@@ -68,6 +68,9 @@ struct Configuration {
 
     std::string versionCheckUrl;
     bool useMultithreadedInitialization = false;
+    bool useMultithreadedUpdate = false;
+    float initializeGLBudget = 10.f;
+    bool deferDisabledRenderables = false;
 
     struct LoadingScreen {
         bool isShowingMessages = true;
@@ -76,6 +79,13 @@ struct Configuration {
     };
     LoadingScreen loadingScreen;
 
+    struct StartupTrace {
+        bool isActive = false;
+        std::string file;
+        int summaryCount = 10;
+    };
+    StartupTrace startupTrace;
+
     bool isCheckingOpenGLState = false;
     bool isLoggingOpenGLCalls = false;
 
@@ -59,7 +59,10 @@ namespace interaction {
     class SessionRecording;
     class ShortcutManager;
 } // namespace interaction
-namespace performance { class PerformanceManager; }
+namespace performance {
+    class PerformanceManager;
+    class StartupTracer;
+} // namespace performance
 namespace properties { class PropertyOwner; }
 namespace scripting {
     class ScriptEngine;
@@ -96,6 +99,7 @@ interaction::NavigationHandler& gNavigationHandler();
 interaction::SessionRecording& gSessionRecording();
 interaction::ShortcutManager& gShortcutManager();
 performance::PerformanceManager& gPerformanceManager();
+performance::StartupTracer& gStartupTracer();
 properties::PropertyOwner& gRootPropertyOwner();
 properties::PropertyOwner& gScreenSpaceRootPropertyOwner();
 scripting::ScriptEngine& gScriptEngine();
@@ -133,6 +137,7 @@ static interaction::SessionRecording& sessionRecording = detail::gSessionRecordi
 static interaction::ShortcutManager& shortcutManager = detail::gShortcutManager();
 static performance::PerformanceManager& performanceManager =
     detail::gPerformanceManager();
+static performance::StartupTracer& startupTracer = detail::gStartupTracer();
 static properties::PropertyOwner& rootPropertyOwner = detail::gRootPropertyOwner();
 static properties::PropertyOwner& screenSpaceRootPropertyOwner =
     detail::gScreenSpaceRootPropertyOwner();
@@ -97,6 +97,13 @@ public:
     // Accessors
     Camera* camera() const;
     const SceneGraphNode* anchorNode() const;
+
+    /**
+     * Returns the anchor node of the navigation state that will be applied in the next
+     * frame, or the current anchor node if no navigation state is pending.
+     */
+    const SceneGraphNode* nextAnchorNode() const;
+
     const InputState& inputState() const;
     const OrbitalNavigator& orbitalNavigator() const;
     OrbitalNavigator& orbitalNavigator();
@@ -0,0 +1,149 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___STARTUPTRACER___H__
+#define __OPENSPACE_CORE___STARTUPTRACER___H__
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace openspace::performance {
+
+/**
+ * The StartupTracer records the begin and end time of the individual stages that make up
+ * the startup of the application, such as the initialization of the modules, the
+ * evaluation of the asset files, the resource synchronizations, and the initialization
+ * of the scene graph nodes. Each span is recorded together with the thread on which it
+ * happened. The recorded spans can be written into a file in the Chrome trace event
+ * format (which can be opened in <code>chrome://tracing</code> or Perfetto) and can be
+ * summarized into a list of the slowest assets and scene graph nodes.
+ * Spans are only recorded while the tracer is enabled, all functions are thread-safe.
+ */
+class StartupTracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// The part of the application that a span belongs to
+    enum class Category {
+        Engine = 0,
+        Module,
+        Asset,
+        Synchronization,
+        Node
+    };
+
+    struct Span {
+        /// The name of the entity that is traced, for example an asset path
+        std::string name;
+        /// The stage of the entity that is traced, for example "Initialize"
+        std::string stage;
+        Category category;
+        /// A small number identifying the thread, or -1 for asynchronous spans
+        int threadId;
+        /// The begin and end of the span in microseconds since the tracer was created
+        std::chrono::microseconds begin;
+        std::chrono::microseconds end;
+    };
+
+    /**
+     * Records a span from its construction to its destruction on the current thread, if
+     * the \p tracer was enabled at the time of construction.
+     */
+    class ScopedSpan {
+    public:
+        ScopedSpan(StartupTracer& tracer, std::string name, Category category,
+            std::string stage);
+        ~ScopedSpan();
+
+    private:
+        StartupTracer& _tracer;
+        bool _isActive;
+        std::string _name;
+        Category _category;
+        std::string _stage;
+        Clock::time_point _begin;
+    };
+
+    StartupTracer();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /**
+     * Adds a span that started at \p begin and ended at \p end. If \p isAsynchronous is
+     * \c true, the span is not attributed to the current thread, which is used for work
+     * that is only polled from the current thread, such as resource synchronizations.
+     * If the tracer is disabled, this function does nothing.
+     */
+    void addSpan(std::string name, Category category, std::string stage,
+        Clock::time_point begin, Clock::time_point end, bool isAsynchronous = false);
+
+    /// Returns all spans that have been recorded so far in the order of their addition
+    std::vector<Span> spans() const;
+
+    /// Removes all recorded spans
+    void clear();
+
+    /**
+     * Returns the up to \p n entities of the \p category that took the longest time, in
+     * descending order. Each span only counts its self time, that is its duration
+     * without the spans of the same category that are nested in it on the same thread,
+     * such as the assets that are loaded by another asset. The self times of all stages
+     * of the same entity are summed up.
+     */
+    std::vector<std::pair<std::string, std::chrono::microseconds>> slowest(
+        Category category, size_t n) const;
+
+    /// Returns the recorded spans as a JSON document in the Chrome trace event format
+    std::string chromeTrace() const;
+
+    /**
+     * Writes the result of #chromeTrace into the file at \p path.
+     *
+     * \throw ghoul::RuntimeError If the file could not be written
+     */
+    void writeChromeTrace(const std::string& path) const;
+
+    /// Logs the total time of each stage and the \p n slowest assets and nodes
+    void logSummary(size_t n) const;
+
+private:
+    int threadId(std::thread::id id);
+
+    std::atomic_bool _isEnabled = false;
+    const Clock::time_point _origin;
+
+    mutable std::mutex _mutex;
+    std::vector<Span> _spans;
+    std::map<std::thread::id, int> _threadIds;
+};
+
+} // namespace openspace::performance
+
+#endif // __OPENSPACE_CORE___STARTUPTRACER___H__
@@ -0,0 +1,158 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___BINARYVALUE___H__
+#define __OPENSPACE_CORE___BINARYVALUE___H__
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace openspace::properties {
+
+namespace detail {
+    template <typename T>
+    struct IsVector : std::false_type {};
+
+    template <typename U>
+    struct IsVector<std::vector<U>> : std::true_type {};
+} // namespace detail
+
+/**
+ * Encodes the \p value into the compact binary representation that is used to transport
+ * property values between nodes without going through Lua. Trivially copyable types
+ * (scalars and the glm vector and matrix types) are stored as their raw bytes, strings
+ * as their characters, vectors of trivially copyable types as their raw element array,
+ * and lists of strings as a sequence of length-prefixed strings. The encoding is only
+ * meant to be decoded by #decodeBinaryValue with the same type \c T on a machine with
+ * the same architecture, which is the case for all nodes of a cluster.
+ *
+ * \param value The value that should be encoded
+ * \param result The string into which the bytes of the encoded value are written
+ * \return \c true if the type \c T has a binary representation, \c false otherwise
+ */
+template <typename T>
+bool encodeBinaryValue(const T& value, std::string& result) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        result = value;
+        return true;
+    }
+    else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+        result.clear();
+        for (const std::string& v : value) {
+            const uint32_t length = static_cast<uint32_t>(v.size());
+            result.append(reinterpret_cast<const char*>(&length), sizeof(uint32_t));
+            result.append(v);
+        }
+        return true;
+    }
+    else if constexpr (detail::IsVector<T>::value) {
+        using U = typename T::value_type;
+        if constexpr (std::is_trivially_copyable_v<U> && !std::is_same_v<U, bool>) {
+            result.assign(
+                reinterpret_cast<const char*>(value.data()),
+                value.size() * sizeof(U)
+            );
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+    else if constexpr (std::is_trivially_copyable_v<T>) {
+        result.assign(reinterpret_cast<const char*>(&value), sizeof(T));
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+/**
+ * Decodes the \p data that was created by #encodeBinaryValue with the same type \c T
+ * into the \p value. If the \p data does not describe a valid value of type \c T, the
+ * \p value is left unchanged.
+ *
+ * \param data The encoded value
+ * \param value The value into which the decoded value is written
+ * \return \c true if the \p data was a valid encoding for the type \c T, \c false
+ *         otherwise
+ */
+template <typename T>
+bool decodeBinaryValue(std::string_view data, T& value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        value = std::string(data);
+        return true;
+    }
+    else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+        std::vector<std::string> result;
+        size_t offset = 0;
+        while (offset < data.size()) {
+            if (data.size() - offset < sizeof(uint32_t)) {
+                return false;
+            }
+            uint32_t length;
+            std::memcpy(&length, data.data() + offset, sizeof(uint32_t));
+            offset += sizeof(uint32_t);
+            if (data.size() - offset < length) {
+                return false;
+            }
+            result.emplace_back(data.substr(offset, length));
+            offset += length;
+        }
+        value = std::move(result);
+        return true;
+    }
+    else if constexpr (detail::IsVector<T>::value) {
+        using U = typename T::value_type;
+        if constexpr (std::is_trivially_copyable_v<U> && !std::is_same_v<U, bool>) {
+            if (data.size() % sizeof(U) != 0) {
+                return false;
+            }
+            value.resize(data.size() / sizeof(U));
+            std::memcpy(value.data(), data.data(), data.size());
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+    else if constexpr (std::is_trivially_copyable_v<T>) {
+        if (data.size() != sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data(), sizeof(T));
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+} // namespace openspace::properties
+
+#endif // __OPENSPACE_CORE___BINARYVALUE___H__
@@ -25,10 +25,12 @@
 #ifndef __OPENSPACE_CORE___PROPERTY___H__
 #define __OPENSPACE_CORE___PROPERTY___H__
 
+#include <ghoul/misc/boolean.h>
 #include <ghoul/misc/dictionary.h>
 #include <ghoul/misc/easing.h>
 #include <functional>
 #include <string>
+#include <string_view>
 
 struct lua_State;
 
@@ -114,6 +116,10 @@ public:
     /// Property
     static OnChangeHandle OnChangeHandleAll;
 
+    /// Determines whether an onChange callback is invoked immediately whenever the value
+    /// changes or only once per frame in #notifyDeferredChangeListeners
+    BooleanType(DeferNotification);
+
     /**
      * The constructor for the property. The \p info (see #PropertyInfo) contains
      * necessary information for this Property. #PropertyInfo::identifier needs to be
@@ -246,20 +252,51 @@ public:
      */
     virtual bool setStringValue(std::string value);
 
+    /**
+     * This method encodes the encapsulated value of this Property into a compact binary
+     * representation (see properties::encodeBinaryValue) that can be passed to the
+     * Property::setBinaryValue method of the same Property on another node without
+     * involving Lua. The default implementation does not support a binary encoding.
+     *
+     * \param value The string to which the binary encoding of the value is written
+     * \return \c true if the encoding succeeded, \c false otherwise
+     */
+    virtual bool getBinaryValue(std::string& value) const;
+
+    /**
+     * This method sets the value encapsulated by this Property by decoding the binary
+     * representation that was created by Property::getBinaryValue or by
+     * properties::encodeBinaryValue with the type of this Property. The default
+     * implementation does not support a binary encoding.
+     *
+     * \param value The binary encoding of the new value
+     * \return \c true if the decoding and setting of the value succeeded, \c false
+     *         otherwise
+     */
+    virtual bool setBinaryValue(std::string_view value);
+
     /**
      * This method registers a \p callback function that will be called every time if
      * either Property:set or Property::setLuaValue was called with a value that is
      * different from the previously stored value. The callback can be removed by calling
      * the removeOnChange method with the OnChangeHandle that was returned here.
+     * If \p deferNotification is \c Yes, the \p callback is not called for every
+     * change, but the Property is only marked as changed and the callback is called once
+     * in the next call to #notifyDeferredChangeListeners, which happens once per frame.
+     * This coalesces the many changes caused by interpolations or streamed GUI values
+     * into a single notification in which the last value is visible.
      *
      * \param callback The callback function that is called when the encapsulated type has
      *        been successfully changed by either the Property::set or
      *        Property::setLuaValue methods.
+     * \param deferNotification Whether the callback is called immediately for each change
+     *        or only once per frame
      * \return An OnChangeHandle that can be used in subsequent calls to remove a callback
      *
      * \pre The callback must not be empty
      */
-    OnChangeHandle onChange(std::function<void()> callback);
+    OnChangeHandle onChange(std::function<void()> callback,
+        DeferNotification deferNotification = DeferNotification::No);
 
     /**
     * This method registers a \p callback function that will be called when the property
@@ -284,6 +321,15 @@ public:
      */
     void removeOnChange(OnChangeHandle handle);
 
+    /**
+     * Calls the deferred onChange callbacks of all Property%s whose value has changed
+     * since the last call of this function. Each callback is called at most once, no
+     * matter how often the value has changed in between. Properties that are changed by
+     * one of these callbacks are notified in the next call of this function. This
+     * function is called by the engine once per frame after all updates are done.
+     */
+    static void notifyDeferredChangeListeners();
+
     /**
     * This method deregisters a callback that was previously registered with the onDelete
     * method.
@@ -528,6 +574,10 @@ protected:
     /// The callback function sthat will be invoked whenever the value changes
     std::vector<std::pair<OnChangeHandle, std::function<void()>>> _onChangeCallbacks;
 
+    /// The callback functions that will be invoked once per frame if the value changed
+    std::vector<std::pair<OnChangeHandle, std::function<void()>>>
+        _onChangeDeferredCallbacks;
+
     /// The callback function sthat will be invoked whenever the value changes
     std::vector<std::pair<OnDeleteHandle, std::function<void()>>> _onDeleteCallbacks;
 
@@ -536,6 +586,9 @@ private:
 
     OnChangeHandle _currentHandleValue = 0;
 
+    /// Whether this Property is waiting for the next notifyDeferredChangeListeners call
+    bool _hasDeferredNotification = false;
+
 #ifdef _DEBUG
     // These identifiers can be used for debugging. Each Property is assigned one unique
     // identifier.
@@ -28,7 +28,9 @@
 #include <openspace/documentation/documentationgenerator.h>
 
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace openspace::properties {
@@ -48,6 +50,9 @@ class Property;
  * Property::property method, providing an URI for the location of the property. If the
  * URI contains separators (<code>.</code>), the first name before the separator will be
  * used as a subOwner's name and the search will proceed recursively.
+ * If #createUriIndex was called on a PropertyOwner, it keeps a map from the URIs of all
+ * Propertys in its hierarchy to the Propertys, so that looking up a Property does not
+ * have to traverse the hierarchy.
  */
 class PropertyOwner : public DocumentationGenerator {
 public:
@@ -143,12 +148,39 @@ public:
      * sub-owner and only the last part of the identifier is referring to a Property owned
      * by PropertyOwner named by the second-but-last name.
      *
+     * If this PropertyOwner has a URI index, the Property is found with a single lookup
+     * in the index instead.
+     *
      * \param uri The identifier of the Property that should be extracted
      * \return If the Property cannot be found, \c nullptr is returned, otherwise the
      *         pointer to the Property is returned
      */
     Property* property(const std::string& uri) const;
 
+    /**
+     * Returns all Propertys directly or indirectly owned by this PropertyOwner whose URI,
+     * relative to this PropertyOwner, starts with the provided \p prefix. If this
+     * PropertyOwner has a URI index, only the Propertys that match the prefix are
+     * visited. The Propertys are returned in the lexicographical order of their URIs.
+     *
+     * \param prefix The beginning of the URIs of the Propertys that are returned. If the
+     *        prefix is empty, all Propertys are returned
+     * \return The list of Propertys whose URI starts with the \p prefix
+     */
+    std::vector<Property*> propertiesWithUriPrefix(const std::string& prefix) const;
+
+    /**
+     * Creates an index of the URIs of all Propertys that are directly or indirectly
+     * owned by this PropertyOwner, which is used by #property and
+     * #propertiesWithUriPrefix. The index is kept up to date when Propertys or
+     * sub-owners are added or removed anywhere in the hierarchy below this
+     * PropertyOwner. This is meant for the root of a large hierarchy in which Propertys
+     * are frequently looked up.
+     *
+     * \pre This PropertyOwner must not be owned by another PropertyOwner
+     */
+    void createUriIndex();
+
     /**
      * This method checks if a Property with the provided \p uri exists in this
      * PropertyOwner (or any sub-owner). If the identifier contains one or more
@@ -313,6 +345,28 @@ protected:
     std::map<std::string, std::string> _groupNames;
     /// Collection of string tag(s) assigned to this property
     std::vector<std::string> _tags;
+
+private:
+    struct UriIndex;
+
+    /// Looks up the \p uri by traversing the hierarchy of sub-owners
+    Property* findProperty(std::string_view uri) const;
+
+    /// Returns the URI of this PropertyOwner relative to the _indexRoot, including a
+    /// trailing separator
+    std::string indexUriPrefix() const;
+
+    /// Adds all Propertys of this PropertyOwner and its sub-owners to the index of
+    /// \p root, using the \p uriPrefix for the Propertys of this PropertyOwner
+    void addToIndex(PropertyOwner* root, const std::string& uriPrefix);
+
+    /// Removes all Propertys of this PropertyOwner and its sub-owners from the index
+    void removeFromIndex(const std::string& uriPrefix);
+
+    /// The URI index if #createUriIndex was called on this PropertyOwner
+    std::shared_ptr<UriIndex> _uriIndex;
+    /// The PropertyOwner that contains the URI index that this PropertyOwner is part of
+    PropertyOwner* _indexRoot = nullptr;
 };
 
 }  // namespace openspace::properties
@@ -27,6 +27,7 @@
 
 #include <openspace/properties/property.h>
 
+#include <openspace/properties/binaryvalue.h>
 #include <openspace/properties/propertydelegate.h>
 
 namespace openspace::properties {
@@ -136,6 +137,24 @@ public:
 
     bool setStringValue(std::string value) override;
 
+    /**
+     * Encodes the stored value using properties::encodeBinaryValue. Types that do not
+     * have a binary representation cause this method to return \c false.
+     *
+     * \param value The string to which the binary encoding is written
+     * \return \c true if the encoding succeeded; \c false otherwise
+     */
+    bool getBinaryValue(std::string& value) const override;
+
+    /**
+     * Decodes the \p value using properties::decodeBinaryValue and, if successful, sets
+     * the new value through TemplateProperty::setValue.
+     *
+     * \param value The binary encoding of the new value
+     * \return \c true if the decoding succeeded; \c false otherwise
+     */
+    bool setBinaryValue(std::string_view value) override;
+
     /**
      * Returns the description for this TemplateProperty as a Lua script that returns a
      * table on execution.
@@ -253,4 +253,19 @@ bool TemplateProperty<T>::setStringValue(std::string value) {
     return success;
 }
 
+template <typename T>
+bool TemplateProperty<T>::getBinaryValue(std::string& value) const {
+    return encodeBinaryValue(_value, value);
+}
+
+template <typename T>
+bool TemplateProperty<T>::setBinaryValue(std::string_view value) {
+    T thisValue = _value;
+    const bool success = decodeBinaryValue(value, thisValue);
+    if (success) {
+        setValue(std::move(thisValue));
+    }
+    return success;
+}
+
 }  // namespace openspace::properties
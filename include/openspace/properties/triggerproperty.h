@@ -66,6 +66,20 @@ public:
      */
     void set(std::any value) override;
 
+    /**
+     * A TriggerProperty does not carry a value, so its binary encoding is always empty.
+     * \param value The string that is cleared
+     * \return Returns always <code>true</code>
+     */
+    bool getBinaryValue(std::string& value) const override;
+
+    /**
+     * Silently ignores the binary \p value and will trigger the listeners.
+     * \param value The ignored value
+     * \return Returns always <code>true</code>
+     */
+    bool setBinaryValue(std::string_view value) override;
+
     std::string toJson() const override;
 
     std::string jsonValue() const override;
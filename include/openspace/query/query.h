@@ -43,6 +43,7 @@ SceneGraphNode* sceneGraphNode(const std::string& name);
 const Renderable* renderable(const std::string& name);
 properties::Property* property(const std::string& uri);
 std::vector<properties::Property*> allProperties();
+std::vector<properties::Property*> propertiesWithUriPrefix(const std::string& prefix);
 
 } // namespace openspace
 
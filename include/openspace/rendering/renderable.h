@@ -74,6 +74,23 @@ public:
     void setBoundingSphere(float boundingSphere);
     float boundingSphere() const;
 
+    /**
+     * Returns the radius of a sphere, centered on the scene graph node, that contains all
+     * geometry of this Renderable and that is used to cull it. The bounding sphere is
+     * also used for navigation and distance measurements, so Renderables whose geometry
+     * extends beyond it override this function instead of changing the bounding sphere.
+     * By default, this is the #boundingSphere.
+     */
+    virtual float cullingSphere() const;
+
+    /**
+     * Returns whether the Scene is allowed to skip rendering this Renderable if its
+     * #cullingSphere is outside of the view frustum or smaller than a pixel. By default,
+     * this is the case if a culling sphere is set. Renderables that have to do work in
+     * #render even if they are not visible have to override this function.
+     */
+    virtual bool isCullable() const;
+
     virtual void render(const RenderData& data, RendererTasks& rendererTask);
     virtual void update(const UpdateData& data);
     virtual SurfacePositionHandle calculateSurfacePositionHandle(
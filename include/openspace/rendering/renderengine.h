@@ -214,6 +214,11 @@ private:
     
     properties::BoolProperty _enableFXAA;
 
+    properties::BoolProperty _sceneCulling;
+    properties::FloatProperty _cullingMinimumPixelSize;
+    properties::IntProperty _nFrustumCulledNodes;
+    properties::IntProperty _nSubPixelCulledNodes;
+
     properties::BoolProperty _disableHDRPipeline;
     properties::FloatProperty _hdrExposure;
     properties::FloatProperty _gamma;
@@ -0,0 +1,126 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___BOUNDINGSPHEREHIERARCHY___H__
+#define __OPENSPACE_CORE___BOUNDINGSPHEREHIERARCHY___H__
+
+#include <ghoul/glm.h>
+#include <cstdint>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * A binary bounding volume hierarchy over a set of spheres that is used to determine
+ * which items are outside of a view frustum or too small to cover a pixel without
+ * testing every item individually. The items are identified by their index in the list
+ * of spheres that was passed to #build. Moving items are supported by updating their
+ * spheres through #setSphere and calling #refit, which recomputes the bounds of the
+ * hierarchy without changing its structure. If the items have moved so far that the
+ * refitted bounds become too loose, the hierarchy is rebuilt automatically.
+ */
+class BoundingSphereHierarchy {
+public:
+    struct Sphere {
+        glm::dvec3 center = glm::dvec3(0.0);
+        double radius = 0.0;
+    };
+
+    enum class Visibility : uint8_t {
+        Visible = 0,
+        OutsideFrustum,
+        SubPixel
+    };
+
+    /**
+     * Rebuilds the hierarchy for the provided \p spheres. Item \c i of all subsequent
+     * calls refers to the <code>i</code>-th sphere of this list.
+     */
+    void build(std::vector<Sphere> spheres);
+
+    /**
+     * Updates the sphere of the \p item. The bounds of the hierarchy are only updated by
+     * the next call to #refit.
+     *
+     * \pre \p item must be smaller than #nItems
+     * \pre \p sphere.radius must not be negative
+     */
+    void setSphere(size_t item, const Sphere& sphere);
+
+    /**
+     * Recomputes the bounds of all inner nodes of the hierarchy from the current item
+     * spheres. If the sum of the radii of the inner nodes has grown to more than twice
+     * the sum directly after the last build, the hierarchy is rebuilt instead.
+     */
+    void refit();
+
+    /**
+     * Classifies all items against the frustum described by the \p viewProjection
+     * matrix and stores the results in \p result, which is resized to #nItems. An item
+     * is OutsideFrustum if its sphere is completely outside of one of the four side
+     * planes of the frustum. An item is SubPixel if the radius of its sphere, projected
+     * onto the screen from the \p cameraPosition, is smaller than the
+     * \p minimumPixelSize. If an inner node of the hierarchy is culled, all items below
+     * it are culled without being tested individually.
+     *
+     * \param viewProjection The combined view and projection matrix in world space
+     * \param cameraPosition The position of the camera in world space
+     * \param pixelsPerUnit The number of pixels that an object of size 1 covers at a
+     *        distance of 1 in front of the camera, which is the vertical scaling factor
+     *        of the projection matrix times half the vertical resolution
+     * \param minimumPixelSize The minimum projected radius in pixels that an item must
+     *        have to be visible. If this value is 0, no items are SubPixel
+     * \param result The list of visibilities of all items
+     */
+    void cull(const glm::dmat4& viewProjection, const glm::dvec3& cameraPosition,
+        double pixelsPerUnit, double minimumPixelSize,
+        std::vector<Visibility>& result) const;
+
+    /// Returns the number of items in the hierarchy
+    size_t nItems() const;
+
+private:
+    struct Node {
+        Sphere sphere;
+        // The number of items below this node; a node with a single item is a leaf
+        size_t nItems = 0;
+        // The item of a leaf node
+        size_t item = 0;
+        // The index of the right child of an inner node. The left child directly
+        // follows its parent
+        size_t right = 0;
+    };
+
+    void buildNode(std::vector<size_t>::iterator begin,
+        std::vector<size_t>::iterator end);
+
+    // The nodes are stored in depth-first order, so every child comes after its parent
+    std::vector<Node> _nodes;
+    std::vector<Sphere> _spheres;
+    double _builtRadiusSum = 0.0;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___BOUNDINGSPHEREHIERARCHY___H__
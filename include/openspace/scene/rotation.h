@@ -52,6 +52,14 @@ public:
     virtual glm::dmat3 matrix(const UpdateData& time) const = 0;
     void update(const UpdateData& data);
 
+    /**
+     * Returns whether this Rotation can be updated on a worker thread while other scene
+     * graph nodes are updated at the same time. This requires that the matrix only
+     * depends on the Rotation itself and on services that are safe to be used
+     * concurrently, such as the SpiceManager, and not on other scene graph nodes.
+     */
+    virtual bool isThreadSafe() const;
+
     static documentation::Documentation Documentation();
 
 protected:
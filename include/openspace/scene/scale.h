@@ -52,6 +52,14 @@ public:
     virtual double scaleValue(const UpdateData& data) const = 0;
     virtual void update(const UpdateData& data);
 
+    /**
+     * Returns whether this Scale can be updated on a worker thread while other scene
+     * graph nodes are updated at the same time. This requires that the scaling factor
+     * only depends on the Scale itself and on services that are safe to be used
+     * concurrently, such as the SpiceManager, and not on other scene graph nodes.
+     */
+    virtual bool isThreadSafe() const;
+
     static documentation::Documentation Documentation();
 
 protected:
@@ -27,10 +27,17 @@
 
 #include <openspace/properties/propertyowner.h>
 
+#include <openspace/scene/boundingspherehierarchy.h>
 #include <openspace/scene/scenegraphnode.h>
 #include <openspace/scene/scenelicense.h>
 #include <ghoul/misc/easing.h>
 #include <ghoul/misc/exception.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <mutex>
 #include <set>
 #include <unordered_map>
@@ -45,6 +52,7 @@ namespace documentation { struct Documentation; }
 namespace scripting { struct LuaLibrary; }
 
 class SceneInitializer;
+class ThreadPool;
 
 // Notifications:
 // SceneGraphFinishedLoading
@@ -68,8 +76,35 @@ public:
         std::string time;
     };
 
-    // constructors & destructor
-    Scene(std::unique_ptr<SceneInitializer> initializer);
+    /// This struct describes whether and how nodes are culled in #buildRenderQueue
+    struct CullingSettings {
+        bool isEnabled = false;
+        /// The minimum radius in pixels that the bounding sphere of a node must cover
+        /// on the screen to be rendered
+        double minimumPixelSize = 0.0;
+        /// The vertical resolution of the rendering in pixels
+        int resolutionHeight = 0;
+    };
+
+    /// The number of nodes that were culled by the last #buildRenderQueue call
+    struct CullingStatistics {
+        int nOutsideFrustum = 0;
+        int nSubPixel = 0;
+    };
+
+    /**
+     * Creates an empty scene.
+     *
+     * \param initializer The initializer that is used to initialize added nodes
+     * \param nUpdateThreads The number of worker threads that are used to update the
+     *        transformations of independent nodes concurrently. If this value is 0, all
+     *        nodes are updated on the calling thread
+     * \param initializeGLBudget The time per call of #initializeNodesGL that is spent on
+     *        the OpenGL initialization of nodes. If this value is 0, all nodes that are
+     *        ready are initialized at once
+     */
+    Scene(std::unique_ptr<SceneInitializer> initializer, unsigned int nUpdateThreads = 0,
+        std::chrono::microseconds initializeGLBudget = std::chrono::microseconds(0));
     ~Scene();
 
     /**
@@ -99,12 +134,37 @@ public:
     Camera* camera() const;
 
     /**
-     * Updates all SceneGraphNodes relative positions
+     * Updates all SceneGraphNodes relative positions. If the Scene was created with
+     * update threads, the transformations of nodes that are thread-safe and whose parent
+     * and dependencies are thread-safe are updated concurrently first, in an order that
+     * respects their dependencies, and the remaining updates happen afterwards in the
+     * topological order. The results are identical to updating all nodes in order.
      */
     void update(const UpdateData& data);
 
     /**
-     * Render visible SceneGraphNodes using the provided camera.
+     * Collects all SceneGraphNodes that are rendered this frame into one queue per render
+     * bin in a single traversal of the scene graph. The queue of the Transparent render
+     * bin is sorted back to front as seen from the camera. This has to be called once
+     * per frame before #render. If culling is enabled, cullable nodes whose bounding
+     * sphere is outside the view frustum or smaller than the minimum pixel size are not
+     * added to the queues.
+     */
+    void buildRenderQueue(const RenderData& data);
+
+    /**
+     * Sets the culling parameters that are used by subsequent #buildRenderQueue calls.
+     */
+    void setCullingSettings(CullingSettings settings);
+
+    /**
+     * Returns the number of nodes that were culled by the last #buildRenderQueue call.
+     */
+    CullingStatistics cullingStatistics() const;
+
+    /**
+     * Renders the SceneGraphNodes of the render queues built by #buildRenderQueue whose
+     * render bin is contained in the <code>renderBinMask</code> of the \p data.
      */
     void render(const RenderData& data, RendererTasks& tasks);
 
@@ -170,10 +230,19 @@ public:
     void initializeNode(SceneGraphNode* node);
 
     /**
-     * Return true if the scene is initializing
+     * Return true if the scene is initializing, including nodes that still wait for
+     * their OpenGL initialization
      */
     bool isInitializing() const;
 
+    /**
+     * Calls initializeGL on the nodes that have finished their initialization, until the
+     * time budget that was passed to the constructor is used up. At least one node is
+     * initialized per call and the remaining nodes are kept for the next call. This
+     * function is called as part of #update and has to be called from the main thread.
+     */
+    void initializeNodesGL();
+
     /**
      * Adds an interpolation request for the passed \p prop that will run for
      * \p durationSeconds seconds. Every time the #updateInterpolations method is called
@@ -251,6 +320,32 @@ private:
 
     void sortTopologically();
 
+    /**
+     * Rebuilds the graph of update tasks from the topologically sorted nodes.
+     */
+    void buildUpdateGraph();
+
+    /**
+     * Updates the transformations of all concurrent nodes using the _updatePool and
+     * returns when all of them have been updated.
+     */
+    void updateTransformsConcurrently(const UpdateData& data);
+
+    /**
+     * Updates the transformation of the node of the \p task and continues with one of
+     * the nodes that become ready through it, while the others are scheduled on the
+     * _updatePool.
+     */
+    void runUpdateTask(size_t task, const UpdateData& data);
+
+    /**
+     * Moves the bounding spheres in the _boundingSphereHierarchy to the current world
+     * positions of the nodes, or rebuilds it if nodes were added or removed.
+     */
+    void updateBoundingSphereHierarchy();
+
+    void renderNode(SceneGraphNode* node, const RenderData& data, RendererTasks& tasks);
+
     std::unique_ptr<Camera> _camera;
     std::vector<SceneGraphNode*> _topologicallySortedNodes;
     std::vector<SceneGraphNode*> _circularNodes;
@@ -258,6 +353,45 @@ private:
     bool _dirtyNodeRegistry = false;
     SceneGraphNode _rootDummy;
     std::unique_ptr<SceneInitializer> _initializer;
+    // Nodes that have been initialized, but whose initializeGL has not been called yet
+    std::deque<SceneGraphNode*> _nodesToInitializeGL;
+    std::chrono::microseconds _initializeGLBudget;
+
+    // One task per node in _topologicallySortedNodes, connecting each node to the nodes
+    // that need its transformation
+    struct UpdateTask {
+        SceneGraphNode* node = nullptr;
+        // The number of parents and dependencies of the node
+        size_t nInputs = 0;
+        // The indices of the tasks that have this node as parent or dependency
+        std::vector<size_t> outputs;
+        // Whether this node and all of its inputs can be updated concurrently. Updated
+        // every frame before the tasks are scheduled
+        bool isConcurrent = false;
+    };
+    std::vector<UpdateTask> _updateTasks;
+    std::unique_ptr<std::atomic<size_t>[]> _remainingUpdateInputs;
+    std::unique_ptr<ThreadPool> _updatePool;
+    std::mutex _updateMutex;
+    std::condition_variable _updateCondition;
+    size_t _nRemainingUpdateTasks = 0;
+    std::exception_ptr _updateException;
+
+    struct RenderQueueItem {
+        SceneGraphNode* node;
+        // The distance to the camera, used to sort the Transparent render bin
+        double distance;
+    };
+    // One render queue for each render bin in the order of Renderable::RenderBin
+    std::array<std::vector<RenderQueueItem>, 4> _renderQueues;
+
+    // Contains the bounding sphere of the node at the same index in
+    // _topologicallySortedNodes. Nodes that are not cullable have a radius of 0
+    BoundingSphereHierarchy _boundingSphereHierarchy;
+    bool _isBoundingSphereHierarchyDirty = true;
+    std::vector<BoundingSphereHierarchy::Visibility> _visibilities;
+    CullingSettings _cullingSettings;
+    CullingStatistics _cullingStatistics;
 
     std::vector<InterestingTime> _interestingTimes;
 
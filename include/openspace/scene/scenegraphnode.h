@@ -36,6 +36,7 @@
 #include <ghoul/misc/boolean.h>
 #include <atomic>
 #include <functional>
+#include <future>
 #include <memory>
 #include <vector>
 #include <chrono>
@@ -99,6 +100,56 @@ public:
     void traversePreOrder(const std::function<void(SceneGraphNode*)>& fn);
     void traversePostOrder(const std::function<void(SceneGraphNode*)>& fn);
     void update(const UpdateData& data);
+
+    /**
+     * Updates the translation, rotation, and scale of this node and computes its world
+     * transformation. This is the first half of #update and requires that the parent
+     * and all dependencies of this node have already been updated.
+     *
+     * \return \c true if the node is active and #updateRenderable should be called
+     */
+    bool updateTransform(const UpdateData& data);
+
+    /**
+     * Updates the Renderable of this node using the world transformation computed by
+     * the last call to #updateTransform. This is the second half of #update and has to
+     * be called on the main thread.
+     */
+    void updateRenderable(const UpdateData& data);
+
+    /**
+     * Returns whether #updateTransform can be called on a worker thread while other
+     * nodes are updated concurrently. This is the case if the translation, rotation,
+     * and scale are all thread-safe and the node has not opted out of concurrent
+     * updates.
+     */
+    bool isUpdateThreadSafe() const;
+
+    /**
+     * Returns whether this node is rendered at the provided \p time. This requires the
+     * node to be initialized and inside its time frame and its Renderable to be visible,
+     * ready, and enabled.
+     */
+    bool isRenderedAt(const Time& time) const;
+
+    /**
+     * Returns whether the Scene may skip rendering this node if its #worldCullingSphere
+     * is not visible. This is the case if the Renderable allows it and has a culling
+     * sphere, and the node does not compute its screen space values.
+     */
+    bool isCullable() const;
+
+    /**
+     * Returns the radius of a sphere around the #worldPosition that contains the
+     * Renderable of this node in world space and that is used for culling.
+     */
+    double worldCullingSphere() const;
+
+    /**
+     * Renders the Renderable of this node. The caller is responsible for only calling
+     * this function if #isRenderedAt returns \c true for the current time and the
+     * render bin of the Renderable matches the <code>renderBinMask</code> of the \p data.
+     */
     void render(const RenderData& data, RendererTasks& tasks);
 
     void attachChild(std::unique_ptr<SceneGraphNode> child);
@@ -155,6 +206,27 @@ private:
     double calculateWorldScale() const;
     void computeScreenSpaceData(RenderData& newData);
 
+    /// Initializes the deferred renderable on a shared pool of worker threads
+    void startRenderableInitialization();
+
+    /**
+     * Finishes the initialization that was started by #startRenderableInitialization
+     * once the worker thread is done. The initializeGL of the renderable happens here.
+     */
+    void finishRenderableInitialization();
+
+    /// Waits for a running initialization of the renderable to finish
+    void waitForRenderableInitialization();
+
+    // The state of the renderable, which can lag behind the state of the node if the
+    // initialization of disabled renderables is deferred until they are enabled
+    enum class RenderableState : int {
+        Deferred,
+        Initializing,
+        Initialized,
+        GLInitialized
+    };
+
     std::atomic<State> _state = State::Loaded;
     std::vector<std::unique_ptr<SceneGraphNode>> _children;
     SceneGraphNode* _parent = nullptr;
@@ -169,6 +241,11 @@ private:
     PerformanceRecord _performanceRecord = { 0, 0, 0, 0, 0 };
 
     std::unique_ptr<Renderable> _renderable;
+    std::atomic<RenderableState> _renderableState = RenderableState::Deferred;
+    // The destructor waits for a running initialization, so that it is finished before
+    // the renderable is destroyed
+    std::future<void> _renderableInitialization;
+    properties::StringProperty _renderableLoadingState;
 
     properties::StringProperty _guiPath;
     properties::StringProperty _guiDisplayName;
@@ -182,6 +259,12 @@ private:
 
     std::unique_ptr<TimeFrame> _timeFrame;
 
+    // If this value is 'false', the transformation of this node is always updated on the
+    // main thread, regardless of whether its components claim to be thread-safe
+    bool _allowsConcurrentUpdate = true;
+    // Whether the last call to updateTransform updated the node
+    bool _isTransformUpdated = false;
+
     // Cached transform data
     glm::dvec3 _worldPositionCached = glm::dvec3(0.0);
     glm::dmat3 _worldRotationCached = glm::dmat3(1.0);
@@ -26,6 +26,10 @@
 #define __OPENSPACE_CORE___SCENEINITIALIZER___H__
 
 #include <openspace/util/threadpool.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -51,19 +55,68 @@ private:
     std::vector<SceneGraphNode*> _initializedNodes;
 };
 
+/**
+ * Initializes the scene graph nodes on a pool of worker threads. Instead of initializing
+ * the nodes in the order in which they are added, the nodes that the camera focus
+ * depends on are initialized first and all other nodes are initialized in the order of
+ * their expected cost, starting with the most expensive one. This keeps a single
+ * expensive node from being started last and stalling the end of the loading.
+ * The expected costs and the camera focus are learned from the previous run and are
+ * stored in a cache file.
+ */
 class MultiThreadedSceneInitializer : public SceneInitializer {
 public:
-    MultiThreadedSceneInitializer(unsigned int nThreads);
+    /**
+     * Creates the initializer with \p nThreads worker threads. If \p costCacheFile is
+     * not empty and points to a file written by #saveCosts, the costs and the camera
+     * focus stored in it are used to prioritize the nodes.
+     */
+    MultiThreadedSceneInitializer(unsigned int nThreads, std::string costCacheFile = "");
 
     void initializeNode(SceneGraphNode* node) override;
     std::vector<SceneGraphNode*> takeInitializedNodes() override;
     bool isInitializing() const override;
 
+    /**
+     * Writes the time that each node took to initialize into the cost cache file,
+     * together with the identifiers of the \p focus node, its parents, and its
+     * dependencies. If \p focus is \c nullptr, no focus is stored. This function must
+     * only be called while no nodes are initializing.
+     */
+    void saveCosts(const SceneGraphNode* focus) const;
+
 private:
+    struct PendingNode {
+        SceneGraphNode* node;
+        bool isFocus;
+        std::chrono::microseconds cost;
+        // Used to initialize nodes with the same priority in the order they were added
+        uint64_t index;
+    };
+
+    /// Returns whether \p lhs should be initialized after \p rhs
+    static bool hasLowerPriority(const PendingNode& lhs, const PendingNode& rhs);
+
+    /// Removes the node with the highest priority from the queue and initializes it
+    void initializeNextNode();
+
+    std::string _costCacheFile;
+    std::unordered_set<std::string> _focusNodes;
+    std::unordered_map<std::string, std::chrono::microseconds> _expectedCosts;
+    std::chrono::microseconds _defaultCost = std::chrono::microseconds(0);
+    std::unordered_map<std::string, std::chrono::microseconds> _measuredCosts;
+
+    // A heap of the nodes that are waiting to be initialized
+    std::vector<PendingNode> _pendingNodes;
+    uint64_t _nAddedNodes = 0;
+
     std::vector<SceneGraphNode*> _initializedNodes;
     std::unordered_set<SceneGraphNode*> _initializingNodes;
-    ThreadPool _threadPool;
     mutable std::mutex _mutex;
+
+    // The thread pool is destroyed first, so that the workers are stopped before the
+    // state they use is destroyed
+    ThreadPool _threadPool;
 };
 
 } // namespace openspace
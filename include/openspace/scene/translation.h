@@ -54,6 +54,15 @@ public:
 
     virtual glm::dvec3 position(const UpdateData& data) const = 0;
 
+    /**
+     * Returns whether #position(const UpdateData&) may be called from other threads
+     * while the scene is updated, for example to sample a trail in the background. This
+     * requires that computing a position does not modify the Translation and that a
+     * change of its properties replaces the values used by #position atomically, as a
+     * background computation might still be running when a property is changed.
+     */
+    virtual bool isThreadSafe() const;
+
     // Registers a callback that gets called when a significant change has been made that
     // invalidates potentially stored points, for example in trails
     void onParameterChange(std::function<void()> callback);
@@ -28,6 +28,7 @@
 #include <openspace/util/syncable.h>
 #include <openspace/documentation/documentationgenerator.h>
 
+#include <openspace/properties/binaryvalue.h>
 #include <openspace/scripting/lualibrary.h>
 #include <ghoul/lua/luastate.h>
 #include <ghoul/misc/boolean.h>
@@ -53,10 +54,15 @@ public:
     using ScriptCallback = std::function<void(ghoul::Dictionary)>;
     BooleanType(RemoteScripting);
 
+    /// A queued script or, if the \c uri is not empty, a queued binary property set
     struct QueueItem {
         std::string script;
         RemoteScripting remoteScripting;
         ScriptCallback callback;
+
+        std::string uri;
+        std::string value;
+        std::string luaValue;
     };
 
     static constexpr const char* OpenSpaceLibraryName = "openspace";
@@ -94,6 +100,41 @@ public:
     void queueScript(const std::string& script, RemoteScripting remoteScripting,
         ScriptCallback cb = ScriptCallback());
 
+    /**
+     * Queues setting the Property with the \p uri to a new value without going through
+     * the Lua interpreter. The \p binaryValue has to be created by
+     * properties::encodeBinaryValue with the type of the Property (or be empty for a
+     * TriggerProperty) and is synchronized to all nodes in the same queue as the
+     * scripts, so that property sets and scripts are applied in the order in which they
+     * were queued. Just like <code>openspace.setPropertyValueSingle</code>, this removes
+     * a running interpolation of the Property. The \p luaValue is the same value as a
+     * Lua literal and is only used when the property change has to be stored as a
+     * script, that is when it is sent to parallel connection clients or saved into a
+     * session recording.
+     *
+     * \param uri The fully qualified identifier of the Property that is changed
+     * \param binaryValue The binary encoding of the new value
+     * \param luaValue The new value as a Lua literal
+     * \param remoteScripting Whether the change is sent to parallel connection clients
+     */
+    void queuePropertySet(std::string uri, std::string binaryValue, std::string luaValue,
+        RemoteScripting remoteScripting);
+
+    /**
+     * Queues setting the Property with the \p uri to the \p value without going through
+     * the Lua interpreter (see #queuePropertySet). If the type \c T does not have a
+     * binary encoding, a call to <code>openspace.setPropertyValueSingle</code> is queued
+     * instead.
+     *
+     * \param uri The fully qualified identifier of the Property that is changed
+     * \param value The new value, which must be of the type of the Property
+     * \param luaValue The new value as a Lua literal
+     * \param remoteScripting Whether the change is sent to parallel connection clients
+     */
+    template <typename T>
+    void queuePropertyValue(std::string uri, const T& value, std::string luaValue,
+        RemoteScripting remoteScripting);
+
     std::vector<std::string> allLuaFunctions() const;
 
     std::string generateJson() const override;
@@ -109,18 +150,27 @@ private:
     void addBaseLibrary();
     void remapPrintFunction();
 
+    void applyPropertySet(const std::string& uri, std::string_view value);
+
     ghoul::lua::LuaState _state;
     std::vector<LuaLibrary> _registeredLibraries;
 
+    // A script (if the uri is empty) or a binary property set as it is synchronized.
+    // Both share the same queues so that they are applied in the order they were queued
+    struct SyncItem {
+        std::string uri;
+        std::string value;
+    };
+
     std::queue<QueueItem> _incomingScripts;
 
     // Slave scripts are mutex protected since decode and rendering may
     // happen asynchronously.
     std::mutex _slaveScriptsMutex;
-    std::queue<std::string> _slaveScriptQueue;
+    std::queue<SyncItem> _slaveScriptQueue;
     std::queue<QueueItem> _masterScriptQueue;
 
-    std::vector<std::string> _scriptsToSync;
+    std::vector<SyncItem> _scriptsToSync;
 
     // Logging variables
     bool _logFileExists = false;
@@ -129,6 +179,28 @@ private:
     std::string _logFilename;
 };
 
+template <typename T>
+void ScriptEngine::queuePropertyValue(std::string uri, const T& value,
+                                      std::string luaValue,
+                                      RemoteScripting remoteScripting)
+{
+    std::string binaryValue;
+    if (properties::encodeBinaryValue(value, binaryValue)) {
+        queuePropertySet(
+            std::move(uri),
+            std::move(binaryValue),
+            std::move(luaValue),
+            remoteScripting
+        );
+    }
+    else {
+        queueScript(
+            "openspace.setPropertyValueSingle('" + uri + "', " + luaValue + ");",
+            remoteScripting
+        );
+    }
+}
+
 } // namespace openspace::scripting
 
 #endif // __OPENSPACE_CORE___SCRIPTENGINE___H__
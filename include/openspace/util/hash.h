@@ -0,0 +1,57 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___HASH___H__
+#define __OPENSPACE_CORE___HASH___H__
+
+#include <cstdint>
+#include <string_view>
+
+namespace openspace {
+
+/// The initial value of a 64-bit FNV-1a hash before any data has been added to it
+constexpr const uint64_t FNV1aOffsetBasis = 0xCBF2'9CE4'8422'2325;
+
+/**
+ * Returns the 64-bit FNV-1a hash of the \p data, continuing from the \p hash of the data
+ * that preceded it. Unlike std::hash, the result is the same in every execution and on
+ * every platform, so it can be used for data that is persisted between launches, such
+ * as the names of cache files.
+ *
+ * \param data The bytes that are added to the hash
+ * \param hash The hash of the preceding data, or the offset basis for the first data
+ * \return The hash of the preceding data followed by \p data
+ */
+constexpr uint64_t hashFNV1a(std::string_view data, uint64_t hash = FNV1aOffsetBasis) {
+    constexpr const uint64_t Prime = 0x0000'0100'0000'01B3;
+    for (const char c : data) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= Prime;
+    }
+    return hash;
+}
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___HASH___H__
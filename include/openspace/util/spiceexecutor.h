@@ -0,0 +1,238 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___SPICEEXECUTOR___H__
+#define __OPENSPACE_CORE___SPICEEXECUTOR___H__
+
+#include <openspace/util/spicemanager.h>
+
+#include <ghoul/glm.h>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * The SpiceExecutor owns the thread on which all CSPICE calls are made, as CSPICE keeps
+ * global state and is not thread-safe. Batches of requests are submitted through
+ * #submit, which returns a future, or #execute, which waits for the results. The
+ * SpiceExecutor's thread drains the submitted batches in the order in which they
+ * arrived, so a batch is never interleaved with other CSPICE calls, such as a kernel
+ * being loaded, and the thread hand-off happens once per batch instead of once per
+ * request. Every function of the SpiceManager that calls into CSPICE is executed on the
+ * same thread through #run, so no other thread ever enters CSPICE and no lock around it
+ * is needed.
+ *
+ * Each request produces one Result, at the same index as the request in the batch. If a
+ * request fails, the exception is stored in its Result and rethrown when the value is
+ * accessed, so that the failure of one request does not affect the rest of the batch.
+ *
+ * The SpiceExecutor is owned by the SpiceManager and accessed through
+ * SpiceManager::executor.
+ */
+class SpiceExecutor {
+public:
+    /// Starts the thread that owns all CSPICE calls
+    SpiceExecutor();
+
+    /// Finishes all batches that have already been submitted and stops the thread
+    ~SpiceExecutor();
+
+    /// Requests the position of a target relative to an observer, see
+    /// SpiceManager::targetPosition
+    struct PositionRequest {
+        std::string target;
+        std::string observer;
+        std::string referenceFrame;
+        SpiceManager::AberrationCorrection aberrationCorrection;
+        double time = 0.0;
+
+        /// If this is set, it is used instead of the names above. The query has to stay
+        /// valid until the request has been evaluated
+        const SpiceManager::PositionQuery* query = nullptr;
+    };
+
+    /// The result of a PositionRequest
+    struct PositionResult {
+        glm::dvec3 position = glm::dvec3(0.0);
+        double lightTime = 0.0;
+    };
+
+    /// Requests the position and velocity of a target relative to an observer, see
+    /// SpiceManager::targetState
+    struct StateRequest {
+        std::string target;
+        std::string observer;
+        std::string referenceFrame;
+        SpiceManager::AberrationCorrection aberrationCorrection;
+        double time = 0.0;
+    };
+
+    /// Requests the matrix that transforms positions from one reference frame into
+    /// another, see SpiceManager::frameTransformationMatrix
+    struct TransformMatrixRequest {
+        std::string from;
+        std::string to;
+        double time = 0.0;
+
+        /// If \c true, the matrix is estimated outside of the CK coverage instead of
+        /// failing, see SpiceManager::positionTransformMatrix
+        bool estimateUncovered = false;
+    };
+
+    /// Requests the field of view of an instrument, see SpiceManager::fieldOfView
+    struct FieldOfViewRequest {
+        std::string instrument;
+    };
+
+    /// Requests the surface intercept of a ray from an observer, see
+    /// SpiceManager::surfaceIntercept
+    struct SurfaceInterceptRequest {
+        std::string target;
+        std::string observer;
+        std::string fovFrame;
+        std::string referenceFrame;
+        SpiceManager::AberrationCorrection aberrationCorrection;
+        double time = 0.0;
+        glm::dvec3 direction = glm::dvec3(0.0);
+    };
+
+    using Request = std::variant<
+        PositionRequest,
+        StateRequest,
+        TransformMatrixRequest,
+        FieldOfViewRequest,
+        SurfaceInterceptRequest
+    >;
+
+    /// The result of a single request of a batch
+    struct Result {
+        /**
+         * Returns the value of the request, which has to be of the type that belongs to
+         * the type of the request: PositionResult, SpiceManager::TargetStateResult,
+         * glm::dmat3, SpiceManager::FieldOfViewResult, or
+         * SpiceManager::SurfaceInterceptResult.
+         *
+         * \throw SpiceManager::SpiceException If the request failed
+         */
+        template <typename T>
+        const T& get() const;
+
+        /// Holds std::monostate if the request failed
+        std::variant<
+            std::monostate,
+            PositionResult,
+            SpiceManager::TargetStateResult,
+            glm::dmat3,
+            SpiceManager::FieldOfViewResult,
+            SpiceManager::SurfaceInterceptResult
+        > value;
+
+        /// The exception that was thrown when evaluating the request, if any
+        std::exception_ptr exception;
+    };
+
+    /**
+     * Queues the \p batch behind all batches that were submitted before. The requests are
+     * evaluated in order and without any other CSPICE calls in between.
+     *
+     * \param batch The requests that are evaluated in order
+     * \return A future that holds one Result per request
+     */
+    std::future<std::vector<Result>> submit(std::vector<Request> batch);
+
+    /**
+     * Evaluates the \p batch like #submit and waits for the results. If this is called
+     * on the SpiceExecutor's thread, the batch is evaluated immediately.
+     *
+     * \param batch The requests that are evaluated in order
+     * \return One Result per request
+     */
+    std::vector<Result> execute(const std::vector<Request>& batch);
+
+    /**
+     * Executes the \p function on the SpiceExecutor's thread behind all work that was
+     * submitted before, waits for it, and returns its result. An exception thrown by the
+     * \p function is rethrown on the calling thread. If this is called on the
+     * SpiceExecutor's thread, the \p function is executed immediately, so functions of
+     * the SpiceManager that use this can call each other.
+     */
+    template <typename Function>
+    auto run(Function&& function) -> decltype(function());
+
+    /// Returns whether the calling thread is the thread that owns all CSPICE calls
+    bool isSpiceThread() const;
+
+private:
+    /// Adds the \p job to the end of the queue that is drained by the thread
+    void enqueue(std::function<void()> job);
+
+    /// The loop of the thread that executes the queued jobs in order
+    void processJobs();
+
+    /// Evaluates the \p batch on the calling thread, which has to be the SpiceExecutor's
+    std::vector<Result> evaluate(const std::vector<Request>& batch) const;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::function<void()>> _jobs;
+    bool _isStopping = false;
+
+    // Declared last so that the queue exists before the thread starts
+    std::thread _thread;
+};
+
+template <typename Function>
+auto SpiceExecutor::run(Function&& function) -> decltype(function()) {
+    if (isSpiceThread()) {
+        return function();
+    }
+
+    using T = decltype(function());
+    std::packaged_task<T()> task(std::forward<Function>(function));
+    std::future<T> result = task.get_future();
+    // The task stays alive until it has been executed, as this function waits for it
+    enqueue([&task]() { task(); });
+    return result.get();
+}
+
+template <typename T>
+const T& SpiceExecutor::Result::get() const {
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+    return std::get<T>(value);
+}
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___SPICEEXECUTOR___H__
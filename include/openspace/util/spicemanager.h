@@ -29,7 +29,9 @@
 #include <ghoul/misc/boolean.h>
 #include <ghoul/misc/exception.h>
 #include <array>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <set>
@@ -38,6 +40,8 @@ namespace openspace {
 
 namespace scripting { struct LuaLibrary; }
 
+class SpiceExecutor;
+
 class SpiceManager {
 public:
     BooleanType(UseException);
@@ -151,6 +155,15 @@ public:
     static bool isInitialized();
     static SpiceManager& ref();
 
+    /**
+     * Returns the executor whose thread makes all calls into CSPICE. Every function of
+     * the SpiceManager that calls into CSPICE is executed on that thread, and code that
+     * issues many requests in a row can evaluate them as a single batch through it.
+     *
+     * \return The executor that owns the access to CSPICE
+     */
+    SpiceExecutor& executor();
+
     /**
      * Loads one or more SPICE kernels into a program. The provided path can either be a
      * binary, text-kernel, or meta-kernel which gets loaded into the kernel pool. The
@@ -236,6 +249,48 @@ public:
      */
     bool hasCkCoverage(const std::string& frame, double et) const;
 
+    /**
+     * Returns the intervals for which the loaded SPK kernels cover the \p target. Only
+     * binary SPK kernels contribute to the coverage.
+     *
+     * \param target The body to be examined
+     * \return The list of (start, end) ephemeris times that are covered, which is empty
+     *         if no loaded SPK kernel contains the \p target
+     *
+     * \throw SpiceException If \p target does not name a valid SPICE object
+     * \pre \p target must not be empty.
+     */
+    std::vector<std::pair<double, double>> spkCoverage(const std::string& target) const;
+
+    /**
+     * Returns the intervals for which the loaded CK kernels cover the \p frame. Only
+     * binary CK kernels contribute to the coverage.
+     *
+     * \param frame The frame to be examined
+     * \return The list of (start, end) ephemeris times that are covered, which is empty
+     *         if no loaded CK kernel contains the \p frame
+     *
+     * \throw SpiceException If \p frame is not a valid frame
+     * \pre \p frame must not be empty.
+     */
+    std::vector<std::pair<double, double>> ckCoverage(const std::string& frame) const;
+
+    /**
+     * Returns the absolute paths of all kernels that are currently loaded, in the order
+     * in which they were loaded.
+     *
+     * \return The paths of all loaded kernels
+     */
+    std::vector<std::string> loadedKernels() const;
+
+    /**
+     * Returns a number that changes whenever a kernel is loaded or unloaded. Values that
+     * were derived from the kernel pool are still valid if this number did not change.
+     *
+     * \return The current generation of the kernel pool
+     */
+    unsigned int kernelGeneration() const;
+
     /**
      * Determines whether values exist for some \p item for any body, identified by its
      * \p naifId, in the kernel pool by passing it to the \c bodfnd_c function.
@@ -448,7 +503,12 @@ public:
     /**
      * Converts the \p timeString representing a date to a double precision
      * value representing the ephemeris time; that is the number of TDB
-     * seconds past the J2000 epoch.
+     * seconds past the J2000 epoch. UTC calendar dates of the forms
+     * <code>YYYY-MM-DD</code>, <code>YYYY-MON-DD</code>, or <code>YYYY MON DD</code>,
+     * optionally followed by a space (or <code>T</code> for <code>YYYY-MM-DD</code>)
+     * and <code>hh:mm</code> or <code>hh:mm:ss.fff</code>, are converted natively
+     * using the leap seconds of the loaded leapseconds kernel. All other formats are
+     * passed to \c str2et_c.
      *
      * \param timeString A string representing the time to be converted
      * \return The converted time; the number of TDB seconds past the J2000 epoch,
@@ -542,6 +602,86 @@ public:
         const std::string& observer, const std::string& referenceFrame,
         AberrationCorrection aberrationCorrection, double ephemerisTime) const;
 
+    /**
+     * A position query of a target body relative to an observer in a reference frame
+     * whose names have already been resolved into NAIF IDs. Queries are created with
+     * #positionQuery and evaluated with the #targetPosition overloads that take a query,
+     * which neither resolve the names again nor look up the SPK coverage by name. A query
+     * stays valid when kernels are loaded or unloaded.
+     */
+    struct PositionQuery {
+        std::string target;
+        std::string observer;
+        std::string referenceFrame;
+        AberrationCorrection aberrationCorrection;
+
+        int targetId = 0;
+        int observerId = 0;
+        int frameId = 0;
+
+        /// The SPK coverage intervals of target and observer, refreshed on kernel loads
+        mutable const std::vector<std::pair<double, double>>* targetCoverage = nullptr;
+        mutable const std::vector<std::pair<double, double>>* observerCoverage = nullptr;
+        mutable unsigned int coverageGeneration = 0;
+    };
+
+    /**
+     * Resolves the names of the \p target, \p observer, and \p referenceFrame into
+     * their NAIF IDs and returns a PositionQuery that can be evaluated repeatedly without
+     * any further name lookups.
+     *
+     * \param target The target body name or the target body's NAIF ID
+     * \param observer The observing body name or the observing body's NAIF ID
+     * \param referenceFrame The reference frame of the output position vector
+     * \param aberrationCorrection The aberration correction used for the position
+     *        calculation
+     * \return The pre-resolved query
+     *
+     * \throw SpiceException If the \p target or \p observer do not name a valid NAIF
+     *        object or \p referenceFrame does not name a valid reference frame
+     * \pre \p target must not be empty.
+     * \pre \p observer must not be empty.
+     * \pre \p referenceFrame must not be empty.
+     */
+    PositionQuery positionQuery(const std::string& target, const std::string& observer,
+        const std::string& referenceFrame,
+        AberrationCorrection aberrationCorrection = AberrationCorrection()) const;
+
+    /**
+     * Returns the position of the target of the \p query relative to its observer at the
+     * \p ephemerisTime. The result is the same as calling #targetPosition with the names
+     * that were used to create the \p query, but the position is evaluated directly from
+     * the resolved NAIF IDs (using \c spkezp_c).
+     *
+     * \param query The query that was created by #positionQuery
+     * \param ephemerisTime The time at which the position is to be queried
+     * \param lightTime If the aberration correction of the \p query is different from
+     *        AbberationCorrection::Type::None, this variable will contain the light time
+     *        between the observer and the target.
+     * \return The position of the target relative to the observer
+     *
+     * \throw SpiceException If there is not sufficient data available to compute the
+     *        position or neither the target nor the observer have coverage.
+     * \post If an exception is thrown, \p lightTime will not be modified.
+     *
+     * \sa http://naif.jpl.nasa.gov/pub/naif/toolkit_docs/C/cspice/spkezp_c.html
+     */
+    glm::dvec3 targetPosition(const PositionQuery& query, double ephemerisTime,
+        double& lightTime) const;
+
+    /**
+     * Returns the position of the target of the \p query relative to its observer at the
+     * \p ephemerisTime. See the overload with a light time parameter for details.
+     *
+     * \param query The query that was created by #positionQuery
+     * \param ephemerisTime The time at which the position is to be queried
+     * \return The position of the target relative to the observer
+     *
+     * \throw SpiceException If there is not sufficient data available to compute the
+     *        position or neither the target nor the observer have coverage.
+     */
+    glm::dvec3 targetPosition(const PositionQuery& query, double ephemerisTime) const;
+
     /**
      * This method returns the transformation matrix that defines the transformation from
      * the reference frame \p from to the reference frame \p to. As both reference frames
@@ -999,6 +1139,46 @@ private:
     std::map<int, std::set<double>> _ckCoverageTimes;
     std::map<int, std::set<double>> _spkCoverageTimes;
 
+    /// Incremented whenever _spkIntervals changes so PositionQuery can refresh its cache
+    unsigned int _spkCoverageGeneration = 1;
+
+    /// Incremented whenever a kernel is loaded or unloaded
+    std::atomic<unsigned int> _kernelGeneration = { 1 };
+
+    /**
+     * Converts the \p timeString into an ephemeris time without calling SPICE if it is
+     * one of the calendar date formats described in ephemerisTimeFromDate.
+     *
+     * \param timeString The date string that should be converted
+     * \param ephemerisTime The converted time if the conversion succeeded
+     * \return \c true if the \p timeString could be converted, \c false if it has to
+     *         be passed to \c str2et_c instead
+     */
+    bool ephemerisTimeFromCalendarDate(const std::string& timeString,
+        double& ephemerisTime) const;
+
+    /// Reads the leap seconds and the TDB constants from the SPICE kernel pool
+    void loadLeapSeconds();
+
+    /// The time constants from the leapseconds kernel (see \c deltet_c)
+    struct LeapSeconds {
+        /// Pairs of the UTC seconds past J2000 from which on a difference between TAI
+        /// and UTC is valid and that difference, sorted by the former
+        std::vector<std::pair<double, double>> deltaAt;
+        double deltaTa = 0.0;
+        double k = 0.0;
+        double eb = 0.0;
+        double m0 = 0.0;
+        double m1 = 0.0;
+    };
+    /// \c nullptr if no leapseconds kernel is loaded. The table is only ever replaced as
+    /// a whole through atomic operations, so that dates can be converted without a
+    /// detour through the executor's thread
+    std::shared_ptr<const LeapSeconds> _leapSeconds;
+
+    /// Owns the thread on which all calls into CSPICE are made
+    std::unique_ptr<SpiceExecutor> _executor;
+
     /// Stores whether the SpiceManager throws exceptions (Yes) or fails silently (No)
     UseException _useExceptions = UseException::Yes;
 
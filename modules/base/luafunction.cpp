@@ -0,0 +1,821 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/base/luafunction.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/glm.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/lua/ghoul_lua.h>
+#include <ghoul/lua/lua_helper.h>
+#include <ghoul/lua/luastate.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace openspace {
+
+/// The compiled form of a function, evaluated on a stack of doubles
+struct LuaFunction::Program {
+    /// The maximum number of values on the stack while evaluating a program
+    static constexpr const int MaxStackSize = 32;
+    /// The maximum number of parameters and local variables of a program
+    static constexpr const int MaxVariables = 32;
+
+    enum class Op {
+        Constant, Load, Store, Add, Subtract, Multiply, Divide, Modulo, Power, Negate,
+        Call
+    };
+
+    enum class Function {
+        Abs, Acos, Asin, Atan, Ceil, Cos, Exp, Floor, Fmod, Log, Max, Min, Sin, Sqrt, Tan
+    };
+
+    struct Instruction {
+        Op op;
+        /// The value pushed by Constant
+        double value = 0.0;
+        /// The variable of Load and Store, the number of arguments of Call
+        int index = 0;
+        /// The function of Call
+        Function function = Function::Abs;
+    };
+
+    std::vector<Instruction> instructions;
+    int nParameters = 0;
+};
+
+/// The Lua states for one function of one script that are not currently in use
+struct LuaFunction::StatePool {
+    struct State {
+        ghoul::lua::LuaState state;
+        /// The reference of the function in the registry
+        int reference = LUA_NOREF;
+    };
+
+    /// Returns a free state or creates a new one
+    std::unique_ptr<State> acquire();
+    /// Returns the \p state to the pool after its stack has been cleared
+    void release(std::unique_ptr<State> state);
+
+    std::string scriptFile;
+    std::string function;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<State>> freeStates;
+};
+
+struct LuaFunction::Script {
+    std::string scriptFile;
+    std::unique_ptr<Program> program;
+    std::shared_ptr<StatePool> pool;
+};
+
+} // namespace openspace
+
+namespace {
+    constexpr const char* _loggerCat = "LuaFunction";
+
+    using Program = openspace::LuaFunction::Program;
+
+    // The pools of Lua states for each script and function. Pools are shared by all
+    // LuaFunctions that have loaded the same script and are destroyed with the last one
+    std::mutex ArenaMutex;
+    std::map<std::string, std::weak_ptr<openspace::LuaFunction::StatePool>> Arena;
+
+    struct Token {
+        enum class Type { Number, Name, Symbol, End };
+
+        Type type;
+        std::string text;
+        double number = 0.0;
+    };
+
+    // Splits the script into tokens. Returns false if the script contains anything that
+    // the compiler does not support, such as strings, tables, or comparisons
+    bool tokenize(const std::string& script, std::vector<Token>& tokens) {
+        constexpr const std::string_view Symbols = "+-*/%^(),=.;";
+
+        const size_t size = script.size();
+        size_t i = 0;
+        while (i < size) {
+            const char c = script[i];
+            const char next = i + 1 < size ? script[i + 1] : '\0';
+
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                ++i;
+            }
+            else if (c == '-' && next == '-') {
+                i += 2;
+                // Long comments start with a long bracket --[[ or --[==[
+                if (i < size && script[i] == '[') {
+                    size_t j = i + 1;
+                    while (j < size && script[j] == '=') {
+                        ++j;
+                    }
+                    if (j < size && script[j] == '[') {
+                        const std::string close = ']' + std::string(j - i - 1, '=') + ']';
+                        const size_t end = script.find(close, j + 1);
+                        if (end == std::string::npos) {
+                            return false;
+                        }
+                        i = end + close.size();
+                        continue;
+                    }
+                }
+                const size_t end = script.find('\n', i);
+                i = (end == std::string::npos) ? size : end;
+            }
+            else if (std::isdigit(static_cast<unsigned char>(c)) ||
+                     (c == '.' && std::isdigit(static_cast<unsigned char>(next))))
+            {
+                if (c == '0' && (next == 'x' || next == 'X')) {
+                    return false;
+                }
+                char* end = nullptr;
+                const double value = std::strtod(script.c_str() + i, &end);
+                const size_t length = end - (script.c_str() + i);
+                i += length;
+                if (i < size && (std::isalnum(static_cast<unsigned char>(script[i])) ||
+                    script[i] == '_' || script[i] == '.'))
+                {
+                    return false;
+                }
+                tokens.push_back({ Token::Type::Number, std::string(), value });
+            }
+            else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+                const size_t begin = i;
+                while (i < size && (std::isalnum(static_cast<unsigned char>(script[i])) ||
+                       script[i] == '_'))
+                {
+                    ++i;
+                }
+                tokens.push_back({ Token::Type::Name, script.substr(begin, i - begin) });
+            }
+            else if (Symbols.find(c) != std::string_view::npos) {
+                // Floor division, equality, and concatenation are not supported
+                if ((c == '/' && next == '/') || (c == '=' && next == '=') ||
+                    (c == '.' && next == '.'))
+                {
+                    return false;
+                }
+                tokens.push_back({ Token::Type::Symbol, std::string(1, c) });
+                ++i;
+            }
+            else {
+                return false;
+            }
+        }
+        tokens.push_back({ Token::Type::End, std::string() });
+        return true;
+    }
+
+    bool isReserved(const std::string& name) {
+        constexpr const std::array<const char*, 22> Reserved = {
+            "and", "break", "do", "else", "elseif", "end", "false", "for", "function",
+            "goto", "if", "in", "local", "nil", "not", "or", "repeat", "return", "then",
+            "true", "until", "while"
+        };
+        return std::find(Reserved.begin(), Reserved.end(), name) != Reserved.end();
+    }
+
+    struct MathFunction {
+        const char* name;
+        Program::Function function;
+        int minArguments;
+        int maxArguments;
+    };
+
+    // The supported functions of the math library and the number of arguments they take
+    constexpr const std::array<MathFunction, 15> MathFunctions = {{
+        { "abs", Program::Function::Abs, 1, 1 },
+        { "acos", Program::Function::Acos, 1, 1 },
+        { "asin", Program::Function::Asin, 1, 1 },
+        { "atan", Program::Function::Atan, 1, 2 },
+        { "ceil", Program::Function::Ceil, 1, 1 },
+        { "cos", Program::Function::Cos, 1, 1 },
+        { "exp", Program::Function::Exp, 1, 1 },
+        { "floor", Program::Function::Floor, 1, 1 },
+        { "fmod", Program::Function::Fmod, 2, 2 },
+        { "log", Program::Function::Log, 1, 2 },
+        { "max", Program::Function::Max, 1, Program::MaxStackSize },
+        { "min", Program::Function::Min, 1, Program::MaxStackSize },
+        { "sin", Program::Function::Sin, 1, 1 },
+        { "sqrt", Program::Function::Sqrt, 1, 1 },
+        { "tan", Program::Function::Tan, 1, 1 }
+    }};
+
+    // Compiles a script that only consists of the definition of a single function:
+    //   function name(a, b, ...)
+    //       local x = <expression>
+    //       y = <expression>           (only for parameters and local variables)
+    //       return <expression>, <expression>, ...
+    //   end
+    // Every construct outside of this subset of Lua makes the compilation fail
+    class Compiler {
+    public:
+        Compiler(const std::vector<Token>& tokens, std::string name, int nArguments,
+                 int nResults)
+            : _tokens(tokens)
+            , _name(std::move(name))
+            , _nArguments(nArguments)
+            , _nResults(nResults)
+        {}
+
+        bool compile(Program& program) {
+            _program = &program;
+
+            if (!acceptName("function") || !acceptName(_name) || !acceptSymbol("(")) {
+                return false;
+            }
+            if (!acceptSymbol(")")) {
+                do {
+                    const Token& parameter = peek();
+                    if (parameter.type != Token::Type::Name ||
+                        isReserved(parameter.text) || declareVariable(parameter.text) < 0)
+                    {
+                        return false;
+                    }
+                    ++_position;
+                } while (acceptSymbol(","));
+                if (!acceptSymbol(")")) {
+                    return false;
+                }
+            }
+            program.nParameters = _nVariables;
+            if (program.nParameters > _nArguments) {
+                return false;
+            }
+
+            while (!acceptName("return")) {
+                if (!statement()) {
+                    return false;
+                }
+            }
+
+            int nValues = 0;
+            do {
+                if (!expression()) {
+                    return false;
+                }
+                ++nValues;
+            } while (acceptSymbol(","));
+            acceptSymbol(";");
+
+            return nValues == _nResults && acceptName("end") &&
+                   peek().type == Token::Type::End;
+        }
+
+        int maxDepth() const {
+            return _maxDepth;
+        }
+
+    private:
+        const Token& peek(size_t offset = 0) const {
+            return _tokens[std::min(_position + offset, _tokens.size() - 1)];
+        }
+
+        bool acceptSymbol(const char* symbol) {
+            if (peek().type == Token::Type::Symbol && peek().text == symbol) {
+                ++_position;
+                return true;
+            }
+            return false;
+        }
+
+        bool acceptName(const std::string& name) {
+            if (peek().type == Token::Type::Name && peek().text == name) {
+                ++_position;
+                return true;
+            }
+            return false;
+        }
+
+        bool isSymbolAt(size_t offset, const char* symbol) const {
+            const Token& token = peek(offset);
+            return token.type == Token::Type::Symbol && token.text == symbol;
+        }
+
+        // Adds a parameter or local variable and returns its index, or -1 if there are
+        // too many variables. A variable with the same name is shadowed by the new one
+        int declareVariable(const std::string& name) {
+            if (_nVariables == Program::MaxVariables) {
+                return -1;
+            }
+            _variables[name] = _nVariables;
+            return _nVariables++;
+        }
+
+        bool statement() {
+            if (acceptName("local")) {
+                const Token& name = peek();
+                if (name.type != Token::Type::Name || isReserved(name.text) ||
+                    !isSymbolAt(1, "="))
+                {
+                    return false;
+                }
+                _position += 2;
+                if (!expression()) {
+                    return false;
+                }
+                // The new variable is only visible after its initializer
+                const int variable = declareVariable(name.text);
+                if (variable < 0) {
+                    return false;
+                }
+                emit({ Program::Op::Store, 0.0, variable }, -1);
+            }
+            else {
+                // Assignments to anything but a known variable would create a global
+                const auto it = _variables.find(peek().text);
+                if (peek().type != Token::Type::Name || it == _variables.end() ||
+                    !isSymbolAt(1, "="))
+                {
+                    return false;
+                }
+                const int variable = it->second;
+                _position += 2;
+                if (!expression()) {
+                    return false;
+                }
+                emit({ Program::Op::Store, 0.0, variable }, -1);
+            }
+            acceptSymbol(";");
+            return true;
+        }
+
+        // expression := term { ('+' | '-') term }
+        bool expression() {
+            if (!term()) {
+                return false;
+            }
+            while (true) {
+                Program::Op op;
+                if (acceptSymbol("+")) {
+                    op = Program::Op::Add;
+                }
+                else if (acceptSymbol("-")) {
+                    op = Program::Op::Subtract;
+                }
+                else {
+                    return true;
+                }
+                if (!term()) {
+                    return false;
+                }
+                emit({ op }, -1);
+            }
+        }
+
+        // term := unary { ('*' | '/' | '%') unary }
+        bool term() {
+            if (!unary()) {
+                return false;
+            }
+            while (true) {
+                Program::Op op;
+                if (acceptSymbol("*")) {
+                    op = Program::Op::Multiply;
+                }
+                else if (acceptSymbol("/")) {
+                    op = Program::Op::Divide;
+                }
+                else if (acceptSymbol("%")) {
+                    op = Program::Op::Modulo;
+                }
+                else {
+                    return true;
+                }
+                if (!unary()) {
+                    return false;
+                }
+                emit({ op }, -1);
+            }
+        }
+
+        // unary := '-' unary | power
+        bool unary() {
+            if (acceptSymbol("-")) {
+                if (!unary()) {
+                    return false;
+                }
+                emit({ Program::Op::Negate }, 0);
+                return true;
+            }
+            return power();
+        }
+
+        // power := primary [ '^' unary ], which makes '^' right associative and binding
+        // more tightly than a unary minus on its left, as in Lua
+        bool power() {
+            if (!primary()) {
+                return false;
+            }
+            if (acceptSymbol("^")) {
+                if (!unary()) {
+                    return false;
+                }
+                emit({ Program::Op::Power }, -1);
+            }
+            return true;
+        }
+
+        // primary := number | variable | 'math' '.' constant |
+        //            'math' '.' function '(' expression { ',' expression } ')' |
+        //            '(' expression ')'
+        bool primary() {
+            const Token& token = peek();
+            if (token.type == Token::Type::Number) {
+                ++_position;
+                emit({ Program::Op::Constant, token.number }, 1);
+                return true;
+            }
+            if (acceptSymbol("(")) {
+                return expression() && acceptSymbol(")");
+            }
+            if (token.type != Token::Type::Name || isReserved(token.text)) {
+                return false;
+            }
+
+            const auto it = _variables.find(token.text);
+            if (it != _variables.end()) {
+                ++_position;
+                emit({ Program::Op::Load, 0.0, it->second }, 1);
+                return true;
+            }
+            if (token.text != "math" || !isSymbolAt(1, ".") ||
+                peek(2).type != Token::Type::Name)
+            {
+                // Any other name would be a global variable
+                return false;
+            }
+            const std::string name = peek(2).text;
+            _position += 3;
+
+            if (name == "pi") {
+                emit({ Program::Op::Constant, glm::pi<double>() }, 1);
+                return true;
+            }
+            if (name == "huge") {
+                emit({ Program::Op::Constant, HUGE_VAL }, 1);
+                return true;
+            }
+
+            const auto f = std::find_if(
+                MathFunctions.begin(),
+                MathFunctions.end(),
+                [&name](const MathFunction& mf) { return name == mf.name; }
+            );
+            if (f == MathFunctions.end() || !acceptSymbol("(")) {
+                return false;
+            }
+            int nArguments = 0;
+            if (!acceptSymbol(")")) {
+                do {
+                    if (!expression()) {
+                        return false;
+                    }
+                    ++nArguments;
+                } while (acceptSymbol(","));
+                if (!acceptSymbol(")")) {
+                    return false;
+                }
+            }
+            if (nArguments < f->minArguments || nArguments > f->maxArguments) {
+                return false;
+            }
+            emit({ Program::Op::Call, 0.0, nArguments, f->function }, 1 - nArguments);
+            return true;
+        }
+
+        void emit(Program::Instruction instruction, int stackChange) {
+            _program->instructions.push_back(instruction);
+            _depth += stackChange;
+            _maxDepth = std::max(_maxDepth, _depth);
+        }
+
+        const std::vector<Token>& _tokens;
+        const std::string _name;
+        const int _nArguments;
+        const int _nResults;
+
+        Program* _program = nullptr;
+        size_t _position = 0;
+        std::map<std::string, int> _variables;
+        int _nVariables = 0;
+        int _depth = 0;
+        int _maxDepth = 0;
+    };
+
+    std::unique_ptr<Program> compile(const std::string& script, const std::string& name,
+                                     int nArguments, int nResults)
+    {
+        std::vector<Token> tokens;
+        if (!tokenize(script, tokens)) {
+            return nullptr;
+        }
+
+        auto program = std::make_unique<Program>();
+        Compiler compiler(tokens, name, nArguments, nResults);
+        if (!compiler.compile(*program) || compiler.maxDepth() > Program::MaxStackSize) {
+            return nullptr;
+        }
+        return program;
+    }
+
+    // The modulo operation for floating point numbers as defined by Lua
+    double luaModulo(double a, double b) {
+        double m = std::fmod(a, b);
+        if ((m > 0.0) ? b < 0.0 : (m < 0.0 && b != m)) {
+            m += b;
+        }
+        return m;
+    }
+
+    double callFunction(Program::Function function, const double* args, int nArgs) {
+        using F = Program::Function;
+        switch (function) {
+            case F::Abs:   return std::abs(args[0]);
+            case F::Acos:  return std::acos(args[0]);
+            case F::Asin:  return std::asin(args[0]);
+            case F::Atan:  return std::atan2(args[0], nArgs == 2 ? args[1] : 1.0);
+            case F::Ceil:  return std::ceil(args[0]);
+            case F::Cos:   return std::cos(args[0]);
+            case F::Exp:   return std::exp(args[0]);
+            case F::Floor: return std::floor(args[0]);
+            case F::Fmod:  return std::fmod(args[0], args[1]);
+            case F::Log:
+                if (nArgs == 1) {
+                    return std::log(args[0]);
+                }
+                else if (args[1] == 2.0) {
+                    return std::log2(args[0]);
+                }
+                else if (args[1] == 10.0) {
+                    return std::log10(args[0]);
+                }
+                else {
+                    return std::log(args[0]) / std::log(args[1]);
+                }
+            case F::Max: {
+                double m = args[0];
+                for (int i = 1; i < nArgs; ++i) {
+                    if (m < args[i]) {
+                        m = args[i];
+                    }
+                }
+                return m;
+            }
+            case F::Min: {
+                double m = args[0];
+                for (int i = 1; i < nArgs; ++i) {
+                    if (args[i] < m) {
+                        m = args[i];
+                    }
+                }
+                return m;
+            }
+            case F::Sin:   return std::sin(args[0]);
+            case F::Sqrt:  return std::sqrt(args[0]);
+            case F::Tan:   return std::tan(args[0]);
+            default:       throw ghoul::MissingCaseException();
+        }
+    }
+
+    void run(const Program& program, const double* arguments, double* results,
+             int nResults)
+    {
+        std::array<double, Program::MaxStackSize> stack;
+        std::array<double, Program::MaxVariables> variables;
+        std::copy(arguments, arguments + program.nParameters, variables.begin());
+
+        int top = 0;
+        for (const Program::Instruction& i : program.instructions) {
+            switch (i.op) {
+                case Program::Op::Constant:
+                    stack[top++] = i.value;
+                    break;
+                case Program::Op::Load:
+                    stack[top++] = variables[i.index];
+                    break;
+                case Program::Op::Store:
+                    variables[i.index] = stack[--top];
+                    break;
+                case Program::Op::Add:
+                    --top;
+                    stack[top - 1] = stack[top - 1] + stack[top];
+                    break;
+                case Program::Op::Subtract:
+                    --top;
+                    stack[top - 1] = stack[top - 1] - stack[top];
+                    break;
+                case Program::Op::Multiply:
+                    --top;
+                    stack[top - 1] = stack[top - 1] * stack[top];
+                    break;
+                case Program::Op::Divide:
+                    --top;
+                    stack[top - 1] = stack[top - 1] / stack[top];
+                    break;
+                case Program::Op::Modulo:
+                    --top;
+                    stack[top - 1] = luaModulo(stack[top - 1], stack[top]);
+                    break;
+                case Program::Op::Power:
+                    --top;
+                    stack[top - 1] = std::pow(stack[top - 1], stack[top]);
+                    break;
+                case Program::Op::Negate:
+                    stack[top - 1] = -stack[top - 1];
+                    break;
+                case Program::Op::Call:
+                    top -= i.index;
+                    stack[top] = callFunction(i.function, &stack[top], i.index);
+                    ++top;
+                    break;
+            }
+        }
+        std::copy(stack.begin() + top - nResults, stack.begin() + top, results);
+    }
+} // namespace
+
+namespace openspace {
+
+std::unique_ptr<LuaFunction::StatePool::State> LuaFunction::StatePool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeStates.empty()) {
+            std::unique_ptr<State> state = std::move(freeStates.back());
+            freeStates.pop_back();
+            return state;
+        }
+    }
+
+    // Executing the script might take a while, so we do it without holding the lock
+    auto state = std::make_unique<State>();
+    ghoul::lua::runScriptFile(state->state, scriptFile);
+    lua_getglobal(state->state, function.c_str());
+    if (!lua_isfunction(state->state, -1)) {
+        throw ghoul::RuntimeError(
+            fmt::format(
+                "Script '{}' does not have a function '{}'", scriptFile, function
+            ),
+            "LuaFunction"
+        );
+    }
+    // Pops the function from the stack and stores it in the registry
+    state->reference = luaL_ref(state->state, LUA_REGISTRYINDEX);
+    return state;
+}
+
+void LuaFunction::StatePool::release(std::unique_ptr<State> state) {
+    lua_settop(state->state, 0);
+    std::lock_guard<std::mutex> lock(mutex);
+    freeStates.push_back(std::move(state));
+}
+
+LuaFunction::LuaFunction(std::string name, int nArguments, int nResults)
+    : _name(std::move(name))
+    , _nArguments(nArguments)
+    , _nResults(nResults)
+{}
+
+LuaFunction::~LuaFunction() {} // NOLINT
+
+void LuaFunction::load(const std::string& scriptFile, AllowCompilation allowCompilation)
+{
+    const std::shared_ptr<const Script> previous = std::atomic_load(&_script);
+    auto script = std::make_shared<Script>();
+    script->scriptFile = scriptFile;
+
+    if (allowCompilation == AllowCompilation::Yes) {
+        std::ifstream file(scriptFile);
+        if (file.good()) {
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            script->program = compile(buffer.str(), _name, _nArguments, _nResults);
+        }
+        if (script->program) {
+            LDEBUG(fmt::format("Compiled function '{}' in '{}'", _name, scriptFile));
+            std::atomic_store(&_script, std::shared_ptr<const Script>(script));
+            return;
+        }
+    }
+
+    std::shared_ptr<StatePool> pool;
+    {
+        const std::string key = scriptFile + '|' + _name;
+        std::lock_guard<std::mutex> lock(ArenaMutex);
+        pool = Arena[key].lock();
+        // If we are reloading the pool that we were using, the script has changed and
+        // its states are outdated. Other LuaFunctions sharing that pool will pick up the
+        // new one when they reload
+        if (!pool || (previous && pool == previous->pool)) {
+            pool = std::make_shared<StatePool>();
+            pool->scriptFile = scriptFile;
+            pool->function = _name;
+            Arena[key] = pool;
+        }
+    }
+
+    // Create the first state right away to report errors in the script when it is loaded
+    try {
+        pool->release(pool->acquire());
+    }
+    catch (...) {
+        std::atomic_store(&_script, std::shared_ptr<const Script>());
+        throw;
+    }
+    script->pool = std::move(pool);
+    std::atomic_store(&_script, std::shared_ptr<const Script>(script));
+}
+
+bool LuaFunction::isLoaded() const {
+    return std::atomic_load(&_script) != nullptr;
+}
+
+bool LuaFunction::isCompiled() const {
+    const std::shared_ptr<const Script> script = std::atomic_load(&_script);
+    return script && script->program;
+}
+
+bool LuaFunction::evaluate(const double* arguments, double* results) const {
+    // The script is kept alive by this copy even if it is replaced while it is in use
+    const std::shared_ptr<const Script> script = std::atomic_load(&_script);
+    if (!script) {
+        return false;
+    }
+    if (script->program) {
+        run(*script->program, arguments, results, _nResults);
+        return true;
+    }
+
+    std::unique_ptr<StatePool::State> state;
+    try {
+        state = script->pool->acquire();
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERRORC(e.component, e.message);
+        return false;
+    }
+
+    lua_State* L = state->state;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, state->reference);
+    for (int i = 0; i < _nArguments; ++i) {
+        lua_pushnumber(L, arguments[i]);
+    }
+
+    bool success = lua_pcall(L, _nArguments, _nResults, 0) == LUA_OK;
+    if (success) {
+        for (int i = 0; i < _nResults; ++i) {
+            int isNumber = 0;
+            results[i] = lua_tonumberx(L, i - _nResults, &isNumber);
+            if (!isNumber) {
+                LERROR(fmt::format(
+                    "Function '{}' in '{}' has to return {} numbers",
+                    _name, script->scriptFile, _nResults
+                ));
+                success = false;
+                break;
+            }
+        }
+    }
+    else {
+        LERROR(fmt::format("Error executing '{}': {}", _name, lua_tostring(L, -1)));
+    }
+
+    script->pool->release(std::move(state));
+    return success;
+}
+
+} // namespace openspace
@@ -0,0 +1,111 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_BASE___LUAFUNCTION___H__
+#define __OPENSPACE_MODULE_BASE___LUAFUNCTION___H__
+
+#include <ghoul/misc/boolean.h>
+#include <memory>
+#include <string>
+
+namespace openspace {
+
+/**
+ * Evaluates a global function that is defined in a Lua script file, as used by the
+ * LuaTranslation, LuaRotation, and LuaScale. The script is only executed when it is
+ * loaded; afterwards the function is looked up through a reference in the Lua registry.
+ * The Lua states are taken from a shared arena that keeps one pool of states per
+ * script and function, so that many objects using the same script share a few states
+ * and evaluating the function concurrently from multiple threads is safe.
+ *
+ * If the script consists of nothing but the function, and the function only performs
+ * arithmetic on its arguments and local variables using the operators
+ * <code>+ - * / % ^</code>, numbers, and the functions and constants of the \c math
+ * library, it can be compiled into a small program that is evaluated without Lua.
+ */
+class LuaFunction {
+public:
+    BooleanType(AllowCompilation);
+
+    /**
+     * Creates a LuaFunction that calls the global function with the provided \p name.
+     *
+     * \param name The name of the global function in the script
+     * \param nArguments The number of arguments that are passed to the function
+     * \param nResults The number of values the function returns
+     */
+    LuaFunction(std::string name, int nArguments, int nResults);
+    ~LuaFunction();
+
+    /**
+     * Loads the \p scriptFile and looks up the function in it. If \p allowCompilation
+     * is \c Yes and the function is simple enough, it is compiled instead. A previously
+     * loaded script is replaced, even if it is the same file, so that changes to the
+     * file are picked up. Concurrent calls to #evaluate keep using the previous script
+     * until the new one has been loaded completely. If loading fails, no script is
+     * loaded afterwards.
+     *
+     * \throw ghoul::RuntimeError If the script could not be executed or does not define
+     *        the function
+     */
+    void load(const std::string& scriptFile, AllowCompilation allowCompilation);
+
+    /// Returns whether a script has been loaded successfully
+    bool isLoaded() const;
+
+    /// Returns whether the function is evaluated without Lua
+    bool isCompiled() const;
+
+    /**
+     * Calls the function with the \p arguments and writes the returned values into
+     * \p results. This function can be called from multiple threads at the same time.
+     *
+     * \param arguments The nArguments arguments to the function
+     * \param results The location the nResults returned values are written to
+     * \return \c true if the function was evaluated successfully, \c false if no script
+     *         has been loaded or the function failed, in which case an error is logged
+     */
+    bool evaluate(const double* arguments, double* results) const;
+
+    struct Program;
+    struct StatePool;
+
+private:
+    /// The result of loading a script: either the compiled program or the pool of Lua
+    /// states to evaluate the function in
+    struct Script;
+
+    const std::string _name;
+    const int _nArguments;
+    const int _nResults;
+
+    /// The currently loaded script. It is never modified after it has been loaded, but
+    /// replaced as a whole through atomic operations, so that #load can be called while
+    /// other threads are evaluating the function
+    std::shared_ptr<const Script> _script;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_BASE___LUAFUNCTION___H__
@@ -42,6 +42,7 @@
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureunit.h>
+#include <algorithm>
 
 namespace {
     constexpr const char* ProgramName = "ModelProgram";
@@ -292,6 +293,16 @@ bool RenderableModel::isReady() const {
     return _program && _texture;
 }
 
+bool RenderableModel::isCullable() const {
+    const glm::dmat3 transform = _modelTransform.value();
+    const double scale = std::max({
+        glm::length(transform[0]),
+        glm::length(transform[1]),
+        glm::length(transform[2])
+    });
+    return Renderable::isCullable() && scale <= 1.0 + 1e-6;
+}
+
 void RenderableModel::initialize() {
     for (const std::unique_ptr<LightSource>& ls : _lightSources) {
         ls->initialize();
@@ -63,6 +63,12 @@ public:
 
     bool isReady() const override;
 
+    /**
+     * Models are only culled by the Scene if their ModelTransform does not enlarge them,
+     * as the bounding sphere of the geometry does not include this transform.
+     */
+    bool isCullable() const override;
+
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     void update(const UpdateData& data) override;
 
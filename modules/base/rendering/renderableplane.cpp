@@ -165,6 +165,11 @@ bool RenderablePlane::isReady() const {
     return _shader != nullptr;
 }
 
+float RenderablePlane::cullingSphere() const {
+    // The corners of the quad are further away from the center than its size
+    return _size * glm::root_two<float>();
+}
+
 void RenderablePlane::initializeGL() {
     glGenVertexArrays(1, &_quad); // generate array
     glGenBuffers(1, &_vertexPositionBuffer); // generate buffer
@@ -290,6 +290,10 @@ bool RenderableTrail::isReady() const {
     return _programObject != nullptr;
 }
 
+bool RenderableTrail::isCullable() const {
+    return false;
+}
+
 void RenderableTrail::render(const RenderData& data, RendererTasks&) {
     _programObject->activate();
     _programObject->setUniform(_uniformCache.opacity, _opacity);
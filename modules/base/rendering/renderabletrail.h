@@ -97,6 +97,12 @@ struct Appearance : properties::PropertyOwner {
 
     bool isReady() const override;
 
+    /**
+     * Trails are never culled by the Scene, as their bounding sphere describes the extent
+     * of the trail but is centered on the object that is moving along it.
+     */
+    bool isCullable() const override;
+
     /**
      * The render method will set up the shader information and then render first the
      * information contained in the the \c _primaryRenderInformation, then the optional
@@ -27,9 +27,14 @@
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/scene/translation.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/opengl/programobject.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <numeric>
+#include <thread>
 
 // This class is using a VBO ring buffer + a constantly updated point as follows:
 // Structure of the array with a _resolution of 16. FF denotes the floating position that
@@ -79,6 +84,16 @@
 // items in memory as was shown to be much slower than the current system.   ---abock
 
 namespace {
+    // The threads on which the full sweeps of all trails are computed in the background.
+    // Their number is limited, so that a time jump that affects many trails does not
+    // start competing for the translations all at once
+    openspace::ThreadPool& sweepPool() {
+        static openspace::ThreadPool pool(
+            std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u)
+        );
+        return pool;
+    }
+
     constexpr openspace::properties::Property::PropertyInfo PeriodInfo = {
         "Period",
         "Period (in days)",
@@ -158,17 +173,17 @@ RenderableTrailOrbit::RenderableTrailOrbit(const ghoul::Dictionary& dictionary)
         "RenderableTrailOrbit"
     );
 
-    _translation->onParameterChange([this]() { _needsFullSweep = true; });
+    _translation->onParameterChange([this]() { invalidateTrail(); });
 
     // Period is in days
     using namespace std::chrono;
     const long long sph = duration_cast<seconds>(hours(24)).count();
     _period = dictionary.value<double>(PeriodInfo.identifier) * sph;
-    _period.onChange([&] { _needsFullSweep = true; _indexBufferDirty = true; });
+    _period.onChange([&] { invalidateTrail(); _indexBufferDirty = true; });
     addProperty(_period);
 
     _resolution = static_cast<int>(dictionary.value<double>(ResolutionInfo.identifier));
-    _resolution.onChange([&] { _needsFullSweep = true; _indexBufferDirty = true; });
+    _resolution.onChange([&] { invalidateTrail(); _indexBufferDirty = true; });
     addProperty(_resolution);
 
     // We store the vertices with (excluding the wrapping) decending temporal order
@@ -205,6 +220,10 @@ void RenderableTrailOrbit::initializeGL() {
 }
 
 void RenderableTrailOrbit::deinitializeGL() {
+    if (_sweep.valid()) {
+        _sweep.wait();
+    }
+
     glDeleteVertexArrays(1, &_primaryRenderInformation._vaoID);
     glDeleteBuffers(1, &_primaryRenderInformation._vBufferID);
     glDeleteBuffers(1, &_primaryRenderInformation._iBufferID);
@@ -379,9 +398,35 @@ void RenderableTrailOrbit::update(const UpdateData& data) {
 RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::updateTrails(
                                                                    const UpdateData& data)
 {
+    if (_sweep.valid()) {
+        // Until the sweep in the background is done, the previous trail is shown with
+        // only its floating position following the object
+        if (_sweep.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            const bool hasMoved = data.time.j2000Seconds() != _previousTime;
+            return { hasMoved, false, 0 };
+        }
+
+        Sweep sweep;
+        try {
+            sweep = _sweep.get();
+        }
+        catch (...) {
+            // Try again with the next update, as if the sweep had failed right away
+            _needsFullSweep = true;
+            throw;
+        }
+
+        if (sweep.generation == _sweepGeneration) {
+            applySweep(std::move(sweep));
+            return { false, true, UpdateReport::All };
+        }
+        // Otherwise, the trail was invalidated while the sweep was computed, so we have
+        // to start over. The storage can still be reused for the next sweep
+        _sweepVertexArray = std::move(sweep.vertices);
+    }
+
     if (_needsFullSweep) {
-        fullSweep(data.time.j2000Seconds());
-        return { false, true, UpdateReport::All } ;
+        return fullSweep(data.time.j2000Seconds());
     }
 
 
@@ -419,8 +464,7 @@ RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::updateTrails(
         // If we would need to generate more new points than there are total points in the
         // array, it is faster to regenerate the entire array
         if (nNewPoints >= _resolution) {
-            fullSweep(data.time.j2000Seconds());
-            return { false, true, UpdateReport::All };
+            return fullSweep(data.time.j2000Seconds());
         }
 
         for (int i = 0; i < nNewPoints; ++i) {
@@ -459,8 +503,7 @@ RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::updateTrails(
         // If we would need to generate more new points than there are total points in the
         // array, it is faster to regenerate the entire array
         if (nNewPoints >= _resolution) {
-            fullSweep(data.time.j2000Seconds());
-            return { false, true, UpdateReport::All };
+            return fullSweep(data.time.j2000Seconds());
         }
 
         for (int i = 0; i < nNewPoints; ++i) {
@@ -495,10 +538,64 @@ RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::updateTrails(
     }
 }
 
-void RenderableTrailOrbit::fullSweep(double time) {
+RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::fullSweep(double time) {
+    if (_translation->isThreadSafe() && !_vertexArray.empty()) {
+        // We have a previous trail to show in the meantime, so we can compute the sweep
+        // in the background
+        auto task = std::make_shared<std::packaged_task<Sweep()>>(
+            [this, time, period = _period.value(), resolution = _resolution.value(),
+             generation = _sweepGeneration, vertices = std::move(_sweepVertexArray)]
+            () mutable
+            {
+                Sweep sweep = computeSweep(time, period, resolution, std::move(vertices));
+                sweep.generation = generation;
+                return sweep;
+            }
+        );
+        _sweep = task->get_future();
+        sweepPool().enqueue([task]() { (*task)(); });
+        _sweepVertexArray = std::vector<TrailVBOLayout>();
+        _needsFullSweep = false;
+        return { true, false, 0 };
+    }
+
+    Sweep sweep = computeSweep(time, _period, _resolution, std::move(_sweepVertexArray));
+    sweep.generation = _sweepGeneration;
+    applySweep(std::move(sweep));
+    _needsFullSweep = false;
+    return { false, true, UpdateReport::All };
+}
+
+RenderableTrailOrbit::Sweep RenderableTrailOrbit::computeSweep(double time,
+                                                                double period,
+                                                                int resolution,
+                                             std::vector<TrailVBOLayout> vertices) const
+{
+    Sweep sweep;
     // Reserve the space for the vertices
-    _vertexArray.clear();
-    _vertexArray.resize(_resolution);
+    sweep.vertices = std::move(vertices);
+    sweep.vertices.clear();
+    sweep.vertices.resize(resolution);
+
+    sweep.lastPointTime = time;
+
+    const double secondsPerPoint = period / (resolution - 1);
+    // starting at 1 because the first position is a floating current one
+    for (int i = 1; i < resolution; ++i) {
+        const glm::vec3 p = _translation->position({ {}, Time(time), Time(0.0), false });
+        sweep.vertices[i] = { p.x, p.y, p.z };
+
+        time -= secondsPerPoint;
+    }
+
+    sweep.firstPointTime = time + secondsPerPoint;
+    return sweep;
+}
+
+void RenderableTrailOrbit::applySweep(Sweep sweep) {
+    // The previous trail's storage becomes the buffer for the next sweep
+    _sweepVertexArray = std::move(_vertexArray);
+    _vertexArray = std::move(sweep.vertices);
 
     // The index buffer stays constant until we change the size of the array
     if (_indexBufferDirty) {
@@ -509,22 +606,16 @@ void RenderableTrailOrbit::fullSweep(double time) {
         std::iota(_indexArray.begin() + _resolution, _indexArray.end(), 0);
     }
 
-    _lastPointTime = time;
-
-    const double secondsPerPoint = _period / (_resolution - 1);
-    // starting at 1 because the first position is a floating current one
-    for (int i = 1; i < _resolution; ++i) {
-        const glm::vec3 p = _translation->position({ {}, Time(time), Time(0.0), false });
-        _vertexArray[i] = { p.x, p.y, p.z };
-
-        time -= secondsPerPoint;
-    }
+    _lastPointTime = sweep.lastPointTime;
+    _firstPointTime = sweep.firstPointTime;
 
     _primaryRenderInformation.first = 0;
     _primaryRenderInformation.count = _resolution;
+}
 
-    _firstPointTime = time + secondsPerPoint;
-    _needsFullSweep = false;
+void RenderableTrailOrbit::invalidateTrail() {
+    _needsFullSweep = true;
+    ++_sweepGeneration;
 }
 
 } // namespace openspace
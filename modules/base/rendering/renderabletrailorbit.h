@@ -29,6 +29,8 @@
 
 #include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
+#include <future>
+#include <vector>
 
 namespace openspace {
 
@@ -43,6 +45,12 @@ namespace documentation { struct Documentation; }
  * are rendered. Each of these fixed points are fixed time steps apart, where as the most
  * current point is floating and updated every frame. The _period determines the length of
  * the trail (the distance between the newest and oldest point being _period days).
+ *
+ * If the time jumps or the parameters of the trail change, all points have to be
+ * recomputed in a full sweep. If the Translation is thread-safe, full sweeps after the
+ * first one are computed on a thread pool that is shared by all trails into a second
+ * vertex array while the previous trail continues to be shown; the arrays are swapped
+ * once the sweep is done.
  */
 class RenderableTrailOrbit : public RenderableTrail {
 public:
@@ -56,12 +64,6 @@ public:
     static documentation::Documentation Documentation();
 
 private:
-    /**
-     * Performs a full sweep of the orbit and fills the entire vertex buffer object.
-     * \param time The current time up to which the full sweep should be performed
-     */
-    void fullSweep(double time);
-
     /// This structure is returned from the #updateTrails method and gives information
     /// about which parts of the vertex array to update
     struct UpdateReport {
@@ -84,6 +86,51 @@ private:
      */
     UpdateReport updateTrails(const UpdateData& data);
 
+    /// The result of a full sweep, containing the positions of all fixed points
+    struct Sweep {
+        /// The fixed points, with the newest point at index 1
+        std::vector<TrailVBOLayout> vertices;
+        /// The time stamp of the oldest point
+        double firstPointTime = 0.0;
+        /// The time stamp of the newest fixed point
+        double lastPointTime = 0.0;
+        /// The value of _sweepGeneration when the sweep was started
+        unsigned int generation = 0;
+    };
+
+    /**
+     * Performs a full sweep of the orbit. If the translation is thread-safe and a
+     * previous trail exists, the sweep is started in the background and the previous
+     * trail is kept until the sweep is done, with only its floating position being
+     * updated. Otherwise, the sweep is performed right away and the entire vertex buffer
+     * object is filled.
+     *
+     * \param time The current time up to which the full sweep should be performed
+     * \return The UpdateReport containing information which array parts were touched
+     */
+    UpdateReport fullSweep(double time);
+
+    /**
+     * Computes the positions of all fixed points of the trail. This function only reads
+     * the translation and can thus be called from other threads if the translation is
+     * thread-safe.
+     *
+     * \param time The time of the newest fixed point
+     * \param period The length of the trail in seconds
+     * \param resolution The number of points of the trail, including the floating point
+     * \param vertices The array into which the points are written, reusing its storage
+     * \return The computed sweep
+     */
+    Sweep computeSweep(double time, double period, int resolution,
+        std::vector<TrailVBOLayout> vertices) const;
+
+    /// Makes the \p sweep the current trail and keeps the previous vertex array around to
+    /// be reused by the next sweep
+    void applySweep(Sweep sweep);
+
+    /// Marks the trail as needing a full sweep and discards sweeps that are in progress
+    void invalidateTrail();
+
     /// The orbital period of the RenderableTrail in days
     properties::DoubleProperty _period;
     /// The number of points that should be sampled between _period and now
@@ -102,6 +149,13 @@ private:
     double _lastPointTime = 0.0;
     /// The time stamp of when the last valid trail was generated.
     double _previousTime = 0.0;
+
+    /// Incremented whenever a change invalidates the sweeps that are in progress
+    unsigned int _sweepGeneration = 0;
+    /// The full sweep that is being computed in the background, if any
+    std::future<Sweep> _sweep;
+    /// The second vertex array that the next full sweep is written into
+    std::vector<TrailVBOLayout> _sweepVertexArray;
 };
 
 } // namespace openspace
@@ -27,8 +27,18 @@
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/scene/translation.h>
+#include <openspace/util/hash.h>
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/updatestructures.h>
+#include <ghoul/fmt.h>
+#include <ghoul/filesystem/cachemanager.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <queue>
+#include <typeinfo>
 
 // This class creates the entire trajectory at once and keeps it in memory the entire
 // time. This means that there is no need for updating the trail at runtime, but also that
@@ -43,6 +53,14 @@
 // _endTime. This buffer is updated every frame.
 
 namespace {
+    constexpr const char* _loggerCat = "RenderableTrailTrajectory";
+
+    constexpr const int8_t CurrentCacheVersion = 2;
+
+    // The number of segments the trajectory is split into before the adaptive sampling
+    // starts to subdivide them
+    constexpr const int InitialAdaptiveSegments = 256;
+
     constexpr openspace::properties::Property::PropertyInfo StartTimeInfo = {
         "StartTime",
         "Start Time",
@@ -81,6 +99,73 @@ namespace {
         "If this value is set to 'true', the entire trail will be rendered; if it is "
         "'false', only the trail until the current time in the application will be shown."
     };
+
+    constexpr openspace::properties::Property::PropertyInfo AdaptiveSamplingInfo = {
+        "AdaptiveSampling",
+        "Adaptive Sampling",
+        "If this value is set to 'true', the trajectory is sampled more densely where it "
+        "curves and more sparsely where it is straight. In this case, 'SampleInterval' / "
+        "'TimeStampSubsampleFactor' is the smallest time between two samples and the "
+        "time stamps are no longer equidistant in time."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo MaximumAngleInfo = {
+        "MaximumAngle",
+        "Maximum Angle",
+        "The largest angle (in degrees) between two consecutive line segments that the "
+        "adaptive sampling accepts without subdividing the segments further."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo MaximumErrorInfo = {
+        "MaximumError",
+        "Maximum Error",
+        "The largest distance between the sampled line and the trajectory, relative to "
+        "the size of the entire trail, that the adaptive sampling accepts without "
+        "subdividing the segments further."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo MaximumVerticesInfo = {
+        "MaximumVertices",
+        "Maximum Vertices",
+        "The maximum number of vertices that the adaptive sampling creates. If this "
+        "number is reached, the segments with the largest errors are subdivided first."
+    };
+
+    // A part of the trajectory considered by the adaptive sampling. The midpoint is
+    // sampled as well and is used to estimate how well the segment fits the trajectory
+    struct Segment {
+        double t0;
+        double t1;
+        glm::dvec3 p0;
+        glm::dvec3 pm;
+        glm::dvec3 p1;
+        double error;
+    };
+
+    bool operator<(const Segment& lhs, const Segment& rhs) {
+        return lhs.error < rhs.error;
+    }
+
+    // Identifies the contents of a file by its size and last modification time
+    std::string fileDescription(const std::string& path) {
+        std::error_code ec;
+        const uintmax_t size = std::filesystem::file_size(path, ec);
+        const auto modified = std::filesystem::last_write_time(path, ec);
+        return fmt::format(
+            "{}:{}:{};", path, size, modified.time_since_epoch().count()
+        );
+    }
+
+    std::string kernelDescription() {
+        std::vector<std::string> kernels = openspace::SpiceManager::ref().loadedKernels();
+        std::sort(kernels.begin(), kernels.end());
+
+        std::string description;
+        for (const std::string& kernel : kernels) {
+            description += fileDescription(kernel);
+        }
+        return description;
+    }
 } // namespace
 
 namespace openspace {
@@ -121,6 +206,30 @@ documentation::Documentation RenderableTrailTrajectory::Documentation() {
                 new BoolVerifier,
                 Optional::Yes,
                 RenderFullPathInfo.description
+            },
+            {
+                AdaptiveSamplingInfo.identifier,
+                new BoolVerifier,
+                Optional::Yes,
+                AdaptiveSamplingInfo.description
+            },
+            {
+                MaximumAngleInfo.identifier,
+                new DoubleVerifier,
+                Optional::Yes,
+                MaximumAngleInfo.description
+            },
+            {
+                MaximumErrorInfo.identifier,
+                new DoubleVerifier,
+                Optional::Yes,
+                MaximumErrorInfo.description
+            },
+            {
+                MaximumVerticesInfo.identifier,
+                new IntVerifier,
+                Optional::Yes,
+                MaximumVerticesInfo.description
             }
         }
     };
@@ -145,6 +254,10 @@ RenderableTrailTrajectory::RenderableTrailTrajectory(const ghoul::Dictionary& di
     , _sampleInterval(SampleIntervalInfo, 2.0, 2.0, 1e6)
     , _timeStampSubsamplingFactor(TimeSubSampleInfo, 1, 1, 1000000000)
     , _renderFullTrail(RenderFullPathInfo, false)
+    , _adaptiveSampling(AdaptiveSamplingInfo, false)
+    , _maximumAngle(MaximumAngleInfo, 1.0, 0.01, 45.0)
+    , _maximumError(MaximumErrorInfo, 1e-4, 1e-7, 1e-1)
+    , _maximumVertices(MaximumVerticesInfo, 1000000, 3, 100000000)
 {
     documentation::testSpecificationAndThrow(
         Documentation(),
@@ -179,6 +292,32 @@ RenderableTrailTrajectory::RenderableTrailTrajectory(const ghoul::Dictionary& di
     }
     addProperty(_renderFullTrail);
 
+    if (dictionary.hasKeyAndValue<bool>(AdaptiveSamplingInfo.identifier)) {
+        _adaptiveSampling = dictionary.value<bool>(AdaptiveSamplingInfo.identifier);
+    }
+    _adaptiveSampling.onChange([this] { _needsFullSweep = true; });
+    addProperty(_adaptiveSampling);
+
+    if (dictionary.hasKeyAndValue<double>(MaximumAngleInfo.identifier)) {
+        _maximumAngle = dictionary.value<double>(MaximumAngleInfo.identifier);
+    }
+    _maximumAngle.onChange([this] { _needsFullSweep = true; });
+    addProperty(_maximumAngle);
+
+    if (dictionary.hasKeyAndValue<double>(MaximumErrorInfo.identifier)) {
+        _maximumError = dictionary.value<double>(MaximumErrorInfo.identifier);
+    }
+    _maximumError.onChange([this] { _needsFullSweep = true; });
+    addProperty(_maximumError);
+
+    if (dictionary.hasKeyAndValue<double>(MaximumVerticesInfo.identifier)) {
+        _maximumVertices = static_cast<int>(
+            dictionary.value<double>(MaximumVerticesInfo.identifier)
+        );
+    }
+    _maximumVertices.onChange([this] { _needsFullSweep = true; });
+    addProperty(_maximumVertices);
+
     // We store the vertices with ascending temporal order
     _primaryRenderInformation.sorting = RenderInformation::VertexSorting::OldestFirst;
 }
@@ -214,26 +353,14 @@ void RenderableTrailTrajectory::update(const UpdateData& data) {
         _end = SpiceManager::ref().ephemerisTimeFromDate(_endTime);
 
         const double totalSampleInterval = _sampleInterval / _timeStampSubsamplingFactor;
-        // How many values do we need to compute given the distance between the start and
-        // end date and the desired sample interval
-        const int nValues = static_cast<int>((_end - _start) / totalSampleInterval);
-
-        // Make space for the vertices
-        _vertexArray.clear();
-        _vertexArray.resize(nValues);
-
-        // ... fill all of the values
-        for (int i = 0; i < nValues; ++i) {
-            const glm::vec3 p = _translation->position({
-                {},
-                Time(_start + i * totalSampleInterval),
-                Time(0.0),
-                false
-            });
-            _vertexArray[i] = { p.x, p.y, p.z };
+        if (_adaptiveSampling) {
+            sampleAdaptively(totalSampleInterval);
+        }
+        else {
+            sampleUniformly(totalSampleInterval);
         }
 
-        // ... and upload them to the GPU
+        // Upload the vertices to the GPU
         glBindVertexArray(_primaryRenderInformation._vaoID);
         glBindBuffer(GL_ARRAY_BUFFER, _primaryRenderInformation._vBufferID);
         glBufferData(
@@ -263,14 +390,16 @@ void RenderableTrailTrajectory::update(const UpdateData& data) {
     }
     else {
         // If only trail so far should be rendered, we need to find the corresponding time
-        // in the array and only render it until then
+        // in the array and only render it until then. As the samples might not be
+        // equidistant in time, we have to search for the last sample before now
         _primaryRenderInformation.first = 0;
-        const double t = std::max(
-            0.0,
-            (data.time.j2000Seconds() - _start) / (_end - _start)
+        const auto it = std::upper_bound(
+            _timeStamps.begin(),
+            _timeStamps.end(),
+            data.time.j2000Seconds()
         );
         _primaryRenderInformation.count = std::min(
-            static_cast<GLsizei>(ceil(_vertexArray.size() * t)),
+            static_cast<GLsizei>(std::distance(_timeStamps.begin(), it)),
             static_cast<GLsizei>(_vertexArray.size() - 1)
         );
     }
@@ -278,7 +407,8 @@ void RenderableTrailTrajectory::update(const UpdateData& data) {
     // If we are inside the valid time, we additionally want to draw a line from the last
     // correct point to the current location of the object
     if (data.time.j2000Seconds() >= _start &&
-        data.time.j2000Seconds() <= _end && !_renderFullTrail)
+        data.time.j2000Seconds() <= _end && !_renderFullTrail &&
+        _primaryRenderInformation.count > 0)
     {
         // Copy the last valid location
         glm::dvec3 v0(
@@ -354,4 +484,329 @@ void RenderableTrailTrajectory::update(const UpdateData& data) {
 
 }
 
+void RenderableTrailTrajectory::sampleUniformly(double interval) {
+    // How many values do we need to compute given the distance between the start and
+    // end date and the desired sample interval
+    const int nValues = static_cast<int>((_end - _start) / interval);
+
+    // Make space for the vertices
+    _vertexArray.clear();
+    _vertexArray.resize(nValues);
+    _timeStamps.clear();
+    _timeStamps.resize(nValues);
+
+    // ... fill all of the values
+    for (int i = 0; i < nValues; ++i) {
+        _timeStamps[i] = _start + i * interval;
+        const glm::vec3 p = _translation->position({
+            {},
+            Time(_timeStamps[i]),
+            Time(0.0),
+            false
+        });
+        _vertexArray[i] = { p.x, p.y, p.z };
+    }
+}
+
+void RenderableTrailTrajectory::sampleAdaptively(double minimumInterval) {
+    _vertexArray.clear();
+    _timeStamps.clear();
+    if (_end <= _start) {
+        return;
+    }
+
+    // The file name only contains the hash of the key, so the full key is stored in the
+    // file to detect collisions. The hash has to be stable between launches
+    const std::string key = cacheKey(minimumInterval);
+    const std::string cachedFile = FileSys.cacheManager()->cachedFilename(
+        "RenderableTrailTrajectory",
+        fmt::format("{:016x}", hashFNV1a(key)),
+        ghoul::filesystem::CacheManager::Persistent::Yes
+    );
+    if (FileSys.fileExists(cachedFile)) {
+        if (loadCachedTrail(cachedFile, key)) {
+            LDEBUG(fmt::format("Cached file '{}' used for trajectory", cachedFile));
+            return;
+        }
+        // Otherwise, the cache file is overwritten below
+        _vertexArray.clear();
+        _timeStamps.clear();
+    }
+
+    AdaptiveSettings settings;
+    settings.minimumInterval = minimumInterval;
+    settings.maximumAngle = _maximumAngle;
+    settings.maximumError = _maximumError;
+    settings.maximumVertices = _maximumVertices;
+
+    AdaptiveSamples samples = computeAdaptiveSamples(
+        [this](double t) -> glm::dvec3 {
+            return _translation->position({ {}, Time(t), Time(0.0), false });
+        },
+        _start,
+        _end,
+        settings
+    );
+
+    _timeStamps = std::move(samples.timeStamps);
+    _vertexArray.reserve(samples.positions.size());
+    for (const glm::dvec3& p : samples.positions) {
+        _vertexArray.push_back({
+            static_cast<float>(p.x),
+            static_cast<float>(p.y),
+            static_cast<float>(p.z)
+        });
+    }
+
+    LDEBUG(fmt::format(
+        "Sampled trajectory with {} vertices instead of {}",
+        _vertexArray.size(), static_cast<size_t>((_end - _start) / minimumInterval)
+    ));
+
+    saveCachedTrail(cachedFile, key);
+}
+
+RenderableTrailTrajectory::AdaptiveSamples
+RenderableTrailTrajectory::computeAdaptiveSamples(
+                                    const std::function<glm::dvec3(double)>& positionAt,
+                                                        double start, double end,
+                                                        const AdaptiveSettings& settings)
+{
+    AdaptiveSamples result;
+    if (end <= start || settings.minimumInterval <= 0.0) {
+        return result;
+    }
+
+    // Each segment contributes its start point and its midpoint, the last segment also
+    // contributes its end point
+    const size_t maxVertices = static_cast<size_t>(std::max(settings.maximumVertices, 3));
+    const size_t maxSegments = (maxVertices - 1) / 2;
+    const double duration = end - start;
+    const size_t nFinestSegments = std::max<size_t>(
+        static_cast<size_t>(duration / (2.0 * settings.minimumInterval)),
+        1
+    );
+    const size_t nInitial = std::min({
+        static_cast<size_t>(InitialAdaptiveSegments),
+        nFinestSegments,
+        maxSegments
+    });
+
+    std::vector<Segment> segments(nInitial);
+    glm::dvec3 minPos(std::numeric_limits<double>::max());
+    glm::dvec3 maxPos(-std::numeric_limits<double>::max());
+    glm::dvec3 p0 = positionAt(start);
+    for (size_t i = 0; i < nInitial; ++i) {
+        Segment& s = segments[i];
+        s.t0 = start + duration * i / nInitial;
+        s.t1 = (i == nInitial - 1) ? end : start + duration * (i + 1) / nInitial;
+        s.p0 = p0;
+        s.pm = positionAt((s.t0 + s.t1) / 2.0);
+        s.p1 = positionAt(s.t1);
+        p0 = s.p1;
+
+        minPos = glm::min(minPos, glm::min(s.p0, s.pm));
+        maxPos = glm::max(maxPos, glm::max(s.p0, s.pm));
+    }
+    minPos = glm::min(minPos, p0);
+    maxPos = glm::max(maxPos, p0);
+
+    // The deviation from the chord is measured relative to the extent of the trail,
+    // which approximates the screen-space error when the entire trail is in view
+    const double maxAngle = glm::radians(settings.maximumAngle);
+    const double extent = glm::distance(minPos, maxPos);
+    const double maxDeviation = settings.maximumError * extent / 2.0;
+    auto error = [maxAngle, maxDeviation](const Segment& s) {
+        const glm::dvec3 a = s.pm - s.p0;
+        const glm::dvec3 b = s.p1 - s.pm;
+        const double la = glm::length(a);
+        const double lb = glm::length(b);
+        if (la == 0.0 || lb == 0.0) {
+            return 0.0;
+        }
+        const double cosAngle = glm::clamp(glm::dot(a, b) / (la * lb), -1.0, 1.0);
+        const double angle = std::acos(cosAngle);
+
+        const glm::dvec3 chord = s.p1 - s.p0;
+        const double lc = glm::length(chord);
+        const double deviation = lc > 0.0 ? glm::length(glm::cross(a, chord)) / lc : la;
+
+        return std::max(
+            maxAngle > 0.0 ? angle / maxAngle : 0.0,
+            maxDeviation > 0.0 ? deviation / maxDeviation : 0.0
+        );
+    };
+
+    // Segments that cannot be subdivided any further are moved to the finished list,
+    // all others are refined in the order of their error. Splitting a segment places
+    // samples a quarter of its length apart, which must not be below the minimum interval
+    std::vector<Segment> finished;
+    std::priority_queue<Segment> queue;
+    auto enqueue = [&](Segment s) {
+        s.error = error(s);
+        if ((s.t1 - s.t0) / 4.0 < settings.minimumInterval || s.error <= 1.0) {
+            finished.push_back(s);
+        }
+        else {
+            queue.push(s);
+        }
+    };
+    for (const Segment& s : segments) {
+        enqueue(s);
+    }
+
+    size_t nSegments = nInitial;
+    while (!queue.empty() && nSegments < maxSegments) {
+        const Segment s = queue.top();
+        queue.pop();
+
+        const double tm = (s.t0 + s.t1) / 2.0;
+        Segment left = { s.t0, tm, s.p0, positionAt((s.t0 + tm) / 2.0), s.pm, 0.0 };
+        Segment right = { tm, s.t1, s.pm, positionAt((tm + s.t1) / 2.0), s.p1, 0.0 };
+        enqueue(left);
+        enqueue(right);
+        ++nSegments;
+    }
+    while (!queue.empty()) {
+        finished.push_back(queue.top());
+        queue.pop();
+    }
+
+    std::sort(
+        finished.begin(),
+        finished.end(),
+        [](const Segment& lhs, const Segment& rhs) { return lhs.t0 < rhs.t0; }
+    );
+
+    result.timeStamps.reserve(2 * finished.size() + 1);
+    result.positions.reserve(2 * finished.size() + 1);
+    for (const Segment& s : finished) {
+        result.timeStamps.push_back(s.t0);
+        result.positions.push_back(s.p0);
+        result.timeStamps.push_back((s.t0 + s.t1) / 2.0);
+        result.positions.push_back(s.pm);
+    }
+    result.timeStamps.push_back(finished.back().t1);
+    result.positions.push_back(finished.back().p1);
+    return result;
+}
+
+std::string RenderableTrailTrajectory::cacheKey(double minimumInterval) const {
+    std::string key = fmt::format(
+        "{}|{}|{}|{}|{}|{}|{}|",
+        typeid(*_translation).name(), _start, _end, minimumInterval,
+        static_cast<double>(_maximumAngle), static_cast<double>(_maximumError),
+        static_cast<int>(_maximumVertices)
+    );
+    for (const properties::Property* p : _translation->propertiesRecursive()) {
+        key += p->identifier() + '=' + p->getStringValue() + ';';
+
+        // Translations that read their data from a file (for example Horizons) only
+        // expose the file's path, so a change to the file has to be detected separately
+        using SP = properties::StringProperty;
+        const SP* sp = dynamic_cast<const SP*>(p);
+        if (sp) {
+            std::error_code ec;
+            if (std::filesystem::is_regular_file(sp->value(), ec)) {
+                key += fileDescription(sp->value());
+            }
+        }
+    }
+    // The result depends on the loaded kernels if the translation is based on SPICE
+    key += kernelDescription();
+    return key;
+}
+
+bool RenderableTrailTrajectory::loadCachedTrail(const std::string& file,
+                                                const std::string& key)
+{
+    std::ifstream fileStream(file, std::ifstream::binary);
+    if (!fileStream.good()) {
+        LERROR(fmt::format("Error opening file '{}' for loading cache file", file));
+        return false;
+    }
+    fileStream.seekg(0, std::ifstream::end);
+    const uint64_t fileSize = static_cast<uint64_t>(fileStream.tellg());
+    fileStream.seekg(0, std::ifstream::beg);
+    auto remainingBytes = [&fileStream, fileSize]() -> uint64_t {
+        return fileSize - static_cast<uint64_t>(fileStream.tellg());
+    };
+
+    int8_t version = 0;
+    fileStream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+    if (!fileStream.good() || version != CurrentCacheVersion) {
+        LINFO("The format of the cached file has changed: deleting old cache");
+        fileStream.close();
+        FileSys.deleteFile(file);
+        return false;
+    }
+
+    uint64_t keySize = 0;
+    fileStream.read(reinterpret_cast<char*>(&keySize), sizeof(uint64_t));
+    if (!fileStream.good() || keySize != key.size() || keySize > remainingBytes()) {
+        return false;
+    }
+    std::string storedKey(keySize, '\0');
+    fileStream.read(storedKey.data(), keySize);
+    if (!fileStream.good() || storedKey != key) {
+        // A different trajectory whose key has the same hash
+        return false;
+    }
+
+    uint64_t nVertices = 0;
+    fileStream.read(reinterpret_cast<char*>(&nVertices), sizeof(uint64_t));
+    // Checking the size before resizing prevents a truncated or corrupted file from
+    // causing a huge allocation
+    constexpr const uint64_t VertexSize = sizeof(double) + sizeof(TrailVBOLayout);
+    if (!fileStream.good() || nVertices != remainingBytes() / VertexSize ||
+        remainingBytes() % VertexSize != 0)
+    {
+        LWARNING(fmt::format("Cached file '{}' is truncated or corrupted", file));
+        return false;
+    }
+
+    _timeStamps.resize(nVertices);
+    _vertexArray.resize(nVertices);
+    fileStream.read(
+        reinterpret_cast<char*>(_timeStamps.data()),
+        nVertices * sizeof(double)
+    );
+    fileStream.read(
+        reinterpret_cast<char*>(_vertexArray.data()),
+        nVertices * sizeof(TrailVBOLayout)
+    );
+
+    return fileStream.good();
+}
+
+bool RenderableTrailTrajectory::saveCachedTrail(const std::string& file,
+                                                const std::string& key) const
+{
+    std::ofstream fileStream(file, std::ofstream::binary);
+    if (!fileStream.good()) {
+        LERROR(fmt::format("Error opening file '{}' for save cache file", file));
+        return false;
+    }
+
+    fileStream.write(
+        reinterpret_cast<const char*>(&CurrentCacheVersion),
+        sizeof(int8_t)
+    );
+    const uint64_t keySize = key.size();
+    fileStream.write(reinterpret_cast<const char*>(&keySize), sizeof(uint64_t));
+    fileStream.write(key.data(), keySize);
+    const uint64_t nVertices = _timeStamps.size();
+    fileStream.write(reinterpret_cast<const char*>(&nVertices), sizeof(uint64_t));
+    fileStream.write(
+        reinterpret_cast<const char*>(_timeStamps.data()),
+        nVertices * sizeof(double)
+    );
+    fileStream.write(
+        reinterpret_cast<const char*>(_vertexArray.data()),
+        nVertices * sizeof(TrailVBOLayout)
+    );
+
+    return fileStream.good();
+}
+
 } // namespace openspace
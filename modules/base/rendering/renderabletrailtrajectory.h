@@ -32,6 +32,8 @@
 #include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
 #include <array>
+#include <functional>
+#include <vector>
 
 namespace openspace {
 
@@ -47,6 +49,14 @@ namespace documentation { struct Documentation; }
  * trail in the future. If _renderFullTrail is false, the current position of the object
  * has to be updated constantly to make the trail connect to the object that has the
  * trail.
+ *
+ * If _adaptiveSampling is enabled, _sampleInterval is instead treated as the finest
+ * allowed spacing between samples. The trail is first sampled coarsely and segments are
+ * then subdivided, worst first, until the angular deviation at each segment's midpoint
+ * is below _maximumAngle and the midpoint's deviation from the chord is below
+ * _maximumError times the extent of the trail (an estimate of the screen-space error if
+ * the whole trail is in view), or until _maximumVertices is reached. As the adaptive
+ * sampling can be expensive, its result is cached on disk.
  */
 class RenderableTrailTrajectory : public RenderableTrail {
 public:
@@ -59,7 +69,54 @@ public:
 
     static documentation::Documentation Documentation();
 
+    /// The parameters that control the adaptive sampling of a trajectory
+    struct AdaptiveSettings {
+        /// The smallest allowed time (in seconds) between two samples
+        double minimumInterval = 0.0;
+        /// The largest allowed angle (in degrees) between consecutive segments
+        double maximumAngle = 0.0;
+        /// The largest allowed deviation from the chord relative to the trail's extent
+        double maximumError = 0.0;
+        /// The maximum number of samples that are created
+        int maximumVertices = 0;
+    };
+
+    /// The time stamps and positions that result from an adaptive sampling
+    struct AdaptiveSamples {
+        std::vector<double> timeStamps;
+        std::vector<glm::dvec3> positions;
+    };
+
+    /**
+     * Samples the trajectory described by \p positionAt between \p start and \p end
+     * adaptively. The trajectory is subdivided where it curves until the \p settings'
+     * angle and error criteria are met or the maximum number of vertices is reached. A
+     * segment is only subdivided if the resulting samples are at least
+     * AdaptiveSettings::minimumInterval apart, so no two samples are ever closer than
+     * that in time.
+     */
+    static AdaptiveSamples computeAdaptiveSamples(
+                                      const std::function<glm::dvec3(double)>& positionAt,
+                                                                 double start, double end,
+                                                        const AdaptiveSettings& settings);
+
 private:
+    /// Samples the trajectory between _start and _end with a fixed interval
+    void sampleUniformly(double interval);
+
+    /**
+     * Samples the trajectory between _start and _end adaptively, never placing two
+     * samples closer than \p minimumInterval in time. The result is cached on disk.
+     */
+    void sampleAdaptively(double minimumInterval);
+
+    /// Returns a string that uniquely identifies the result of the adaptive sampling
+    std::string cacheKey(double minimumInterval) const;
+
+    /// Loads the trail from the cache \p file if it was stored with the same \p key
+    bool loadCachedTrail(const std::string& file, const std::string& key);
+    bool saveCachedTrail(const std::string& file, const std::string& key) const;
+
     /// The start time of the trail
     properties::StringProperty _startTime;
     /// The end time of the trail
@@ -71,6 +128,14 @@ private:
     properties::IntProperty _timeStampSubsamplingFactor;
     /// Determines whether the full trail should be rendered or the future trail removed
     properties::BoolProperty _renderFullTrail;
+    /// Determines whether the trail is sampled adaptively or with a fixed interval
+    properties::BoolProperty _adaptiveSampling;
+    /// The largest allowed angle (in degrees) between consecutive adaptive segments
+    properties::DoubleProperty _maximumAngle;
+    /// The largest allowed deviation from the trajectory relative to the trail's extent
+    properties::DoubleProperty _maximumError;
+    /// The maximum number of vertices that the adaptive sampling is allowed to create
+    properties::IntProperty _maximumVertices;
 
     /// Dirty flag that determines whether the full vertex buffer needs to be resampled
     bool _needsFullSweep = true;
@@ -80,6 +145,9 @@ private:
 
     std::array<TrailVBOLayout, 2> _auxiliaryVboData = {};
 
+    /// The time (in J2000 seconds) of each of the vertices in the _vertexArray
+    std::vector<double> _timeStamps;
+
     /// The conversion of the _startTime into the internal time format
     double _start = 0.0;
     /// The conversion of the _endTime into the internal time format
@@ -30,27 +30,38 @@
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
-#include <ghoul/lua/ghoul_lua.h>
-#include <ghoul/lua/lua_helper.h>
+#include <ghoul/misc/exception.h>
 #include <chrono>
 
 namespace {
+    constexpr const char* _loggerCat = "LuaRotation";
+
     constexpr openspace::properties::Property::PropertyInfo ScriptInfo = {
         "Script",
         "Script",
         "This value is the path to the Lua script that will be executed to compute the "
         "rotation for this transformation. The script needs to define a function "
         "'rotation' that takes the current simulation time in seconds past the J2000 "
-        "epoch as the first argument, the current wall time as milliseconds past the "
-        "J2000 epoch as the second argument and computes the rotation returned as 9 "
-        "values."
+        "epoch as the first argument, the simulation time of the previous frame in "
+        "seconds past the J2000 epoch as the second argument, the current wall-clock "
+        "time in milliseconds as the third argument, and returns the nine values of "
+        "the rotation matrix in column-major order."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CompileScriptInfo = {
+        "CompileScript",
+        "Compile Script",
+        "If this value is enabled and the function in the script only does arithmetic "
+        "on its arguments, local variables, and the functions of the 'math' library, "
+        "the function is compiled and evaluated without Lua, which is much faster. "
+        "Scripts that do anything else are always executed with Lua."
     };
 } // namespace
 
 namespace openspace {
 
 documentation::Documentation LuaRotation::Documentation() {
-    using namespace openspace::documentation;
+    using namespace documentation;
     return {
         "Lua Rotation",
         "base_transform_rotation_lua",
@@ -65,6 +76,12 @@ documentation::Documentation LuaRotation::Documentation() {
                 new StringVerifier,
                 Optional::No,
                 ScriptInfo.description
+            },
+            {
+                CompileScriptInfo.identifier,
+                new BoolVerifier,
+                Optional::Yes,
+                CompileScriptInfo.description
             }
         }
     };
@@ -72,69 +89,67 @@ documentation::Documentation LuaRotation::Documentation() {
 
 LuaRotation::LuaRotation()
     : _luaScriptFile(ScriptInfo)
-    , _state(ghoul::lua::LuaState::IncludeStandardLibrary::No)
+    , _compileScript(CompileScriptInfo, true)
+    , _function("rotation", 3, 9)
 {
     addProperty(_luaScriptFile);
+    addProperty(_compileScript);
 
     _luaScriptFile.onChange([&]() {
-        requireUpdate();
+        loadScript();
         _fileHandle = std::make_unique<ghoul::filesystem::File>(_luaScriptFile);
         _fileHandle->setCallback([&](const ghoul::filesystem::File&) {
-            requireUpdate();
+            loadScript();
+            notifyObservers();
         });
     });
+    _compileScript.onChange([&]() { loadScript(); });
 }
 
 LuaRotation::LuaRotation(const ghoul::Dictionary& dictionary) : LuaRotation() {
-    documentation::testSpecificationAndThrow(
-        Documentation(),
-        dictionary,
-        "LuaRotation"
-    );
+    documentation::testSpecificationAndThrow(Documentation(), dictionary, "LuaRotation");
 
+    if (dictionary.hasKey(CompileScriptInfo.identifier)) {
+        _compileScript = dictionary.value<bool>(CompileScriptInfo.identifier);
+    }
     _luaScriptFile = absPath(dictionary.value<std::string>(ScriptInfo.identifier));
 }
 
-glm::dmat3 LuaRotation::matrix(const UpdateData& data) const {
-    ghoul::lua::runScriptFile(_state, _luaScriptFile);
-
-    // Get the scaling function
-    lua_getglobal(_state, "rotation");
-    const bool isFunction = lua_isfunction(_state, -1);
-    if (!isFunction) {
-        LERRORC(
-            "LuaRotation",
-            fmt::format("Script '{}' does nto have a function 'rotation'", _luaScriptFile)
-        );
-        return glm::dmat3(1.0);
+void LuaRotation::loadScript() {
+    requireUpdate();
+    if (_luaScriptFile.value().empty()) {
+        return;
     }
 
-    // First argument is the number of seconds past the J2000 epoch in ingame time
-    ghoul::lua::push(_state, data.time.j2000Seconds());
-
-    // Second argument is the number of seconds past the J2000 epoch of the last frame
-    ghoul::lua::push(_state, data.previousFrameTime.j2000Seconds());
-
-    // Third argument is the number of milliseconds past the J2000 epoch in wallclock
-    using namespace std::chrono;
-    auto now = high_resolution_clock::now();
-    ghoul::lua::push(_state, duration_cast<milliseconds>(now.time_since_epoch()).count());
-
-    // Execute the scaling function
-    int success = lua_pcall(_state, 2, 9, 0);
-    if (success != 0) {
-        LERRORC(
-            "LuaScale",
-            fmt::format("Error executing 'rotation': {}", lua_tostring(_state, -1))
+    try {
+        _function.load(
+            _luaScriptFile,
+            LuaFunction::AllowCompilation(_compileScript.value())
         );
     }
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(e.message);
+    }
+}
+
+glm::dmat3 LuaRotation::matrix(const UpdateData& data) const {
+    using namespace std::chrono;
+    const auto now = high_resolution_clock::now();
+    const double arguments[3] = {
+        data.time.j2000Seconds(),
+        data.previousFrameTime.j2000Seconds(),
+        static_cast<double>(duration_cast<milliseconds>(now.time_since_epoch()).count())
+    };
 
     double values[9];
-    for (int i = 0; i < 9; ++i) {
-        values[i] = luaL_checknumber(_state, -1 - i);
+    if (!_function.evaluate(arguments, values)) {
+        return glm::dmat3(1.0);
     }
-
     return glm::make_mat3(values);
 }
 
+bool LuaRotation::isThreadSafe() const {
+    return true;
+}
+
 } // namespace openspace
@@ -30,27 +30,37 @@
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
-#include <ghoul/lua/ghoul_lua.h>
-#include <ghoul/lua/lua_helper.h>
-
+#include <ghoul/misc/exception.h>
 #include <chrono>
 
 namespace {
+    constexpr const char* _loggerCat = "LuaScale";
+
     constexpr openspace::properties::Property::PropertyInfo ScriptInfo = {
         "Script",
         "Script",
         "This value is the path to the Lua script that will be executed to compute the "
         "scaling factor for this transformation. The script needs to define a function "
-        "'scale' that takes the current simulation time in seconds past the J2000 epoch "
-        "as the first argument, the current wall time as milliseconds past the J2000 "
-        "epoch the second argument and computes the scaling factor."
+        "'scale' that takes the current simulation time in seconds past the J2000 "
+        "epoch as the first argument, the simulation time of the previous frame in "
+        "seconds past the J2000 epoch as the second argument, the current wall-clock "
+        "time in milliseconds as the third argument, and returns the scaling factor."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CompileScriptInfo = {
+        "CompileScript",
+        "Compile Script",
+        "If this value is enabled and the function in the script only does arithmetic "
+        "on its arguments, local variables, and the functions of the 'math' library, "
+        "the function is compiled and evaluated without Lua, which is much faster. "
+        "Scripts that do anything else are always executed with Lua."
     };
 } // namespace
 
 namespace openspace {
 
 documentation::Documentation LuaScale::Documentation() {
-    using namespace openspace::documentation;
+    using namespace documentation;
     return {
         "Lua Scaling",
         "base_scale_lua",
@@ -60,6 +70,12 @@ documentation::Documentation LuaScale::Documentation() {
                 new StringVerifier,
                 Optional::No,
                 ScriptInfo.description
+            },
+            {
+                CompileScriptInfo.identifier,
+                new BoolVerifier,
+                Optional::Yes,
+                CompileScriptInfo.description
             }
         }
     };
@@ -67,60 +83,67 @@ documentation::Documentation LuaScale::Documentation() {
 
 LuaScale::LuaScale()
     : _luaScriptFile(ScriptInfo)
-    , _state(ghoul::lua::LuaState::IncludeStandardLibrary::No)
+    , _compileScript(CompileScriptInfo, true)
+    , _function("scale", 3, 1)
 {
     addProperty(_luaScriptFile);
+    addProperty(_compileScript);
 
     _luaScriptFile.onChange([&]() {
-        requireUpdate();
+        loadScript();
         _fileHandle = std::make_unique<ghoul::filesystem::File>(_luaScriptFile);
         _fileHandle->setCallback([&](const ghoul::filesystem::File&) {
-            requireUpdate();
+            loadScript();
+            notifyObservers();
         });
     });
+    _compileScript.onChange([&]() { loadScript(); });
 }
 
 LuaScale::LuaScale(const ghoul::Dictionary& dictionary) : LuaScale() {
     documentation::testSpecificationAndThrow(Documentation(), dictionary, "LuaScale");
 
+    if (dictionary.hasKey(CompileScriptInfo.identifier)) {
+        _compileScript = dictionary.value<bool>(CompileScriptInfo.identifier);
+    }
     _luaScriptFile = absPath(dictionary.value<std::string>(ScriptInfo.identifier));
 }
 
-double LuaScale::scaleValue(const UpdateData& data) const {
-    ghoul::lua::runScriptFile(_state, _luaScriptFile);
-
-    // Get the scaling function
-    lua_getglobal(_state, "scale");
-    const bool isFunction = lua_isfunction(_state, -1);
-    if (!isFunction) {
-        LERRORC(
-            "LuaScale",
-            fmt::format("Script '{}' does not have a function 'scale'", _luaScriptFile)
-        );
-        return 0.0;
+void LuaScale::loadScript() {
+    requireUpdate();
+    if (_luaScriptFile.value().empty()) {
+        return;
     }
 
-    // First argument is the number of seconds past the J2000 epoch in ingame time
-    ghoul::lua::push(_state, data.time.j2000Seconds());
-
-    // Second argument is the number of seconds past the J2000 epoch of last frame
-    ghoul::lua::push(_state, data.previousFrameTime.j2000Seconds());
+    try {
+        _function.load(
+            _luaScriptFile,
+            LuaFunction::AllowCompilation(_compileScript.value())
+        );
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(e.message);
+    }
+}
 
-    // Second argument is the number of milliseconds past the J2000 epoch in wallclock
+double LuaScale::scaleValue(const UpdateData& data) const {
     using namespace std::chrono;
-    const auto now = std::chrono::high_resolution_clock::now();
-    ghoul::lua::push(_state, duration_cast<milliseconds>(now.time_since_epoch()).count());
-
-    // Execute the scaling function
-    const int success = lua_pcall(_state, 2, 1, 0);
-    if (success != 0) {
-        LERRORC(
-            "LuaScale",
-            fmt::format("Error executing 'scale': {}", lua_tostring(_state, -1))
-        );
+    const auto now = high_resolution_clock::now();
+    const double arguments[3] = {
+        data.time.j2000Seconds(),
+        data.previousFrameTime.j2000Seconds(),
+        static_cast<double>(duration_cast<milliseconds>(now.time_since_epoch()).count())
+    };
+
+    double value = 0.0;
+    if (!_function.evaluate(arguments, &value)) {
+        return 0.0;
     }
+    return value;
+}
 
-    return luaL_checknumber(_state, -1);
+bool LuaScale::isThreadSafe() const {
+    return true;
 }
 
 } // namespace openspace
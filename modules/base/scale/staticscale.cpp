@@ -72,4 +72,8 @@ StaticScale::StaticScale(const ghoul::Dictionary& dictionary) : StaticScale() {
     _scaleValue = static_cast<float>(dictionary.value<double>(ScaleInfo.identifier));
 }
 
+bool StaticScale::isThreadSafe() const {
+    return true;
+}
+
 } // namespace openspace
@@ -125,4 +125,8 @@ double TimeDependentScale::scaleValue(const UpdateData& data) const {
     }
 }
 
+bool TimeDependentScale::isThreadSafe() const {
+    return true;
+}
+
 } // namespace openspace
@@ -27,24 +27,34 @@
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/util/updatestructures.h>
-#include <ghoul/fmt.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
-#include <ghoul/lua/ghoul_lua.h>
-#include <ghoul/lua/lua_helper.h>
-
+#include <ghoul/misc/exception.h>
 #include <chrono>
 
 namespace {
+    constexpr const char* _loggerCat = "LuaTranslation";
+
     constexpr openspace::properties::Property::PropertyInfo ScriptInfo = {
         "Script",
         "Script",
         "This value is the path to the Lua script that will be executed to compute the "
         "translation for this transformation. The script needs to define a function "
-        "'translate' that takes the current simulation time in seconds past the J2000 "
-        "epoch as the first argument, the current wall time as milliseconds past the "
-        "J2000 epoch as the second argument and computes the translation."
+        "'translation' that takes the current simulation time in seconds past the J2000 "
+        "epoch as the first argument, the simulation time of the previous frame in "
+        "seconds past the J2000 epoch as the second argument, the current wall-clock "
+        "time in milliseconds as the third argument, and returns the three components "
+        "of the translation."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CompileScriptInfo = {
+        "CompileScript",
+        "Compile Script",
+        "If this value is enabled and the function in the script only does arithmetic "
+        "on its arguments, local variables, and the functions of the 'math' library, "
+        "the function is compiled and evaluated without Lua, which is much faster. "
+        "Scripts that do anything else are always executed with Lua."
     };
 } // namespace
 
@@ -66,80 +76,83 @@ documentation::Documentation LuaTranslation::Documentation() {
                 new StringVerifier,
                 Optional::No,
                 ScriptInfo.description
+            },
+            {
+                CompileScriptInfo.identifier,
+                new BoolVerifier,
+                Optional::Yes,
+                CompileScriptInfo.description
             }
         }
     };
 }
 
-
 LuaTranslation::LuaTranslation()
     : _luaScriptFile(ScriptInfo)
-    , _state(ghoul::lua::LuaState::IncludeStandardLibrary::No)
+    , _compileScript(CompileScriptInfo, true)
+    , _function("translation", 3, 3)
 {
     addProperty(_luaScriptFile);
+    addProperty(_compileScript);
 
     _luaScriptFile.onChange([&]() {
-        requireUpdate();
+        loadScript();
         _fileHandle = std::make_unique<ghoul::filesystem::File>(_luaScriptFile);
         _fileHandle->setCallback([&](const ghoul::filesystem::File&) {
-             requireUpdate();
-             notifyObservers();
-         });
+            loadScript();
+            notifyObservers();
+        });
     });
+    _compileScript.onChange([&]() { loadScript(); });
 }
 
 LuaTranslation::LuaTranslation(const ghoul::Dictionary& dictionary) : LuaTranslation() {
     documentation::testSpecificationAndThrow(
         Documentation(),
         dictionary,
-        "StaticTranslation"
+        "LuaTranslation"
     );
 
+    if (dictionary.hasKey(CompileScriptInfo.identifier)) {
+        _compileScript = dictionary.value<bool>(CompileScriptInfo.identifier);
+    }
     _luaScriptFile = absPath(dictionary.value<std::string>(ScriptInfo.identifier));
 }
 
-glm::dvec3 LuaTranslation::position(const UpdateData& data) const {
-    ghoul::lua::runScriptFile(_state, _luaScriptFile);
-
-    // Get the scaling function
-    lua_getglobal(_state, "translation");
-    const bool isFunction = lua_isfunction(_state, -1);
-    if (!isFunction) {
-        LERRORC(
-            "LuaScale",
-            fmt::format(
-                "Script '{}' does not have a function 'translation'",
-                _luaScriptFile
-            )
-        );
-        return glm::dvec3(0.0);
+void LuaTranslation::loadScript() {
+    requireUpdate();
+    if (_luaScriptFile.value().empty()) {
+        return;
     }
 
-    // First argument is the number of seconds past the J2000 epoch in ingame time
-    ghoul::lua::push(_state, data.time.j2000Seconds());
+    try {
+        _function.load(
+            _luaScriptFile,
+            LuaFunction::AllowCompilation(_compileScript.value())
+        );
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(e.message);
+    }
+}
 
-    // Second argument is the number of seconds past the J2000 epoch of the last frame
-    ghoul::lua::push(_state, data.previousFrameTime.j2000Seconds());
+bool LuaTranslation::isThreadSafe() const {
+    return true;
+}
 
-    // Third argument is the number of milliseconds past the J2000 epoch in wallclock
+glm::dvec3 LuaTranslation::position(const UpdateData& data) const {
     using namespace std::chrono;
     const auto now = high_resolution_clock::now();
-    ghoul::lua::push(_state, duration_cast<milliseconds>(now.time_since_epoch()).count());
-
-    // Execute the scaling function
-    const int success = lua_pcall(_state, 2, 3, 0);
-    if (success != 0) {
-        LERRORC(
-            "LuaScale",
-            fmt::format("Error executing 'translation': {}", lua_tostring(_state, -1))
-        );
-    }
+    const double arguments[3] = {
+        data.time.j2000Seconds(),
+        data.previousFrameTime.j2000Seconds(),
+        static_cast<double>(duration_cast<milliseconds>(now.time_since_epoch()).count())
+    };
 
     double values[3];
-    for (int i = 1; i <= 3; ++i) {
-        values[i] = ghoul::lua::value<double>(_state, i);
+    if (!_function.evaluate(arguments, values)) {
+        return glm::dvec3(0.0);
     }
-
     return glm::make_vec3(values);
 }
 
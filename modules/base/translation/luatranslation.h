@@ -27,8 +27,9 @@
 
 #include <openspace/scene/translation.h>
 
+#include <modules/base/luafunction.h>
 #include <openspace/properties/stringproperty.h>
-#include <ghoul/lua/luastate.h>
+#include <openspace/properties/scalar/boolproperty.h>
 #include <memory>
 
 namespace ghoul::filesystem { class File; }
@@ -43,13 +44,17 @@ public:
     LuaTranslation(const ghoul::Dictionary& dictionary);
 
     glm::dvec3 position(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
 
     static documentation::Documentation Documentation();
 
 private:
+    void loadScript();
+
     properties::StringProperty _luaScriptFile;
+    properties::BoolProperty _compileScript;
     std::unique_ptr<ghoul::filesystem::File> _fileHandle;
-    ghoul::lua::LuaState _state;
+    LuaFunction _function;
 };
 
 } // namespace openspace
@@ -71,9 +71,14 @@ StaticTranslation::StaticTranslation()
     addProperty(_position);
 
     _position.onChange([this]() {
+        std::atomic_store(
+            &_publishedPosition,
+            std::make_shared<const glm::dvec3>(_position.value())
+        );
         requireUpdate();
         notifyObservers();
     });
+    _publishedPosition = std::make_shared<const glm::dvec3>(_position.value());
 }
 
 StaticTranslation::StaticTranslation(const ghoul::Dictionary& dictionary)
@@ -89,7 +94,11 @@ StaticTranslation::StaticTranslation(const ghoul::Dictionary& dictionary)
 }
 
 glm::dvec3 StaticTranslation::position(const UpdateData&) const {
-    return _position;
+    return *std::atomic_load(&_publishedPosition);
+}
+
+bool StaticTranslation::isThreadSafe() const {
+    return true;
 }
 
 } // namespace openspace
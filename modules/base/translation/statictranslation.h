@@ -28,6 +28,7 @@
 #include <openspace/scene/translation.h>
 
 #include <openspace/properties/vector/dvec3property.h>
+#include <memory>
 
 namespace openspace {
 
@@ -41,10 +42,15 @@ public:
     StaticTranslation(const ghoul::Dictionary& dictionary);
 
     glm::dvec3 position(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
     static documentation::Documentation Documentation();
 
 private:
     properties::DVec3Property _position;
+
+    /// A copy of the _position that is replaced as a whole through atomic operations
+    /// whenever the property changes, so that the position can be read on other threads
+    std::shared_ptr<const glm::dvec3> _publishedPosition;
 };
 
 } // namespace openspace
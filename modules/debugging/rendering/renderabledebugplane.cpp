@@ -33,6 +33,7 @@
 #include <openspace/rendering/renderengine.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
+#include <ghoul/glm.h>
 #include <ghoul/io/texture/texturereader.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/texture.h>
@@ -181,6 +182,11 @@ bool RenderableDebugPlane::isReady() const {
     return ready;
 }
 
+float RenderableDebugPlane::cullingSphere() const {
+    // The corners of the quad are further away from the center than its size
+    return _size * glm::root_two<float>();
+}
+
 void RenderableDebugPlane::initializeGL() {
     glGenVertexArrays(1, &_quad); // generate array
     glGenBuffers(1, &_vertexPositionBuffer); // generate buffer
@@ -46,37 +46,37 @@ OctreeCuller::OctreeCuller(globebrowsing::AABB3 viewFrustum)
     : _viewFrustum(std::move(viewFrustum))
 {}
 
-bool OctreeCuller::isVisible(const std::vector<glm::dvec4>& corners,
-                             const glm::dmat4& mvp)
+bool OctreeCuller::isVisible(const std::array<glm::dvec4, 8>& corners,
+                             const glm::dmat4& mvp) const
 {
-    createNodeBounds(corners, mvp);
-    return intersects(_viewFrustum, _nodeBounds);
+    return intersects(_viewFrustum, createNodeBounds(corners, mvp));
 }
 
-glm::vec2 OctreeCuller::getNodeSizeInPixels(const std::vector<glm::dvec4>& corners,
+glm::vec2 OctreeCuller::getNodeSizeInPixels(const std::array<glm::dvec4, 8>& corners,
                                             const glm::dmat4& mvp,
-                                            const glm::vec2& screenSize)
+                                            const glm::vec2& screenSize) const
 {
-
-    createNodeBounds(corners, mvp);
+    const globebrowsing::AABB3 nodeBounds = createNodeBounds(corners, mvp);
 
     // Screen space is mapped to [-1, 1] so divide by 2 and multiply with screen size.
-    glm::vec3 size = (_nodeBounds.max - _nodeBounds.min) / 2.f;
+    glm::vec3 size = (nodeBounds.max - nodeBounds.min) / 2.f;
     size = glm::abs(size);
     return glm::vec2(size.x * screenSize.x, size.y * screenSize.y);
 }
 
-void OctreeCuller::createNodeBounds(const std::vector<glm::dvec4>& corners,
-                                    const glm::dmat4& mvp)
+globebrowsing::AABB3 OctreeCuller::createNodeBounds(
+                                                const std::array<glm::dvec4, 8>& corners,
+                                                         const glm::dmat4& mvp) const
 {
     // Create a bounding box in clipping space from node boundaries.
-    _nodeBounds = globebrowsing::AABB3();
+    globebrowsing::AABB3 nodeBounds;
 
     for (size_t i = 0; i < 8; ++i) {
         glm::dvec4 cornerClippingSpace = mvp * corners[i];
         glm::dvec4 ndc = (1.f / glm::abs(cornerClippingSpace.w)) * cornerClippingSpace;
-        expand(_nodeBounds, glm::dvec3(ndc));
+        expand(nodeBounds, glm::dvec3(ndc));
     }
+    return nodeBounds;
 }
 
 } // namespace openspace
@@ -26,7 +26,7 @@
 #define __OPENSPACE_MODULE_GAIA___OCTREECULLER___H__
 
 #include <modules/globebrowsing/src/basictypes.h>
-#include <vector>
+#include <array>
 
 // TODO: Move /geometry/* to libOpenSpace so as not to depend on globebrowsing.
 
@@ -36,7 +36,8 @@ namespace openspace {
  * Culls all octree nodes that are completely outside the view frustum.
  *
  * The frustum culling uses a 2D axis aligned bounding box for the OctreeNode in
- * screen space.
+ * screen space. The culler doesn't keep any state between calls, so it can be used from
+ * multiple threads at the same time.
  */
 
 class OctreeCuller {
@@ -53,22 +54,23 @@ public:
     /**
      * \return true if any part of the node is visible in the current view.
      */
-    bool isVisible(const std::vector<glm::dvec4>& corners, const glm::dmat4& mvp);
+    bool isVisible(const std::array<glm::dvec4, 8>& corners,
+        const glm::dmat4& mvp) const;
 
     /**
      * \return the size [in pixels] of the node in clipping space.
      */
-    glm::vec2 getNodeSizeInPixels(const std::vector<glm::dvec4>& corners,
-        const glm::dmat4& mvp, const glm::vec2& screenSize);
+    glm::vec2 getNodeSizeInPixels(const std::array<glm::dvec4, 8>& corners,
+        const glm::dmat4& mvp, const glm::vec2& screenSize) const;
 
 private:
     /**
-     * Creates an axis-aligned bounding box containing all \p corners in clipping space.
+     * \return an axis-aligned bounding box containing all \p corners in clipping space.
      */
-    void createNodeBounds(const std::vector<glm::dvec4>& corners, const glm::dmat4& mvp);
+    globebrowsing::AABB3 createNodeBounds(const std::array<glm::dvec4, 8>& corners,
+        const glm::dmat4& mvp) const;
 
     const globebrowsing::AABB3 _viewFrustum;
-    globebrowsing::AABB3 _nodeBounds;
 };
 
 } // namespace openspace
@@ -26,18 +26,42 @@
 
 #include <modules/gaia/rendering/octreeculler.h>
 #include <openspace/util/distanceconstants.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/fmt.h>
 #include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <future>
+#include <limits>
 #include <thread>
 
 namespace {
     constexpr const char* _loggerCat = "OctreeManager";
+
+    void sortByBufferIndex(
+                     std::vector<openspace::OctreeManager::StagingArena::Chunk>& chunks)
+    {
+        using Chunk = openspace::OctreeManager::StagingArena::Chunk;
+        std::sort(
+            chunks.begin(),
+            chunks.end(),
+            [](const Chunk& a, const Chunk& b) { return a.bufferIndex < b.bufferIndex; }
+        );
+    }
 } // namespace
 
 namespace openspace {
 
+const float* OctreeManager::StagingArena::chunkData(const Chunk& chunk) const {
+    return data.data() + chunk.offset;
+}
+
+OctreeManager::OctreeManager() = default;
+
+OctreeManager::~OctreeManager() = default;
+
 void OctreeManager::initOctree(long long cpuRamBudget, int maxDist, int maxStarsPerNode) {
     if (_root) {
         LDEBUG("Clear existing Octree");
@@ -53,8 +77,28 @@ void OctreeManager::initOctree(long long cpuRamBudget, int maxDist, int maxStars
     box.min = glm::vec3(-1.f, -1.f, 0.f);
     box.max = glm::vec3(1.f, 1.f, 100.f);
     _culler = std::make_unique<OctreeCuller>(box);
+
+    // The render thread checks one of the branches itself.
+    if (!_traversalPool) {
+        const unsigned int nThreads = std::thread::hardware_concurrency();
+        if (nThreads > 1) {
+            _traversalPool = std::make_unique<ThreadPool>(std::min(nThreads - 1, 7u));
+        }
+    }
     _removedKeysInPrevCall = std::set<int>();
-    _leastRecentlyFetchedNodes = std::queue<unsigned long long>();
+    _stagingArena.data.clear();
+    _stagingArena.dirtyChunks.clear();
+    _chunkStagedInCall.clear();
+    _chunkSlot.clear();
+    {
+        std::lock_guard g(_evictionMutex);
+        _evictionOrder.clear();
+        _evictionEntries.clear();
+        _evictedNodes.clear();
+    }
+    _traversalFrame = 0;
+    _nEvictedNodes = 0;
+    _nRefetchedNodes = 0;
 
     // Reset default values when rebuilding the Octree during runtime.
     _numInnerNodes = 0;
@@ -85,6 +129,7 @@ void OctreeManager::initOctree(long long cpuRamBudget, int maxDist, int maxStars
         _root->Children[i]->bufferIndex = DEFAULT_INDEX;
         _root->Children[i]->octreePositionIndex = 80 + i;
         _root->Children[i]->numStars = 0;
+        _root->Children[i]->brightestMagnitude = std::numeric_limits<float>::max();
         _root->Children[i]->halfDimension = MAX_DIST / 2.f;
         _root->Children[i]->originX = (i % 2 == 0) ?
             _root->Children[i]->halfDimension :
@@ -107,6 +152,8 @@ void OctreeManager::initBufferIndexStack(long long maxNodes, bool useVBO,
     _rebuildBuffer = true;
     _useVBO = useVBO;
     _datasetFitInMemory = datasetFitInMemory;
+    _chunkStagedInCall.assign(static_cast<size_t>(maxNodes), 0);
+    _chunkSlot.assign(static_cast<size_t>(maxNodes), 0);
 
     // Build stack back-to-front.
     for (long long idx = maxNodes - 1; idx >= 0; --idx) {
@@ -150,6 +197,11 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
                                           size_t chunkSizeInBytes,
                                           const glm::ivec2& additionalNodes)
 {
+    // Keep track of the camera so that node eviction can be scored by distance.
+    {
+        std::lock_guard g(_evictionMutex);
+        _cameraPosition = cameraPos / (1000.0 * distanceconstants::Parsec);
+    }
 
     // If entire dataset fits in RAM then load the entire dataset asynchronously now.
     // Nodes will be rendered when they've been made available.
@@ -277,15 +329,16 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
     // Check if we should remove any nodes from RAM.
     long long tenthOfRamBudget = _maxCpuRamBudget / 10;
     if (_cpuRamBudget < tenthOfRamBudget) {
-        long long bytesToTenthOfRam = tenthOfRamBudget - _cpuRamBudget;
-        size_t nNodesToRemove = static_cast<size_t>(bytesToTenthOfRam / chunkSizeInBytes);
-        std::vector<unsigned long long> nodesToRemove;
-        while (nNodesToRemove > 0) {
-            // Dequeue nodes that were least recently fetched by findAndFetchNeighborNode.
-            nodesToRemove.push_back(_leastRecentlyFetchedNodes.front());
-            _leastRecentlyFetchedNodes.pop();
-            nNodesToRemove--;
-        }
+        // Free at least one chunk so we don't end up here again the next frame.
+        long long bytesToTenthOfRam = std::max(
+            tenthOfRamBudget - _cpuRamBudget,
+            static_cast<long long>(chunkSizeInBytes)
+        );
+        // Evict the nodes that are least important, i.e. not traversed for a long time,
+        // far away from the camera and/or only containing faint stars.
+        std::vector<unsigned long long> nodesToRemove = selectNodesToEvict(
+            bytesToTenthOfRam
+        );
         // Use asynchronous removal.
         if (!nodesToRemove.empty()) {
             std::thread(&OctreeManager::removeNodesFromRam, this, nodesToRemove).detach();
@@ -392,15 +445,19 @@ void OctreeManager::findAndFetchNeighborNode(unsigned long long firstParentId, i
     }).detach();
 }
 
-std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4& mvp,
+const OctreeManager::StagingArena& OctreeManager::traverseData(
+                                                                    const glm::dmat4& mvp,
                                                               const glm::vec2& screenSize,
-                                                              int& deltaStars,
-                                                              gaia::RenderOption option,
-                                                              float lodPixelThreshold)
+                                                                          int& deltaStars,
+                                                                gaia::RenderOption option,
+                                                                  float lodPixelThreshold)
 {
-    auto renderData = std::map<int, std::vector<float>>();
+    // Reuse the storage from the previous render call.
+    _stagingArena.data.clear();
+    _stagingArena.dirtyChunks.clear();
     bool innerRebuild = false;
     _minTotalPixelsLod = lodPixelThreshold;
+    _traversalFrame++;
 
     // Reclaim indices from previous render call.
     for (auto removedKey = _removedKeysInPrevCall.rbegin();
@@ -435,7 +492,7 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
     }
 
     // Check if entire tree is too small to see, and if so remove it.
-    std::vector<glm::dvec4> corners(8);
+    std::array<glm::dvec4, 8> corners;
     float fMaxDist = static_cast<float>(MAX_DIST);
     for (int i = 0; i < 8; ++i) {
         float x = (i % 2 == 0) ? fMaxDist : -fMaxDist;
@@ -445,20 +502,55 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
         corners[i] = glm::dvec4(pos, 1.0);
     }
     if (!_culler->isVisible(corners, mvp)) {
-        return renderData;
+        return _stagingArena;
     }
     glm::vec2 nodeSize = _culler->getNodeSizeInPixels(corners, mvp, screenSize);
     float totalPixels = nodeSize.x * nodeSize.y;
     if (totalPixels < _minTotalPixelsLod * 2) {
         // Remove LOD from first layer of children.
         for (int i = 0; i < 8; ++i) {
-            std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
+            removeNodeFromCache(*_root->Children[i], deltaStars);
+        }
+        sortByBufferIndex(_stagingArena.dirtyChunks);
+        return _stagingArena;
+    }
+
+    // Check culling and LOD for all branches first. This doesn't change any state, so
+    // the branches are checked concurrently if we have the threads for it.
+    for (std::vector<TraversalAction>& actions : _branchActions) {
+        actions.clear();
+    }
+    if (_parallelTraversal && _traversalPool) {
+        std::vector<std::future<void>> branchesDone;
+        branchesDone.reserve(8);
+        for (size_t i = _traversedBranchesInRenderCall; i < 7; ++i) {
+            auto task = std::make_shared<std::packaged_task<void()>>(
+                [this, i, &mvp, &screenSize]() {
+                    checkNodeIntersection(
+                        *_root->Children[i],
+                        mvp,
+                        screenSize,
+                        _branchActions[i]
+                    );
+                }
+            );
+            branchesDone.push_back(task->get_future());
+            _traversalPool->enqueue([task]() { (*task)(); });
+        }
+        checkNodeIntersection(*_root->Children[7], mvp, screenSize, _branchActions[7]);
+        for (std::future<void>& f : branchesDone) {
+            f.get();
+        }
+    }
+    else {
+        for (size_t i = _traversedBranchesInRenderCall; i < 8; ++i) {
+            checkNodeIntersection(
                 *_root->Children[i],
-                deltaStars
+                mvp,
+                screenSize,
+                _branchActions[i]
             );
-            renderData.insert(tmpData.begin(), tmpData.end());
         }
-        return renderData;
     }
 
     for (size_t i = 0; i < 8; ++i) {
@@ -466,38 +558,28 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
             continue;
         }
 
-        std::map<int, std::vector<float>> tmpData = checkNodeIntersection(
-            *_root->Children[i],
-            mvp,
-            screenSize,
-            deltaStars,
-            option
-        );
+        // Apply the decisions in branch order so that buffer indices are handed out
+        // exactly as in a serial traversal. Observe that if there exists identical keys
+        // in the staging arena then the data that was staged first is kept! Thus we
+        // store the removed keys until next render call!
+        applyTraversalActions(_branchActions[i], deltaStars, option);
 
         // Avoid freezing when switching render mode for large datasets by only fetching
         // one branch at a time when rebuilding buffer.
         if (_rebuildBuffer) {
-            //renderData = std::move(tmpData);
             _traversedBranchesInRenderCall++;
             //break;
         }
-
-        // Observe that if there exists identical keys in renderData then those values in
-        // tmpData will be ignored! Thus we store the removed keys until next render call!
-        renderData.insert(tmpData.begin(), tmpData.end());
     }
 
     if (_rebuildBuffer) {
         if (_useVBO) {
             // We need to overwrite bigger indices that had data before! No need for SSBO.
-            std::map<int, std::vector<float>> idxToRemove;
+            // This will only stage indices that haven't already been staged
+            // (i.e. > biggestIdx).
             for (int idx : _removedKeysInPrevCall) {
-                idxToRemove[idx] = std::vector<float>();
+                stageRemoval(idx);
             }
-
-            // This will only insert indices that doesn't already exist in map
-            // (i.e. > biggestIdx).
-            renderData.insert(idxToRemove.begin(), idxToRemove.end());
         }
         if (innerRebuild) {
             deltaStars = 0;
@@ -518,15 +600,17 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
             _traversedBranchesInRenderCall = 0;
         }
     }
-    return renderData;
+
+    // Upload chunks in buffer order.
+    sortByBufferIndex(_stagingArena.dirtyChunks);
+    return _stagingArena;
 }
 
 std::vector<float> OctreeManager::getAllData(gaia::RenderOption option) {
     std::vector<float> fullData;
 
     for (size_t i = 0; i < 8; ++i) {
-        std::vector<float> tmpData = getNodeData(*_root->Children[i], option);
-        fullData.insert(fullData.end(), tmpData.begin(), tmpData.end());
+        getNodeData(*_root->Children[i], option, fullData);
     }
     return fullData;
 }
@@ -809,11 +893,20 @@ void OctreeManager::fetchNodeDataFromFile(OctreeNode& node) {
         node.colData = std::vector<float>(posEnd, colEnd);
         node.velData = std::vector<float>(colEnd, velEnd);
 
+        // The brightest star determines how much the node contributes to the image.
+        node.brightestMagnitude = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < node.colData.size(); i += COL_SIZE) {
+            node.brightestMagnitude = std::min(node.brightestMagnitude, node.colData[i]);
+        }
+
         // Keep track of nodes that are loaded and update CPU RAM budget.
         node.isLoaded = true;
         if (!_datasetFitInMemory) {
-            std::lock_guard g(_leastRecentlyFetchedNodesMutex);
-            _leastRecentlyFetchedNodes.push(node.octreePositionIndex);
+            std::lock_guard g(_evictionMutex);
+            if (_evictedNodes.erase(node.octreePositionIndex) > 0) {
+                _nRefetchedNodes++;
+            }
+            touchNode(node);
         }
         _cpuRamBudget -= nBytes;
     }
@@ -853,6 +946,21 @@ void OctreeManager::removeNode(OctreeNode& node) {
     // Lock node to make sure nobody else is trying to access it while removing.
     std::lock_guard lock(node.loadingLock);
 
+    // Node may have been removed already, don't give back its RAM budget twice.
+    if (!node.isLoaded) {
+        return;
+    }
+
+    // The node might have been traversed again after it was selected for eviction.
+    {
+        std::lock_guard g(_evictionMutex);
+        auto it = _evictionEntries.find(node.octreePositionIndex);
+        if (it != _evictionEntries.end()) {
+            _evictionOrder.erase({ it->second.score, node.octreePositionIndex });
+            _evictionEntries.erase(it);
+        }
+    }
+
     int nBytes = static_cast<int>(
         node.numStars * _valuesPerStar * sizeof(node.posData[0])
     );
@@ -869,6 +977,71 @@ void OctreeManager::removeNode(OctreeNode& node) {
     node.velData.shrink_to_fit();
 }
 
+void OctreeManager::touchNode(const OctreeNode& node) {
+    const unsigned long long frame = _traversalFrame;
+    auto it = _evictionEntries.find(node.octreePositionIndex);
+    if (it != _evictionEntries.end()) {
+        // Only update once per frame, the score can't change within a frame.
+        if (it->second.lastTouchedFrame == frame) {
+            return;
+        }
+        _evictionOrder.erase({ it->second.score, node.octreePositionIndex });
+    }
+
+    // Distance [kPc] from the camera to the closest point of the node.
+    const glm::dvec3 origin = glm::dvec3(node.originX, node.originY, node.originZ);
+    const glm::dvec3 closest = glm::clamp(
+        _cameraPosition,
+        origin - static_cast<double>(node.halfDimension),
+        origin + static_cast<double>(node.halfDimension)
+    );
+    const double dist = std::max(
+        glm::length(_cameraPosition - closest),
+        EVICTION_MIN_DISTANCE
+    );
+
+    // Apparent magnitude of the brightest star, using the distance modulus [pc].
+    const double apparentMag = node.brightestMagnitude +
+                               5.0 * (std::log10(dist * 1000.0) - 1.0);
+    const double brightness = std::clamp(
+        EVICTION_FAINT_LIMIT - apparentMag,
+        0.0,
+        EVICTION_FAINT_LIMIT
+    );
+    const double score = static_cast<double>(frame) +
+                         brightness * EVICTION_FRAMES_PER_MAGNITUDE;
+
+    EvictionEntry entry;
+    entry.score = score;
+    entry.nBytes = static_cast<long long>(
+        node.numStars * _valuesPerStar * sizeof(float)
+    );
+    entry.lastTouchedFrame = frame;
+    _evictionEntries[node.octreePositionIndex] = entry;
+    _evictionOrder.insert({ score, node.octreePositionIndex });
+}
+
+std::vector<unsigned long long> OctreeManager::selectNodesToEvict(long long bytesToFree)
+{
+    std::lock_guard g(_evictionMutex);
+
+    std::vector<unsigned long long> nodesToRemove;
+    long long freedBytes = 0;
+    while (freedBytes < bytesToFree && !_evictionOrder.empty()) {
+        const unsigned long long id = _evictionOrder.begin()->second;
+        _evictionOrder.erase(_evictionOrder.begin());
+
+        auto it = _evictionEntries.find(id);
+        freedBytes += it->second.nBytes;
+        _evictionEntries.erase(it);
+
+        _evictedNodes.insert(id);
+        nodesToRemove.push_back(id);
+    }
+    _nEvictedNodes += nodesToRemove.size();
+    return nodesToRemove;
+}
+
 void OctreeManager::propagateUnloadedNodes(
                                    std::vector<std::shared_ptr<OctreeNode>> ancestorNodes)
 {
@@ -900,6 +1073,10 @@ void OctreeManager::propagateUnloadedNodes(
     }
 }
 
+void OctreeManager::setParallelTraversal(bool enabled) {
+    _parallelTraversal = enabled;
+}
+
 size_t OctreeManager::numLeafNodes() const {
     return _numLeafNodes;
 }
@@ -940,6 +1117,14 @@ bool OctreeManager::isRebuildOngoing() const {
     return _rebuildBuffer;
 }
 
+size_t OctreeManager::numEvictedNodes() const {
+    return _nEvictedNodes;
+}
+
+size_t OctreeManager::numRefetchedNodes() const {
+    return _nRefetchedNodes;
+}
+
 size_t OctreeManager::getChildIndex(float posX, float posY, float posZ, float origX,
                                     float origY, float origZ)
 {
@@ -1098,17 +1283,14 @@ std::string OctreeManager::printStarsPerNode(const OctreeNode& node,
     }
 }
 
-std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNode& node,
-                                                                    const glm::dmat4& mvp,
-                                                              const glm::vec2& screenSize,
-                                                                          int& deltaStars,
-                                                                gaia::RenderOption option)
+void OctreeManager::checkNodeIntersection(OctreeNode& node, const glm::dmat4& mvp,
+                                          const glm::vec2& screenSize,
+                                          std::vector<TraversalAction>& actions) const
 {
-    std::map<int, std::vector<float>> fetchedData;
     //int depth  = static_cast<int>(log2( MAX_DIST / node->halfDimension ));
 
     // Calculate the corners of the node.
-    std::vector<glm::dvec4> corners(8);
+    std::array<glm::dvec4, 8> corners;
     for (int i = 0; i < 8; ++i) {
         const float x = (i % 2 == 0) ?
             node.originX + node.halfDimension :
@@ -1127,8 +1309,8 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
     if (!(_culler->isVisible(corners, mvp))) {
         // Check if this node or any of its children existed in cache previously.
         // If so, then remove them from cache and add those indices to stack.
-        fetchedData = removeNodeFromCache(node, deltaStars);
-        return fetchedData;
+        actions.push_back({ TraversalAction::Type::Remove, &node });
+        return;
     }
 
     // Remove node if it has been unloaded while still in view.
@@ -1136,8 +1318,13 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
     if (node.bufferIndex != DEFAULT_INDEX && !node.isLoaded && _streamOctree &&
         !_datasetFitInMemory)
     {
-        fetchedData = removeNodeFromCache(node, deltaStars);
-        return fetchedData;
+        actions.push_back({ TraversalAction::Type::Remove, &node });
+        return;
+    }
+
+    // Node is visible, so it has just been used. Update its eviction score.
+    if (node.isLoaded && _streamOctree && !_datasetFitInMemory) {
+        actions.push_back({ TraversalAction::Type::Touch, &node });
     }
 
     // Take care of inner nodes.
@@ -1155,77 +1342,79 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
             // Get correct insert index from stack if node didn't exist already. Otherwise
             // we will overwrite the old data. Key merging is not a problem here.
             if ((node.bufferIndex == DEFAULT_INDEX) || _rebuildBuffer) {
-                // Return empty if we couldn't claim a buffer stream index.
-                if (!updateBufferIndex(node)) {
-                    return fetchedData;
-                }
-
-                // We're in an inner node, remove indices from potential children in cache
-                for (int i = 0; i < 8; ++i) {
-                    std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
-                        *node.Children[i],
-                        deltaStars
-                    );
-                    fetchedData.insert(tmpData.begin(), tmpData.end());
-                }
-
-                // Insert data and adjust stars added in this frame.
-                fetchedData[node.bufferIndex] = constructInsertData(
-                    node,
-                    option,
-                    deltaStars
-                );
+                actions.push_back({ TraversalAction::Type::InsertLod, &node });
             }
-            return fetchedData;
+            return;
         }
     }
     // Return node data if node is a leaf.
     else {
         // If node already is in cache then skip it, otherwise store it.
         if ((node.bufferIndex == DEFAULT_INDEX) || _rebuildBuffer) {
-            // Return empty if we couldn't claim a buffer stream index.
-            if (!updateBufferIndex(node)) {
-                return fetchedData;
-            }
-
-            // Insert data and adjust stars added in this frame.
-            fetchedData[node.bufferIndex] = constructInsertData(
-                node,
-                option,
-                deltaStars
-            );
+            actions.push_back({ TraversalAction::Type::InsertLeaf, &node });
         }
-        return fetchedData;
+        return;
     }
 
     // We're in a big, visible inner node -> remove it from cache if it existed.
     // But not its children -> set recursive check to false.
-    fetchedData = removeNodeFromCache(node, deltaStars, false);
+    actions.push_back({ TraversalAction::Type::RemoveSingle, &node });
 
     // Recursively check if children should be rendered.
     for (size_t i = 0; i < 8; ++i) {
-        // Observe that if there exists identical keys in fetchedData then those values in
-        // tmpData will be ignored! Thus we store the removed keys until next render call!
-        std::map<int, std::vector<float>> tmpData = checkNodeIntersection(
-            *node.Children[i],
-            mvp,
-            screenSize,
-            deltaStars,
-            option
-        );
-        fetchedData.insert(tmpData.begin(), tmpData.end());
+        checkNodeIntersection(*node.Children[i], mvp, screenSize, actions);
     }
-    return fetchedData;
 }
 
-std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode& node,
-                                                                     int& deltaStars,
-                                                                     bool recursive)
+void OctreeManager::applyTraversalActions(const std::vector<TraversalAction>& actions,
+                                          int& deltaStars, gaia::RenderOption option)
 {
-    std::map<int, std::vector<float>> keysToRemove;
+    for (const TraversalAction& action : actions) {
+        OctreeNode& node = *action.node;
+        switch (action.type) {
+            case TraversalAction::Type::Touch: {
+                std::lock_guard g(_evictionMutex);
+                touchNode(node);
+                break;
+            }
+            case TraversalAction::Type::Remove:
+                removeNodeFromCache(node, deltaStars);
+                break;
+            case TraversalAction::Type::RemoveSingle:
+                removeNodeFromCache(node, deltaStars, false);
+                break;
+            case TraversalAction::Type::InsertLeaf:
+                // Skip if we couldn't claim a buffer stream index.
+                if (!updateBufferIndex(node)) {
+                    break;
+                }
+
+                // Insert data and adjust stars added in this frame.
+                stageNodeData(node, option, deltaStars);
+                break;
+            case TraversalAction::Type::InsertLod:
+                // Skip if we couldn't claim a buffer stream index.
+                if (!updateBufferIndex(node)) {
+                    break;
+                }
+
+                // We're in an inner node, remove indices from potential children in cache
+                for (int i = 0; i < 8; ++i) {
+                    removeNodeFromCache(*node.Children[i], deltaStars);
+                }
+
+                // Insert data and adjust stars added in this frame.
+                stageNodeData(node, option, deltaStars);
+                break;
+        }
+    }
+}
 
+void OctreeManager::removeNodeFromCache(OctreeNode& node, int& deltaStars,
+                                        bool recursive)
+{
     // If we're in rebuilding mode then there is no need to remove any nodes.
-    //if (_rebuildBuffer) return keysToRemove;
+    //if (_rebuildBuffer) return;
 
     // Check if this node was rendered == had a specified index.
     if (node.bufferIndex != DEFAULT_INDEX) {
@@ -1234,7 +1423,7 @@ std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode&
         _removedKeysInPrevCall.insert(node.bufferIndex);
 
         // Insert dummy node at offset index that should be removed from render.
-        keysToRemove[node.bufferIndex] = std::vector<float>();
+        stageRemoval(node.bufferIndex);
 
         // Reset index and adjust stars removed this frame.
         node.bufferIndex = DEFAULT_INDEX;
@@ -1244,32 +1433,25 @@ std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode&
     // Check children recursively if we're in an inner node.
     if (!(node.isLeaf) && recursive) {
         for (int i = 0; i < 8; ++i) {
-            std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
-                *node.Children[i],
-                deltaStars
-            );
-            keysToRemove.insert(tmpData.begin(), tmpData.end());
+            removeNodeFromCache(*node.Children[i], deltaStars);
         }
     }
-    return keysToRemove;
 }
 
-std::vector<float> OctreeManager::getNodeData(const OctreeNode& node,
-                                              gaia::RenderOption option)
+void OctreeManager::getNodeData(const OctreeNode& node, gaia::RenderOption option,
+                                std::vector<float>& nodeData)
 {
     // Return node data if node is a leaf.
     if (node.isLeaf) {
         int dStars = 0;
-        return constructInsertData(node, option, dStars);
+        constructInsertData(node, option, dStars, nodeData);
+        return;
     }
 
     // If we're not in a leaf, get data from all children recursively.
-    auto nodeData = std::vector<float>();
     for (size_t i = 0; i < 8; ++i) {
-        std::vector<float> tmpData = getNodeData(*node.Children[i], option);
-        nodeData.insert(nodeData.end(), tmpData.begin(), tmpData.end());
+        getNodeData(*node.Children[i], option, nodeData);
     }
-    return nodeData;
 }
 
 void OctreeManager::clearNodeData(OctreeNode& node) {
@@ -1303,6 +1485,7 @@ void OctreeManager::createNodeChildren(OctreeNode& node) {
         node.Children[i]->bufferIndex = DEFAULT_INDEX;
         node.Children[i]->octreePositionIndex = (node.octreePositionIndex * 10) + i;
         node.Children[i]->numStars = 0;
+        node.Children[i]->brightestMagnitude = std::numeric_limits<float>::max();
         node.Children[i]->posData = std::vector<float>();
         node.Children[i]->colData = std::vector<float>();
         node.Children[i]->velData = std::vector<float>();
@@ -1361,31 +1544,33 @@ bool OctreeManager::updateBufferIndex(OctreeNode& node) {
     return true;
 }
 
-std::vector<float> OctreeManager::constructInsertData(const OctreeNode& node,
-                                                      gaia::RenderOption option,
-                                                      int& deltaStars)
+void OctreeManager::constructInsertData(const OctreeNode& node,
+                                        gaia::RenderOption option, int& deltaStars,
+                                        std::vector<float>& insertData)
 {
     // Return early if node doesn't contain any stars!
     if (node.numStars == 0) {
-        return std::vector<float>();
+        return;
     }
 
     // Fill chunk by appending zeroes to data so we overwrite possible earlier values.
     // And more importantly so our attribute pointers knows where to read!
-    auto insertData = std::vector<float>(node.posData.begin(), node.posData.end());
+    const size_t start = insertData.size();
+    insertData.insert(insertData.end(), node.posData.begin(), node.posData.end());
     if (_useVBO) {
-        insertData.resize(POS_SIZE * MAX_STARS_PER_NODE, 0.f);
+        insertData.resize(start + POS_SIZE * MAX_STARS_PER_NODE, 0.f);
     }
     if (option != gaia::RenderOption::Static) {
         insertData.insert(insertData.end(), node.colData.begin(), node.colData.end());
         if (_useVBO) {
-            insertData.resize((POS_SIZE + COL_SIZE) * MAX_STARS_PER_NODE, 0.f);
+            insertData.resize(start + (POS_SIZE + COL_SIZE) * MAX_STARS_PER_NODE, 0.f);
         }
         if (option == gaia::RenderOption::Motion) {
             insertData.insert(insertData.end(), node.velData.begin(), node.velData.end());
             if (_useVBO) {
                 insertData.resize(
-                    (POS_SIZE + COL_SIZE + VEL_SIZE) * MAX_STARS_PER_NODE, 0.f
+                    start + (POS_SIZE + COL_SIZE + VEL_SIZE) * MAX_STARS_PER_NODE,
+                    0.f
                 );
             }
         }
@@ -1393,7 +1578,45 @@ std::vector<float> OctreeManager::constructInsertData(const OctreeNode& node,
 
     // Update deltaStars.
     deltaStars += static_cast<int>(node.numStars);
-    return insertData;
+}
+
+void OctreeManager::stageNodeData(const OctreeNode& node, gaia::RenderOption option,
+                                  int& deltaStars)
+{
+    const size_t slot = stagedChunk(node.bufferIndex);
+    if (_stagingArena.dirtyChunks[slot].size > 0) {
+        // Another node has already written to this chunk in this render call. Keep its
+        // data but still account for the stars.
+        deltaStars += static_cast<int>(node.numStars);
+        return;
+    }
+
+    const size_t offset = _stagingArena.data.size();
+    constructInsertData(node, option, deltaStars, _stagingArena.data);
+    _stagingArena.dirtyChunks[slot].offset = offset;
+    _stagingArena.dirtyChunks[slot].size = _stagingArena.data.size() - offset;
+}
+
+void OctreeManager::stageRemoval(int bufferIndex) {
+    // An already staged chunk keeps its values, otherwise an empty chunk is added.
+    stagedChunk(bufferIndex);
+}
+
+size_t OctreeManager::stagedChunk(int bufferIndex) {
+    const size_t idx = static_cast<size_t>(bufferIndex);
+    if (idx >= _chunkStagedInCall.size()) {
+        _chunkStagedInCall.resize(idx + 1, 0);
+        _chunkSlot.resize(idx + 1, 0);
+    }
+
+    const unsigned long long call = _traversalFrame;
+    if (_chunkStagedInCall[idx] != call) {
+        _chunkStagedInCall[idx] = call;
+        _chunkSlot[idx] = _stagingArena.dirtyChunks.size();
+        const size_t offset = _stagingArena.data.size();
+        _stagingArena.dirtyChunks.push_back({ bufferIndex, offset, 0 });
+    }
+    return _chunkSlot[idx];
 }
 
 }  // namespace openspace
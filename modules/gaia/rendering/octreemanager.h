@@ -28,15 +28,19 @@
 #include <modules/gaia/rendering/gaiaoptions.h>
 #include <ghoul/glm.h>
 #include <ghoul/opengl/ghoul_gl.h>
-#include <map>
+#include <array>
+#include <atomic>
 #include <mutex>
-#include <queue>
+#include <set>
 #include <stack>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace openspace {
 
 class OctreeCuller;
+class ThreadPool;
 
 class OctreeManager {
 public:
@@ -51,6 +55,7 @@ public:
         float originZ;
         float halfDimension;
         size_t numStars;
+        float brightestMagnitude;
         bool isLeaf;
         bool isLoaded;
         bool hasLoadedDescendant;
@@ -59,8 +64,28 @@ public:
         unsigned long long octreePositionIndex;
     };
 
-    OctreeManager() = default;
-    ~OctreeManager() = default;
+    /**
+     * Staging area for the chunks that changed in the last call to
+     * <code>traverseData()</code>. The storage is owned by the OctreeManager and reused
+     * between render calls, so no allocations are made once it has grown to its working
+     * size. Chunks without any values should be cleared in the streaming buffer.
+     */
+    struct StagingArena {
+        struct Chunk {
+            int bufferIndex;
+            size_t offset;
+            size_t size;
+        };
+
+        std::vector<float> data;
+        // Sorted by buffer index.
+        std::vector<Chunk> dirtyChunks;
+
+        const float* chunkData(const Chunk& chunk) const;
+    };
+
+    OctreeManager();
+    ~OctreeManager();
 
     /**
      * Initializes a one layer Octree with root and 8 children that covers all stars.
@@ -103,7 +128,8 @@ public:
      * Used while streaming nodes from files. Checks if any nodes need to be loaded or
      * unloaded. If entire dataset fits in RAM then the whole dataset will be loaded
      * asynchronously. Otherwise only nodes close to the camera will be fetched.
-     * When RAM stars to fill up least-recently used nodes will start to unload.
+     * When RAM starts to fill up the least important nodes will start to unload, see
+     * <code>touchNode()</code> for how importance is scored.
      * Calls <code>findAndFetchNeighborNode()</code> and
      * <code>removeNodesFromRam()</code> internally.
      */
@@ -112,15 +138,16 @@ public:
 
     /**
      * Builds render data structure by traversing the Octree and checking for intersection
-     * with view frustum. Every vector in map contains data for one node.
-     * The corresponding integer key is the index where chunk should be inserted into
-     * streaming buffer. Calls <code>checkNodeIntersection()</code> for every branch.
+     * with view frustum. Every dirty chunk in the returned arena contains data for one
+     * node, and its buffer index is the index where chunk should be inserted into
+     * streaming buffer. Calls <code>checkNodeIntersection()</code> for every branch,
+     * in parallel if enabled, and then applies the decisions branch by branch in the
+     * same order as a serial traversal would.
      * \pdeltaStars keeps track of how many stars that were added/removed this render
-     * call.
+     * call. The returned arena is only valid until the next call.
      */
-    std::map<int, std::vector<float>> traverseData(const glm::dmat4& mvp,
-        const glm::vec2& screenSize, int& deltaStars, gaia::RenderOption option,
-        float lodPixelThreshold);
+    const StagingArena& traverseData(const glm::dmat4& mvp, const glm::vec2& screenSize,
+        int& deltaStars, gaia::RenderOption option, float lodPixelThreshold);
 
     /**
      * Builds full render data structure by traversing all leaves in the Octree.
@@ -158,6 +185,13 @@ public:
      */
     void writeToMultipleFiles(const std::string& outFolderPath, size_t branchIndex);
 
+    /**
+     * Enables or disables evaluating the culling and LOD decisions of the eight
+     * top-level branches on separate threads in <code>traverseData()</code>. The result
+     * is the same in both cases.
+     */
+    void setParallelTraversal(bool enabled);
+
     /**
      * Getters.
      */
@@ -171,6 +205,19 @@ public:
     size_t numFreeSpotsInBuffer() const;
     bool isRebuildOngoing() const;
 
+    /**
+     * \returns the number of nodes that have been evicted from RAM since the Octree was
+     * initialized.
+     */
+    size_t numEvictedNodes() const;
+
+    /**
+     * \returns the number of nodes that have been fetched from file again after having
+     * been evicted from RAM. A high ratio of re-fetches to evictions indicates that the
+     * eviction weights are throwing away nodes that are still needed.
+     */
+    size_t numRefetchedNodes() const;
+
     /**
      * \returns current CPU RAM budget in bytes.
      */
@@ -199,6 +246,15 @@ private:
     const int DEFAULT_INDEX = -1;
     const std::string BINARY_SUFFIX = ".bin";
 
+    // Weights for the eviction score of streamed nodes, expressed in frames. A node that
+    // is one magnitude brighter (apparent magnitude as seen from the camera, i.e. the
+    // distance to the camera is included through the distance modulus) survives
+    // EVICTION_FRAMES_PER_MAGNITUDE frames longer after it was last traversed. Nodes
+    // fainter than EVICTION_FAINT_LIMIT are scored on recency alone.
+    const double EVICTION_FRAMES_PER_MAGNITUDE = 30.0;
+    const double EVICTION_FAINT_LIMIT = 25.0;
+    const double EVICTION_MIN_DISTANCE = 0.001; // [kPc]
+
     /**
      * \returns the correct index of child node. Maps [1,1,1] to 0 and [-1,-1,-1] to 7.
      */
@@ -235,16 +291,41 @@ private:
     std::string printStarsPerNode(const OctreeNode& node,
         const std::string& prefix) const;
 
+    /**
+     * A decision made by <code>checkNodeIntersection()</code> that is applied to the
+     * buffer bookkeeping afterwards by <code>applyTraversalActions()</code>.
+     */
+    struct TraversalAction {
+        enum class Type {
+            Touch,        // Node is visible and loaded, update its eviction score
+            Remove,       // Remove node and all descendants from cache
+            RemoveSingle, // Remove node, but not its descendants, from cache
+            InsertLeaf,   // Claim buffer index for leaf and stage its data
+            InsertLod     // Claim buffer index for inner node, remove descendants from
+                          // cache and stage its LOD data
+        };
+        Type type;
+        OctreeNode* node;
+    };
+
     /**
      * Private help function for <code>traverseData()</code>. Recursively checks which
      * nodes intersect with the view frustum (interpreted as an AABB) and decides if data
      * should be optimized away or not. Keeps track of which nodes that are visible and
-     * loaded (if streaming). \param deltaStars keeps track of how many stars that were
-     * added/removed this render call.
+     * loaded (if streaming). The decisions are appended to \param actions in traversal
+     * order. No state is changed, so different branches can be checked concurrently.
+     */
+    void checkNodeIntersection(OctreeNode& node, const glm::dmat4& mvp,
+        const glm::vec2& screenSize, std::vector<TraversalAction>& actions) const;
+
+    /**
+     * Applies the decisions from <code>checkNodeIntersection()</code> in order. Claims
+     * and releases buffer indices and writes changed chunks to the staging arena.
+     * \param deltaStars keeps track of how many stars that were added/removed this
+     * render call.
      */
-    std::map<int, std::vector<float>> checkNodeIntersection(OctreeNode& node,
-        const glm::dmat4& mvp, const glm::vec2& screenSize, int& deltaStars,
-        gaia::RenderOption option);
+    void applyTraversalActions(const std::vector<TraversalAction>& actions,
+        int& deltaStars, gaia::RenderOption option);
 
     /**
      * Checks if specified node existed in cache, and removes it if that's the case.
@@ -252,13 +333,14 @@ private:
      * long as \param recursive is not set to false. \param deltaStars keeps track of how
      * many stars that were removed.
      */
-    std::map<int, std::vector<float>> removeNodeFromCache(OctreeNode& node,
-        int& deltaStars, bool recursive = true);
+    void removeNodeFromCache(OctreeNode& node, int& deltaStars, bool recursive = true);
 
     /**
-     * Get data in node and its descendants regardless if they are visible or not.
+     * Get data in node and its descendants regardless if they are visible or not. The
+     * data is appended to \param nodeData.
      */
-    std::vector<float> getNodeData(const OctreeNode& node, gaia::RenderOption option);
+    void getNodeData(const OctreeNode& node, gaia::RenderOption option,
+        std::vector<float>& nodeData);
 
     /**
      * Clear data from node and its descendants and shrink vectors to deallocate memory.
@@ -278,14 +360,36 @@ private:
     bool updateBufferIndex(OctreeNode& node);
 
     /**
-     * Node should be inserted into stream. This function \returns the data to be
-     * inserted. If VBOs are used then the chunks will be appended by zeros, otherwise
-     * only the star data corresponding to RenderOption \param option will be inserted.
+     * Node should be inserted into stream. This function appends the data to be
+     * inserted to \param insertData. If VBOs are used then the chunks will be appended
+     * by zeros, otherwise only the star data corresponding to RenderOption \param option
+     * will be inserted.
      *
      * \param deltaStars keeps track of how many stars that were added.
      */
-    std::vector<float> constructInsertData(const OctreeNode& node,
-        gaia::RenderOption option, int& deltaStars);
+    void constructInsertData(const OctreeNode& node, gaia::RenderOption option,
+        int& deltaStars, std::vector<float>& insertData);
+
+    /**
+     * Writes the data of \param node into the staging arena at the node's buffer index.
+     * If another node already has written data to the same index in this render call,
+     * then that data is kept. Data always replaces a staged removal.
+     */
+    void stageNodeData(const OctreeNode& node, gaia::RenderOption option,
+        int& deltaStars);
+
+    /**
+     * Marks the chunk at \param bufferIndex as removed in the staging arena, unless the
+     * chunk already has been staged in this render call.
+     */
+    void stageRemoval(int bufferIndex);
+
+    /**
+     * \returns the position of the chunk with \param bufferIndex in the dirty list of
+     * the staging arena, adding an empty chunk if it hasn't been staged in this render
+     * call.
+     */
+    size_t stagedChunk(int bufferIndex);
 
     /**
      * Write a node to outFileStream. \param writeData defines if data should be included
@@ -355,12 +459,54 @@ private:
      */
     void propagateUnloadedNodes(std::vector<std::shared_ptr<OctreeNode>> ancestorNodes);
 
+    /**
+     * Updates the eviction score of a loaded node. The score is the frame in which the
+     * node was last traversed, pushed forward in time by how bright the node appears
+     * from the camera. Nodes with the lowest score are evicted first. Each update is
+     * O(log n) in the number of loaded nodes. Must be called with
+     * <code>_evictionMutex</code> locked.
+     */
+    void touchNode(const OctreeNode& node);
+
+    /**
+     * Selects the nodes with the lowest eviction score until at least \param bytesToFree
+     * bytes would be released and removes them from the eviction bookkeeping.
+     * \returns the position indices of the selected nodes.
+     */
+    std::vector<unsigned long long> selectNodesToEvict(long long bytesToFree);
+
+    struct EvictionEntry {
+        double score;
+        long long nBytes;
+        unsigned long long lastTouchedFrame;
+    };
+
     std::shared_ptr<OctreeNode> _root;
     std::unique_ptr<OctreeCuller> _culler;
     std::stack<int> _freeSpotsInBuffer;
     std::set<int> _removedKeysInPrevCall;
-    std::queue<unsigned long long> _leastRecentlyFetchedNodes;
-    std::mutex _leastRecentlyFetchedNodesMutex;
+
+    StagingArena _stagingArena;
+    // Per buffer index, the render call in which the chunk was last staged and its
+    // position in the dirty list of the staging arena.
+    std::vector<unsigned long long> _chunkStagedInCall;
+    std::vector<size_t> _chunkSlot;
+
+    // Decisions for each top-level branch, reused between render calls.
+    std::array<std::vector<TraversalAction>, 8> _branchActions;
+    std::unique_ptr<ThreadPool> _traversalPool;
+    bool _parallelTraversal = true;
+
+    // Loaded nodes ordered by eviction score (lowest first) with a lookup from node
+    // position index to its current entry, so that each score update is O(log n).
+    std::set<std::pair<double, unsigned long long>> _evictionOrder;
+    std::unordered_map<unsigned long long, EvictionEntry> _evictionEntries;
+    std::unordered_set<unsigned long long> _evictedNodes;
+    std::mutex _evictionMutex;
+    glm::dvec3 _cameraPosition = glm::dvec3(0.0);
+    std::atomic<unsigned long long> _traversalFrame = 0;
+    std::atomic<size_t> _nEvictedNodes = 0;
+    std::atomic<size_t> _nRefetchedNodes = 0;
 
     size_t _totalDepth = 0;
     size_t _numLeafNodes = 0;
@@ -225,6 +225,20 @@ namespace {
         "additional stars."
     };
 
+    constexpr openspace::properties::Property::PropertyInfo NumEvictedNodesInfo = {
+        "NumEvictedNodes",
+        "Evicted Nodes",
+        "The number of nodes that have been evicted from CPU RAM while streaming, to "
+        "make room for nodes that are more important to the current view."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo NumRefetchedNodesInfo = {
+        "NumRefetchedNodes",
+        "Re-fetched Nodes",
+        "The number of nodes that had to be read from file again after having been "
+        "evicted from CPU RAM while streaming."
+    };
+
     constexpr openspace::properties::Property::PropertyInfo LodPixelThresholdInfo = {
         "LodPixelThreshold",
         "LOD Pixel Threshold",
@@ -536,6 +550,8 @@ RenderableGaiaStars::RenderableGaiaStars(const ghoul::Dictionary& dictionary)
     , _nRenderedStars(NumRenderedStarsInfo, 0, 0, 2000000000) // 2 Billion stars
     , _cpuRamBudgetProperty(CpuRamBudgetInfo, 0.f, 0.f, 1.f)
     , _gpuStreamBudgetProperty(GpuStreamBudgetInfo, 0.f, 0.f, 1.f)
+    , _nEvictedNodes(NumEvictedNodesInfo, 0, 0, 2000000000)
+    , _nRefetchedNodes(NumRefetchedNodesInfo, 0, 0, 2000000000)
     , _reportGlErrors(ReportGlErrorsInfo, false)
     , _accumulatedIndices(1, 0)
 {
@@ -857,6 +873,12 @@ RenderableGaiaStars::RenderableGaiaStars(const ghoul::Dictionary& dictionary)
     addProperty(_cpuRamBudgetProperty);
     _gpuStreamBudgetProperty.setReadOnly(true);
     addProperty(_gpuStreamBudgetProperty);
+
+    // Add eviction statistics, used to tune the node eviction while streaming.
+    _nEvictedNodes.setReadOnly(true);
+    addProperty(_nEvictedNodes);
+    _nRefetchedNodes.setReadOnly(true);
+    addProperty(_nRefetchedNodes);
 }
 
 bool RenderableGaiaStars::isReady() const {
@@ -1171,12 +1193,16 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
 
         // Update CPU Budget property.
         _cpuRamBudgetProperty = static_cast<float>(_octreeManager.cpuRamBudget());
+
+        // Update eviction statistics.
+        _nEvictedNodes = static_cast<int>(_octreeManager.numEvictedNodes());
+        _nRefetchedNodes = static_cast<int>(_octreeManager.numRefetchedNodes());
     }
 
-    // Traverse Octree and build a map with new nodes to render, uses mvp matrix to decide
+    // Traverse Octree and stage the chunks that changed, uses mvp matrix to decide
     const int renderOption = _renderOption;
     int deltaStars = 0;
-    std::map<int, std::vector<float>> updateData = _octreeManager.traverseData(
+    const OctreeManager::StagingArena& updateData = _octreeManager.traverseData(
         modelViewProjMat,
         screenSize,
         deltaStars,
@@ -1209,8 +1235,9 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
         _accumulatedIndices.resize(nChunksToRender + 1, lastValue);
 
         // Update vector with accumulated indices.
-        for (const auto& [offset, subData] : updateData) {
-            int newValue = static_cast<int>(subData.size() / _nRenderValuesPerStar) +
+        for (const OctreeManager::StagingArena::Chunk& chunk : updateData.dirtyChunks) {
+            const int offset = chunk.bufferIndex;
+            int newValue = static_cast<int>(chunk.size / _nRenderValuesPerStar) +
                            _accumulatedIndices[offset];
             int changeInValue = newValue - _accumulatedIndices[offset + 1];
             _accumulatedIndices[offset + 1] = newValue;
@@ -1247,16 +1274,16 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
         );
 
         // Update SSBO with one insert per chunk/node.
-        // The key in map holds the offset index.
-        for (const auto &[offset, subData] : updateData) {
+        // The buffer index of the chunk holds the offset index.
+        for (const OctreeManager::StagingArena::Chunk& chunk : updateData.dirtyChunks) {
             // We don't need to fill chunk with zeros for SSBOs!
             // Just check if we have any values to update.
-            if (!subData.empty()) {
+            if (chunk.size > 0) {
                 glBufferSubData(
                     GL_SHADER_STORAGE_BUFFER,
-                    offset * _chunkSize * sizeof(GLfloat),
-                    subData.size() * sizeof(GLfloat),
-                    subData.data()
+                    chunk.bufferIndex * _chunkSize * sizeof(GLfloat),
+                    chunk.size * sizeof(GLfloat),
+                    updateData.chunkData(chunk)
                 );
             }
         }
@@ -1286,19 +1313,23 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
             GL_STREAM_DRAW
         );
 
+        // Removed chunks are overwritten with zeroes so we overwrite possible earlier
+        // values. Added chunks are already filled up with zeroes in octree fetch.
+        if (_zeroChunk.size() < _chunkSize) {
+            _zeroChunk.resize(_chunkSize, 0.f);
+        }
+
         // Update buffer with one insert per chunk/node.
-        //The key in map holds the offset index.
-        for (const auto& [offset, subData] : updateData) {
-            // Fill chunk by appending zeroes so we overwrite possible earlier values.
-            // Only required when removing nodes because chunks are filled up in octree
-            // fetch on add.
-            std::vector<float> vectorData(subData.begin(), subData.end());
-            vectorData.resize(posChunkSize, 0.f);
+        // The buffer index of the chunk holds the offset index.
+        for (const OctreeManager::StagingArena::Chunk& chunk : updateData.dirtyChunks) {
+            const float* chunkData = chunk.size > 0 ?
+                updateData.chunkData(chunk) :
+                _zeroChunk.data();
             glBufferSubData(
                 GL_ARRAY_BUFFER,
-                offset * posChunkSize * sizeof(GLfloat),
+                chunk.bufferIndex * posChunkSize * sizeof(GLfloat),
                 posChunkSize * sizeof(GLfloat),
-                vectorData.data()
+                chunkData
             );
         }
 
@@ -1320,16 +1351,17 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
             );
 
             // Update buffer with one insert per chunk/node.
-            //The key in map holds the offset index.
-            for (const auto& [offset, subData] : updateData) {
-                // Fill chunk by appending zeroes so we overwrite possible earlier values.
-                std::vector<float> vectorData(subData.begin(), subData.end());
-                vectorData.resize(posChunkSize + colChunkSize, 0.f);
+            // The buffer index of the chunk holds the offset index.
+            for (const OctreeManager::StagingArena::Chunk& chunk : updateData.dirtyChunks)
+            {
+                const float* chunkData = chunk.size > 0 ?
+                    updateData.chunkData(chunk) + posChunkSize :
+                    _zeroChunk.data();
                 glBufferSubData(
                     GL_ARRAY_BUFFER,
-                    offset * colChunkSize * sizeof(GLfloat),
+                    chunk.bufferIndex * colChunkSize * sizeof(GLfloat),
                     colChunkSize * sizeof(GLfloat),
-                    vectorData.data() + posChunkSize
+                    chunkData
                 );
             }
 
@@ -1352,16 +1384,18 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
                 );
 
                 // Update buffer with one insert per chunk/node.
-                //The key in map holds the offset index.
-                for (const auto& [offset, subData] : updateData) {
-                    // Fill chunk by appending zeroes.
-                    std::vector<float> vectorData(subData.begin(), subData.end());
-                    vectorData.resize(_chunkSize, 0.f);
+                // The buffer index of the chunk holds the offset index.
+                for (const OctreeManager::StagingArena::Chunk& chunk :
+                     updateData.dirtyChunks)
+                {
+                    const float* chunkData = chunk.size > 0 ?
+                        updateData.chunkData(chunk) + posChunkSize + colChunkSize :
+                        _zeroChunk.data();
                     glBufferSubData(
                         GL_ARRAY_BUFFER,
-                        offset * velChunkSize * sizeof(GLfloat),
+                        chunk.bufferIndex * velChunkSize * sizeof(GLfloat),
                         velChunkSize * sizeof(GLfloat),
-                        vectorData.data() + posChunkSize + colChunkSize
+                        chunkData
                     );
                 }
             }
@@ -161,6 +161,8 @@ private:
     // LongLongProperty doesn't show up in menu, use FloatProperty instead.
     properties::FloatProperty _cpuRamBudgetProperty;
     properties::FloatProperty _gpuStreamBudgetProperty;
+    properties::IntProperty _nEvictedNodes;
+    properties::IntProperty _nRefetchedNodes;
     properties::FloatProperty _maxGpuMemoryPercent;
     properties::FloatProperty _maxCpuMemoryPercent;
 
@@ -188,6 +190,8 @@ private:
         ghoul::opengl::bufferbinding::Buffer::ShaderStorage>> _ssboDataBinding;
 
     std::vector<int> _accumulatedIndices;
+    // Uploaded in place of chunks that have been removed from the VBOs.
+    std::vector<float> _zeroChunk;
     size_t _nRenderValuesPerStar = 0;
     int _nStarsToRender = 0;
     bool _firstDrawCalls = true;
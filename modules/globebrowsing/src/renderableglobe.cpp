@@ -47,6 +47,7 @@
 #include <ghoul/opengl/textureunit.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <algorithm>
 #include <numeric>
 #include <queue>
 
@@ -768,6 +769,15 @@ bool RenderableGlobe::isReady() const {
     return true;
 }
 
+float RenderableGlobe::cullingSphere() const {
+    // The rings extend far beyond the ellipsoid and are drawn by the globe, so they would
+    // be culled together with the planet otherwise
+    if (_hasRings && _ringsComponent.isEnabled()) {
+        return std::max(boundingSphere(), _ringsComponent.size());
+    }
+    return boundingSphere();
+}
+
 void RenderableGlobe::render(const RenderData& data, RendererTasks& rendererTask) {
     const double distanceToCamera = distance(
         data.camera.positionVec3(),
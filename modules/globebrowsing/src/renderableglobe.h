@@ -101,6 +101,7 @@ public:
     void deinitialize() override;
     void deinitializeGL() override;
     bool isReady() const override;
+    float cullingSphere() const override;
 
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     void update(const UpdateData& data) override;
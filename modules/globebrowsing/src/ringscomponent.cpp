@@ -202,7 +202,6 @@ void RingsComponent::initialize() {
     addProperty(_enabled);
 
     _size = static_cast<float>(_ringsDictionary.value<double>(SizeInfo.identifier));
-    //setBoundingSphere(_size);
     _size.onChange([&]() { _planeIsDirty = true; });
     addProperty(_size);
 
@@ -500,4 +499,8 @@ bool RingsComponent::isEnabled() const {
     return _enabled;
 }
 
+float RingsComponent::size() const {
+    return _size;
+}
+
 } // namespace openspace
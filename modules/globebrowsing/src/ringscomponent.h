@@ -74,6 +74,9 @@ public:
 
     bool isEnabled() const;
 
+    /// Returns the outer radius of the rings in model space
+    float size() const;
+
 private:
     void loadTexture();
     void createPlane();
@@ -93,6 +93,26 @@ void executeScript(const std::string& id, const std::string& value,
     }
 }
 
+// Regular properties are set through the binary property queue of the script engine,
+// which avoids a roundtrip through Lua; groups still need the Lua function to resolve
+// the tag
+template <typename T>
+void executeScript(const std::string& id, const T& value, const std::string& luaValue,
+                   IsRegularProperty isRegular)
+{
+    if (isRegular) {
+        global::scriptEngine.queuePropertyValue(
+            id,
+            value,
+            luaValue,
+            scripting::ScriptEngine::RemoteScripting::Yes
+        );
+    }
+    else {
+        executeScriptGroup(id, luaValue);
+    }
+}
+
 void renderBoolProperty(Property* prop, const std::string& ownerName,
                         IsRegularProperty isRegular, ShowToolTip showTooltip,
                         double tooltipDelay)
@@ -110,7 +130,12 @@ void renderBoolProperty(Property* prop, const std::string& ownerName,
     }
 
     if (value != p->value()) {
-        executeScript(p->fullyQualifiedIdentifier(), value ? "true" : "false", isRegular);
+        executeScript(
+            p->fullyQualifiedIdentifier(),
+            value,
+            value ? "true" : "false",
+            isRegular
+        );
     }
     ImGui::PopID();
 }
@@ -172,7 +197,12 @@ void renderOptionProperty(Property* prop, const std::string& ownerName,
     }
     }
     if (value != p->value() && !isReadOnly) {
-        executeScript(p->fullyQualifiedIdentifier(), std::to_string(value), isRegular);
+        executeScript(
+            p->fullyQualifiedIdentifier(),
+            value,
+            std::to_string(value),
+            isRegular
+        );
     }
     ImGui::PopID();
 }
@@ -214,7 +244,12 @@ void renderSelectionProperty(Property* prop, const std::string& ownerName,
                 parameters += std::to_string(i) + ",";
             }
             parameters += "}";
-            executeScript(p->fullyQualifiedIdentifier(), parameters, isRegular);
+            executeScript(
+                p->fullyQualifiedIdentifier(),
+                newSelectedIndices,
+                parameters,
+                isRegular
+            );
         }
         ImGui::TreePop();
     }
@@ -252,6 +287,7 @@ void renderStringProperty(Property* prop, const std::string& ownerName,
     if (hasNewValue) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            std::string(buffer),
             "[[" + std::string(buffer) + "]]",
             isRegular
         );
@@ -292,20 +328,18 @@ void renderStringListProperty(Property* prop, const std::string& ownerName,
 
     if (hasNewValue) {
         std::vector<std::string> tokens = ghoul::tokenizeString(std::string(buffer), ',');
+        std::vector<std::string> values;
         std::string script = "{";
         for (std::string& token : tokens) {
             if (!token.empty()) {
                 ghoul::trimWhitespace(token);
                 script += "[[" + token + "]],";
+                values.push_back(token);
             }
         }
         script += "}";
 
-        executeScript(
-            p->fullyQualifiedIdentifier(),
-            std::move(script),
-            isRegular
-        );
+        executeScript(p->fullyQualifiedIdentifier(), values, script, isRegular);
     }
 
     ImGui::PopID();
@@ -337,7 +371,12 @@ void renderDoubleProperty(properties::Property* prop, const std::string& ownerNa
     }
 
     if (changed) {
-        executeScript(p->fullyQualifiedIdentifier(), std::to_string(value), isRegular);
+        executeScript(
+            p->fullyQualifiedIdentifier(),
+            static_cast<double>(value),
+            std::to_string(value),
+            isRegular
+        );
     }
 
     ImGui::PopID();
@@ -362,7 +401,12 @@ void renderIntProperty(Property* prop, const std::string& ownerName,
     }
 
     if (changed) {
-        executeScript(p->fullyQualifiedIdentifier(), std::to_string(value), isRegular);
+        executeScript(
+            p->fullyQualifiedIdentifier(),
+            value,
+            std::to_string(value),
+            isRegular
+        );
     }
 
     ImGui::PopID();
@@ -393,6 +437,7 @@ void renderIVec2Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            value,
             ghoul::to_string(value),
             isRegular
         );
@@ -427,6 +472,7 @@ void renderIVec3Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            value,
             ghoul::to_string(value),
             isRegular
         );
@@ -460,6 +506,7 @@ void renderIVec4Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            value,
             ghoul::to_string(value),
             isRegular
         );
@@ -492,7 +539,12 @@ void renderFloatProperty(Property* prop, const std::string& ownerName,
     }
 
     if (changed) {
-        executeScript(p->fullyQualifiedIdentifier(), std::to_string(value), isRegular);
+        executeScript(
+            p->fullyQualifiedIdentifier(),
+            value,
+            std::to_string(value),
+            isRegular
+        );
     }
 
     ImGui::PopID();
@@ -526,6 +578,7 @@ void renderVec2Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            value,
             ghoul::to_string(value),
             isRegular
         );
@@ -571,6 +624,7 @@ void renderVec3Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            value,
             ghoul::to_string(value),
             isRegular
         );
@@ -616,6 +670,7 @@ void renderVec4Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            value,
             ghoul::to_string(value),
             isRegular
         );
@@ -651,6 +706,7 @@ void renderDVec2Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            glm::dvec2(value),
             ghoul::to_string(value),
             isRegular
         );
@@ -687,6 +743,7 @@ void renderDVec3Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            glm::dvec3(value),
             ghoul::to_string(value),
             isRegular
         );
@@ -723,6 +780,7 @@ void renderDVec4Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            glm::dvec4(value),
             ghoul::to_string(value),
             isRegular
         );
@@ -780,6 +838,7 @@ void renderDMat2Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            glm::dmat2(value),
             ghoul::to_string(value),
             isRegular
         );
@@ -847,6 +906,7 @@ void renderDMat3Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            glm::dmat3(value),
             ghoul::to_string(value),
             isRegular
         );
@@ -924,6 +984,7 @@ void renderDMat4Property(Property* prop, const std::string& ownerName,
     if (changed) {
         executeScript(
             p->fullyQualifiedIdentifier(),
+            glm::dmat4(value),
             ghoul::to_string(value),
             isRegular
         );
@@ -942,7 +1003,18 @@ void renderTriggerProperty(Property* prop, const std::string& ownerName,
 
     bool pressed = ImGui::Button(name.c_str());
     if (pressed) {
-        executeScript(prop->fullyQualifiedIdentifier(), "nil", isRegular);
+        if (isRegular) {
+            // A trigger does not carry a value, so its binary encoding is empty
+            global::scriptEngine.queuePropertySet(
+                prop->fullyQualifiedIdentifier(),
+                "",
+                "nil",
+                scripting::ScriptEngine::RemoteScripting::Yes
+            );
+        }
+        else {
+            executeScriptGroup(prop->fullyQualifiedIdentifier(), "nil");
+        }
     }
     if (showTooltip) {
         renderTooltip(prop, tooltipDelay);
@@ -26,12 +26,15 @@
 
 #include <openspace/json.h>
 #include <openspace/engine/globals.h>
+#include <openspace/properties/property.h>
 #include <openspace/scripting/scriptengine.h>
 #include <openspace/query/query.h>
 #include <openspace/util/timemanager.h>
 #include <openspace/util/time.h>
 #include <ghoul/fmt.h>
+#include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
+#include <type_traits>
 
 namespace {
     constexpr const char* PropertyKey = "property";
@@ -99,6 +102,84 @@ namespace {
             return "nil";
         }
     }
+
+    template <typename T>
+    bool valueFromJson(const nlohmann::json& json, T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            if (!json.is_boolean()) {
+                return false;
+            }
+            value = json.get<bool>();
+        }
+        else if constexpr (std::is_arithmetic_v<T>) {
+            if (!json.is_number()) {
+                return false;
+            }
+            value = static_cast<T>(json.get<double>());
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            if (!json.is_string()) {
+                return false;
+            }
+            value = json.get<std::string>();
+        }
+        else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+            if (!json.is_array()) {
+                return false;
+            }
+            value.clear();
+            for (const nlohmann::json& v : json) {
+                if (!v.is_string()) {
+                    return false;
+                }
+                value.push_back(v.get<std::string>());
+            }
+        }
+        else {
+            // glm vector types
+            if (!json.is_array() || json.size() != static_cast<size_t>(T::length())) {
+                return false;
+            }
+            for (glm::length_t i = 0; i < T::length(); ++i) {
+                if (!json[i].is_number()) {
+                    return false;
+                }
+                value[i] = static_cast<typename T::value_type>(json[i].get<double>());
+            }
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool queueBinaryValueOfType(const openspace::properties::Property& prop,
+                                const std::string& uri, const nlohmann::json& value,
+                                const std::string& literal)
+    {
+        if (prop.type() != typeid(T)) {
+            return false;
+        }
+        T v;
+        if (!valueFromJson(value, v)) {
+            return false;
+        }
+        openspace::global::scriptEngine.queuePropertyValue(
+            uri,
+            v,
+            literal,
+            openspace::scripting::ScriptEngine::RemoteScripting::Yes
+        );
+        return true;
+    }
+
+    // Queues a binary property set if the property's type is among the types that can be
+    // created directly from a JSON value. Returns false if a script has to be used
+    template <typename... Ts>
+    bool queueBinaryValue(const openspace::properties::Property& prop,
+                          const std::string& uri, const nlohmann::json& value,
+                          const std::string& literal)
+    {
+        return (queueBinaryValueOfType<Ts>(prop, uri, value, literal) || ...);
+    }
 } // namespace
 
 namespace openspace {
@@ -116,12 +197,24 @@ void SetPropertyTopic::handleJson(const nlohmann::json& json) {
             nlohmann::json value = json.at(ValueKey);
             std::string literal = luaLiteralFromJson(value);
 
-            global::scriptEngine.queueScript(
-                fmt::format(
-                    "openspace.setPropertyValueSingle(\"{}\", {})", propertyKey, literal
-                ),
-                 scripting::ScriptEngine::RemoteScripting::Yes
-             );
+            properties::Property* prop = property(propertyKey);
+            const bool isQueued = prop && queueBinaryValue<
+                bool, int, float, double, std::string, std::vector<std::string>,
+                glm::vec2, glm::vec3, glm::vec4, glm::dvec2, glm::dvec3, glm::dvec4,
+                glm::ivec2, glm::ivec3, glm::ivec4
+            >(*prop, propertyKey, value, literal);
+
+            if (!isQueued) {
+                // Property types that cannot be created from JSON directly, or values
+                // that do not match the type, are handled by the Lua function
+                global::scriptEngine.queueScript(
+                    fmt::format(
+                        "openspace.setPropertyValueSingle(\"{}\", {})",
+                        propertyKey, literal
+                    ),
+                    scripting::ScriptEngine::RemoteScripting::Yes
+                );
+            }
         }
     }
     catch (const std::out_of_range& e) {
@@ -83,7 +83,12 @@ void SubscriptionTopic::handleJson(const nlohmann::json& json) {
                 _connection->sendJson(wrappedPayload(_prop));
             };
 
-            _onChangeHandle = _prop->onChange(onChange);
+            // Interpolations and GUI sliders can change the value many times per frame,
+            // but the client only needs to know the latest value
+            _onChangeHandle = _prop->onChange(
+                onChange,
+                properties::Property::DeferNotification::Yes
+            );
             _onDeleteHandle = _prop->onDelete([this]() {
                 _onChangeHandle = UnsetCallbackHandle;
                 _onDeleteHandle = UnsetCallbackHandle;
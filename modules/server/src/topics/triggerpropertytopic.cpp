@@ -42,10 +42,11 @@ namespace openspace {
 void TriggerPropertyTopic::handleJson(const nlohmann::json& json) {
     try {
         const std::string& propertyKey = json.at(PropertyKey).get<std::string>();
-        global::scriptEngine.queueScript(
-            fmt::format(
-                "openspace.setPropertyValueSingle(\"{}\", nil)", propertyKey
-            ),
+        // A trigger does not carry a value, so its binary encoding is empty
+        global::scriptEngine.queuePropertySet(
+            propertyKey,
+            "",
+            "nil",
             scripting::ScriptEngine::RemoteScripting::Yes
         );
     }
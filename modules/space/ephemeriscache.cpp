@@ -0,0 +1,574 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/space/ephemeriscache.h>
+
+#include <openspace/util/hash.h>
+#include <openspace/util/threadpool.h>
+#include <ghoul/filesystem/cachemanager.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+
+namespace {
+    constexpr const char* _loggerCat = "EphemerisCache";
+
+    constexpr const int8_t CurrentCacheVersion = 1;
+
+    constexpr const int Degree = 12;
+    constexpr const int NCoefficients = Degree + 1;
+
+    // The largest number of components of a cached value (a 3x3 matrix)
+    constexpr const int MaxComponents = 9;
+
+    // A segment is split into at most 2^MaxDepth pieces before it is given up on
+    constexpr const int MaxDepth = 8;
+
+    // The segments are never shorter than a day and the number of segments is limited
+    // so that the table of a cache with a long coverage stays small
+    constexpr const double MinSegmentLength = 24.0 * 60.0 * 60.0;
+    constexpr const size_t MaxSegments = 16384;
+
+    // If none of the loaded kernels restricts the time range, as is the case for frames
+    // that are defined by text kernels, the range from 1900 to 2100 is cached
+    constexpr const double DefaultBegin = -100.0 * 365.25 * 24.0 * 60.0 * 60.0;
+    constexpr const double DefaultEnd = 100.0 * 365.25 * 24.0 * 60.0 * 60.0;
+
+    // Caches that are currently in use, so that nodes using the same quantity share the
+    // fitted segments
+    std::mutex CacheMutex;
+    std::map<std::string, std::weak_ptr<openspace::EphemerisCache>> Caches;
+
+    // Evaluates the Chebyshev series with the coefficients \p c at \p u in [-1, 1]
+    double chebyshev(const double* c, double u) {
+        double b1 = 0.0;
+        double b2 = 0.0;
+        for (int i = Degree; i >= 1; --i) {
+            const double b0 = 2.0 * u * b1 - b2 + c[i];
+            b2 = b1;
+            b1 = b0;
+        }
+        return u * b1 - b2 + c[0];
+    }
+
+    // The Chebyshev nodes of the first kind, at which the fitted function is sampled
+    double chebyshevNode(int k) {
+        return std::cos(glm::pi<double>() * (k + 0.5) / NCoefficients);
+    }
+
+    // The extrema of the Chebyshev polynomial of degree NCoefficients, at which the
+    // interpolation error is largest, including both ends of the interval
+    double chebyshevExtremum(int k) {
+        return std::cos(glm::pi<double>() * k / NCoefficients);
+    }
+
+    std::pair<double, double> hull(const std::vector<std::pair<double, double>>& ivs) {
+        std::pair<double, double> result = {
+            std::numeric_limits<double>::max(),
+            -std::numeric_limits<double>::max()
+        };
+        for (const std::pair<double, double>& interval : ivs) {
+            result.first = std::min(result.first, interval.first);
+            result.second = std::max(result.second, interval.second);
+        }
+        return result;
+    }
+
+    // A hash of the paths, sizes, and modification times of all loaded kernels, so that
+    // a kernel that is replaced by a newer version with the same size invalidates the
+    // cache as well. The hash is part of a persistent file name, so it has to be stable
+    // between launches, which std::hash is not guaranteed to be
+    std::string kernelHash() {
+        std::vector<std::string> kernels = openspace::SpiceManager::ref().loadedKernels();
+        std::sort(kernels.begin(), kernels.end());
+
+        std::string description;
+        for (const std::string& kernel : kernels) {
+            std::error_code ec;
+            const uintmax_t size = std::filesystem::file_size(kernel, ec);
+            const auto modified = std::filesystem::last_write_time(kernel, ec);
+            description += fmt::format(
+                "{}:{}:{};", kernel, size, modified.time_since_epoch().count()
+            );
+        }
+        return fmt::format("{:016x}", openspace::hashFNV1a(description));
+    }
+} // namespace
+
+namespace openspace {
+
+const EphemerisCache::Segment EphemerisCache::PendingSegment;
+
+std::shared_ptr<EphemerisCache> EphemerisCache::positionCache(
+                                                                const std::string& target,
+                                                              const std::string& observer,
+                                                                 const std::string& frame,
+                                                                         double tolerance)
+{
+    return sharedCache(Type::Position, { target, observer, frame }, tolerance);
+}
+
+std::shared_ptr<EphemerisCache> EphemerisCache::rotationCache(
+                                                           const std::string& sourceFrame,
+                                                      const std::string& destinationFrame,
+                                                                         double tolerance)
+{
+    return sharedCache(Type::Rotation, { sourceFrame, destinationFrame }, tolerance);
+}
+
+std::shared_ptr<EphemerisCache> EphemerisCache::sharedCache(Type type,
+                                                           std::vector<std::string> names,
+                                                                         double tolerance)
+{
+    ghoul_assert(tolerance > 0.0, "Tolerance must be positive");
+
+    std::string key = type == Type::Position ? "Position" : "Rotation";
+    for (const std::string& name : names) {
+        key += '|' + name;
+    }
+    key += fmt::format("|{}", tolerance);
+
+    std::lock_guard<std::mutex> lock(CacheMutex);
+    auto it = Caches.find(key);
+    if (it != Caches.end()) {
+        if (std::shared_ptr<EphemerisCache> cache = it->second.lock()) {
+            return cache;
+        }
+    }
+
+    std::shared_ptr<EphemerisCache> cache(
+        new EphemerisCache(type, std::move(names), tolerance, key)
+    );
+    Caches[key] = cache;
+    return cache;
+}
+
+EphemerisCache::EphemerisCache(Type type, std::vector<std::string> names,
+                               double tolerance, std::string identifier)
+    : _type(type)
+    , _names(std::move(names))
+    , _tolerance(tolerance)
+    , _identifier(std::move(identifier))
+    , _nComponents(type == Type::Position ? 3 : 9)
+{}
+
+EphemerisCache::~EphemerisCache() {
+    // Wait for the segment that is currently being fitted and drop all others
+    _fitPool = nullptr;
+
+    if (!_tables.empty()) {
+        saveTable(*_tables.back());
+    }
+}
+
+bool EphemerisCache::position(double ephemerisTime, glm::dvec3& result) {
+    ghoul_assert(_type == Type::Position, "Cache does not store positions");
+    return evaluate(ephemerisTime, glm::value_ptr(result));
+}
+
+bool EphemerisCache::rotation(double ephemerisTime, glm::dmat3& result) {
+    ghoul_assert(_type == Type::Rotation, "Cache does not store rotations");
+    return evaluate(ephemerisTime, glm::value_ptr(result));
+}
+
+bool EphemerisCache::evaluate(double ephemerisTime, double* values) {
+    Table& table = currentTable();
+
+    const double x = (ephemerisTime - table.begin) / table.segmentLength;
+    // The negated comparison also rejects NaN and tables without segments
+    if (!(x >= 0.0 && x < static_cast<double>(table.nSegments))) {
+        return false;
+    }
+
+    const size_t index = static_cast<size_t>(x);
+    const Segment* segment = table.segments[index].load(std::memory_order_acquire);
+    if (!segment) {
+        // Only the first thread that misses the segment schedules it to be fitted; all
+        // lookups fall back to the SpiceManager until the fitted segment is published
+        if (table.segments[index].compare_exchange_strong(segment, &PendingSegment)) {
+            scheduleFit(table, index);
+        }
+        return false;
+    }
+    if (segment == &PendingSegment || segment->nPieces == 0) {
+        return false;
+    }
+
+    const double local = (x - static_cast<double>(index)) * segment->nPieces;
+    const uint32_t piece = std::min(static_cast<uint32_t>(local), segment->nPieces - 1);
+    const double u = 2.0 * (local - piece) - 1.0;
+
+    const size_t offset = static_cast<size_t>(piece) * _nComponents * NCoefficients;
+    const double* c = segment->coefficients.data() + offset;
+    for (int i = 0; i < _nComponents; ++i) {
+        values[i] = chebyshev(c + i * NCoefficients, u);
+    }
+    return true;
+}
+
+EphemerisCache::Table& EphemerisCache::currentTable() {
+    const unsigned int generation = SpiceManager::ref().kernelGeneration();
+
+    Table* table = _table.load(std::memory_order_acquire);
+    if (!table || table->kernelGeneration != generation) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // Another thread might have replaced the table while we were waiting
+        table = _table.load(std::memory_order_acquire);
+        if (!table || table->kernelGeneration != generation) {
+            createTable();
+            table = _table.load(std::memory_order_acquire);
+        }
+    }
+    return *table;
+}
+
+void EphemerisCache::createTable() {
+    if (!_tables.empty()) {
+        saveTable(*_tables.back());
+    }
+
+    auto table = std::make_unique<Table>();
+    table->kernelGeneration = SpiceManager::ref().kernelGeneration();
+
+    std::pair<double, double> range = { DefaultBegin, DefaultEnd };
+    try {
+        std::vector<std::vector<std::pair<double, double>>> coverages;
+        if (_type == Type::Position) {
+            table->query = SpiceManager::ref().positionQuery(
+                _names[0],
+                _names[1],
+                _names[2]
+            );
+            coverages.push_back(SpiceManager::ref().spkCoverage(_names[0]));
+            coverages.push_back(SpiceManager::ref().spkCoverage(_names[1]));
+        }
+        else {
+            coverages.push_back(SpiceManager::ref().ckCoverage(_names[0]));
+            coverages.push_back(SpiceManager::ref().ckCoverage(_names[1]));
+        }
+
+        // The cached range is the intersection of the coverage of all objects that
+        // appear in binary kernels
+        bool isRestricted = false;
+        for (const std::vector<std::pair<double, double>>& coverage : coverages) {
+            if (coverage.empty()) {
+                continue;
+            }
+            const std::pair<double, double> h = hull(coverage);
+            range.first = isRestricted ? std::max(range.first, h.first) : h.first;
+            range.second = isRestricted ? std::min(range.second, h.second) : h.second;
+            isRestricted = true;
+        }
+    }
+    catch (const SpiceManager::SpiceException& e) {
+        // The names are not known (yet), so nothing is cached until the next kernel is
+        // loaded and the values are computed by the SpiceManager
+        LDEBUG(fmt::format("Not caching '{}': {}", _identifier, e.message));
+        range = { 0.0, 0.0 };
+    }
+
+    if (range.second > range.first) {
+        const double length = range.second - range.first;
+        table->begin = range.first;
+        table->segmentLength = std::max(length / MaxSegments, MinSegmentLength);
+        table->nSegments = static_cast<size_t>(
+            std::ceil(length / table->segmentLength)
+        );
+        table->segments = std::make_unique<std::atomic<const Segment*>[]>(
+            table->nSegments
+        );
+        for (size_t i = 0; i < table->nSegments; ++i) {
+            table->segments[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        table->cacheFile = FileSys.cacheManager()->cachedFilename(
+            "ephemeris",
+            _identifier + '|' + kernelHash(),
+            ghoul::filesystem::CacheManager::Persistent::Yes
+        );
+        if (FileSys.fileExists(table->cacheFile)) {
+            loadTable(*table);
+        }
+    }
+    else {
+        table->segmentLength = 1.0;
+    }
+
+    // Previous tables are kept alive as other threads might still be reading them
+    _tables.push_back(std::move(table));
+    _table.store(_tables.back().get(), std::memory_order_release);
+}
+
+void EphemerisCache::scheduleFit(Table& table, size_t index) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_fitPool) {
+        _fitPool = std::make_unique<ThreadPool>(1);
+    }
+    // The tables are only destroyed together with the cache, which first stops the pool
+    _fitPool->enqueue([this, &table, index]() { fitSegment(table, index); });
+}
+
+void EphemerisCache::fitSegment(Table& table, size_t index) {
+    if (table.kernelGeneration != SpiceManager::ref().kernelGeneration()) {
+        // The kernels have changed since the segment was scheduled, so the table is no
+        // longer used and the segment is left pending
+        return;
+    }
+
+    const double begin = table.begin + index * table.segmentLength;
+    auto segment = std::make_unique<Segment>();
+    try {
+        bool success = false;
+        for (int depth = std::max(_depthHint - 1, 0); depth <= MaxDepth; ++depth) {
+            success = fitPieces(table, begin, depth, *segment);
+            if (success) {
+                _depthHint = depth;
+                break;
+            }
+        }
+        if (!success) {
+            _depthHint = MaxDepth;
+        }
+    }
+    catch (const SpiceManager::SpiceException&) {
+        // Leave the error reporting to the SpiceManager call that replaces the cache
+    }
+
+    if (segment->nPieces == 0) {
+        segment->coefficients.clear();
+    }
+
+    // The segment is fitted without the lock so that a kernel change does not have to
+    // wait for it, but it is published with it as the table might be saved concurrently
+    std::lock_guard<std::mutex> lock(_mutex);
+    const Segment* result = segment.get();
+    table.fittedSegments.push_back(std::move(segment));
+    table.hasChanged = true;
+    table.segments[index].store(result, std::memory_order_release);
+}
+
+bool EphemerisCache::fitPieces(const Table& table, double begin, int depth,
+                               Segment& segment) const
+{
+    // Each piece is sampled at the Chebyshev nodes, followed by the points at which the
+    // fit is checked against SPICE
+    constexpr const int NSamples = 2 * NCoefficients + 1;
+
+    const uint32_t nPieces = 1u << depth;
+    const double length = table.segmentLength / nPieces;
+    const int stride = _nComponents * NCoefficients;
+    segment.coefficients.resize(static_cast<size_t>(nPieces) * stride);
+
+    std::array<double, MaxComponents * NSamples> samples;
+    for (uint32_t p = 0; p < nPieces; ++p) {
+        const double start = begin + p * length;
+        double* coefficients = segment.coefficients.data() + p * stride;
+
+        std::vector<SpiceExecutor::Request> requests;
+        requests.reserve(NSamples);
+        for (int k = 0; k < NCoefficients; ++k) {
+            const double t = start + 0.5 * length * (chebyshevNode(k) + 1.0);
+            requests.push_back(request(table, t));
+        }
+        for (int k = 0; k <= NCoefficients; ++k) {
+            const double t = start + 0.5 * length * (chebyshevExtremum(k) + 1.0);
+            requests.push_back(request(table, t));
+        }
+        const std::vector<SpiceExecutor::Result> results =
+            SpiceManager::ref().executor().execute(std::move(requests));
+        for (int k = 0; k < NSamples; ++k) {
+            value(results[k], samples.data() + k * _nComponents);
+        }
+
+        for (int i = 0; i < _nComponents; ++i) {
+            for (int j = 0; j < NCoefficients; ++j) {
+                double sum = 0.0;
+                for (int k = 0; k < NCoefficients; ++k) {
+                    const double angle =
+                        glm::pi<double>() * j * (k + 0.5) / NCoefficients;
+                    sum += samples[k * _nComponents + i] * std::cos(angle);
+                }
+                coefficients[i * NCoefficients + j] = (j == 0 ? 1.0 : 2.0) * sum /
+                                                      NCoefficients;
+            }
+        }
+
+        for (int k = 0; k <= NCoefficients; ++k) {
+            const double u = chebyshevExtremum(k);
+            const double* values = samples.data() + (NCoefficients + k) * _nComponents;
+            for (int i = 0; i < _nComponents; ++i) {
+                const double* c = coefficients + i * NCoefficients;
+                if (std::abs(chebyshev(c, u) - values[i]) > _tolerance) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    segment.nPieces = nPieces;
+    return true;
+}
+
+SpiceExecutor::Request EphemerisCache::request(const Table& table,
+                                               double ephemerisTime) const
+{
+    if (_type == Type::Position) {
+        SpiceExecutor::PositionRequest r;
+        r.query = &*table.query;
+        r.time = ephemerisTime;
+        return r;
+    }
+    else {
+        SpiceExecutor::TransformMatrixRequest r;
+        r.from = _names[0];
+        r.to = _names[1];
+        r.time = ephemerisTime;
+        r.estimateUncovered = true;
+        return r;
+    }
+}
+
+void EphemerisCache::value(const SpiceExecutor::Result& result, double* values) const {
+    if (_type == Type::Position) {
+        const glm::dvec3& p = result.get<SpiceExecutor::PositionResult>().position;
+        std::copy(glm::value_ptr(p), glm::value_ptr(p) + 3, values);
+    }
+    else {
+        const glm::dmat3& m = result.get<glm::dmat3>();
+        std::copy(glm::value_ptr(m), glm::value_ptr(m) + 9, values);
+    }
+}
+
+bool EphemerisCache::loadTable(Table& table) {
+    std::ifstream fileStream(table.cacheFile, std::ifstream::binary);
+    if (!fileStream.good()) {
+        LERROR(fmt::format(
+            "Error opening file '{}' for loading cache file", table.cacheFile
+        ));
+        return false;
+    }
+
+    int8_t version = 0;
+    fileStream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+    if (version != CurrentCacheVersion) {
+        LINFO("The format of the cached file has changed: deleting old cache");
+        fileStream.close();
+        FileSys.deleteFile(table.cacheFile);
+        return false;
+    }
+
+    double begin = 0.0;
+    fileStream.read(reinterpret_cast<char*>(&begin), sizeof(double));
+    double segmentLength = 0.0;
+    fileStream.read(reinterpret_cast<char*>(&segmentLength), sizeof(double));
+    uint64_t nSegments = 0;
+    fileStream.read(reinterpret_cast<char*>(&nSegments), sizeof(uint64_t));
+    if (begin != table.begin || segmentLength != table.segmentLength ||
+        nSegments != table.nSegments)
+    {
+        // The file is overwritten with the new layout when the table is saved
+        return false;
+    }
+
+    uint64_t nFitted = 0;
+    fileStream.read(reinterpret_cast<char*>(&nFitted), sizeof(uint64_t));
+    const size_t stride = static_cast<size_t>(_nComponents) * NCoefficients;
+    for (uint64_t i = 0; i < nFitted && fileStream.good(); ++i) {
+        uint64_t index = 0;
+        fileStream.read(reinterpret_cast<char*>(&index), sizeof(uint64_t));
+        auto segment = std::make_unique<Segment>();
+        fileStream.read(reinterpret_cast<char*>(&segment->nPieces), sizeof(uint32_t));
+        if (index >= table.nSegments || segment->nPieces > (1u << MaxDepth)) {
+            LERROR(fmt::format("Cache file '{}' is corrupted", table.cacheFile));
+            return false;
+        }
+        segment->coefficients.resize(segment->nPieces * stride);
+        fileStream.read(
+            reinterpret_cast<char*>(segment->coefficients.data()),
+            segment->coefficients.size() * sizeof(double)
+        );
+        if (!fileStream.good()) {
+            break;
+        }
+        table.segments[index].store(segment.get(), std::memory_order_relaxed);
+        table.fittedSegments.push_back(std::move(segment));
+    }
+
+    return fileStream.good();
+}
+
+void EphemerisCache::saveTable(const Table& table) const {
+    if (!table.hasChanged) {
+        return;
+    }
+
+    std::ofstream fileStream(table.cacheFile, std::ofstream::binary);
+    if (!fileStream.good()) {
+        LERROR(fmt::format(
+            "Error opening file '{}' for save cache file", table.cacheFile
+        ));
+        return;
+    }
+
+    fileStream.write(
+        reinterpret_cast<const char*>(&CurrentCacheVersion),
+        sizeof(int8_t)
+    );
+    fileStream.write(reinterpret_cast<const char*>(&table.begin), sizeof(double));
+    fileStream.write(
+        reinterpret_cast<const char*>(&table.segmentLength),
+        sizeof(double)
+    );
+    const uint64_t nSegments = table.nSegments;
+    fileStream.write(reinterpret_cast<const char*>(&nSegments), sizeof(uint64_t));
+
+    const uint64_t nFitted = table.fittedSegments.size();
+    fileStream.write(reinterpret_cast<const char*>(&nFitted), sizeof(uint64_t));
+    for (uint64_t index = 0; index < table.nSegments; ++index) {
+        const Segment* segment = table.segments[index].load(std::memory_order_acquire);
+        if (!segment || segment == &PendingSegment) {
+            continue;
+        }
+        fileStream.write(reinterpret_cast<const char*>(&index), sizeof(uint64_t));
+        fileStream.write(
+            reinterpret_cast<const char*>(&segment->nPieces),
+            sizeof(uint32_t)
+        );
+        fileStream.write(
+            reinterpret_cast<const char*>(segment->coefficients.data()),
+            segment->coefficients.size() * sizeof(double)
+        );
+    }
+}
+
+} // namespace openspace
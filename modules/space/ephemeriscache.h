@@ -0,0 +1,173 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SPACE___EPHEMERISCACHE___H__
+#define __OPENSPACE_MODULE_SPACE___EPHEMERISCACHE___H__
+
+#include <openspace/util/spiceexecutor.h>
+#include <ghoul/glm.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+class ThreadPool;
+
+/**
+ * Approximates the position of a target relative to an observer, or the rotation from
+ * one reference frame into another, by piecewise Chebyshev polynomials that are fitted
+ * to the values computed by the SpiceManager. The time range covered by the loaded
+ * kernels is split into segments of equal length. Each segment is fitted on a background
+ * thread when it is first used and is split into 2^n equally long pieces until every
+ * piece matches SPICE within the tolerance. Until the fit is finished, the values in the
+ * segment have to be evaluated through the SpiceManager, so a lookup never waits for a
+ * fit. Looking up a value in a fitted segment needs no locks and no search; segments
+ * that cannot be fitted within the tolerance are marked and have to be evaluated through
+ * the SpiceManager as well.
+ *
+ * Caches for the same quantity are shared and their fitted segments are stored in the
+ * cache directory, keyed by the set of loaded kernels. Whenever a kernel is loaded or
+ * unloaded, the segments are discarded and fitted again.
+ */
+class EphemerisCache {
+public:
+    /**
+     * Returns the cache for the position of the \p target relative to the \p observer
+     * in the reference \p frame, without aberration correction.
+     *
+     * \param target The target body name or the target body's NAIF ID
+     * \param observer The observing body name or the observing body's NAIF ID
+     * \param frame The reference frame of the position
+     * \param tolerance The largest allowed difference to SPICE in km per component
+     */
+    static std::shared_ptr<EphemerisCache> positionCache(const std::string& target,
+        const std::string& observer, const std::string& frame, double tolerance);
+
+    /**
+     * Returns the cache for the rotation matrix from the \p sourceFrame into the
+     * \p destinationFrame as returned by SpiceManager::positionTransformMatrix.
+     *
+     * \param sourceFrame The frame to be converted from
+     * \param destinationFrame The frame to be converted to
+     * \param tolerance The largest allowed difference to SPICE for each matrix element
+     */
+    static std::shared_ptr<EphemerisCache> rotationCache(const std::string& sourceFrame,
+        const std::string& destinationFrame, double tolerance);
+
+    ~EphemerisCache();
+
+    /**
+     * Computes the cached position at the \p ephemerisTime. Returns \c false if the time
+     * lies outside of the cached range or in a segment that could not be fitted or has
+     * not been fitted yet, in which case the position has to be computed by the
+     * SpiceManager.
+     *
+     * \pre This cache must have been created by #positionCache
+     */
+    bool position(double ephemerisTime, glm::dvec3& result);
+
+    /**
+     * Computes the cached rotation matrix at the \p ephemerisTime. Returns \c false if
+     * the time lies outside of the cached range or in a segment that could not be
+     * fitted or has not been fitted yet, in which case the matrix has to be computed by
+     * the SpiceManager.
+     *
+     * \pre This cache must have been created by #rotationCache
+     */
+    bool rotation(double ephemerisTime, glm::dmat3& result);
+
+private:
+    enum class Type { Position, Rotation };
+
+    /// The fitted polynomials for one segment of the time range
+    struct Segment {
+        /// The number of equally long pieces; 0 if the segment could not be fitted
+        uint32_t nPieces = 0;
+        /// The Chebyshev coefficients of each component for each piece
+        std::vector<double> coefficients;
+    };
+
+    /// The segments that were fitted for one state of the kernel pool
+    struct Table {
+        unsigned int kernelGeneration = 0;
+        std::string cacheFile;
+        double begin = 0.0;
+        double segmentLength = 0.0;
+        size_t nSegments = 0;
+        /// Null for each segment that has not been fitted yet and PendingSegment for each
+        /// segment that is scheduled to be fitted
+        std::unique_ptr<std::atomic<const Segment*>[]> segments;
+        std::vector<std::unique_ptr<Segment>> fittedSegments;
+        std::optional<SpiceManager::PositionQuery> query;
+        bool hasChanged = false;
+    };
+
+    EphemerisCache(Type type, std::vector<std::string> names, double tolerance,
+        std::string identifier);
+
+    static std::shared_ptr<EphemerisCache> sharedCache(Type type,
+        std::vector<std::string> names, double tolerance);
+
+    bool evaluate(double ephemerisTime, double* values);
+    Table& currentTable();
+    void createTable();
+    void scheduleFit(Table& table, size_t index);
+    void fitSegment(Table& table, size_t index);
+    bool fitPieces(const Table& table, double begin, int depth, Segment& segment) const;
+    SpiceExecutor::Request request(const Table& table, double ephemerisTime) const;
+    void value(const SpiceExecutor::Result& result, double* values) const;
+
+    bool loadTable(Table& table);
+    void saveTable(const Table& table) const;
+
+    const Type _type;
+    const std::vector<std::string> _names;
+    const double _tolerance;
+    /// Identifies the cached quantity and tolerance in log messages and the cache file
+    const std::string _identifier;
+    const int _nComponents;
+
+    std::atomic<Table*> _table = { nullptr };
+    /// The current table and all tables it replaced, which might still be in use
+    std::vector<std::unique_ptr<Table>> _tables;
+    /// Guards the publishing of fitted segments and the replacement of tables
+    std::mutex _mutex;
+    /// The depth at which the last segment could be fitted, to skip shallower depths.
+    /// Only used by the single thread of the _fitPool
+    int _depthHint = 0;
+    /// Fits the scheduled segments one at a time; created when the first segment is
+    /// scheduled
+    std::unique_ptr<ThreadPool> _fitPool;
+
+    /// Marks the segments that are scheduled to be fitted
+    static const Segment PendingSegment;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SPACE___EPHEMERISCACHE___H__
@@ -0,0 +1,1013 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/space/kepler.h>
+
+#include <ghoul/filesystem/cachemanager.h>
+#include <ghoul/filesystem/file.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <tuple>
+
+namespace {
+    constexpr const char* _loggerCat = "Kepler";
+
+    constexpr const int8_t CurrentCacheVersion = 1;
+
+    // Below this number of entries per thread, a file is parsed on fewer threads
+    constexpr const size_t MinEntriesPerThread = 2048;
+
+    // The list of leap years only goes until 2056 as we need to touch this file then
+    // again anyway ;)
+    const std::vector<int> LeapYears = {
+        1956, 1960, 1964, 1968, 1972, 1976, 1980, 1984, 1988, 1992, 1996,
+        2000, 2004, 2008, 2012, 2016, 2020, 2024, 2028, 2032, 2036, 2040,
+        2044, 2048, 2052, 2056
+    };
+
+    // Catalogs that are currently in use, so that consumers of the same file share the
+    // parsed elements. The key is the type of the catalog and the path of the file
+    std::mutex CatalogMutex;
+    std::map<std::string, std::weak_ptr<const openspace::kepler::Elements>> Catalogs;
+
+    // Returns the zero-based number of days between the beginning of the year and the
+    // dayOfMonth of the month (1 - 12). Does NOT account for leap years
+    int daysIntoGivenYear(int month, int dayOfMonth) {
+        constexpr const int DaysOfMonths[] = {
+            31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+        };
+
+        int dayCount = dayOfMonth - 1;
+        for (int m = 0; m < month - 1; ++m) {
+            dayCount += DaysOfMonths[m];
+        }
+        return dayCount;
+    }
+
+    // Parses the value that was read from the (1-based) line of the file
+    double parseValue(const std::string& value, const std::string& filename, size_t line)
+    {
+        const char* begin = value.c_str();
+        char* end = nullptr;
+        const double result = std::strtod(begin, &end);
+        if (end == begin) {
+            throw ghoul::RuntimeError(fmt::format(
+                "File {} @ line {} contains the malformed value '{}'",
+                filename, line, value
+            ));
+        }
+        return result;
+    }
+
+    // Parses the two lines of an element set whose title is on the (1-based) line of
+    // the file
+    openspace::kepler::Parameters parseTleEntry(const std::string& line1,
+                                                const std::string& line2,
+                                                const std::string& filename,
+                                                size_t line)
+    {
+        openspace::kepler::Parameters p;
+
+        if (line1.size() < 32 || line1[0] != '1') {
+            throw ghoul::RuntimeError(fmt::format(
+                "File {} @ line {} does not have '1' header", filename, line + 1
+            ));
+        }
+        // First line
+        // Field Columns   Content
+        //     1   01-01   Line number
+        //     2   03-07   Satellite number
+        //     3   08-08   Classification (U = Unclassified)
+        //     4   10-11   International Designator (Last two digits of launch year)
+        //     5   12-14   International Designator (Launch number of the year)
+        //     6   15-17   International Designator(piece of the launch)    A
+        //     7   19-20   Epoch Year(last two digits of year)
+        //     8   21-32   Epoch(day of the year and fractional portion of the day)
+        //     9   34-43   First Time Derivative of the Mean Motion divided by two
+        //    10   45-52   Second Time Derivative of Mean Motion divided by six
+        //    11   54-61   BSTAR drag term(decimal point assumed)[10] - 11606 - 4
+        //    12   63-63   The "Ephemeris type"
+        //    13   65-68   Element set  number.Incremented when a new TLE is generated
+        //    14   69-69   Checksum (modulo 10)
+        p.epoch = openspace::kepler::epochFromSubstring(line1.substr(18, 14));
+
+        if (line2.size() < 63 || line2[0] != '2') {
+            throw ghoul::RuntimeError(fmt::format(
+                "File {} @ line {} does not have '2' header", filename, line + 2
+            ));
+        }
+        // Second line
+        // Field    Columns   Content
+        //     1      01-01   Line number
+        //     2      03-07   Satellite number
+        //     3      09-16   Inclination (degrees)
+        //     4      18-25   Right ascension of the ascending node (degrees)
+        //     5      27-33   Eccentricity (decimal point assumed)
+        //     6      35-42   Argument of perigee (degrees)
+        //     7      44-51   Mean Anomaly (degrees)
+        //     8      53-63   Mean Motion (revolutions per day)
+        //     9      64-68   Revolution number at epoch (revolutions)
+        //    10      69-69   Checksum (modulo 10)
+        p.inclination = parseValue(line2.substr(8, 8), filename, line + 2);
+        p.ascendingNode = parseValue(line2.substr(17, 8), filename, line + 2);
+        p.eccentricity = parseValue("0." + line2.substr(26, 7), filename, line + 2);
+        p.argumentOfPeriapsis = parseValue(line2.substr(34, 8), filename, line + 2);
+        p.meanAnomaly = parseValue(line2.substr(43, 8), filename, line + 2);
+        p.meanMotion = parseValue(line2.substr(52, 11), filename, line + 2);
+
+        // Calculate the semi major axis based on the mean motion using kepler's laws
+        p.semiMajorAxis = openspace::kepler::calculateSemiMajorAxis(p.meanMotion);
+
+        // Converting the mean motion (revolutions per day) to period (seconds per
+        // revolution)
+        using namespace std::chrono;
+        p.period = seconds(hours(24)).count() / p.meanMotion;
+        return p;
+    }
+
+    // The extent of a line in a file's content, without the line ending
+    struct Line {
+        size_t begin;
+        size_t length;
+    };
+
+    // Reads the whole file into content and returns the extents of all of its lines,
+    // ignoring trailing empty lines
+    std::vector<Line> readLines(const std::string& filename, std::string& content) {
+        std::ifstream file(filename, std::ifstream::binary);
+        if (!file.good()) {
+            throw ghoul::RuntimeError(fmt::format("Error opening file {}", filename));
+        }
+        file.seekg(0, std::ifstream::end);
+        content = std::string(static_cast<size_t>(file.tellg()), '\0');
+        file.seekg(0, std::ifstream::beg);
+        file.read(content.data(), content.size());
+        file.close();
+
+        std::vector<Line> lines;
+        size_t begin = 0;
+        while (begin < content.size()) {
+            size_t end = content.find('\n', begin);
+            if (end == std::string::npos) {
+                end = content.size();
+            }
+            size_t length = end - begin;
+            if (length > 0 && content[begin + length - 1] == '\r') {
+                --length;
+            }
+            lines.push_back({ begin, length });
+            begin = end + 1;
+        }
+        while (!lines.empty() && lines.back().length == 0) {
+            lines.pop_back();
+        }
+        return lines;
+    }
+
+    // Calls parseEntry for the indices [0, nEntries) in blocks on all available hardware
+    // threads and returns the results in order. If parseEntry throws, the exception of
+    // the earliest block is rethrown
+    std::vector<openspace::kepler::Parameters> parseEntries(size_t nEntries,
+               const std::function<openspace::kepler::Parameters(size_t)>& parseEntry)
+    {
+        std::vector<openspace::kepler::Parameters> entries(nEntries);
+
+        auto parseRange = [&](size_t first, size_t last, std::exception_ptr& error) {
+            try {
+                for (size_t i = first; i < last; ++i) {
+                    entries[i] = parseEntry(i);
+                }
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        };
+
+        const size_t nHardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        const size_t nThreads = std::max<size_t>(
+            std::min(nHardwareThreads, nEntries / MinEntriesPerThread),
+            1
+        );
+        const size_t entriesPerThread = (nEntries + nThreads - 1) / nThreads;
+
+        std::vector<std::exception_ptr> errors(nThreads);
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < nThreads; ++t) {
+            const size_t first = std::min(t * entriesPerThread, nEntries);
+            const size_t last = std::min(first + entriesPerThread, nEntries);
+            threads.emplace_back(parseRange, first, last, std::ref(errors[t]));
+        }
+        parseRange(0, std::min(entriesPerThread, nEntries), errors[0]);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        // Report the error of the earliest block to match a sequential read
+        for (const std::exception_ptr& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        return entries;
+    }
+
+    openspace::kepler::Elements parseTleFile(const std::string& filename) {
+        std::string content;
+        const std::vector<Line> lines = readLines(filename, content);
+
+        // 3 because a TLE has 3 lines per element/ object. Malformed entries are
+        // skipped. They are marked with a period of 0 as the entries are parsed
+        // concurrently
+        const size_t nEntries = lines.size() / 3;
+        const std::vector<openspace::kepler::Parameters> entries = parseEntries(
+            nEntries,
+            [&](size_t i) {
+                // The first line of each entry is the title and is ignored
+                const Line& l1 = lines[3 * i + 1];
+                const Line& l2 = lines[3 * i + 2];
+                try {
+                    return parseTleEntry(
+                        content.substr(l1.begin, l1.length),
+                        content.substr(l2.begin, l2.length),
+                        filename,
+                        3 * i + 1
+                    );
+                }
+                catch (const ghoul::RuntimeError&) {
+                    return openspace::kepler::Parameters();
+                }
+            }
+        );
+
+        openspace::kepler::Elements elements;
+        elements.reserve(nEntries);
+        size_t nSkipped = 0;
+        for (const openspace::kepler::Parameters& p : entries) {
+            if (p.period > 0.0) {
+                elements.push_back(p);
+            }
+            else {
+                ++nSkipped;
+            }
+        }
+        if (nSkipped > 0) {
+            LWARNING(fmt::format(
+                "Skipped {} of {} entries in {} that are malformed",
+                nSkipped, nEntries, filename
+            ));
+        }
+        return elements;
+    }
+
+    double importAngleValue(const std::string& angle, const std::string& filename,
+                            size_t line)
+    {
+        double output = parseValue(angle, filename, line);
+        output = std::fmod(output, 360.0);
+        if (output < 0.0) {
+            output += 360.0;
+        }
+        return output;
+    }
+
+    // Parses a line of the form full_name,epoch_cal,e,a,i,om,w,ma,per. The values are
+    // read from the end of the line, as the name might contain commas itself
+    openspace::kepler::Parameters parseSbdbEntry(std::string_view line,
+                                                 const std::string& filename,
+                                                 size_t entry)
+    {
+        constexpr const double AuToKm = 1.496e8;
+        constexpr const double DaysToSeconds = 86400.0;
+
+        std::array<std::string, 8> fields;
+        for (int i = static_cast<int>(fields.size()) - 1; i >= 0; --i) {
+            const size_t comma = line.rfind(',');
+            if (comma == std::string_view::npos) {
+                throw ghoul::RuntimeError(fmt::format(
+                    "File {} @ line {} has too few fields", filename, entry + 2
+                ));
+            }
+            fields[i] = std::string(line.substr(comma + 1));
+            line = line.substr(0, comma);
+        }
+
+        openspace::kepler::Parameters p;
+        p.epoch = openspace::kepler::epochFromYMDdSubstring(fields[0]);
+        p.eccentricity = parseValue(fields[1], filename, entry + 2);
+        p.semiMajorAxis = parseValue(fields[2], filename, entry + 2) * AuToKm;
+        p.inclination = importAngleValue(fields[3], filename, entry + 2);
+        p.ascendingNode = importAngleValue(fields[4], filename, entry + 2);
+        p.argumentOfPeriapsis = importAngleValue(fields[5], filename, entry + 2);
+        p.meanAnomaly = importAngleValue(fields[6], filename, entry + 2);
+        p.period = parseValue(fields[7], filename, entry + 2) * DaysToSeconds;
+        p.meanMotion = DaysToSeconds / p.period;
+        return p;
+    }
+
+    openspace::kepler::Elements parseSbdbFile(const std::string& filename) {
+        constexpr const char* ExpectedHeader = "full_name,epoch_cal,e,a,i,om,w,ma,per";
+
+        std::string content;
+        const std::vector<Line> lines = readLines(filename, content);
+        if (lines.empty() ||
+            content.compare(lines[0].begin, lines[0].length, ExpectedHeader) != 0)
+        {
+            throw ghoul::RuntimeError(fmt::format(
+                "File {} does not have the appropriate JPL SBDB header at line 1",
+                filename
+            ));
+        }
+
+        // Malformed entries and orbits that are not closed are skipped. They are marked
+        // with a period of 0 as the entries are parsed concurrently
+        const size_t nEntries = lines.size() - 1;
+        const std::vector<openspace::kepler::Parameters> entries = parseEntries(
+            nEntries,
+            [&](size_t i) {
+                const Line& l = lines[i + 1];
+                try {
+                    openspace::kepler::Parameters p = parseSbdbEntry(
+                        std::string_view(content).substr(l.begin, l.length),
+                        filename,
+                        i
+                    );
+                    if (p.eccentricity < 0.0 || p.eccentricity >= 1.0 ||
+                        !(p.period > 0.0))
+                    {
+                        p.period = 0.0;
+                    }
+                    return p;
+                }
+                catch (const std::exception&) {
+                    return openspace::kepler::Parameters();
+                }
+            }
+        );
+
+        openspace::kepler::Elements elements;
+        elements.reserve(nEntries);
+        size_t nSkipped = 0;
+        for (const openspace::kepler::Parameters& p : entries) {
+            if (p.period > 0.0) {
+                elements.push_back(p);
+            }
+            else {
+                ++nSkipped;
+            }
+        }
+        if (nSkipped > 0) {
+            LWARNING(fmt::format(
+                "Skipped {} of {} entries in {} that are malformed or describe no "
+                "closed orbit", nSkipped, nEntries, filename
+            ));
+        }
+        return elements;
+    }
+
+    // The members of Elements in the order in which they are stored in the cache file
+    using Column = std::vector<double> openspace::kepler::Elements::*;
+    constexpr const std::array<Column, 9> CacheColumns = {
+        &openspace::kepler::Elements::inclination,
+        &openspace::kepler::Elements::semiMajorAxis,
+        &openspace::kepler::Elements::ascendingNode,
+        &openspace::kepler::Elements::eccentricity,
+        &openspace::kepler::Elements::argumentOfPeriapsis,
+        &openspace::kepler::Elements::meanAnomaly,
+        &openspace::kepler::Elements::meanMotion,
+        &openspace::kepler::Elements::epoch,
+        &openspace::kepler::Elements::period
+    };
+
+    bool loadCachedCatalog(const std::string& file, openspace::kepler::Elements& elements)
+    {
+        std::ifstream fileStream(file, std::ifstream::binary);
+        if (!fileStream.good()) {
+            LERROR(fmt::format("Error opening file '{}' for loading cache file", file));
+            return false;
+        }
+
+        int8_t version = 0;
+        fileStream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+        if (version != CurrentCacheVersion) {
+            LINFO("The format of the cached file has changed: deleting old cache");
+            fileStream.close();
+            FileSys.deleteFile(file);
+            return false;
+        }
+
+        uint64_t nEntries = 0;
+        fileStream.read(reinterpret_cast<char*>(&nEntries), sizeof(uint64_t));
+        for (Column column : CacheColumns) {
+            std::vector<double>& values = elements.*column;
+            values.resize(nEntries);
+            fileStream.read(
+                reinterpret_cast<char*>(values.data()),
+                nEntries * sizeof(double)
+            );
+        }
+
+        return fileStream.good();
+    }
+
+    bool saveCachedCatalog(const std::string& file,
+                           const openspace::kepler::Elements& elements)
+    {
+        std::ofstream fileStream(file, std::ofstream::binary);
+        if (!fileStream.good()) {
+            LERROR(fmt::format("Error opening file '{}' for save cache file", file));
+            return false;
+        }
+
+        fileStream.write(
+            reinterpret_cast<const char*>(&CurrentCacheVersion),
+            sizeof(int8_t)
+        );
+        const uint64_t nEntries = elements.size();
+        fileStream.write(reinterpret_cast<const char*>(&nEntries), sizeof(uint64_t));
+        for (Column column : CacheColumns) {
+            const std::vector<double>& values = elements.*column;
+            fileStream.write(
+                reinterpret_cast<const char*>(values.data()),
+                nEntries * sizeof(double)
+            );
+        }
+
+        return fileStream.good();
+    }
+
+    using Catalog = std::shared_ptr<const openspace::kepler::Elements>;
+    using Parser = openspace::kepler::Elements(*)(const std::string&);
+
+    // Returns the elements in filename, parsed by parse, and shares them with all other
+    // callers that requested the same file while it is still in use. The parsed elements
+    // are stored in a persistent cache file that is identified by the type
+    Catalog readCatalog(const std::string& filename, const char* type, Parser parse) {
+        if (!FileSys.fileExists(filename)) {
+            throw ghoul::RuntimeError(fmt::format("File {} does not exist", filename));
+        }
+
+        const std::string path = absPath(filename);
+        const std::string key = std::string(type) + '|' + path;
+
+        // The lock is held while loading so that concurrent requests for the same file
+        // only parse it once
+        std::lock_guard<std::mutex> lock(CatalogMutex);
+        auto it = Catalogs.find(key);
+        if (it != Catalogs.end()) {
+            if (Catalog catalog = it->second.lock()) {
+                return catalog;
+            }
+        }
+
+        const std::string cachedFile = FileSys.cacheManager()->cachedFilename(
+            ghoul::filesystem::File(path),
+            type,
+            ghoul::filesystem::CacheManager::Persistent::Yes
+        );
+
+        auto catalog = std::make_shared<openspace::kepler::Elements>();
+        bool hasCache = false;
+        if (FileSys.fileExists(cachedFile)) {
+            LDEBUG(fmt::format("Cached file '{}' used for file '{}'", cachedFile, path));
+            hasCache = loadCachedCatalog(cachedFile, *catalog);
+            // Otherwise, the cache file is overwritten below
+        }
+
+        if (!hasCache) {
+            LDEBUG(fmt::format("Loading file '{}'", path));
+            *catalog = parse(path);
+            saveCachedCatalog(cachedFile, *catalog);
+        }
+
+        Catalogs[key] = catalog;
+        return catalog;
+    }
+
+    // Below this number of orbits per thread, the overhead of starting a thread is
+    // larger than the time it takes to compute the orbits
+    constexpr const size_t MinOrbitsPerThread = 256;
+
+    // The number of Newton iterations that are necessary to converge to double precision
+    // from the starting guess used in computeEccentricAnomalies for the worst-case mean
+    // anomaly in each eccentricity range
+    int numberOfIterations(double eccentricity) {
+        if (eccentricity < 0.2) {
+            return 5;
+        }
+        else if (eccentricity < 0.9) {
+            return 8;
+        }
+        else {
+            return 12;
+        }
+    }
+
+    void computeOrbitRange(const openspace::kepler::Elements& elements,
+                           unsigned int nSegments, size_t begin, size_t end,
+                           const openspace::kepler::OrbitCallback& writeOrbit)
+    {
+        const size_t nSamples = static_cast<size_t>(nSegments) + 1;
+
+        // Per-thread scratch space that is reused for all orbits in the range
+        std::vector<double> meanAnomalies(nSamples);
+        std::vector<double> eccentricAnomalies(nSamples);
+        std::vector<glm::dvec3> positions(nSamples);
+
+        for (size_t i = begin; i < end; ++i) {
+            const double e = elements.eccentricity[i];
+            const double period = elements.period[i];
+            const double meanMotion = glm::two_pi<double>() / period;
+            const double meanAnomalyAtEpoch = glm::radians(elements.meanAnomaly[i]);
+
+            for (size_t j = 0; j < nSamples; ++j) {
+                const double t = period * static_cast<double>(j) /
+                                 static_cast<double>(nSegments);
+                meanAnomalies[j] = meanAnomalyAtEpoch + t * meanMotion;
+            }
+
+            openspace::kepler::computeEccentricAnomalies(
+                e,
+                meanAnomalies.data(),
+                eccentricAnomalies.data(),
+                nSamples
+            );
+
+            // The columns of the rotation from the orbit plane into the reference frame,
+            // which is a rotation around the z axis by the ascending node, the x axis by
+            // the inclination and the z axis by the argument of periapsis, scaled by the
+            // semi-major and semi-minor axis respectively
+            const double asc = glm::radians(elements.ascendingNode[i]);
+            const double inc = glm::radians(elements.inclination[i]);
+            const double per = glm::radians(elements.argumentOfPeriapsis[i]);
+            const double cosAsc = std::cos(asc);
+            const double sinAsc = std::sin(asc);
+            const double cosInc = std::cos(inc);
+            const double sinInc = std::sin(inc);
+            const double cosPer = std::cos(per);
+            const double sinPer = std::sin(per);
+
+            const double a = elements.semiMajorAxis[i] * 1000.0;
+            const double b = a * std::sqrt(1.0 - e * e);
+            const glm::dvec3 majorAxis = a * glm::dvec3(
+                cosAsc * cosPer - sinAsc * sinPer * cosInc,
+                sinAsc * cosPer + cosAsc * sinPer * cosInc,
+                sinPer * sinInc
+            );
+            const glm::dvec3 minorAxis = b * glm::dvec3(
+                -cosAsc * sinPer - sinAsc * cosPer * cosInc,
+                -sinAsc * sinPer + cosAsc * cosPer * cosInc,
+                cosPer * sinInc
+            );
+
+            for (size_t j = 0; j < nSamples; ++j) {
+                const double x = std::cos(eccentricAnomalies[j]) - e;
+                const double y = std::sin(eccentricAnomalies[j]);
+                positions[j] = x * majorAxis + y * minorAxis;
+            }
+
+            writeOrbit(i, positions.data());
+        }
+    }
+} // namespace
+
+namespace openspace::kepler {
+
+void Elements::push_back(const Parameters& parameters) {
+    inclination.push_back(parameters.inclination);
+    semiMajorAxis.push_back(parameters.semiMajorAxis);
+    ascendingNode.push_back(parameters.ascendingNode);
+    eccentricity.push_back(parameters.eccentricity);
+    argumentOfPeriapsis.push_back(parameters.argumentOfPeriapsis);
+    meanAnomaly.push_back(parameters.meanAnomaly);
+    meanMotion.push_back(parameters.meanMotion);
+    epoch.push_back(parameters.epoch);
+    period.push_back(parameters.period);
+}
+
+void Elements::reserve(size_t n) {
+    inclination.reserve(n);
+    semiMajorAxis.reserve(n);
+    ascendingNode.reserve(n);
+    eccentricity.reserve(n);
+    argumentOfPeriapsis.reserve(n);
+    meanAnomaly.reserve(n);
+    meanMotion.reserve(n);
+    epoch.reserve(n);
+    period.reserve(n);
+}
+
+void Elements::clear() {
+    inclination.clear();
+    semiMajorAxis.clear();
+    ascendingNode.clear();
+    eccentricity.clear();
+    argumentOfPeriapsis.clear();
+    meanAnomaly.clear();
+    meanMotion.clear();
+    epoch.clear();
+    period.clear();
+}
+
+size_t Elements::size() const {
+    return eccentricity.size();
+}
+
+bool Elements::empty() const {
+    return eccentricity.empty();
+}
+
+Parameters Elements::at(size_t i) const {
+    ghoul_assert(i < size(), "Index out of range");
+
+    Parameters p;
+    p.inclination = inclination[i];
+    p.semiMajorAxis = semiMajorAxis[i];
+    p.ascendingNode = ascendingNode[i];
+    p.eccentricity = eccentricity[i];
+    p.argumentOfPeriapsis = argumentOfPeriapsis[i];
+    p.meanAnomaly = meanAnomaly[i];
+    p.meanMotion = meanMotion[i];
+    p.epoch = epoch[i];
+    p.period = period[i];
+    return p;
+}
+
+int countDays(int year) {
+    // Find the position of the current year in the vector, the difference
+    // between its position and the position of 2000 (for J2000) gives the
+    // number of leap years
+    constexpr const int Epoch = 2000;
+    constexpr const int DaysRegularYear = 365;
+    constexpr const int DaysLeapYear = 366;
+
+    if (year == Epoch) {
+        return 0;
+    }
+
+    // Get the position of the most recent leap year
+    const auto lb = std::lower_bound(LeapYears.begin(), LeapYears.end(), year);
+
+    // Get the position of the epoch
+    const auto y2000 = std::find(LeapYears.begin(), LeapYears.end(), Epoch);
+
+    // The distance between the two iterators gives us the number of leap years
+    const int nLeapYears = static_cast<int>(std::abs(std::distance(y2000, lb)));
+
+    const int nYears = std::abs(year - Epoch);
+    const int nRegularYears = nYears - nLeapYears;
+
+    // Get the total number of days as the sum of leap years + non leap years
+    const int result = nRegularYears * DaysRegularYear + nLeapYears * DaysLeapYear;
+    return result;
+}
+
+int countLeapSeconds(int year, int dayOfYear) {
+    // Find the position of the current year in the vector; its position in
+    // the vector gives the number of leap seconds
+    struct LeapSecond {
+        int year;
+        int dayOfYear;
+        bool operator<(const LeapSecond& rhs) const {
+            return std::tie(year, dayOfYear) < std::tie(rhs.year, rhs.dayOfYear);
+        }
+    };
+
+    const LeapSecond Epoch = { 2000, 1 };
+
+    // List taken from: https://www.ietf.org/timezones/data/leap-seconds.list
+    static const std::vector<LeapSecond> LeapSeconds = {
+        { 1972,   1 },
+        { 1972, 183 },
+        { 1973,   1 },
+        { 1974,   1 },
+        { 1975,   1 },
+        { 1976,   1 },
+        { 1977,   1 },
+        { 1978,   1 },
+        { 1979,   1 },
+        { 1980,   1 },
+        { 1981, 182 },
+        { 1982, 182 },
+        { 1983, 182 },
+        { 1985, 182 },
+        { 1988,   1 },
+        { 1990,   1 },
+        { 1991,   1 },
+        { 1992, 183 },
+        { 1993, 182 },
+        { 1994, 182 },
+        { 1996,   1 },
+        { 1997, 182 },
+        { 1999,   1 },
+        { 2006,   1 },
+        { 2009,   1 },
+        { 2012, 183 },
+        { 2015, 182 },
+        { 2017,   1 }
+    };
+
+    // Get the position of the last leap second before the desired date
+    LeapSecond date { year, dayOfYear };
+    const auto it = std::lower_bound(LeapSeconds.begin(), LeapSeconds.end(), date);
+
+    // Get the position of the Epoch
+    const auto y2000 = std::lower_bound(
+        LeapSeconds.begin(),
+        LeapSeconds.end(),
+        Epoch
+    );
+
+    // The distance between the two iterators gives us the number of leap years
+    const int nLeapSeconds = static_cast<int>(std::abs(std::distance(y2000, it)));
+    return nLeapSeconds;
+}
+
+bool isLeapYear(int year) {
+    return std::binary_search(LeapYears.begin(), LeapYears.end(), year);
+}
+
+double calculateSemiMajorAxis(double meanMotion) {
+    constexpr const double GravitationalConstant = 6.6740831e-11;
+    constexpr const double MassEarth = 5.9721986e24;
+    constexpr const double muEarth = GravitationalConstant * MassEarth;
+
+    // Use Kepler's 3rd law to calculate semimajor axis
+    // a^3 / P^2 = mu / (2pi)^2
+    // <=> a = ((mu * P^2) / (2pi^2))^(1/3)
+    // with a = semimajor axis
+    // P = period in seconds
+    // mu = G*M_earth
+    double period = std::chrono::seconds(std::chrono::hours(24)).count() / meanMotion;
+
+    const double pisq = glm::pi<double>() * glm::pi<double>();
+    double semiMajorAxis = pow((muEarth * period*period) / (4 * pisq), 1.0 / 3.0);
+
+    // We need the semi major axis in km instead of m
+    return semiMajorAxis / 1000.0;
+}
+
+double epochFromSubstring(const std::string& epochString) {
+    // The epochString is in the form:
+    // YYDDD.DDDDDDDD
+    // With YY being the last two years of the launch epoch, the first DDD the day
+    // of the year and the remaning a fractional part of the day
+
+    // The main overview of this function:
+    // 1. Reconstruct the full year from the YY part
+    // 2. Calculate the number of seconds since the beginning of the year
+    // 2.a Get the number of full days since the beginning of the year
+    // 2.b If the year is a leap year, modify the number of days
+    // 3. Convert the number of days to a number of seconds
+    // 4. Get the number of leap seconds since January 1st, 2000 and remove them
+    // 5. Adjust for the fact the epoch starts on 1st Januaray at 12:00:00, not
+    // midnight
+
+    // According to https://celestrak.com/columns/v04n03/
+    // Apparently, US Space Command sees no need to change the two-line element
+    // set format yet since no artificial earth satellites existed prior to 1957.
+    // By their reasoning, two-digit years from 57-99 correspond to 1957-1999 and
+    // those from 00-56 correspond to 2000-2056. We'll see each other again in 2057!
+
+    // 1. Get the full year
+    std::string yearPrefix = [y = epochString.substr(0, 2)](){
+        int year = std::atoi(y.c_str());
+        return year >= 57 ? "19" : "20";
+    }();
+    const int year = std::atoi((yearPrefix + epochString.substr(0, 2)).c_str());
+    const int daysSince2000 = countDays(year);
+
+    // 2.
+    // 2.a
+    double daysInYear = std::atof(epochString.substr(2).c_str());
+
+    // 2.b
+    if (isLeapYear(year) && daysInYear >= 60) {
+        // We are in a leap year, so we have an effective day more if we are
+        // beyond the end of february (= 31+29 days)
+        --daysInYear;
+    }
+
+    // 3
+    using namespace std::chrono;
+    const int SecondsPerDay = static_cast<int>(seconds(hours(24)).count());
+    //Need to subtract 1 from daysInYear since it is not a zero-based count
+    const double nSecondsSince2000 = (daysSince2000 + daysInYear - 1) * SecondsPerDay;
+
+    // 4
+    // We need to remove additional leap seconds past 2000 and add them prior to
+    // 2000 to sync up the time zones
+    const double nLeapSecondsOffset = -countLeapSeconds(
+        year,
+        static_cast<int>(std::floor(daysInYear))
+    );
+
+    // 5
+    const double nSecondsEpochOffset = static_cast<double>(
+        seconds(hours(12)).count()
+    );
+
+    // Combine all of the values
+    const double epoch = nSecondsSince2000 + nLeapSecondsOffset - nSecondsEpochOffset;
+    return epoch;
+}
+
+double epochFromYMDdSubstring(const std::string& epochString) {
+    // The epochString is in the form:
+    // YYYYMMDD.ddddddd
+    // With YYYY as the year, MM the month (1 - 12), DD the day of month (1-31),
+    // and dddd the fraction of that day.
+
+    // The main overview of this function:
+    // 1. Read the year value
+    // 2. Calculate the number of seconds since the beginning of the year
+    // 2.a Get the number of full days since the beginning of the year
+    // 2.b If the year is a leap year, modify the number of days
+    // 3. Convert the number of days to a number of seconds
+    // 4. Get the number of leap seconds since January 1st, 2000 and remove them
+    // 5. Adjust for the fact the epoch starts on 1st January at 12:00:00, not
+    // midnight
+
+    // 1
+    int year = std::atoi(epochString.substr(0, 4).c_str());
+    const int daysSince2000 = countDays(year);
+
+    // 2.
+    // 2.a
+    int monthNum = std::atoi(epochString.substr(4, 2).c_str());
+    int dayOfMonthNum = std::atoi(epochString.substr(6, 2).c_str());
+    int wholeDaysInto = daysIntoGivenYear(monthNum, dayOfMonthNum);
+    // The fraction includes the decimal point
+    double fractionOfDay = std::atof(epochString.substr(8).c_str());
+    double daysInYear = static_cast<double>(wholeDaysInto) + fractionOfDay;
+
+    // 2.b
+    if (isLeapYear(year) && daysInYear >= 60) {
+        // We are in a leap year, so we have an effective day more if we are
+        // beyond the end of february (= 31+29 days)
+        --daysInYear;
+    }
+
+    // 3
+    using namespace std::chrono;
+    const int SecondsPerDay = static_cast<int>(seconds(hours(24)).count());
+    //Need to subtract 1 from daysInYear since it is not a zero-based count
+    const double nSecondsSince2000 = (daysSince2000 + daysInYear - 1) * SecondsPerDay;
+
+    // 4
+    // We need to remove additional leap seconds past 2000 and add them prior to
+    // 2000 to sync up the time zones
+    const double nLeapSecondsOffset = -countLeapSeconds(
+        year,
+        static_cast<int>(std::floor(daysInYear))
+    );
+
+    // 5
+    const double nSecondsEpochOffset = static_cast<double>(
+        seconds(hours(12)).count()
+    );
+
+    // Combine all of the values
+    const double epoch = nSecondsSince2000 + nLeapSecondsOffset - nSecondsEpochOffset;
+    return epoch;
+}
+
+std::shared_ptr<const Elements> readTleFile(const std::string& filename) {
+    return readCatalog(filename, "TLECatalog", parseTleFile);
+}
+
+Parameters readTleEntry(const std::string& filename, int lineNumber) {
+    if (!FileSys.fileExists(filename)) {
+        throw ghoul::RuntimeError(fmt::format("File {} does not exist", filename));
+    }
+
+    std::string content;
+    const std::vector<Line> lines = readLines(filename, content);
+    if (lineNumber < 1 || static_cast<size_t>(lineNumber) + 2 > lines.size()) {
+        throw ghoul::RuntimeError(fmt::format(
+            "File {} @ line {} does not contain a TLE entry", filename, lineNumber
+        ));
+    }
+
+    // The title is on the line with the lineNumber and is ignored
+    const Line& l1 = lines[lineNumber];
+    const Line& l2 = lines[lineNumber + 1];
+    return parseTleEntry(
+        content.substr(l1.begin, l1.length),
+        content.substr(l2.begin, l2.length),
+        filename,
+        lineNumber
+    );
+}
+
+std::shared_ptr<const Elements> readSbdbFile(const std::string& filename) {
+    return readCatalog(filename, "SBDBCatalog", parseSbdbFile);
+}
+
+void computeEccentricAnomalies(double eccentricity, const double* meanAnomalies,
+                               double* eccentricAnomalies, size_t n)
+{
+    ghoul_assert(eccentricity >= 0.0 && eccentricity < 1.0, "Eccentricity out of range");
+
+    const double e = eccentricity;
+    const int nIterations = numberOfIterations(e);
+
+    for (size_t i = 0; i < n; ++i) {
+        // Reduce the mean anomaly to [-pi, pi) so that the starting guess below is valid
+        const double m = meanAnomalies[i] - glm::two_pi<double>() *
+            std::floor((meanAnomalies[i] + glm::pi<double>()) / glm::two_pi<double>());
+
+        // Starting guess by Danby, which lets Newton's method converge for all
+        // eccentricities in [0, 1)
+        double x = m + std::copysign(0.85 * e, m);
+        for (int j = 0; j < nIterations; ++j) {
+            x -= (x - e * std::sin(x) - m) / (1.0 - e * std::cos(x));
+        }
+        eccentricAnomalies[i] = x;
+    }
+}
+
+void computeOrbitPositions(const Elements& elements, unsigned int nSegments,
+                           const OrbitCallback& writeOrbit)
+{
+    ghoul_assert(nSegments > 0, "There must be at least one segment per orbit");
+
+    const size_t nOrbits = elements.size();
+    if (nOrbits == 0) {
+        return;
+    }
+
+    const size_t nHardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    const size_t nThreads = std::min(
+        nHardwareThreads,
+        (nOrbits + MinOrbitsPerThread - 1) / MinOrbitsPerThread
+    );
+    const size_t orbitsPerThread = (nOrbits + nThreads - 1) / nThreads;
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads - 1);
+    for (size_t t = 1; t < nThreads; ++t) {
+        const size_t begin = t * orbitsPerThread;
+        const size_t end = std::min(begin + orbitsPerThread, nOrbits);
+        if (begin >= end) {
+            break;
+        }
+        threads.emplace_back(
+            computeOrbitRange,
+            std::cref(elements),
+            nSegments,
+            begin,
+            end,
+            std::cref(writeOrbit)
+        );
+    }
+
+    // The first range is computed on the calling thread
+    computeOrbitRange(
+        elements,
+        nSegments,
+        0,
+        std::min(orbitsPerThread, nOrbits),
+        writeOrbit
+    );
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace openspace::kepler
@@ -0,0 +1,197 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SPACE___KEPLER___H__
+#define __OPENSPACE_MODULE_SPACE___KEPLER___H__
+
+#include <ghoul/glm.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace openspace::kepler {
+
+/// The Keplerian elements and derived values of a single orbit
+struct Parameters {
+    double inclination = 0.0; // degrees
+    double semiMajorAxis = 0.0; // km
+    double ascendingNode = 0.0; // degrees
+    double eccentricity = 0.0;
+    double argumentOfPeriapsis = 0.0; // degrees
+    double meanAnomaly = 0.0; // degrees at the epoch
+    double meanMotion = 0.0; // revolutions per day
+    double epoch = 0.0; // seconds past the J2000 epoch
+    double period = 0.0; // seconds
+};
+
+/**
+ * The Keplerian elements of a collection of orbits, stored as a structure of arrays so
+ * that a single element can be streamed for many orbits at once. The units of all
+ * members are the same as for the Parameters struct.
+ */
+struct Elements {
+    void push_back(const Parameters& parameters);
+    void reserve(size_t n);
+    void clear();
+
+    size_t size() const;
+    bool empty() const;
+
+    /// Returns the elements of the orbit with the index \p i
+    Parameters at(size_t i) const;
+
+    std::vector<double> inclination;
+    std::vector<double> semiMajorAxis;
+    std::vector<double> ascendingNode;
+    std::vector<double> eccentricity;
+    std::vector<double> argumentOfPeriapsis;
+    std::vector<double> meanAnomaly;
+    std::vector<double> meanMotion;
+    std::vector<double> epoch;
+    std::vector<double> period;
+};
+
+/**
+ * Returns the number of full days between the beginning of the year 2000 and the
+ * beginning of the \p year.
+ */
+int countDays(int year);
+
+/**
+ * Returns the number of leap seconds that lie between the {\p year, \p dayOfYear} time
+ * point and {2000, 1}.
+ */
+int countLeapSeconds(int year, int dayOfYear);
+
+/// Returns whether the \p year is a leap year. Only years in [1956, 2056] are supported
+bool isLeapYear(int year);
+
+/**
+ * Returns the semi-major axis in km of an orbit around Earth that has the \p meanMotion
+ * in revolutions per day.
+ */
+double calculateSemiMajorAxis(double meanMotion);
+
+/**
+ * Converts the epoch of a two-line element of the form <code>YYDDD.DDDDDDDD</code> into
+ * the number of seconds past the J2000 epoch.
+ */
+double epochFromSubstring(const std::string& epochString);
+
+/**
+ * Converts the epoch of the JPL Small-Body Database of the form
+ * <code>YYYYMMDD.DDDDDDD</code> into the number of seconds past the J2000 epoch.
+ */
+double epochFromYMDdSubstring(const std::string& epochString);
+
+/**
+ * Returns the Keplerian elements of all objects in the two-line element file
+ * \p filename. The file consists of groups of three lines, a title line followed by the
+ * two lines of the element set as described by https://celestrak.com/columns/v04n03.
+ * Large files are parsed in parallel in blocks of lines and the result is stored in a
+ * persistent binary cache file, which is used instead of the text file for later loads
+ * as long as the file has not been modified. All callers that request the same file
+ * while a previous result is still in use receive the same object. Entries that do not
+ * follow the two-line element format are skipped with a warning.
+ *
+ * \param filename The path to the two-line element file
+ * \return The Keplerian elements of all valid objects in the order in which they appear
+ *
+ * \throw ghoul::RuntimeError If the file does not exist
+ */
+std::shared_ptr<const Elements> readTleFile(const std::string& filename);
+
+/**
+ * Returns the Keplerian elements of the single object in the two-line element file
+ * \p filename whose title is on the line \p lineNumber. The two lines of the element set
+ * have to directly follow the title line, but the entry does not have to be aligned
+ * with the groups of three lines that readTleFile expects.
+ *
+ * \param filename The path to the two-line element file
+ * \param lineNumber The 1-based line number of the title line of the entry
+ * \return The Keplerian elements of the object
+ *
+ * \throw ghoul::RuntimeError If the file does not exist, or if the entry does not exist
+ *        or does not follow the two-line element format
+ */
+Parameters readTleEntry(const std::string& filename, int lineNumber);
+
+/**
+ * Returns the Keplerian elements of all objects in the JPL Small-Body Database file
+ * \p filename. The file is a CSV file with the header
+ * <code>full_name,epoch_cal,e,a,i,om,w,ma,per</code> and the semi-major axis in AU and
+ * the period in days. The file is parsed, cached, and shared in the same way as in
+ * readTleFile. Entries that are malformed or that do not describe a closed orbit are
+ * skipped with a warning.
+ *
+ * \param filename The path to the small-body database file
+ * \return The Keplerian elements of all valid objects in the order in which they appear
+ *
+ * \throw ghoul::RuntimeError If the file does not exist or does not have the expected
+ *        header
+ */
+std::shared_ptr<const Elements> readSbdbFile(const std::string& filename);
+
+/**
+ * Solves Kepler's equation <code>M = E - e sin(E)</code> for the eccentric anomaly
+ * <code>E</code> of \p n mean anomalies that share the same \p eccentricity. The
+ * number of Newton iterations only depends on the \p eccentricity and the loop body is
+ * free of data-dependent branches, which lets the compiler vectorize it across the mean
+ * anomalies.
+ *
+ * \param eccentricity The eccentricity of the orbit, must be in [0, 1)
+ * \param meanAnomalies The \p n mean anomalies in radians
+ * \param eccentricAnomalies The \p n eccentric anomalies in radians that are computed.
+ *        The values are congruent to the solution of Kepler's equation modulo 2 pi
+ * \param n The number of mean anomalies that are solved for
+ */
+void computeEccentricAnomalies(double eccentricity, const double* meanAnomalies,
+    double* eccentricAnomalies, size_t n);
+
+/// Receives the index of an orbit and the positions that were computed along it
+using OrbitCallback = std::function<void(size_t, const glm::dvec3*)>;
+
+/**
+ * Computes \p nSegments + 1 positions along each orbit in \p elements, spaced evenly in
+ * time over one full period and starting at the orbit's epoch. The positions are the
+ * same as a KeplerTranslation with the same elements would return for those times. The
+ * orbits are distributed over all available hardware threads and \p writeOrbit is called
+ * once for each orbit with the index of the orbit and a pointer to its positions (in
+ * meters). As the \p writeOrbit callback is called concurrently for different orbits, it
+ * must only write to memory that belongs to the orbit it was called for. The positions
+ * are only valid for the duration of the callback.
+ *
+ * \param elements The Keplerian elements of all orbits
+ * \param nSegments The number of segments each orbit is divided into
+ * \param writeOrbit The callback that receives the positions of each orbit
+ *
+ * \pre \p nSegments must be positive
+ */
+void computeOrbitPositions(const Elements& elements, unsigned int nSegments,
+    const OrbitCallback& writeOrbit);
+
+} // namespace openspace::kepler
+
+#endif // __OPENSPACE_MODULE_SPACE___KEPLER___H__
@@ -28,6 +28,7 @@
 #include <openspace/rendering/renderable.h>
 
 #include <modules/base/rendering/renderabletrail.h>
+#include <modules/space/kepler.h>
 #include <modules/space/translation/keplertranslation.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/scalar/uintproperty.h>
@@ -37,16 +38,6 @@
 
 namespace openspace {
 
-const std::vector<int> LeapYears = {
-    1956, 1960, 1964, 1968, 1972, 1976, 1980, 1984, 1988, 1992, 1996,
-    2000, 2004, 2008, 2012, 2016, 2020, 2024, 2028, 2032, 2036, 2040,
-    2044, 2048, 2052, 2056
-};
-int countDays(int year);
-int countLeapSeconds(int year, int dayOfYear);
-double calculateSemiMajorAxis(double meanMotion);
-double epochFromSubstring(const std::string& epochString);
-
 class RenderableSatellites : public Renderable {
 public:
     RenderableSatellites(const ghoul::Dictionary& dictionary);
@@ -58,19 +49,6 @@ public:
     void render(const RenderData& data, RendererTasks& rendererTask) override;
 
     static documentation::Documentation Documentation();
-    /**
-        * Reads the provided TLE file and calls the KeplerTranslation::setKeplerElments
-        * method with the correct values. If \p filename is a valid TLE file but contains
-        * disallowed values (see KeplerTranslation::setKeplerElements), a
-        * KeplerTranslation::RangeError is thrown.
-        *
-        * \param filename The path to the file that contains the TLE file.
-        *
-        * \throw ghoul::RuntimeError if the TLE file does not exist or there is a 
-        *        problem with its format.
-        * \pre The \p filename must exist
-        */
-    void readTLEFile(const std::string& filename);
 
 private:
     struct Vertex {
@@ -79,18 +57,6 @@ private:
         glm::vec2 texcoord = glm::vec2(0.f);
     };
 
-    struct KeplerParameters {
-        double inclination = 0.0;
-        double semiMajorAxis = 0.0;
-        double ascendingNode = 0.0;
-        double eccentricity = 0.0;
-        double argumentOfPeriapsis = 0.0;
-        double meanAnomaly = 0.0;
-        double meanMotion = 0.0;
-        double epoch = 0.0;
-        double period = 0.0;
-    };
-
     /// The layout of the VBOs
     struct TrailVBOLayout {
         float x = 0.f;
@@ -101,8 +67,8 @@ private:
         double period = 0.0;
     };
 
-    KeplerTranslation _keplerTranslator;
-    std::vector<KeplerParameters> _TLEData;
+    /// The elements of all objects in the TLE file, shared with other users of the file
+    std::shared_ptr<const kepler::Elements> _TLEData;
 
     /// The backend storage for the vertex buffer object containing all points for this
     /// trail.
@@ -25,6 +25,7 @@
 #include <modules/space/rendering/renderablesmallbody.h>
 
 #include <modules/space/rendering/renderablesatellites.h>
+#include <modules/space/kepler.h>
 #include <modules/space/translation/keplertranslation.h>
 #include <modules/space/translation/tletranslation.h>
 #include <modules/space/spacemodule.h>
@@ -86,100 +87,6 @@ namespace {
 
 namespace openspace {
 
-const std::vector<int> DaysOfMonths = {
-    31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
-};
-
-enum Months {
-    January = 0,
-    February,
-    March,
-    April,
-    May,
-    June,
-    July,
-    August,
-    September,
-    October,
-    November,
-    December
-};
-
-int daysIntoGivenYear(int month, int dayOfMonth) {
-    //month and dayCount are zero-based. Does NOT account for leap year.
-    month -= 1;
-    int dayCount = dayOfMonth - 1;
-
-    for (int m = Months::January; m < month; ++m) {
-        dayCount += DaysOfMonths[m];
-    }
-    return dayCount;
-}
-
-double epochFromYMDdSubstring(const std::string& epochString) {
-    // The epochString is in the form:
-    // YYYYMMDD.ddddddd
-    // With YYYY as the year, MM the month (1 - 12), DD the day of month (1-31),
-    // and dddd the fraction of that day.
-
-    // The main overview of this function:
-    // 1. Read the year value
-    // 2. Calculate the number of seconds since the beginning of the year
-    // 2.a Get the number of full days since the beginning of the year
-    // 2.b If the year is a leap year, modify the number of days
-    // 3. Convert the number of days to a number of seconds
-    // 4. Get the number of leap seconds since January 1st, 2000 and remove them
-    // 5. Adjust for the fact the epoch starts on 1st January at 12:00:00, not
-    // midnight
-
-    // 1
-    int year = std::atoi(epochString.substr(0, 4).c_str());
-    const int daysSince2000 = countDays(year);
-
-    // 2.
-    // 2.a
-    int monthNum = std::atoi(epochString.substr(4, 2).c_str());
-    int dayOfMonthNum = std::atoi(epochString.substr(6, 2).c_str());
-    int wholeDaysInto = daysIntoGivenYear(monthNum, dayOfMonthNum);
-    double fractionOfDay = std::atof(epochString.substr(9, 7).c_str());
-    double daysInYear = static_cast<double>(wholeDaysInto) + fractionOfDay;
-
-    // 2.b
-    const bool isInLeapYear = std::find(
-        LeapYears.begin(),
-        LeapYears.end(),
-        year
-    ) != LeapYears.end();
-    if (isInLeapYear && daysInYear >= 60) {
-        // We are in a leap year, so we have an effective day more if we are
-        // beyond the end of february (= 31+29 days)
-        --daysInYear;
-    }
-
-    // 3
-    using namespace std::chrono;
-    const int SecondsPerDay = static_cast<int>(seconds(hours(24)).count());
-    //Need to subtract 1 from daysInYear since it is not a zero-based count
-    const double nSecondsSince2000 = (daysSince2000 + daysInYear - 1) * SecondsPerDay;
-
-    // 4
-    // We need to remove additional leap seconds past 2000 and add them prior to
-    // 2000 to sync up the time zones
-    const double nLeapSecondsOffset = -countLeapSeconds(
-        year,
-        static_cast<int>(std::floor(daysInYear))
-    );
-
-    // 5
-    const double nSecondsEpochOffset = static_cast<double>(
-        seconds(hours(12)).count()
-    );
-
-    // Combine all of the values
-    const double epoch = nSecondsSince2000 + nLeapSecondsOffset - nSecondsEpochOffset;
-    return epoch;
-}
-
 documentation::Documentation RenderableSmallBody::Documentation() {
     using namespace documentation;
     return {
@@ -273,152 +180,7 @@ RenderableSmallBody::RenderableSmallBody(const ghoul::Dictionary& dictionary)
    
     
 void RenderableSmallBody::readJplSbDb(const std::string& filename) {
-    if (!FileSys.fileExists(filename)) {
-        throw ghoul::RuntimeError(fmt::format(
-            "JPL SBDB file {} does not exist.", filename
-        ));
-    }
-
-    std::ifstream file;
-    file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    file.open(filename);
-
-    std::streamoff numberOfLines = std::count(std::istreambuf_iterator<char>(file), 
-                                   std::istreambuf_iterator<char>(), '\n' );
-    file.seekg(std::ios_base::beg); // reset iterator to beginning of file
-
-    std::string line;
-    std::string name;
-    std::string field;
-    std::streamoff csvLine = -1;
-    int fieldCount = 0;
-    const std::string expectedHeaderLine =
-        "full_name,epoch_cal,e,a,i,om,w,ma,per";
-
-    try {
-        std::getline(file, line); // get rid of first line (header)
-        numberOfLines -= 1;
-        if (line.compare(expectedHeaderLine) != 0) {
-            LERROR(fmt::format(
-                "File {} does not have the appropriate JPL SBDB header at line 1.",
-                filename
-            ));
-            file.close();
-            return;
-        }
-
-        for (csvLine = 0; csvLine < numberOfLines; csvLine++) {
-            fieldCount = 0;
-            KeplerParameters keplerElements;
-            // Object designator string
-            std::getline(file, name, ',');
-            fieldCount++;
-
-            // Epoch
-            if (!std::getline(file, field, ',')) {
-                throw std::invalid_argument("Unable to read epoch from line"
-                    + std::to_string(csvLine + 1));
-            }
-            keplerElements.epoch = epochFromYMDdSubstring(field);
-            fieldCount++;
-
-            // Eccentricity (unit-less)
-            if (!std::getline(file, field, ',')) {
-                throw std::invalid_argument("Unable to read eccentricity from line"
-                    + std::to_string(csvLine + 1));
-            }
-            keplerElements.eccentricity = std::stod(field);
-            fieldCount++;
-
-            // Semi-major axis (astronomical units - au)
-            if (!std::getline(file, field, ',')) {
-                throw std::invalid_argument("Unable to read semi-major axis from line"
-                    + std::to_string(csvLine + 1));
-            }
-            keplerElements.semiMajorAxis = std::stod(field);
-            keplerElements.semiMajorAxis *= convertAuToKm;
-            fieldCount++;
-
-            // Inclination (degrees)
-            if (!std::getline(file, field, ',')) {
-                throw std::invalid_argument("Unable to read inclination from line"
-                    + std::to_string(csvLine + 1));
-            }
-            keplerElements.inclination = importAngleValue(field);
-            fieldCount++;
-
-            // Longitude of ascending node (degrees)
-            if (!std::getline(file, field, ',')) {
-                throw std::invalid_argument("Unable to read ascending node from line"
-                    + std::to_string(csvLine + 1));
-            }
-            keplerElements.ascendingNode = importAngleValue(field);
-            fieldCount++;
-
-            // Argument of Periapsis (degrees)
-            if (!std::getline(file, field, ',')) {
-                throw std::invalid_argument("Unable to read arg of periapsis from line"
-                    + std::to_string(csvLine + 1));
-            }
-            keplerElements.argumentOfPeriapsis = importAngleValue(field);
-            fieldCount++;
-
-            // Mean Anomaly (degrees)
-            if (!std::getline(file, field, ',')) {
-                throw std::invalid_argument("Unable to read mean anomaly from line"
-                    + std::to_string(csvLine + 1));
-            }
-            keplerElements.meanAnomaly = importAngleValue(field);
-            fieldCount++;
-
-            // Period (days)
-            if (!std::getline(file, field)) {
-                throw std::invalid_argument("Unable to read period from line"
-                    + std::to_string(csvLine + 1));
-            }
-            keplerElements.period = std::stod(field);
-            keplerElements.period *= convertDaysToSecs;
-            fieldCount++;
-
-            _sbData.push_back(keplerElements);
-            _sbNames.push_back(name);
-        }
-    }
-    catch (std::invalid_argument&) {
-        const char* errMsg = "Unable to convert field {} to double value "\
-            "(invalid_argument exception) at line {}/{} of {}";
-        LERROR(fmt::format(
-            errMsg,
-            fieldCount, csvLine + 1, numberOfLines, filename
-        ));
-    }
-    catch (std::out_of_range&) {
-        const char* errMsg = "Unable to convert field {} to double value "\
-            "(out_of_range exception) at line {}/{} of {}";
-        LERROR(fmt::format(
-            errMsg,
-            fieldCount, csvLine + 1, numberOfLines, filename
-        ));
-    }
-    catch (std::ios_base::failure&) {
-        const char* errMsg = "File read exception (ios_base::failure) while trying "\
-            "to read field {} at line {}/{} of {}";
-        LERROR(fmt::format(
-            errMsg,
-            fieldCount, csvLine + 1, numberOfLines, filename
-        ));
-    }
-
-    file.close();
-}
-
-static double importAngleValue(const std::string& angle) {
-    double output = std::stod(angle);
-    output = std::fmod(output, 360.0);
-    if (output < 0.0) {
-        output += 360.0;
-    }
-    return output;
+    _sbData = kepler::readSbdbFile(filename);
 }
 
 void RenderableSmallBody::initializeGL() {
@@ -465,7 +227,7 @@ bool RenderableSmallBody::isReady() const {
 }
 
 void RenderableSmallBody::render(const RenderData& data, RendererTasks&) {
-    if (_sbData.empty())
+    if (!_sbData || _sbData->empty())
         return;
 
     _programObject->activate();
@@ -491,7 +253,7 @@ void RenderableSmallBody::render(const RenderData& data, RendererTasks&) {
 
     glLineWidth(_appearance.lineWidth);
 
-    const size_t nrOrbits = _sbData.size();
+    const size_t nrOrbits = _sbData->size();
     gl::GLint vertices = 0;
 
     //glDepthMask(false);
@@ -509,51 +271,51 @@ void RenderableSmallBody::render(const RenderData& data, RendererTasks&) {
 }
 
 void RenderableSmallBody::updateBuffers() {
-    readJplSbDb(_path);
-
-    const size_t nVerticesPerOrbit = _nSegments + 1;
-    _vertexBufferData.resize(_sbData.size() * nVerticesPerOrbit);
-    size_t orbitindex = 0;
-
-    for (const auto& orbit : _sbData) {
-        _keplerTranslator.setKeplerElements(
-            orbit.eccentricity,
-            orbit.semiMajorAxis,
-            orbit.inclination,
-            orbit.ascendingNode,
-            orbit.argumentOfPeriapsis,
-            orbit.meanAnomaly,
-            orbit.period,
-            orbit.epoch
-        );
+    const auto start = std::chrono::high_resolution_clock::now();
 
-        for (size_t i=0 ; i < nVerticesPerOrbit; ++i) {
-            size_t index = orbitindex * nVerticesPerOrbit  + i;
-
-            double timeOffset = orbit.period * 
-                    static_cast<double>(i)/ static_cast<double>(_nSegments); 
-            
-            glm::dvec3 position = _keplerTranslator.position({
-                {},
-                Time(timeOffset + orbit.epoch),
-                Time(0.0),
-                false
-            });
-            
-            double positionX = position.x; 
-            double positionY = position.y; 
-            double positionZ = position.z; 
-
-            _vertexBufferData[index].x = static_cast<float>(positionX);
-            _vertexBufferData[index].y = static_cast<float>(positionY);
-            _vertexBufferData[index].z = static_cast<float>(positionZ);
-            _vertexBufferData[index].time = static_cast<float>(timeOffset);
-            _vertexBufferData[index].epoch = orbit.epoch;
-            _vertexBufferData[index].period = orbit.period;
-        }
-      
-        ++orbitindex;
+    try {
+        readJplSbDb(_path);
     }
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(e.message);
+        _sbData = std::make_shared<const kepler::Elements>();
+    }
+
+    const unsigned int nSegments = _nSegments;
+    const size_t nVerticesPerOrbit = nSegments + 1;
+    _vertexBufferData.resize(_sbData->size() * nVerticesPerOrbit);
+
+    // The orbits are propagated concurrently, but each call only writes the vertices of
+    // its own orbit
+    kepler::computeOrbitPositions(
+        *_sbData,
+        nSegments,
+        [this, nSegments, nVerticesPerOrbit](size_t orbit, const glm::dvec3* positions) {
+            const double epoch = _sbData->epoch[orbit];
+            const double period = _sbData->period[orbit];
+            TrailVBOLayout* vertices = &_vertexBufferData[orbit * nVerticesPerOrbit];
+
+            for (size_t i = 0; i < nVerticesPerOrbit; ++i) {
+                const double timeOffset = period *
+                    static_cast<double>(i) / static_cast<double>(nSegments);
+
+                vertices[i].x = static_cast<float>(positions[i].x);
+                vertices[i].y = static_cast<float>(positions[i].y);
+                vertices[i].z = static_cast<float>(positions[i].z);
+                vertices[i].time = static_cast<float>(timeOffset);
+                vertices[i].epoch = epoch;
+                vertices[i].period = period;
+            }
+        }
+    );
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    LINFO(fmt::format(
+        "Loaded {} orbits from '{}' in {:.3f} s",
+        _sbData->size(),
+        _path.value(),
+        std::chrono::duration<double>(end - start).count()
+    ));
 
     glBindVertexArray(_vertexArray);
 
@@ -28,7 +28,7 @@
 #include <openspace/rendering/renderable.h>
 
 #include <modules/base/rendering/renderabletrail.h>
-#include <modules/space/translation/keplertranslation.h>
+#include <modules/space/kepler.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/scalar/uintproperty.h>
 #include <ghoul/glm.h>
@@ -49,11 +49,8 @@ public:
 
     static documentation::Documentation Documentation();
     /**
-        * Reads the provided file downloaded from the JPL Small Body Database and calls
-        * the KeplerTranslation::setKeplerElments method with the correct values.
-        * If \p filename is a valid JPL SBDB file but contains
-        * disallowed values (see KeplerTranslation::setKeplerElements), a
-        * KeplerTranslation::RangeError is thrown.
+        * Reads the provided file downloaded from the JPL Small Body Database through
+        * kepler::readSbdbFile. Entries that contain disallowed values are skipped.
         *
         * \param filename The path to the file that contains the file.
         *
@@ -70,27 +67,13 @@ private:
         glm::vec2 texcoord;
     };
 
-    struct KeplerParameters {
-        double inclination = 0.0;
-        double semiMajorAxis = 0.0;
-        double ascendingNode = 0.0;
-        double eccentricity = 0.0;
-        double argumentOfPeriapsis = 0.0;
-        double meanAnomaly = 0.0;
-        double meanMotion = 0.0;
-        double epoch = 0.0;
-        double period = 0.0;
-    };
-
     /// The layout of the VBOs
     struct TrailVBOLayout {
         float x, y, z, time;
         double epoch, period; 
     };
 
-    KeplerTranslation _keplerTranslator;
-    std::vector<KeplerParameters> _sbData;
-    std::vector<std::string> _sbNames;
+    std::shared_ptr<const kepler::Elements> _sbData;
 
     /// The backend storage for the vertex buffer object containing all points for this
     /// trail.
@@ -121,13 +104,8 @@ private:
 
     UniformCache(modelView, projection, lineFade, inGameTime, color, opacity,
         numberOfSegments) _uniformCache;
-
-    const double convertAuToKm = 1.496e8;
-    const double convertDaysToSecs = 86400.;
 };
 
-static double importAngleValue(const std::string& angle);
-
 } // namespace openspace
 
 #endif // __OPENSPACE_MODULE_SPACE___RENDERABLESMALLBODY___H__
@@ -24,8 +24,10 @@
 
 #include <modules/space/rotation/spicerotation.h>
 
+#include <modules/space/ephemeriscache.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/util/spiceexecutor.h>
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/time.h>
 #include <openspace/util/updatestructures.h>
@@ -52,6 +54,22 @@ namespace {
         "Time Frame",
         "The time frame in which the spice kernels are valid."
     };
+
+    constexpr openspace::properties::Property::PropertyInfo UseCacheInfo = {
+        "UseEphemerisCache",
+        "Use Ephemeris Cache",
+        "If this value is enabled, the rotation is computed from polynomials that are "
+        "fitted to the SPICE kernels and stored in the cache directory, rather than "
+        "evaluating the kernels directly. The default value is false."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CacheToleranceInfo = {
+        "EphemerisCacheTolerance",
+        "Ephemeris Cache Tolerance",
+        "The largest amount by which each element of a cached rotation matrix may differ "
+        "from the matrix computed by SPICE. Where the polynomials cannot reach this "
+        "tolerance, the kernels are evaluated directly."
+    };
 } // namespace
 
 namespace openspace {
@@ -93,6 +111,18 @@ documentation::Documentation SpiceRotation::Documentation() {
                 Optional::Yes,
                 TimeFrameInfo.description
             },
+            {
+                UseCacheInfo.identifier,
+                new BoolVerifier,
+                Optional::Yes,
+                UseCacheInfo.description
+            },
+            {
+                CacheToleranceInfo.identifier,
+                new DoubleGreaterVerifier(0.0),
+                Optional::Yes,
+                CacheToleranceInfo.description
+            },
         }
     };
 }
@@ -100,6 +130,8 @@ documentation::Documentation SpiceRotation::Documentation() {
 SpiceRotation::SpiceRotation(const ghoul::Dictionary& dictionary)
     : _sourceFrame(SourceInfo)
     , _destinationFrame(DestinationInfo)
+    , _useCache(UseCacheInfo, false)
+    , _cacheTolerance(CacheToleranceInfo, 1e-9, 1e-15, 1e-3)
 {
     documentation::testSpecificationAndThrow(
         Documentation(),
@@ -110,6 +142,14 @@ SpiceRotation::SpiceRotation(const ghoul::Dictionary& dictionary)
     _sourceFrame = dictionary.value<std::string>(SourceInfo.identifier);
     _destinationFrame = dictionary.value<std::string>(DestinationInfo.identifier);
 
+    if (dictionary.hasKey(UseCacheInfo.identifier)) {
+        _useCache = dictionary.value<bool>(UseCacheInfo.identifier);
+    }
+
+    if (dictionary.hasKey(CacheToleranceInfo.identifier)) {
+        _cacheTolerance = dictionary.value<double>(CacheToleranceInfo.identifier);
+    }
+
     if (dictionary.hasKeyAndValue<std::string>(KeyKernels)) {
         SpiceManager::ref().loadKernel(dictionary.value<std::string>(KeyKernels));
     }
@@ -137,20 +177,60 @@ SpiceRotation::SpiceRotation(const ghoul::Dictionary& dictionary)
 
     addProperty(_sourceFrame);
     addProperty(_destinationFrame);
+    addProperty(_useCache);
+    addProperty(_cacheTolerance);
 
-    _sourceFrame.onChange([this]() { requireUpdate(); });
-    _destinationFrame.onChange([this]() { requireUpdate(); });
+    auto update = [this]() {
+        updateCache();
+        requireUpdate();
+    };
+    _sourceFrame.onChange(update);
+    _destinationFrame.onChange(update);
+    _useCache.onChange(update);
+    _cacheTolerance.onChange(update);
+}
+
+bool SpiceRotation::initialize() {
+    updateCache();
+    return Rotation::initialize();
+}
+
+void SpiceRotation::updateCache() {
+    if (_useCache) {
+        _cache = EphemerisCache::rotationCache(
+            _sourceFrame,
+            _destinationFrame,
+            _cacheTolerance
+        );
+    }
+    else {
+        _cache = nullptr;
+    }
 }
 
 glm::dmat3 SpiceRotation::matrix(const UpdateData& data) const {
     if (_timeFrame && !_timeFrame->isActive(data.time)) {
         return glm::dmat3(1.0);
     }
-    return SpiceManager::ref().positionTransformMatrix(
-        _sourceFrame,
-        _destinationFrame,
-        data.time.j2000Seconds()
-    );
+
+    glm::dmat3 cachedMatrix;
+    if (_cache && _cache->rotation(data.time.j2000Seconds(), cachedMatrix)) {
+        return cachedMatrix;
+    }
+
+    SpiceExecutor::TransformMatrixRequest request;
+    request.from = _sourceFrame;
+    request.to = _destinationFrame;
+    request.time = data.time.j2000Seconds();
+    request.estimateUncovered = true;
+
+    const std::vector<SpiceExecutor::Result> results =
+        SpiceManager::ref().executor().execute({ request });
+    return results[0].get<glm::dmat3>();
+}
+
+bool SpiceRotation::isThreadSafe() const {
+    return true;
 }
 
 } // namespace openspace
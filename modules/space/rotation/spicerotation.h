@@ -27,26 +27,42 @@
 
 #include <openspace/scene/rotation.h>
 
+#include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/scene/timeframe.h>
+#include <memory>
 
 namespace openspace {
 
 namespace documentation { struct Documentation; }
 
+class EphemerisCache;
+
 class SpiceRotation : public Rotation {
 public:
     SpiceRotation(const ghoul::Dictionary& dictionary);
 
+    bool initialize() override;
+
     const glm::dmat3& matrix() const;
     glm::dmat3 matrix(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
 
     static documentation::Documentation Documentation();
 
 private:
+    /// Selects the ephemeris cache for the source and destination frames
+    void updateCache();
+
     properties::StringProperty _sourceFrame;
     properties::StringProperty _destinationFrame;
+    properties::BoolProperty _useCache;
+    properties::DoubleProperty _cacheTolerance;
     std::unique_ptr<TimeFrame> _timeFrame;
+
+    /// The cached approximation of the rotation, if the cache is enabled
+    std::shared_ptr<EphemerisCache> _cache;
 };
 
 } // namespace openspace
@@ -26,6 +26,7 @@
 #include <modules/volume/rawvolume.h>
 #include <modules/volume/rawvolumemetadata.h>
 #include <modules/volume/rawvolumewriter.h>
+#include <modules/volume/volumeutils.h>
 #include <openspace/util/spicemanager.h>
 
 #include <openspace/documentation/verifier.h>
@@ -38,8 +39,12 @@
 //#include <ghoul/misc/dictionaryluaformatter.h>
 #include <ghoul/misc/defer.h>
 
+#include <atomic>
+#include <exception>
 #include <fstream>
+#include <memory>
 #include <queue>
+#include <thread>
 
 
 
@@ -70,312 +75,6 @@ namespace {
 
 namespace openspace{
 namespace volume {
-// The list of leap years only goes until 2056 as we need to touch this file then
-// again anyway ;)
-const std::vector<int> LeapYears = {
-    1956, 1960, 1964, 1968, 1972, 1976, 1980, 1984, 1988, 1992, 1996,
-    2000, 2004, 2008, 2012, 2016, 2020, 2024, 2028, 2032, 2036, 2040,
-    2044, 2048, 2052, 2056
-};
-// Count the number of full days since the beginning of 2000 to the beginning of
-// the parameter 'year'
-int countDays(int year) {
-    // Find the position of the current year in the vector, the difference
-    // between its position and the position of 2000 (for J2000) gives the
-    // number of leap years
-    constexpr const int Epoch = 2000;
-    constexpr const int DaysRegularYear = 365;
-    constexpr const int DaysLeapYear = 366;
-
-    if (year == Epoch) {
-        return 0;
-    }
-
-    // Get the position of the most recent leap year
-    const auto lb = std::lower_bound(LeapYears.begin(), LeapYears.end(), year);
-
-    // Get the position of the epoch
-    const auto y2000 = std::find(LeapYears.begin(), LeapYears.end(), Epoch);
-
-    // The distance between the two iterators gives us the number of leap years
-    const int nLeapYears = static_cast<int>(std::abs(std::distance(y2000, lb)));
-
-    const int nYears = std::abs(year - Epoch);
-    const int nRegularYears = nYears - nLeapYears;
-
-    // Get the total number of days as the sum of leap years + non leap years
-    const int result = nRegularYears * DaysRegularYear + nLeapYears * DaysLeapYear;
-    return result;
-}
-
-// Returns the number of leap seconds that lie between the {year, dayOfYear}
-// time point and { 2000, 1 }
-int countLeapSeconds(int year, int dayOfYear) {
-    // Find the position of the current year in the vector; its position in
-    // the vector gives the number of leap seconds
-    struct LeapSecond {
-        int year;
-        int dayOfYear;
-        bool operator<(const LeapSecond& rhs) const {
-            return std::tie(year, dayOfYear) < std::tie(rhs.year, rhs.dayOfYear);
-        }
-    };
-
-    const LeapSecond Epoch = { 2000, 1 };
-
-    // List taken from: https://www.ietf.org/timezones/data/leap-seconds.list
-    static const std::vector<LeapSecond> LeapSeconds = {
-        { 1972,   1 },
-        { 1972, 183 },
-        { 1973,   1 },
-        { 1974,   1 },
-        { 1975,   1 },
-        { 1976,   1 },
-        { 1977,   1 },
-        { 1978,   1 },
-        { 1979,   1 },
-        { 1980,   1 },
-        { 1981, 182 },
-        { 1982, 182 },
-        { 1983, 182 },
-        { 1985, 182 },
-        { 1988,   1 },
-        { 1990,   1 },
-        { 1991,   1 },
-        { 1992, 183 },
-        { 1993, 182 },
-        { 1994, 182 },
-        { 1996,   1 },
-        { 1997, 182 },
-        { 1999,   1 },
-        { 2006,   1 },
-        { 2009,   1 },
-        { 2012, 183 },
-        { 2015, 182 },
-        { 2017,   1 }
-    };
-
-    // Get the position of the last leap second before the desired date
-    LeapSecond date { year, dayOfYear };
-    const auto it = std::lower_bound(LeapSeconds.begin(), LeapSeconds.end(), date);
-
-    // Get the position of the Epoch
-    const auto y2000 = std::lower_bound(
-        LeapSeconds.begin(),
-        LeapSeconds.end(),
-        Epoch
-    );
-
-    // The distance between the two iterators gives us the number of leap years
-    const int nLeapSeconds = static_cast<int>(std::abs(std::distance(y2000, it)));
-    return nLeapSeconds;
-}
-
-double calculateSemiMajorAxis(double meanMotion) {
-    constexpr const double GravitationalConstant = 6.6740831e-11;
-    constexpr const double MassEarth = 5.9721986e24;
-    constexpr const double muEarth = GravitationalConstant * MassEarth;
-
-    // Use Kepler's 3rd law to calculate semimajor axis
-    // a^3 / P^2 = mu / (2pi)^2
-    // <=> a = ((mu * P^2) / (2pi^2))^(1/3)
-    // with a = semimajor axis
-    // P = period in seconds
-    // mu = G*M_earth
-    double period = std::chrono::seconds(std::chrono::hours(24)).count() / meanMotion;
-
-    const double pisq = glm::pi<double>() * glm::pi<double>();
-    double semiMajorAxis = pow((muEarth * period*period) / (4 * pisq), 1.0 / 3.0);
-
-    // We need the semi major axis in km instead of m
-    return semiMajorAxis / 1000.0;
-}
-
-double epochFromSubstring(const std::string& epochString) {
-    // The epochString is in the form:
-    // YYDDD.DDDDDDDD
-    // With YY being the last two years of the launch epoch, the first DDD the day
-    // of the year and the remaning a fractional part of the day
-
-    // The main overview of this function:
-    // 1. Reconstruct the full year from the YY part
-    // 2. Calculate the number of seconds since the beginning of the year
-    // 2.a Get the number of full days since the beginning of the year
-    // 2.b If the year is a leap year, modify the number of days
-    // 3. Convert the number of days to a number of seconds
-    // 4. Get the number of leap seconds since January 1st, 2000 and remove them
-    // 5. Adjust for the fact the epoch starts on 1st Januaray at 12:00:00, not
-    // midnight
-
-    // According to https://celestrak.com/columns/v04n03/
-    // Apparently, US Space Command sees no need to change the two-line element
-    // set format yet since no artificial earth satellites existed prior to 1957.
-    // By their reasoning, two-digit years from 57-99 correspond to 1957-1999 and
-    // those from 00-56 correspond to 2000-2056. We'll see each other again in 2057!
-
-    // 1. Get the full year
-    std::string yearPrefix = [y = epochString.substr(0, 2)](){
-        int year = std::atoi(y.c_str());
-        return year >= 57 ? "19" : "20";
-    }();
-    const int year = std::atoi((yearPrefix + epochString.substr(0, 2)).c_str());
-    const int daysSince2000 = countDays(year);
-
-    // 2.
-    // 2.a
-    double daysInYear = std::atof(epochString.substr(2).c_str());
-
-    // 2.b
-    const bool isInLeapYear = std::find(
-        LeapYears.begin(),
-        LeapYears.end(),
-        year
-    ) != LeapYears.end();
-    if (isInLeapYear && daysInYear >= 60) {
-        // We are in a leap year, so we have an effective day more if we are
-        // beyond the end of february (= 31+29 days)
-        --daysInYear;
-    }
-
-    // 3
-    using namespace std::chrono;
-    const int SecondsPerDay = static_cast<int>(seconds(hours(24)).count());
-    //Need to subtract 1 from daysInYear since it is not a zero-based count
-    const double nSecondsSince2000 = (daysSince2000 + daysInYear - 1) * SecondsPerDay;
-
-    // 4
-    // We need to remove additionbal leap seconds past 2000 and add them prior to
-    // 2000 to sync up the time zones
-    const double nLeapSecondsOffset = -countLeapSeconds(
-        year,
-        static_cast<int>(std::floor(daysInYear))
-    );
-
-    // 5
-    const double nSecondsEpochOffset = static_cast<double>(
-        seconds(hours(12)).count()
-    );
-
-    // Combine all of the values
-    const double epoch = nSecondsSince2000 + nLeapSecondsOffset - nSecondsEpochOffset;
-    return epoch;
-}
-
-std::vector<KeplerParameters> readTLEFile(const std::string& filename){
-    ghoul_assert(FileSys.fileExists(filename), "The filename must exist");
-    
-    std::vector<KeplerParameters> data;
-
-    std::ifstream file;
-    file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    file.open(filename);
-
-    int numberOfLines = std::count(std::istreambuf_iterator<char>(file), 
-                                   std::istreambuf_iterator<char>(), '\n' );
-    file.seekg(std::ios_base::beg); // reset iterator to beginning of file
-
-    // 3 because a TLE has 3 lines per element/ object.
-    int numberOfObjects = numberOfLines/3;
-
-    std::string line = "-";
-    for (int i = 0; i < numberOfObjects; i++) {
-
-        std::getline(file, line); // get rid of title
-        
-        KeplerParameters keplerElements;
-
-        std::getline(file, line);
-        if (line[0] == '1') {
-            // First line
-            // Field Columns   Content
-            //     1   01-01   Line number
-            //     2   03-07   Satellite number
-            //     3   08-08   Classification (U = Unclassified)
-            //     4   10-11   International Designator (Last two digits of launch year)
-            //     5   12-14   International Designator (Launch number of the year)
-            //     6   15-17   International Designator(piece of the launch)    A
-            //     7   19-20   Epoch Year(last two digits of year)
-            //     8   21-32   Epoch(day of the year and fractional portion of the day)
-            //     9   34-43   First Time Derivative of the Mean Motion divided by two
-            //    10   45-52   Second Time Derivative of Mean Motion divided by six
-            //    11   54-61   BSTAR drag term(decimal point assumed)[10] - 11606 - 4
-            //    12   63-63   The "Ephemeris type"
-            //    13   65-68   Element set  number.Incremented when a new TLE is generated
-            //    14   69-69   Checksum (modulo 10)
-            keplerElements.epoch = epochFromSubstring(line.substr(18, 14));
-        }
-        else {
-            throw ghoul::RuntimeError(fmt::format(
-                "File {} @ line {} does not have '1' header", filename // linNum + 1
-            ));
-        }
-
-        std::getline(file, line);
-        if (line[0] == '2') {
-            // Second line
-            // Field    Columns   Content
-            //     1      01-01   Line number
-            //     2      03-07   Satellite number
-            //     3      09-16   Inclination (degrees)
-            //     4      18-25   Right ascension of the ascending node (degrees)
-            //     5      27-33   Eccentricity (decimal point assumed)
-            //     6      35-42   Argument of perigee (degrees)
-            //     7      44-51   Mean Anomaly (degrees)
-            //     8      53-63   Mean Motion (revolutions per day)
-            //     9      64-68   Revolution number at epoch (revolutions)
-            //    10      69-69   Checksum (modulo 10)
-
-            std::stringstream stream;
-            stream.exceptions(std::ios::failbit);
-
-            // Get inclination
-            stream.str(line.substr(8, 8));
-            stream >> keplerElements.inclination;
-            stream.clear();
-
-            // Get Right ascension of the ascending node
-            stream.str(line.substr(17, 8));
-            stream >> keplerElements.ascendingNode;
-            stream.clear();
-
-            // Get Eccentricity
-            stream.str("0." + line.substr(26, 7));
-            stream >> keplerElements.eccentricity;
-            stream.clear();
-
-            // Get argument of periapsis
-            stream.str(line.substr(34, 8));
-            stream >> keplerElements.argumentOfPeriapsis;
-            stream.clear();
-
-            // Get mean anomaly
-            stream.str(line.substr(43, 8));
-            stream >> keplerElements.meanAnomaly;
-            stream.clear();
-
-            // Get mean motion
-            stream.str(line.substr(52, 11));
-            stream >> keplerElements.meanMotion;
-        }
-        else {
-            throw ghoul::RuntimeError(fmt::format(
-                "File {} @ line {} does not have '2' header", filename  // , lineNum + 2
-            ));
-        }
-
-        // Calculate the semi major axis based on the mean motion using kepler's laws
-        keplerElements.semiMajorAxis = calculateSemiMajorAxis(keplerElements.meanMotion);
-
-        using namespace std::chrono;
-        double period = seconds(hours(24)).count() / keplerElements.meanMotion;
-        keplerElements.period = period;
-
-        data.push_back(keplerElements);
-
-    } // !for loop
-    file.close();
-    return data;
-}
 
 glm::dvec3 cartesianToSphericalCoord(glm::dvec3 position){
     glm::dvec3 sphericalPosition;
@@ -392,68 +91,6 @@ glm::dvec3 cartesianToSphericalCoord(glm::dvec3 position){
 }
 
 
-std::vector<glm::dvec3> getPositionBuffer(std::vector<KeplerParameters> tleData, double timeInSeconds, std::string gridType) {
-
-    float minTheta = 0.0;
-    float minPhi = 0.0;
-    float maxTheta = 0.0;
-    float maxPhi = 0.0;
-
-    std::vector<glm::dvec3> positionBuffer;
-    for(const auto& orbit : tleData) {
-        KeplerTranslation keplerTranslator;
-        keplerTranslator.setKeplerElements(
-            orbit.eccentricity,
-            orbit.semiMajorAxis,
-            orbit.inclination,
-            orbit.ascendingNode,
-            orbit.argumentOfPeriapsis,
-            orbit.meanAnomaly,
-            orbit.period,
-            orbit.epoch
-        );
-        glm::dvec3 position = keplerTranslator.position({
-            {},
-            Time(timeInSeconds),
-            Time(0.0),
-            false
-        });
-        // LINFO(fmt::format("cart: {} ", position));
-        glm::dvec3 sphPos;
-        if( gridType == "Spherical"){
-            sphPos = cartesianToSphericalCoord(position);
-
-            if(sphPos.y < minTheta){
-                minTheta = sphPos.y;
-            }
-            if(sphPos.z < minPhi){
-                minPhi = sphPos.z;
-            }
-            if(sphPos.y > maxTheta){
-                maxTheta = sphPos.y;
-            }
-            if(sphPos.z > maxPhi){
-                maxPhi = sphPos.z;
-            }
-            // LINFO(fmt::format("pos: {} ", sphPos));
-            positionBuffer.push_back(sphPos);
-        
-        }
-        else
-        {
-            positionBuffer.push_back(position);
-        }
-        
-        
-    }
-    LINFO(fmt::format("max theta: {} ", maxTheta));
-    LINFO(fmt::format("max phi: {} ", maxPhi));
-    LINFO(fmt::format("min theta: {} ", minTheta));
-    LINFO(fmt::format("min phi: {} ", minPhi));
-
-    return positionBuffer;
-}
-
 // std::vector<glm::dvec3> generatePositions(int numberOfPositions) {
 //     std::vector<glm::dvec3> positions;
     
@@ -467,17 +104,7 @@ std::vector<glm::dvec3> getPositionBuffer(std::vector<KeplerParameters> tleData,
 //     return positions;
 // }
 
-float getDensityAt(glm::uvec3 cell,  double* densityArray, RawVolume<float>& raw) {
-    float value;
-    // return value at position cell from _densityPerVoxel
-    size_t index = raw.coordsToIndex(cell);
-    value = static_cast<float>(densityArray[index]);
-    //LINFO(fmt::format("indensity: {} ", index));
-
-    return value;
-}
-
-float getMaxApogee(std::vector<KeplerParameters> inData){
+float getMaxApogee(std::vector<kepler::Parameters> inData){
     double maxApogee = 0.0;
     for (const auto& dataElement : inData){
         double ah = dataElement.semiMajorAxis * (1 + dataElement.eccentricity);
@@ -488,11 +115,13 @@ float getMaxApogee(std::vector<KeplerParameters> inData){
     return static_cast<float>(maxApogee*1000);  // * 1000 for meters
 }
 
-int getIndexFromPosition(glm::dvec3 position, glm::uvec3 dim, float maxApogee, std::string gridType){
+int getIndexFromPosition(glm::dvec3 position, glm::uvec3 dim, float maxApogee,
+                         VolumeGridType gridType)
+{
     // epsilon is to make sure that for example if newPosition.x/maxApogee = 1,
     // then the index for that dimension will not exceed the range of the grid.
     float epsilon = static_cast<float>(0.000000001);
-    if(gridType == "Cartesian"){ //|| gridType == "Spherical"){
+    if (gridType == VolumeGridType::Cartesian) {
         glm::dvec3 newPosition = glm::dvec3(position.x + maxApogee
                                         ,position.y + maxApogee
                                         ,position.z + maxApogee);
@@ -504,7 +133,7 @@ int getIndexFromPosition(glm::dvec3 position, glm::uvec3 dim, float maxApogee, s
         
         return coordinateIndex.z * (dim.x * dim.y) + coordinateIndex.y * dim.x + coordinateIndex.x;
     }
-    else if(gridType == "Spherical"){
+    else if (gridType == VolumeGridType::Spherical) {
 
         if(position.y >= 3.1415926535897932384626433832795028){
             position.y = 0;
@@ -528,9 +157,9 @@ int getIndexFromPosition(glm::dvec3 position, glm::uvec3 dim, float maxApogee, s
     return -1;
 }
 
-double getVoxelVolume(int index, RawVolume<float>& raw, glm::uvec3 dim, float maxApogee){
+double getVoxelVolume(int index, glm::uvec3 dim, float maxApogee){
     // get coords from index 
-    glm::uvec3 coords = raw.indexToCoords(index);
+    glm::uvec3 coords = indexToCoords(index, dim);
 
     double rMax = maxApogee / dim.x;
     double thetaMax = 3.141592 / dim.y;
@@ -546,22 +175,44 @@ double getVoxelVolume(int index, RawVolume<float>& raw, glm::uvec3 dim, float ma
 
 }
 
-double* mapDensityToVoxels(double* densityArray, std::vector<glm::dvec3> positions, glm::uvec3 dim, float maxApogee, std::string gridType, RawVolume<float>& raw) {
+// Propagates the orbits [begin, end) to the time and counts the number of objects in
+// each voxel of the grid
+std::vector<unsigned int> binOrbits(KeplerTranslation& translator,
+                                    const std::vector<kepler::Parameters>& tleData,
+                                    size_t begin, size_t end, double timeInSeconds,
+                                    glm::uvec3 dim, float maxApogee,
+                                    VolumeGridType gridType)
+{
+    std::vector<unsigned int> histogram(
+        static_cast<size_t>(dim.x) * static_cast<size_t>(dim.y) * dim.z,
+        0
+    );
 
-    for(const glm::dvec3& position : positions) {
-        //LINFO(fmt::format("pos: {} ", position));
-        int index = getIndexFromPosition(position, dim, maxApogee, gridType);
-        //LINFO(fmt::format("index: {} ", index));
-        if(gridType == "Cartesian"){
-            ++densityArray[index];
-        }
-        else if(gridType == "Spherical"){
-            double voxelVolume = getVoxelVolume(index, raw, dim, maxApogee); //something like this
-            densityArray[index] += 1/voxelVolume;
+    for (size_t i = begin; i < end; ++i) {
+        const kepler::Parameters& orbit = tleData[i];
+        translator.setKeplerElements(
+            orbit.eccentricity,
+            orbit.semiMajorAxis,
+            orbit.inclination,
+            orbit.ascendingNode,
+            orbit.argumentOfPeriapsis,
+            orbit.meanAnomaly,
+            orbit.period,
+            orbit.epoch
+        );
+        glm::dvec3 position = translator.position({
+            {},
+            Time(timeInSeconds),
+            Time(0.0),
+            false
+        });
+        if (gridType == VolumeGridType::Spherical) {
+            position = cartesianToSphericalCoord(position);
         }
-    }
 
-    return densityArray;
+        ++histogram[getIndexFromPosition(position, dim, maxApogee, gridType)];
+    }
+    return histogram;
 }
 
 GenerateDebrisVolumeTask::GenerateDebrisVolumeTask(const ghoul::Dictionary& dictionary)
@@ -586,7 +237,11 @@ GenerateDebrisVolumeTask::GenerateDebrisVolumeTask(const ghoul::Dictionary& dict
     _lowerDomainBound = dictionary.value<glm::vec3>(KeyLowerDomainBound);
     _upperDomainBound = dictionary.value<glm::vec3>(KeyUpperDomainBound);
  
-    _TLEDataVector = readTLEFile(_inputPath);
+    std::shared_ptr<const kepler::Elements> catalog = kepler::readTleFile(_inputPath);
+    _TLEDataVector.reserve(catalog->size());
+    for (size_t i = 0; i < catalog->size(); ++i) {
+        _TLEDataVector.push_back(catalog->at(i));
+    }
     _maxApogee = getMaxApogee(_TLEDataVector);
    
 }
@@ -653,50 +308,131 @@ void GenerateDebrisVolumeTask::perform(const Task::ProgressCallback& progressCal
     LINFO(fmt::format("timestep: {} ", numberOfIterations));
 
     std::queue<volume::RawVolume<float>> rawVolumeQueue = {};
-    const int size = _dimensions.x *_dimensions.y *_dimensions.z;
+    const size_t size = static_cast<size_t>(_dimensions.x) * _dimensions.y *
+                        _dimensions.z;
     float minVal = std::numeric_limits<float>::max();
     float maxVal = std::numeric_limits<float>::min();
+
+    // The volume of a voxel in a spherical grid only depends on its position
+    std::vector<double> voxelVolumes;
+    if (GridType == VolumeGridType::Spherical) {
+        voxelVolumes.resize(size);
+        for (size_t v = 0; v < size; ++v) {
+            voxelVolumes[v] = getVoxelVolume(
+                static_cast<int>(v),
+                _dimensions,
+                _maxApogee
+            );
+        }
+    }
+
     // 2.
-    for(int i=0 ; i<=numberOfIterations ; ++i) {
+    // The timesteps are processed concurrently. If there are fewer timesteps than
+    // threads, each timestep is additionally split into blocks of orbits. Every block is
+    // binned into its own histogram and the histograms of a timestep are merged into its
+    // volume by the thread that finishes the last of its blocks
+    const size_t nTimesteps = static_cast<size_t>(numberOfIterations) + 1;
+    const size_t nOrbits = _TLEDataVector.size();
+    const size_t nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    const size_t nBlocks = std::max<size_t>(
+        std::min((nThreads + nTimesteps - 1) / nTimesteps, nOrbits),
+        1
+    );
+    const size_t orbitsPerBlock = (nOrbits + nBlocks - 1) / nBlocks;
 
-        std::vector<glm::dvec3> startPositionBuffer = getPositionBuffer(_TLEDataVector, startTimeInSeconds+(i*timeStep), _gridType);   //+(i*timeStep)     
-        //LINFO(fmt::format("pos: {} ", startPositionBuffer[4]));
+    std::vector<std::vector<unsigned int>> histograms(nTimesteps * nBlocks);
+    std::vector<std::atomic<size_t>> remainingBlocks(nTimesteps);
+    for (std::atomic<size_t>& remaining : remainingBlocks) {
+        remaining = nBlocks;
+    }
+    std::vector<std::unique_ptr<volume::RawVolume<float>>> rawVolumes(nTimesteps);
+
+    auto createVolume = [&](size_t timestep) {
+        auto rawVolume = std::make_unique<volume::RawVolume<float>>(_dimensions);
+        for (size_t v = 0; v < size; ++v) {
+            unsigned int count = 0;
+            for (size_t b = 0; b < nBlocks; ++b) {
+                count += histograms[timestep * nBlocks + b][v];
+            }
 
-        double *densityArrayp = new double[size]();
-        //densityArrayp = mapDensityToVoxels(densityArrayp, generatedPositions, _dimensions, maxApogee);
-        volume::RawVolume<float> rawVolume(_dimensions);
+            // Every object in a voxel adds the same density, so adding it once per
+            // object gives the same result as adding it when the object is binned
+            double density = 0.0;
+            if (GridType == VolumeGridType::Cartesian) {
+                density = static_cast<double>(count);
+            }
+            else {
+                const double objectDensity = 1 / voxelVolumes[v];
+                for (unsigned int c = 0; c < count; ++c) {
+                    density += objectDensity;
+                }
+            }
+            rawVolume->set(v, static_cast<float>(density));
+        }
 
-        densityArrayp = mapDensityToVoxels(densityArrayp, startPositionBuffer, _dimensions, _maxApogee, _gridType, rawVolume);
-        /*std::vector<glm::dvec3> testBuffer;
-        testBuffer.push_back(glm::dvec3(0,0,0));
-        testBuffer.push_back(glm::dvec3(1,1.5,1.5));
-        testBuffer.push_back(glm::dvec3(1,3,3));
-        testBuffer.push_back(glm::dvec3(3,5,3));
-        //testBuffer.push_back(glm::dvec3(10000,1000000000,1000000000));
+        for (size_t b = 0; b < nBlocks; ++b) {
+            histograms[timestep * nBlocks + b] = std::vector<unsigned int>();
+        }
+        rawVolumes[timestep] = std::move(rawVolume);
+    };
 
+    std::atomic<size_t> nextBlock = 0;
+    auto binBlocks = [&](KeplerTranslation& translator, std::exception_ptr& error) {
+        try {
+            for (size_t b = nextBlock++; b < histograms.size(); b = nextBlock++) {
+                const size_t timestep = b / nBlocks;
+                const size_t begin = std::min((b % nBlocks) * orbitsPerBlock, nOrbits);
+                const size_t end = std::min(begin + orbitsPerBlock, nOrbits);
+                histograms[b] = binOrbits(
+                    translator,
+                    _TLEDataVector,
+                    begin,
+                    end,
+                    startTimeInSeconds + (static_cast<int>(timestep) * timeStep),
+                    _dimensions,
+                    _maxApogee,
+                    GridType
+                );
+                if (--remainingBlocks[timestep] == 0) {
+                    createVolume(timestep);
+                }
+            }
+        }
+        catch (...) {
+            error = std::current_exception();
+            // Let the other threads finish early
+            nextBlock = histograms.size();
+        }
+    };
 
-        densityArrayp = mapDensityToVoxels(densityArrayp, testBuffer, _dimensions, _maxApogee, _gridType);
-        */
-        // create object rawVolume
-        
-        //glm::vec3 domainSize = _upperDomainBound - _lowerDomainBound;
-             
-        // TODO: Create a forEachSatallite and set(cell, value) to combine mapDensityToVoxel
-        //      and forEachVoxel for less time complexity.
-        rawVolume.forEachVoxel([&](glm::uvec3 cell, float) {
-        //     glm::vec3 coord = _lowerDomainBound +
-        //        glm::vec3(cell) / glm::vec3(_dimensions) * domainSize;
-            float value = getDensityAt(cell, densityArrayp, rawVolume);   // (coord)
-      
-            rawVolume.set(cell, value);
+    // The translators are created up front as their properties are not created
+    // concurrently anywhere else either
+    std::vector<std::unique_ptr<KeplerTranslation>> translators;
+    for (size_t t = 0; t < nThreads; ++t) {
+        translators.push_back(std::make_unique<KeplerTranslation>());
+    }
+    std::vector<std::exception_ptr> errors(nThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < nThreads; ++t) {
+        threads.emplace_back(binBlocks, std::ref(*translators[t]), std::ref(errors[t]));
+    }
+    binBlocks(*translators[0], errors[0]);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
 
+    for (std::unique_ptr<volume::RawVolume<float>>& rawVolume : rawVolumes) {
+        rawVolume->forEachVoxel([&](glm::uvec3, float value) {
             minVal = std::min(minVal, value);
             maxVal = std::max(maxVal, value);
-            /*LINFO(fmt::format("min: {} ", minVal));
-            LINFO(fmt::format("max: {} ", maxVal));*/
         });
-        rawVolumeQueue.push(rawVolume);
-        delete[] densityArrayp;
+        rawVolumeQueue.push(std::move(*rawVolume));
+        rawVolume = nullptr;
     }
 
     // two loops is used to get a global min and max value for voxels.
@@ -28,7 +28,7 @@
 #include <openspace/util/task.h>
 #include <openspace/util/time.h>
 
-#include <modules/space/rendering/renderablesatellites.h>
+#include <modules/space/kepler.h>
 #include <modules/space/translation/keplertranslation.h>
 
 
@@ -64,7 +64,7 @@ private:
     glm::vec3 _lowerDomainBound;
     glm::vec3 _upperDomainBound;
 
-    std::vector<KeplerParameters> _TLEDataVector;
+    std::vector<kepler::Parameters> _TLEDataVector;
 
     float _maxApogee;
 
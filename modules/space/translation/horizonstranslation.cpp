@@ -28,14 +28,51 @@
 #include <openspace/documentation/verifier.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/fmt.h>
+#include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/lua/ghoul_lua.h>
 #include <ghoul/lua/lua_helper.h>
+#include <algorithm>
 #include <fstream>
+#include <memory>
+#include <numeric>
+#include <sstream>
 
 namespace {
     constexpr const char* _loggerCat = "HorizonsTranslation";
+
+    constexpr const int8_t CurrentCacheVersion = 1;
+
+    // Estimates the velocity at each sample from the neighboring samples. For interior
+    // samples this is the derivative of the parabola through the three samples, which
+    // is exact for constant accelerations also for unevenly spaced samples
+    std::vector<glm::dvec3> estimateVelocities(const std::vector<double>& times,
+                                               const std::vector<glm::dvec3>& positions)
+    {
+        const size_t n = times.size();
+        std::vector<glm::dvec3> velocities(n, glm::dvec3(0.0));
+        if (n < 2) {
+            return velocities;
+        }
+
+        auto slope = [&](size_t i) {
+            const double dt = times[i + 1] - times[i];
+            return dt > 0.0 ? (positions[i + 1] - positions[i]) / dt : glm::dvec3(0.0);
+        };
+
+        velocities.front() = slope(0);
+        velocities.back() = slope(n - 2);
+        for (size_t i = 1; i < n - 1; ++i) {
+            const double dtPrev = times[i] - times[i - 1];
+            const double dtNext = times[i + 1] - times[i];
+            if (dtPrev + dtNext > 0.0) {
+                velocities[i] = (slope(i - 1) * dtNext + slope(i) * dtPrev) /
+                                (dtPrev + dtNext);
+            }
+        }
+        return velocities;
+    }
 } // namespace
 
 namespace {
@@ -96,47 +133,96 @@ HorizonsTranslation::HorizonsTranslation(const ghoul::Dictionary& dictionary)
         "HorizonsTranslation"
     );
 
+    // Setting the property reads the file through the onChange callback
     _horizonsTextFile = absPath(
         dictionary.value<std::string>(HorizonsTextFileInfo.identifier)
     );
-
-    // Read specified file and store it in memory.
-    readHorizonsTextFile(_horizonsTextFile);
 }
 
 glm::dvec3 HorizonsTranslation::position(const UpdateData& data) const {
-    glm::dvec3 interpolatedPos = glm::dvec3(0.0);
-
-    auto lastBefore = _timeline.lastKeyframeBefore(data.time.j2000Seconds(), true);
-    auto firstAfter = _timeline.firstKeyframeAfter(data.time.j2000Seconds(), false);
-    if (lastBefore && firstAfter) {
-        // We're inbetween first and last value.
-        double timelineDiff = firstAfter->timestamp - lastBefore->timestamp;
-        double timeDiff = data.time.j2000Seconds() - lastBefore->timestamp;
-        double diff = (timelineDiff > DBL_EPSILON) ? timeDiff / timelineDiff : 0.0;
-
-        glm::dvec3 dir = firstAfter->data - lastBefore->data;
-        interpolatedPos = lastBefore->data + dir * diff;
+    const std::shared_ptr<const Samples> samples = std::atomic_load(&_samples);
+    if (!samples || samples->times.empty()) {
+        return glm::dvec3(0.0);
+    }
+    const std::vector<double>& times = samples->times;
+    const std::vector<glm::dvec3>& positions = samples->positions;
+    const std::vector<glm::dvec3>& velocities = samples->velocities;
+
+    const double t = data.time.j2000Seconds();
+    if (t <= times.front()) {
+        // Requesting a time before first value. Return first known position.
+        return positions.front();
     }
-    else if (lastBefore) {
+    if (t >= times.back()) {
         // Requesting a time after last value. Return last known position.
-        interpolatedPos = lastBefore->data;
+        return positions.back();
     }
-    else if (firstAfter) {
-        // Requesting a time before first value. Return last known position.
-        interpolatedPos = firstAfter->data;
+
+    // We're inbetween first and last value
+    const size_t i1 = std::upper_bound(times.begin(), times.end(), t) - times.begin();
+    const size_t i0 = i1 - 1;
+    const double dt = times[i1] - times[i0];
+    if (dt <= 0.0) {
+        return positions[i0];
     }
 
-    return interpolatedPos;
+    // Cubic Hermite basis functions
+    const double s = (t - times[i0]) / dt;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    const double h10 = s3 - 2.0 * s2 + s;
+    const double h01 = -2.0 * s3 + 3.0 * s2;
+    const double h11 = s3 - s2;
+
+    return h00 * positions[i0] + h10 * dt * velocities[i0] +
+           h01 * positions[i1] + h11 * dt * velocities[i1];
+}
+
+bool HorizonsTranslation::isThreadSafe() const {
+    return true;
 }
 
 void HorizonsTranslation::readHorizonsTextFile(const std::string& horizonsTextFilePath) {
+    // The previous samples stay in use until the new ones are complete or the file
+    // turns out to be unreadable
+    auto samples = std::make_shared<Samples>();
+    std::vector<double>& times = samples->times;
+    std::vector<glm::dvec3>& positions = samples->positions;
+
+    if (!FileSys.fileExists(horizonsTextFilePath)) {
+        LERROR(fmt::format(
+            "Failed to open Horizons text file '{}'", horizonsTextFilePath
+        ));
+        std::atomic_store(&_samples, std::shared_ptr<const Samples>());
+        return;
+    }
+
+    const std::string cachedFile = FileSys.cacheManager()->cachedFilename(
+        ghoul::filesystem::File(horizonsTextFilePath),
+        "HorizonsTranslation",
+        ghoul::filesystem::CacheManager::Persistent::Yes
+    );
+    if (FileSys.fileExists(cachedFile)) {
+        LDEBUG(fmt::format(
+            "Cached file '{}' used for Horizons file '{}'",
+            cachedFile, horizonsTextFilePath
+        ));
+        if (loadCachedFile(cachedFile, *samples)) {
+            std::atomic_store(&_samples, std::shared_ptr<const Samples>(samples));
+            return;
+        }
+        // Otherwise, the cache file is overwritten below
+        *samples = Samples();
+    }
+
     std::ifstream fileStream(horizonsTextFilePath);
 
     if (!fileStream.good()) {
         LERROR(fmt::format(
             "Failed to open Horizons text file '{}'", horizonsTextFilePath
         ));
+        std::atomic_store(&_samples, std::shared_ptr<const Samples>());
         return;
     }
 
@@ -144,20 +230,21 @@ void HorizonsTranslation::readHorizonsTextFile(const std::string& horizonsTextFi
     // query that we do not care about. Ignore everything until data starts, including
     // the row marked by $$SOE (i.e. Start Of Ephemerides).
     std::string line;
-    while (line[0] != '$') {
-        std::getline(fileStream, line);
-    }
+    while (std::getline(fileStream, line) && (line.empty() || line[0] != '$')) {}
 
     // Read data line by line until $$EOE (i.e. End Of Ephemerides).
     // Skip the rest of the file.
-    std::getline(fileStream, line);
-    while (line[0] != '$') {
+    while (std::getline(fileStream, line) && (line.empty() || line[0] != '$')) {
+        if (line.empty()) {
+            continue;
+        }
+
         std::stringstream str(line);
         std::string date;
         std::string time;
-        float range = 0;
-        float gLon = 0;
-        float gLat = 0;
+        double range = 0.0;
+        double gLon = 0.0;
+        double gLat = 0.0;
 
         // File is structured by:
         // YYYY-MM-DD
@@ -178,12 +265,103 @@ void HorizonsTranslation::readHorizonsTextFile(const std::string& horizonsTextFi
             1000 * range * sin(glm::radians(gLat))
         );
 
-        // Add position to stored timeline.
-        _timeline.addKeyframe(timeInJ2000, std::move(gPos));
-
-        std::getline(fileStream, line);
+        times.push_back(timeInJ2000);
+        positions.push_back(std::move(gPos));
     }
     fileStream.close();
+
+    // Horizons exports are chronological, but we don't rely on that for the lookup
+    if (!std::is_sorted(times.begin(), times.end())) {
+        std::vector<size_t> order(times.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(
+            order.begin(),
+            order.end(),
+            [&times](size_t a, size_t b) { return times[a] < times[b]; }
+        );
+        std::vector<double> sortedTimes(order.size());
+        std::vector<glm::dvec3> sortedPositions(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            sortedTimes[i] = times[order[i]];
+            sortedPositions[i] = positions[order[i]];
+        }
+        times = std::move(sortedTimes);
+        positions = std::move(sortedPositions);
+    }
+    samples->velocities = estimateVelocities(times, positions);
+
+    saveCachedFile(cachedFile, *samples);
+    std::atomic_store(&_samples, std::shared_ptr<const Samples>(samples));
+}
+
+bool HorizonsTranslation::loadCachedFile(const std::string& file,
+                                         Samples& samples) const
+{
+    std::ifstream fileStream(file, std::ifstream::binary);
+    if (!fileStream.good()) {
+        LERROR(fmt::format("Error opening file '{}' for loading cache file", file));
+        return false;
+    }
+
+    int8_t version = 0;
+    fileStream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+    if (version != CurrentCacheVersion) {
+        LINFO("The format of the cached file has changed: deleting old cache");
+        fileStream.close();
+        FileSys.deleteFile(file);
+        return false;
+    }
+
+    uint64_t nSamples = 0;
+    fileStream.read(reinterpret_cast<char*>(&nSamples), sizeof(uint64_t));
+    samples.times.resize(nSamples);
+    samples.positions.resize(nSamples);
+    samples.velocities.resize(nSamples);
+    fileStream.read(
+        reinterpret_cast<char*>(samples.times.data()),
+        nSamples * sizeof(double)
+    );
+    fileStream.read(
+        reinterpret_cast<char*>(samples.positions.data()),
+        nSamples * sizeof(glm::dvec3)
+    );
+    fileStream.read(
+        reinterpret_cast<char*>(samples.velocities.data()),
+        nSamples * sizeof(glm::dvec3)
+    );
+
+    return fileStream.good();
+}
+
+bool HorizonsTranslation::saveCachedFile(const std::string& file,
+                                         const Samples& samples) const
+{
+    std::ofstream fileStream(file, std::ofstream::binary);
+    if (!fileStream.good()) {
+        LERROR(fmt::format("Error opening file '{}' for save cache file", file));
+        return false;
+    }
+
+    fileStream.write(
+        reinterpret_cast<const char*>(&CurrentCacheVersion),
+        sizeof(int8_t)
+    );
+    const uint64_t nSamples = samples.times.size();
+    fileStream.write(reinterpret_cast<const char*>(&nSamples), sizeof(uint64_t));
+    fileStream.write(
+        reinterpret_cast<const char*>(samples.times.data()),
+        nSamples * sizeof(double)
+    );
+    fileStream.write(
+        reinterpret_cast<const char*>(samples.positions.data()),
+        nSamples * sizeof(glm::dvec3)
+    );
+    fileStream.write(
+        reinterpret_cast<const char*>(samples.velocities.data()),
+        nSamples * sizeof(glm::dvec3)
+    );
+
+    return fileStream.good();
 }
 
 } // namespace openspace
@@ -28,10 +28,10 @@
 #include <openspace/scene/translation.h>
 
 #include <openspace/properties/stringproperty.h>
-#include <openspace/util/timeline.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/lua/luastate.h>
 #include <memory>
+#include <vector>
 
 namespace openspace {
 
@@ -48,6 +48,10 @@ namespace documentation { struct Documentation; }
  * kilometers.
  * GalLon - Galactic Longitude. User must set output to Degrees in "Table Settings".
  * GalLat - Galactic Latitude. User must set output to Degrees in "Table Settings".
+ *
+ * Positions between the samples are interpolated with cubic Hermite splines, using the
+ * velocities estimated from the neighboring samples as tangents. The parsed samples are
+ * stored in a binary cache file that is used instead of the text file on later runs.
  */
 class HorizonsTranslation : public Translation {
 public:
@@ -55,16 +59,32 @@ public:
     HorizonsTranslation(const ghoul::Dictionary& dictionary);
 
     glm::dvec3 position(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
 
     static documentation::Documentation Documentation();
 
 private:
+    struct Samples {
+        /// The sample times in seconds past J2000, sorted in ascending order
+        std::vector<double> times;
+        /// The positions in meters at each of the times
+        std::vector<glm::dvec3> positions;
+        /// The velocities in meters per second at each of the times
+        std::vector<glm::dvec3> velocities;
+    };
+
     void readHorizonsTextFile(const std::string& _horizonsTextFilePath);
+    bool loadCachedFile(const std::string& file, Samples& samples) const;
+    bool saveCachedFile(const std::string& file, const Samples& samples) const;
 
     properties::StringProperty _horizonsTextFile;
     std::unique_ptr<ghoul::filesystem::File> _fileHandle;
     ghoul::lua::LuaState _state;
-    Timeline<glm::dvec3> _timeline;
+
+    /// The samples of the current file. They are never modified after they have been
+    /// read, but replaced as a whole through atomic operations when the file changes, so
+    /// that #position can be called concurrently with a reload
+    std::shared_ptr<const Samples> _samples;
 };
 
 } // namespace openspace
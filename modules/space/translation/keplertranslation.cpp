@@ -28,6 +28,7 @@
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/defer.h>
 #include <glm/gtx/transform.hpp>
 
 namespace {
@@ -188,32 +189,52 @@ KeplerTranslation::KeplerTranslation()
     , _epoch(EpochInfo, 0.0, 0.0, 1e9)
     , _period(PeriodInfo, 0.0, 0.0, 1e6)
 {
-    auto update = [this]() {
-        _orbitPlaneDirty = true;
+    auto updateOrbit = [this]() {
+        // While all elements are set at once, they are published together afterwards
+        if (_isSettingElements) {
+            return;
+        }
+        // The orbit plane is computed right away rather than on the next position
+        // lookup, so that looking up positions does not modify the translation
+        computeOrbitPlane();
         requireUpdate();
     };
+    auto updatePosition = [this]() {
+        if (_isSettingElements) {
+            return;
+        }
+        publishElements();
+    };
 
     // Only the eccentricity, semimajor axis, inclination, and location of ascending node
     // invalidate the shape of the orbit. The other parameters only determine the location
-    // the spacecraft on that orbit
-    _eccentricity.onChange(update);
+    // the spacecraft on that orbit, so they are published to the position method without
+    // notifying the observers
+    _eccentricity.onChange(updateOrbit);
     addProperty(_eccentricity);
 
-    _semiMajorAxis.onChange(update);
+    _semiMajorAxis.onChange(updateOrbit);
     addProperty(_semiMajorAxis);
 
-    _inclination.onChange(update);
+    _inclination.onChange(updateOrbit);
     addProperty(_inclination);
 
-    _ascendingNode.onChange(update);
+    _ascendingNode.onChange(updateOrbit);
     addProperty(_ascendingNode);
 
-    _argumentOfPeriapsis.onChange(update);
+    _argumentOfPeriapsis.onChange(updateOrbit);
     addProperty(_argumentOfPeriapsis);
 
+    _meanAnomalyAtEpoch.onChange(updatePosition);
     addProperty(_meanAnomalyAtEpoch);
+
+    _epoch.onChange(updatePosition);
     addProperty(_epoch);
+
+    _period.onChange(updatePosition);
     addProperty(_period);
+
+    publishElements();
 }
 
 KeplerTranslation::KeplerTranslation(const ghoul::Dictionary& dictionary)
@@ -237,38 +258,39 @@ KeplerTranslation::KeplerTranslation(const ghoul::Dictionary& dictionary)
     );
 }
 
-double KeplerTranslation::eccentricAnomaly(double meanAnomaly) const {
+double KeplerTranslation::eccentricAnomaly(double eccentricity, double meanAnomaly) const
+{
     // Compute the eccentric anomaly (the location of the spacecraft taking the
     // eccentricity of the orbit into account) using different solves for the regimes in
     // which they are most efficient
 
-    if (_eccentricity == 0.0) {
+    if (eccentricity == 0.0) {
         // In a circular orbit, the eccentric anomaly = mean anomaly
         return meanAnomaly;
     }
-    else if (_eccentricity < 0.2) {
-        auto solver = [this, &meanAnomaly](double x) -> double {
+    else if (eccentricity < 0.2) {
+        auto solver = [eccentricity, &meanAnomaly](double x) -> double {
             // For low eccentricity, using a first order solver sufficient
-            return meanAnomaly + _eccentricity * sin(x);
+            return meanAnomaly + eccentricity * sin(x);
         };
         return solveIteration(solver, meanAnomaly, 0.0, 5);
     }
-    else if (_eccentricity < 0.9) {
-        auto solver = [this, &meanAnomaly](double x) -> double {
-            const double e = _eccentricity;
+    else if (eccentricity < 0.9) {
+        auto solver = [eccentricity, &meanAnomaly](double x) -> double {
+            const double e = eccentricity;
             return x + (meanAnomaly + e * sin(x) - x) / (1.0 - e * cos(x));
         };
         return solveIteration(solver, meanAnomaly, 0.0, 6);
     }
-    else if (_eccentricity < 1.0) {
+    else if (eccentricity < 1.0) {
         auto sign = [](double val) -> double {
             return val > 0.0 ? 1.0 : ((val < 0.0) ? -1.0 : 0.0);
         };
-        double e = meanAnomaly + 0.85 * _eccentricity * sign(sin(meanAnomaly));
+        double e = meanAnomaly + 0.85 * eccentricity * sign(sin(meanAnomaly));
 
-        auto solver = [this, &meanAnomaly, &sign](double x) -> double {
-            const double s = _eccentricity * sin(x);
-            const double c = _eccentricity * cos(x);
+        auto solver = [eccentricity, &meanAnomaly, &sign](double x) -> double {
+            const double s = eccentricity * sin(x);
+            const double c = eccentricity * cos(x);
             const double f = x - s - meanAnomaly;
             const double f1 = 1 - c;
             const double f2 = s;
@@ -285,26 +307,33 @@ double KeplerTranslation::eccentricAnomaly(double meanAnomaly) const {
 }
 
 glm::dvec3 KeplerTranslation::position(const UpdateData& data) const {
-    if (_orbitPlaneDirty) {
-        computeOrbitPlane();
-        _orbitPlaneDirty = false;
-    }
+    const std::shared_ptr<const Elements> el = std::atomic_load(&_elements);
 
-    const double t = data.time.j2000Seconds() -_epoch;
-    const double meanMotion = glm::two_pi<double>() / _period;
-    const double meanAnomaly = glm::radians(_meanAnomalyAtEpoch.value()) + t * meanMotion;
-    const double e = eccentricAnomaly(meanAnomaly);
+    const double t = data.time.j2000Seconds() - el->epoch;
+    const double meanMotion = glm::two_pi<double>() / el->period;
+    const double meanAnomaly = glm::radians(el->meanAnomalyAtEpoch) + t * meanMotion;
+    const double e = eccentricAnomaly(el->eccentricity, meanAnomaly);
 
     // Use the eccentric anomaly to compute the actual location
+    const double ecc = el->eccentricity;
     const glm::dvec3 p = {
-        _semiMajorAxis * 1000.0 * (cos(e) - _eccentricity),
-        _semiMajorAxis * 1000.0 * sin(e) * sqrt(1.0 - _eccentricity * _eccentricity),
+        el->semiMajorAxis * 1000.0 * (cos(e) - ecc),
+        el->semiMajorAxis * 1000.0 * sin(e) * sqrt(1.0 - ecc * ecc),
         0.0
     };
-    return _orbitPlaneRotation * p;
+    return el->orbitPlaneRotation * p;
+}
+
+bool KeplerTranslation::isThreadSafe() const {
+    return true;
 }
 
 void KeplerTranslation::computeOrbitPlane() const {
+    publishElements();
+    notifyObservers();
+}
+
+void KeplerTranslation::publishElements() const {
     // We assume the following coordinate system:
     // z = axis of rotation
     // x = pointing towards the first point of Aries
@@ -324,12 +353,16 @@ void KeplerTranslation::computeOrbitPlane() const {
     const double inc = glm::radians(_inclination.value());
     const double per = glm::radians(_argumentOfPeriapsis.value());
 
-    _orbitPlaneRotation = glm::rotate(asc, glm::dvec3(ascendingNodeAxisRot)) *
-                          glm::rotate(inc, glm::dvec3(inclinationAxisRot)) *
-                          glm::rotate(per, glm::dvec3(argPeriapsisAxisRot));
-
-    notifyObservers();
-    _orbitPlaneDirty = false;
+    auto elements = std::make_shared<Elements>();
+    elements->eccentricity = _eccentricity;
+    elements->semiMajorAxis = _semiMajorAxis;
+    elements->meanAnomalyAtEpoch = _meanAnomalyAtEpoch;
+    elements->epoch = _epoch;
+    elements->period = _period;
+    elements->orbitPlaneRotation = glm::rotate(asc, glm::dvec3(ascendingNodeAxisRot)) *
+                                   glm::rotate(inc, glm::dvec3(inclinationAxisRot)) *
+                                   glm::rotate(per, glm::dvec3(argPeriapsisAxisRot));
+    std::atomic_store(&_elements, std::shared_ptr<const Elements>(elements));
 }
 
 void KeplerTranslation::setKeplerElements(double eccentricity, double semiMajorAxis,
@@ -360,6 +393,15 @@ void KeplerTranslation::setKeplerElements(double eccentricity, double semiMajorA
         return val >= min && val <= max;
     };
 
+    // The elements are published once after all of them have been set, or one of them
+    // has been rejected, instead of once for every property
+    _isSettingElements = true;
+    defer {
+        _isSettingElements = false;
+        computeOrbitPlane();
+        requireUpdate();
+    };
+
     if (isInRange(eccentricity, 0.0, 1.0)) {
         _eccentricity = eccentricity;
     }
@@ -398,8 +440,6 @@ void KeplerTranslation::setKeplerElements(double eccentricity, double semiMajorA
 
     _period = orbitalPeriod;
     _epoch = epoch;
-
-    computeOrbitPlane();
 }
 
 } // namespace openspace
@@ -32,6 +32,7 @@
 #include <ghoul/glm.h>
 #include <ghoul/misc/exception.h>
 #include <openspace/util/time.h>
+#include <memory>
 
 namespace openspace {
 
@@ -69,6 +70,7 @@ public:
     * \param time The time to use when doing the position lookup
     */
     glm::dvec3 position(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
 
     /**
      * Method returning the openspace::Documentation that describes the ghoul::Dictinoary
@@ -124,20 +126,26 @@ public:
     /// Default construct that initializes all the properties and member variables
     KeplerTranslation();
 
-    /// Recombutes the rotation matrix used in the update method
+    /// Recomputes the rotation matrix of the orbit plane, publishes it together with the
+    /// current values of the elements to the position method, and notifies observers
     void computeOrbitPlane() const;
 
 private:
+    /// Publishes the current values of the elements and the rotation matrix of the
+    /// orbit plane to the position method without notifying observers
+    void publishElements() const;
+
     /**
      * This method computes the eccentric anomaly (location of the space craft taking the
      * eccentricity into acount) based on the mean anomaly (location of the space craft
      * assuming an eccentricity of 0.0).
      *
+     * \param eccentricity The eccentricity of the orbit
      * \param meanAnomaly The mean anomaly for which the eccentric anomaly shall be
      *        computed
      * \return The eccentric anomaly for the provided \p meanAnomaly
      */
-    double eccentricAnomaly(double meanAnomaly) const;
+    double eccentricAnomaly(double eccentricity, double meanAnomaly) const;
 
     /// The eccentricity of the orbit in [0, 1)
     properties::DoubleProperty _eccentricity;
@@ -157,10 +165,23 @@ private:
     /// The period of the orbit in seconds
     properties::DoubleProperty _period;
 
-    /// Dirty flag for the _orbitPlaneRotation parameters
-    mutable bool _orbitPlaneDirty = true;
-    /// The rotation matrix that defines the plane of the orbit
-    mutable glm::dmat3 _orbitPlaneRotation = glm::dmat3(1.0);
+    /// The values of the elements that are used by the position method
+    struct Elements {
+        double eccentricity = 0.0;
+        double semiMajorAxis = 0.0;
+        double meanAnomalyAtEpoch = 0.0;
+        double epoch = 0.0;
+        double period = 0.0;
+        /// The rotation matrix that defines the plane of the orbit
+        glm::dmat3 orbitPlaneRotation = glm::dmat3(1.0);
+    };
+    /// The elements are never modified after they have been computed, but replaced as a
+    /// whole through atomic operations whenever a property changes, so that positions
+    /// can be computed on other threads while the properties are changed
+    mutable std::shared_ptr<const Elements> _elements;
+    /// Set while setKeplerElements is changing the properties, which suppresses their
+    /// individual publishing
+    bool _isSettingElements = false;
 
     /// The cached position for the last time with which the update method was called
     glm::dvec3 _position = glm::dvec3(0.0);
@@ -24,8 +24,10 @@
 
 #include <modules/space/translation/spicetranslation.h>
 
+#include <modules/space/ephemeriscache.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/util/spiceexecutor.h>
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/time.h>
 #include <openspace/util/updatestructures.h>
@@ -60,6 +62,22 @@ namespace {
         "This is the SPICE NAIF name for the reference frame in which the position "
         "should be retrieved. The default value is GALACTIC."
     };
+
+    constexpr openspace::properties::Property::PropertyInfo UseCacheInfo = {
+        "UseEphemerisCache",
+        "Use Ephemeris Cache",
+        "If this value is enabled, the position is computed from polynomials that are "
+        "fitted to the SPICE kernels and stored in the cache directory, rather than "
+        "evaluating the kernels directly. The default value is false."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CacheToleranceInfo = {
+        "EphemerisCacheTolerance",
+        "Ephemeris Cache Tolerance",
+        "The largest distance (in meters) by which each coordinate of a cached position "
+        "may differ from the position computed by SPICE. Where the polynomials cannot "
+        "reach this tolerance, the kernels are evaluated directly."
+    };
 } // namespace
 
 namespace openspace {
@@ -98,6 +116,18 @@ documentation::Documentation SpiceTranslation::Documentation() {
                 Optional::Yes,
                 FrameInfo.description
             },
+            {
+                UseCacheInfo.identifier,
+                new BoolVerifier,
+                Optional::Yes,
+                UseCacheInfo.description
+            },
+            {
+                CacheToleranceInfo.identifier,
+                new DoubleGreaterVerifier(0.0),
+                Optional::Yes,
+                CacheToleranceInfo.description
+            },
             {
                 KeyKernels,
                 new OrVerifier({ new StringListVerifier, new StringVerifier }),
@@ -114,6 +144,8 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
     : _target(TargetInfo)
     , _observer(ObserverInfo)
     , _frame(FrameInfo, DefaultReferenceFrame)
+    , _useCache(UseCacheInfo, false)
+    , _cacheTolerance(CacheToleranceInfo, 0.01, 1e-6, 1e3)
 {
     documentation::testSpecificationAndThrow(
         Documentation(),
@@ -128,6 +160,14 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
         _frame = dictionary.value<std::string>(FrameInfo.identifier);
     }
 
+    if (dictionary.hasKey(UseCacheInfo.identifier)) {
+        _useCache = dictionary.value<bool>(UseCacheInfo.identifier);
+    }
+
+    if (dictionary.hasKey(CacheToleranceInfo.identifier)) {
+        _cacheTolerance = dictionary.value<double>(CacheToleranceInfo.identifier);
+    }
+
     auto loadKernel = [](const std::string& kernel) {
         if (!FileSys.fileExists(kernel)) {
             throw SpiceManager::SpiceException("Kernel '" + kernel + "' does not exist");
@@ -157,6 +197,7 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
     }
 
     auto update = [this](){
+        resolveQuery();
         requireUpdate();
         notifyObservers();
     };
@@ -169,18 +210,82 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
 
     _frame.onChange(update);
     addProperty(_frame);
+
+    _useCache.onChange(update);
+    addProperty(_useCache);
+
+    _cacheTolerance.onChange(update);
+    addProperty(_cacheTolerance);
+
+    resolveQuery();
+}
+
+bool SpiceTranslation::initialize() {
+    resolveQuery();
+    return Translation::initialize();
+}
+
+void SpiceTranslation::resolveQuery() {
+    auto query = std::make_shared<Query>();
+    query->target = _target;
+    query->observer = _observer;
+    query->frame = _frame;
+
+    try {
+        query->query = SpiceManager::ref().positionQuery(
+            query->target,
+            query->observer,
+            query->frame
+        );
+    }
+    catch (const SpiceManager::SpiceException&) {}
+
+    if (_useCache) {
+        // The cache works in the units of SPICE, kilometers
+        query->cache = EphemerisCache::positionCache(
+            query->target,
+            query->observer,
+            query->frame,
+            _cacheTolerance / 1000.0
+        );
+    }
+
+    std::atomic_store(&_query, std::shared_ptr<const Query>(query));
 }
 
 glm::dvec3 SpiceTranslation::position(const UpdateData& data) const {
-    double lightTime = 0.0;
-    return SpiceManager::ref().targetPosition(
-        _target,
-        _observer,
-        _frame,
-        {},
-        data.time.j2000Seconds(),
-        lightTime
-    ) * glm::pow(10.0, 3.0);
+    // The copy keeps the query alive while it is in use, even if it is replaced
+    const std::shared_ptr<const Query> query = std::atomic_load(&_query);
+
+    glm::dvec3 cachedPosition;
+    if (query->cache && query->cache->position(data.time.j2000Seconds(), cachedPosition))
+    {
+        return cachedPosition * glm::pow(10.0, 3.0);
+    }
+
+    // The request goes through the executor so that positions can be computed for
+    // multiple scene graph nodes concurrently
+    SpiceExecutor::PositionRequest request;
+    if (query->query.has_value()) {
+        request.query = &*query->query;
+    }
+    else {
+        request.target = query->target;
+        request.observer = query->observer;
+        request.referenceFrame = query->frame;
+    }
+    request.time = data.time.j2000Seconds();
+
+    const std::vector<SpiceExecutor::Result> results =
+        SpiceManager::ref().executor().execute({ request });
+    return results[0].get<SpiceExecutor::PositionResult>().position *
+           glm::pow(10.0, 3.0);
+}
+
+bool SpiceTranslation::isThreadSafe() const {
+    // The query is replaced atomically, the cache is safe to be used concurrently, and
+    // all other requests go through the SpiceExecutor
+    return true;
 }
 
 } // namespace openspace
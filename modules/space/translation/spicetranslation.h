@@ -27,24 +27,58 @@
 
 #include <openspace/scene/translation.h>
 
+#include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/stringproperty.h>
+#include <openspace/util/spicemanager.h>
+#include <memory>
+#include <optional>
 
 namespace openspace {
 
+class EphemerisCache;
+
 class SpiceTranslation : public Translation {
 public:
     SpiceTranslation(const ghoul::Dictionary& dictionary);
 
+    bool initialize() override;
+
     glm::dvec3 position(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
 
     static documentation::Documentation Documentation();
 
 private:
+    /// Resolves the target, observer, and frame names into the cached position query and
+    /// selects the ephemeris cache for them
+    void resolveQuery();
+
     properties::StringProperty _target;
     properties::StringProperty _observer;
     properties::StringProperty _frame;
+    properties::BoolProperty _useCache;
+    properties::DoubleProperty _cacheTolerance;
 
     glm::dvec3 _position = glm::dvec3(0.0);
+
+    /// Everything the position method needs to know about the current properties
+    struct Query {
+        std::string target;
+        std::string observer;
+        std::string frame;
+
+        /// Empty if the names could not be resolved, in which case they are looked up on
+        /// every call to position, which reports the error
+        std::optional<SpiceManager::PositionQuery> query;
+
+        /// The cached approximation of the position, if the cache is enabled
+        std::shared_ptr<EphemerisCache> cache;
+    };
+    /// The query is never modified after it has been resolved, but replaced as a whole
+    /// through atomic operations whenever a property changes, so that positions can be
+    /// computed on other threads while the properties are changed
+    std::shared_ptr<const Query> _query;
 };
 
 } // namespace openspace
@@ -61,16 +61,16 @@ public:
 
 private:
     /**
-     * Reads the provided TLE file and calles the KeplerTranslation::setKeplerElments
-     * method with the correct values. If \p filename is a valid TLE file but contains
-     * disallowed values (see KeplerTranslation::setKeplerElements), a
-     * KeplerTranslation::RangeError is thrown.
+     * Reads the provided TLE file through kepler::readTleEntry and calls the
+     * KeplerTranslation::setKeplerElments method with the correct values. If
+     * \p filename is a valid TLE file but contains disallowed values (see
+     * KeplerTranslation::setKeplerElements), a KeplerTranslation::RangeError is thrown.
      *
      * \param filename The path to the file that contains the TLE file.
      * \param lineNum The line number in the file where the set of 3 TLE lines starts
      *
-     * \throw std::system_error if the TLE file is malformed (does not contain at least
-     *        two lines that start with \c 1 and \c 2.
+     * \throw ghoul::RuntimeError if the TLE file is malformed (does not contain at least
+     *        two lines that start with \c 1 and \c 2 after \p lineNum)
      * \throw KeplerTranslation::RangeError If the Keplerian elements are outside of
      *        the valid range supported by Kepler::setKeplerElements
      * \pre The \p filename must exist
@@ -31,6 +31,7 @@
 #include <openspace/engine/globals.h>
 #include <openspace/engine/moduleengine.h>
 #include <openspace/rendering/renderengine.h>
+#include <openspace/util/spiceexecutor.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
@@ -500,21 +501,11 @@ bool RenderableFov::isReady() const {
 }
 
 // Orthogonal projection next to planets surface
-glm::dvec3 RenderableFov::orthogonalProjection(const glm::dvec3& vecFov, double time,
-                                               const std::string& target) const
+glm::dvec3 RenderableFov::orthogonalProjection(const glm::dvec3& vecFov,
+                                               const glm::dvec3& vecToTarget,
+                                           const glm::dmat3& instrumentToReference) const
 {
-    const glm::dvec3 vecToTarget = SpiceManager::ref().targetPosition(
-        target,
-        _instrument.spacecraft,
-        _instrument.referenceFrame,
-        _instrument.aberrationCorrection,
-        time
-    );
-    const glm::dvec3 fov = SpiceManager::ref().frameTransformationMatrix(
-        _instrument.name,
-        _instrument.referenceFrame,
-        time
-    ) * vecFov;
+    const glm::dvec3 fov = instrumentToReference * vecFov;
     const glm::dvec3 p = glm::proj(vecToTarget, fov);
     return p  * 1000.0; // km -> m
 }
@@ -539,6 +530,96 @@ void RenderableFov::computeIntercepts(const UpdateData& data, const std::string&
         }
     };
 
+    const double time = data.time.j2000Seconds();
+    const std::pair<std::string, bool> ref = makeBodyFixedReferenceFrame(
+        _instrument.referenceFrame
+    );
+
+    // All SPICE requests of this frame are submitted as a single batch. The first two
+    // are needed for the orthogonal projections
+    std::vector<SpiceExecutor::Request> requests;
+    {
+        SpiceExecutor::PositionRequest toTarget;
+        toTarget.target = target;
+        toTarget.observer = _instrument.spacecraft;
+        toTarget.referenceFrame = _instrument.referenceFrame;
+        toTarget.aberrationCorrection = _instrument.aberrationCorrection;
+        toTarget.time = time;
+        requests.push_back(std::move(toTarget));
+
+        SpiceExecutor::TransformMatrixRequest instrumentToReference;
+        instrumentToReference.from = _instrument.name;
+        instrumentToReference.to = _instrument.referenceFrame;
+        instrumentToReference.time = time;
+        requests.push_back(std::move(instrumentToReference));
+    }
+
+    // If the target is in the field of view, the surface intercepts of the field-of-view
+    // bounds and of the interpolated points between them follow
+    const size_t boundsOffset = requests.size();
+    const size_t planeOffset = boundsOffset + _instrument.bounds.size();
+    if (isInFov) {
+        auto intercept = [&](const glm::dvec3& probe) {
+            SpiceExecutor::SurfaceInterceptRequest r;
+            r.target = target;
+            r.observer = _instrument.spacecraft;
+            r.fovFrame = _instrument.name;
+            r.referenceFrame = ref.first;
+            r.aberrationCorrection = _instrument.aberrationCorrection;
+            r.time = time;
+            r.direction = probe;
+            return r;
+        };
+
+        for (const glm::dvec3& bound : _instrument.bounds) {
+            requests.push_back(intercept(bound));
+        }
+        for (size_t i = 0; i < _instrument.bounds.size(); ++i) {
+            // Wrap around the array index to 0
+            const size_t j = (i == _instrument.bounds.size() - 1) ? 0 : i + 1;
+            for (size_t m = 0; m < InterpolationSteps; ++m) {
+                const double t = static_cast<double>(m) / (InterpolationSteps);
+                requests.push_back(
+                    intercept(glm::mix(_instrument.bounds[i], _instrument.bounds[j], t))
+                );
+            }
+        }
+    }
+
+    // If we had to convert the reference frame into a body-fixed frame, the intercepts
+    // have to be transformed back
+    const size_t bodyFixedIndex = requests.size();
+    if (isInFov && ref.second) {
+        SpiceExecutor::TransformMatrixRequest bodyFixedToReference;
+        bodyFixedToReference.from = ref.first;
+        bodyFixedToReference.to = _instrument.referenceFrame;
+        bodyFixedToReference.time = time;
+        requests.push_back(std::move(bodyFixedToReference));
+    }
+
+    const std::vector<SpiceExecutor::Result> results =
+        SpiceManager::ref().executor().execute(std::move(requests));
+
+    auto projection = [&](const glm::dvec3& probe) -> glm::vec3 {
+        return orthogonalProjection(
+            probe,
+            results[0].get<SpiceExecutor::PositionResult>().position,
+            results[1].get<glm::dmat3>()
+        );
+    };
+
+    // Computes the intercept vector between the 'probe' and the target
+    // the intercept vector is in meter and contains a standoff distance offset
+    auto interceptVector = [&](SpiceManager::SurfaceInterceptResult r) -> glm::dvec3 {
+        if (ref.second) {
+            r.surfaceVector = results[bodyFixedIndex].get<glm::dmat3>() * r.surfaceVector;
+        }
+
+        // Convert the KM scale that SPICE uses to meter
+        // Standoff distance, we would otherwise end up *exactly* on the surface
+        return r.surfaceVector * 1000.0 * _standOffDistance.value();
+    };
+
     //std::vector<bool> intersects(_instrument.bounds.size());
 
     // First we fill the field-of-view bounds array by testing each bounds vector against
@@ -558,11 +639,7 @@ void RenderableFov::computeIntercepts(const UpdateData& data, const std::string&
         if (!isInFov) {
             // If the target is not in the field of view, we don't need to perform any
             // surface intercepts
-            const glm::vec3 o = orthogonalProjection(
-                bound,
-                data.time.j2000Seconds(),
-                target
-            );
+            const glm::vec3 o = projection(bound);
 
             second = {
                 { o.x, o.y, o.z },
@@ -573,19 +650,8 @@ void RenderableFov::computeIntercepts(const UpdateData& data, const std::string&
         else {
             // The target is in the field of view, but not the entire field of view has to
             // be filled by the target
-            std::pair<std::string, bool> ref = makeBodyFixedReferenceFrame(
-                _instrument.referenceFrame
-            );
-
-            SpiceManager::SurfaceInterceptResult r = SpiceManager::ref().surfaceIntercept(
-                target,
-                _instrument.spacecraft,
-                _instrument.name,
-                ref.first,
-                _instrument.aberrationCorrection,
-                data.time.j2000Seconds(),
-                bound
-            );
+            const SpiceManager::SurfaceInterceptResult& r =
+                results[boundsOffset + i].get<SpiceManager::SurfaceInterceptResult>();
 
             //intersects[i] = r.interceptFound;
 
@@ -593,21 +659,8 @@ void RenderableFov::computeIntercepts(const UpdateData& data, const std::string&
                 // This point intersected the target
                 first.color = RenderInformation::VertexColorTypeIntersectionStart;
 
-                // If we had to convert the reference frame into a body-fixed frame, we
-                // need to apply this change here:
-                if (ref.second) {
-                    r.surfaceVector = SpiceManager::ref().frameTransformationMatrix(
-                        ref.first,
-                        _instrument.referenceFrame,
-                        data.time.j2000Seconds()
-                    ) * r.surfaceVector;
-                }
-
-                // Convert the KM scale that SPICE uses to meter
-                glm::vec3 srfVec = r.surfaceVector * 1000.0;
-
-                // Standoff distance, we would otherwise end up *exactly* on the surface
-                srfVec *= _standOffDistance;
+                // The standoff distance keeps us from ending up *exactly* on the surface
+                const glm::vec3 srfVec = interceptVector(r);
 
                 second = {
                     { srfVec.x, srfVec.y, srfVec.z },
@@ -616,11 +669,7 @@ void RenderableFov::computeIntercepts(const UpdateData& data, const std::string&
             }
             else {
                 // This point did not intersect the target though others did
-                const glm::vec3 o = orthogonalProjection(
-                    bound,
-                    data.time.j2000Seconds(),
-                    target
-                );
+                const glm::vec3 o = projection(bound);
                 second = {
                     { o.x, o.y, o.z },
                     RenderInformation::VertexColorTypeInFieldOfView
@@ -664,65 +713,23 @@ void RenderableFov::computeIntercepts(const UpdateData& data, const std::string&
             const glm::dvec3& iBound = _instrument.bounds[i];
             const glm::dvec3& jBound = _instrument.bounds[j];
 
-            auto intercepts = [&](const glm::dvec3& probe) -> bool {
-                return SpiceManager::ref().surfaceIntercept(
-                    target,
-                    _instrument.spacecraft,
-                    _instrument.name,
-                    makeBodyFixedReferenceFrame(_instrument.referenceFrame).first,
-                    _instrument.aberrationCorrection,
-                    data.time.j2000Seconds(),
-                    probe
-                ).interceptFound;
-            };
-
-            // Computes the intercept vector between the 'probe' and the target
-            // the intercept vector is in meter and contains a standoff distance offset
-            auto interceptVector = [&](const glm::dvec3& probe) -> glm::dvec3 {
-                auto ref = makeBodyFixedReferenceFrame(_instrument.referenceFrame);
-                SpiceManager::SurfaceInterceptResult r =
-                    SpiceManager::ref().surfaceIntercept(
-                        target,
-                        _instrument.spacecraft,
-                        _instrument.name,
-                        ref.first,
-                        _instrument.aberrationCorrection,
-                        data.time.j2000Seconds(),
-                        probe
-                    );
-
-                if (ref.second) {
-                    r.surfaceVector = SpiceManager::ref().frameTransformationMatrix(
-                        ref.first,
-                        _instrument.referenceFrame,
-                        data.time.j2000Seconds()
-                    ) * r.surfaceVector;
-                }
-
-                // Convert the KM scale that SPICE uses to meter
-                // Standoff distance, we would otherwise end up *exactly* on the surface
-                return r.surfaceVector * 1000.0 * _standOffDistance.value();
-            };
-
             for (size_t m = 0; m < InterpolationSteps; ++m) {
-                const double t = static_cast<double>(m) / (InterpolationSteps);
-                const glm::dvec3 tBound = glm::mix(iBound, jBound, t);
+                const size_t index = indexForBounds(i) + m;
+                using Intercept = SpiceManager::SurfaceInterceptResult;
+                const Intercept& r = results[planeOffset + index].get<Intercept>();
 
-                if (intercepts(tBound)) {
-                    const glm::vec3 icpt = interceptVector(tBound);
-                    _orthogonalPlane.data[indexForBounds(i) + m] = {
+                if (r.interceptFound) {
+                    const glm::vec3 icpt = interceptVector(r);
+                    _orthogonalPlane.data[index] = {
                         { icpt.x, icpt.y, icpt.z },
                         RenderInformation::VertexColorTypeSquare
                     };
                 }
                 else {
-                    const glm::vec3 o = orthogonalProjection(
-                        tBound,
-                        data.time.j2000Seconds(),
-                        target
-                    );
+                    const double t = static_cast<double>(m) / (InterpolationSteps);
+                    const glm::vec3 o = projection(glm::mix(iBound, jBound, t));
 
-                    _orthogonalPlane.data[indexForBounds(i) + m] = {
+                    _orthogonalPlane.data[index] = {
                         { o.x, o.y, o.z },
                         RenderInformation::VertexColorTypeSquare
                     };
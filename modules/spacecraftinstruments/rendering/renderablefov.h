@@ -84,8 +84,8 @@ private:
     void computeIntercepts(const UpdateData& data, const std::string& target,
         bool isInFov);
 
-    glm::dvec3 orthogonalProjection(const glm::dvec3& vecFov, double time,
-        const std::string& target) const;
+    glm::dvec3 orthogonalProjection(const glm::dvec3& vecFov,
+        const glm::dvec3& vecToTarget, const glm::dmat3& instrumentToReference) const;
     glm::dvec3 checkForIntercept(const glm::dvec3& ray, double time,
         const std::string& target) const;
 
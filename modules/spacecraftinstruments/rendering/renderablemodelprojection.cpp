@@ -179,6 +179,12 @@ bool RenderableModelProjection::isReady() const {
            _projectionComponent.isReady();
 }
 
+bool RenderableModelProjection::isCullable() const {
+    // The image projections happen in the render call and have to take place even if
+    // the object itself is not visible
+    return false;
+}
+
 void RenderableModelProjection::initializeGL() {
     _programObject = global::renderEngine.buildRenderProgram(
         "ModelShader",
@@ -435,31 +441,18 @@ void RenderableModelProjection::imageProjectGPU(
 }
 
 void RenderableModelProjection::attitudeParameters(double time) {
-    try {
-        _instrumentMatrix = SpiceManager::ref().positionTransformMatrix(
-            _projectionComponent.instrumentId(),
-            DestinationFrame,
-            time
-        );
+    const std::vector<SpiceExecutor::Result> results =
+        _projectionComponent.requestAttitude(time, DestinationFrame);
 
-        SpiceManager::FieldOfViewResult res = SpiceManager::ref().fieldOfView(
-            _projectionComponent.instrumentId()
-        );
-        _boresight = std::move(res.boresightVector);
+    try {
+        _instrumentMatrix = results[0].get<glm::dmat3>();
+        _boresight = results[1].get<SpiceManager::FieldOfViewResult>().boresightVector;
     }
     catch (const SpiceManager::SpiceException&) {
         return;
     }
 
-    double lightTime;
-    const glm::dvec3 p = SpiceManager::ref().targetPosition(
-        _projectionComponent.projectorId(),
-        _projectionComponent.projecteeId(),
-        DestinationFrame,
-        _projectionComponent.aberration(),
-        time,
-        lightTime
-    );
+    const glm::dvec3 p = results[2].get<SpiceExecutor::PositionResult>().position;
 
     const glm::vec3 cpos = p * 10000.0;
 
@@ -56,6 +56,7 @@ public:
     void deinitializeGL() override;
 
     bool isReady() const override;
+    bool isCullable() const override;
 
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     virtual void update(const UpdateData& data) final override;
@@ -465,6 +465,12 @@ bool RenderablePlanetProjection::isReady() const {
     return _geometry && _programObject && _projectionComponent.isReady();
 }
 
+bool RenderablePlanetProjection::isCullable() const {
+    // The image projections happen in the render call and have to take place even if
+    // the object itself is not visible
+    return false;
+}
+
 void RenderablePlanetProjection::imageProjectGPU(
                                           const ghoul::opengl::Texture& projectionTexture)
 {
@@ -509,34 +515,24 @@ void RenderablePlanetProjection::imageProjectGPU(
 }
 
 void RenderablePlanetProjection::attitudeParameters(double time) {
+    const std::vector<SpiceExecutor::Result> results =
+        _projectionComponent.requestAttitude(time, _mainFrame);
+
     // precomputations for shader
-    _instrumentMatrix = SpiceManager::ref().positionTransformMatrix(
-        _projectionComponent.instrumentId(), _mainFrame, time
-    );
+    _instrumentMatrix = results[0].get<glm::dmat3>();
 
     _transform = glm::mat4(_stateMatrix);
 
     glm::dvec3 bs = glm::dvec3(0.0);
     try {
-        SpiceManager::FieldOfViewResult res = SpiceManager::ref().fieldOfView(
-            _projectionComponent.instrumentId()
-        );
-        bs = std::move(res.boresightVector);
+        bs = results[1].get<SpiceManager::FieldOfViewResult>().boresightVector;
     }
     catch (const SpiceManager::SpiceException& e) {
         LERRORC(e.component, e.what());
         return;
     }
 
-    double lightTime;
-    glm::dvec3 p = SpiceManager::ref().targetPosition(
-        _projectionComponent.projectorId(),
-        _projectionComponent.projecteeId(),
-        _mainFrame,
-        _projectionComponent.aberration(),
-        time,
-        lightTime
-    ) * 1000.0;
+    glm::dvec3 p = results[2].get<SpiceExecutor::PositionResult>().position * 1000.0;
 
     const double distance = glm::length(p);
     const double radius = boundingSphere();
@@ -49,6 +49,7 @@ public:
     void initializeGL() override;
     void deinitializeGL() override;
     bool isReady() const override;
+    bool isCullable() const override;
 
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     void update(const UpdateData& data) override;
@@ -930,6 +930,32 @@ ghoul::opengl::Texture& ProjectionComponent::projectionTexture() const {
     }
 }
 
+std::vector<SpiceExecutor::Result> ProjectionComponent::requestAttitude(double time,
+                                                           const std::string& frame) const
+{
+    SpiceExecutor::TransformMatrixRequest instrumentMatrix;
+    instrumentMatrix.from = _instrumentID;
+    instrumentMatrix.to = frame;
+    instrumentMatrix.time = time;
+    instrumentMatrix.estimateUncovered = true;
+
+    SpiceExecutor::FieldOfViewRequest fieldOfView;
+    fieldOfView.instrument = _instrumentID;
+
+    SpiceExecutor::PositionRequest position;
+    position.target = _projectorID;
+    position.observer = _projecteeID;
+    position.referenceFrame = frame;
+    position.aberrationCorrection = _aberration;
+    position.time = time;
+
+    return SpiceManager::ref().executor().execute({
+        std::move(instrumentMatrix),
+        std::move(fieldOfView),
+        std::move(position)
+    });
+}
+
 std::string ProjectionComponent::projectorId() const {
     return _projectorID;
 }
@@ -31,6 +31,7 @@
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/vector/ivec2property.h>
+#include <openspace/util/spiceexecutor.h>
 #include <openspace/util/spicemanager.h>
 #include <ghoul/opengl/ghoul_gl.h>
 
@@ -72,6 +73,16 @@ public:
         const glm::vec3 up, const glm::dmat3& instrumentMatrix, float fieldOfViewY,
         float aspectRatio, float nearPlane, float farPlane, glm::vec3& boreSight);
 
+    /**
+     * Requests the SPICE values that are needed to project an image taken at the
+     * \p time as a single batch. The results are, in this order, the transformation from
+     * the instrument frame into the \p frame (a glm::dmat3), the field of view of the
+     * instrument, and the position of the projector relative to the projectee in the
+     * \p frame (a SpiceExecutor::PositionResult).
+     */
+    std::vector<SpiceExecutor::Result> requestAttitude(double time,
+        const std::string& frame) const;
+
     bool doesPerformProjection() const;
     bool needsClearProjection() const;
     bool needsMipMapGeneration() const;
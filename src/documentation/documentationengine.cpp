@@ -187,7 +187,7 @@ void DocumentationEngine::addHandlebarTemplates(std::vector<HandlebarTemplate> t
     );
 }
 
-std::vector<Documentation> DocumentationEngine::documentations() const {
+const std::vector<Documentation>& DocumentationEngine::documentations() const {
     return _documentations;
 }
 
@@ -246,7 +246,9 @@ TestResult ReferencingVerifier::operator()(const ghoul::Dictionary& dictionary,
 {
     TestResult res = TableVerifier::operator()(dictionary, key);
     if (res.success) {
-        std::vector<Documentation> docs = DocEng.documentations();
+        // Copying all registered documentations for every referenced table would cost
+        // more than the test itself
+        const std::vector<Documentation>& docs = DocEng.documentations();
 
         auto it = std::find_if(
             docs.begin(),
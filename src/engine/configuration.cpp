@@ -84,11 +84,17 @@ namespace {
     constexpr const char* KeyVersionCheckUrl = "VersionCheckUrl";
     constexpr const char* KeyUseMultithreadedInitialization =
                                                          "UseMultithreadedInitialization";
+    constexpr const char* KeyUseMultithreadedUpdate = "UseMultithreadedUpdate";
+    constexpr const char* KeyInitializeGLBudget = "InitializeGLBudget";
+    constexpr const char* KeyDeferDisabledRenderables = "DeferDisabledRenderables";
     constexpr const char* KeyLoadingScreen = "LoadingScreen";
     constexpr const char* KeyShowMessage = "ShowMessage";
     constexpr const char* KeyShowNodeNames = "ShowNodeNames";
     constexpr const char* KeyShowProgressbar = "ShowProgressbar";
     constexpr const char* KeyModuleConfigurations = "ModuleConfigurations";
+    constexpr const char* KeyStartupTrace = "StartupTrace";
+    constexpr const char* KeyFile = "File";
+    constexpr const char* KeySummaryCount = "SummaryCount";
 
     template <typename T>
     void getValue(ghoul::lua::LuaState& L, const char* name, T& value) {
@@ -206,6 +212,18 @@ namespace {
             d.getValue(KeyShowProgressbar, v.isShowingProgressbar);
         }
         // NOLINTNEXTLINE
+        else if constexpr (std::is_same_v<T, Configuration::StartupTrace>) {
+            Configuration::StartupTrace& v =
+                static_cast<Configuration::StartupTrace&>(value);
+            ghoul::Dictionary d = ghoul::lua::value<ghoul::Dictionary>(L);
+
+            d.getValue(KeyActivate, v.isActive);
+            d.getValue(KeyFile, v.file);
+            double count = static_cast<double>(v.summaryCount);
+            d.getValue(KeySummaryCount, count);
+            v.summaryCount = static_cast<int>(count);
+        }
+        // NOLINTNEXTLINE
         else if constexpr (std::is_same_v<T, Configuration::OpenGLDebugContext>) {
             Configuration::OpenGLDebugContext& v =
                 static_cast<Configuration::OpenGLDebugContext&>(value);
@@ -285,6 +303,9 @@ void parseLuaState(Configuration& configuration) {
     getValue(s, KeyScriptLog, c.scriptLog);
     getValue(s, KeyVersionCheckUrl, c.versionCheckUrl);
     getValue(s, KeyUseMultithreadedInitialization, c.useMultithreadedInitialization);
+    getValue(s, KeyUseMultithreadedUpdate, c.useMultithreadedUpdate);
+    getValue(s, KeyInitializeGLBudget, c.initializeGLBudget);
+    getValue(s, KeyDeferDisabledRenderables, c.deferDisabledRenderables);
     getValue(s, KeyCheckOpenGLState, c.isCheckingOpenGLState);
     getValue(s, KeyLogEachOpenGLCall, c.isLoggingOpenGLCalls);
     getValue(s, KeyShutdownCountdown, c.shutdownCountdown);
@@ -301,6 +322,7 @@ void parseLuaState(Configuration& configuration) {
     getValue(s, KeyLogging, c.logging);
     getValue(s, KeyDocumentation, c.documentation);
     getValue(s, KeyLoadingScreen, c.loadingScreen);
+    getValue(s, KeyStartupTrace, c.startupTrace);
     getValue(s, KeyModuleConfigurations, c.moduleConfigurations);
     getValue(s, KeyOpenGLDebugContext, c.openGLDebugContext);
     getValue(s, KeyHttpProxy, c.httpProxy);
@@ -393,6 +393,37 @@ documentation::Documentation Configuration::Documentation = {
             "initialize in parallel. The only use for this value is to disable it for "
             "debugging support."
         },
+        {
+            KeyUseMultithreadedUpdate,
+            new BoolVerifier,
+            Optional::Yes,
+            "This value determines whether the transformations of scene graph nodes that "
+            "do not depend on each other should be updated in parallel each frame. The "
+            "result is the same as updating them one after another, so the only use for "
+            "disabling this value is debugging support. This defaults to 'false'."
+        },
+        {
+            KeyInitializeGLBudget,
+            new DoubleGreaterEqualVerifier(0.0),
+            Optional::Yes,
+            "The time in milliseconds that is spent each frame on the OpenGL "
+            "initialization of scene graph nodes that have finished their "
+            "initialization. Remaining nodes are initialized in the following frames, "
+            "which keeps the loading screen and the user interface responsive while "
+            "large scenes are loaded. At least one node is initialized per frame. If "
+            "this value is 0, all available nodes are initialized at once. This "
+            "defaults to 10."
+        },
+        {
+            KeyDeferDisabledRenderables,
+            new BoolVerifier,
+            Optional::Yes,
+            "If this value is 'true', renderables that are disabled when the scene is "
+            "loaded are not initialized during the startup. Instead, their "
+            "initialization happens in the background the first time they are "
+            "enabled, which reduces the startup time and memory usage of scenes with "
+            "many disabled renderables. This defaults to 'false'."
+        },
         {
             KeyLoadingScreen,
             new TableVerifier({
@@ -423,6 +454,38 @@ documentation::Documentation Configuration::Documentation = {
             "Values in this table describe the behavior of the loading screen that is "
             "displayed while the scene graph is created and initialized."
         },
+        {
+            KeyStartupTrace,
+            new TableVerifier({
+                {
+                    KeyActivate,
+                    new BoolVerifier,
+                    Optional::Yes,
+                    "If this value is set to 'true', the time spent in each stage of the "
+                    "startup (module initialization, asset loading, synchronizations, "
+                    "and the initialization of each scene graph node) is recorded."
+                },
+                {
+                    KeyFile,
+                    new StringVerifier,
+                    Optional::Yes,
+                    "If this value is specified, the recorded startup trace is written "
+                    "to this file in the Chrome trace event format once the loading is "
+                    "finished. The trace can also be written at any later point by "
+                    "calling 'openspace.writeStartupTrace'."
+                },
+                {
+                    KeySummaryCount,
+                    new IntVerifier,
+                    Optional::Yes,
+                    "The number of slowest assets and scene graph nodes that are logged "
+                    "once the loading is finished. The default value is 10."
+                }
+            }),
+            Optional::Yes,
+            "Values in this table control the tracing of the application's startup "
+            "that is used to find out where the time is spent while loading."
+        },
         {
             KeyModuleConfigurations,
             new TableVerifier,
@@ -41,6 +41,7 @@
 #include <openspace/mission/missionmanager.h>
 #include <openspace/network/parallelpeer.h>
 #include <openspace/performance/performancemanager.h>
+#include <openspace/performance/startuptracer.h>
 #include <openspace/properties/propertyowner.h>
 #include <openspace/rendering/dashboard.h>
 #include <openspace/rendering/deferredcastermanager.h>
@@ -193,6 +194,11 @@ performance::PerformanceManager& gPerformanceManager() {
     return g;
 }
 
+performance::StartupTracer& gStartupTracer() {
+    static performance::StartupTracer g;
+    return g;
+}
+
 properties::PropertyOwner& gRootPropertyOwner() {
     static properties::PropertyOwner g({ "" });
     return g;
@@ -218,6 +224,9 @@ scripting::ScriptScheduler& gScriptScheduler() {
 void initialize() {
     ZoneScoped
 
+    // Scripts and network topics look up properties by their URI all the time
+    global::rootPropertyOwner.createUriIndex();
+
     global::rootPropertyOwner.addPropertySubOwner(global::moduleEngine);
 
     global::navigationHandler.setPropertyOwner(&global::rootPropertyOwner);
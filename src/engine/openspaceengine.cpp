@@ -43,6 +43,8 @@
 #include <openspace/network/parallelpeer.h>
 #include <openspace/performance/performancemeasurement.h>
 #include <openspace/performance/performancemanager.h>
+#include <openspace/performance/startuptracer.h>
+#include <openspace/properties/property.h>
 #include <openspace/rendering/dashboard.h>
 #include <openspace/rendering/dashboarditem.h>
 #include <openspace/rendering/helper.h>
@@ -68,6 +70,7 @@
 #include <openspace/util/timemanager.h>
 #include <openspace/util/transformationmanager.h>
 #include <ghoul/ghoul.h>
+#include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/font/fontmanager.h>
 #include <ghoul/font/fontrenderer.h>
@@ -189,6 +192,8 @@ void OpenSpaceEngine::initialize() {
 
     global::initialize();
 
+    global::startupTracer.setEnabled(global::configuration.startupTrace.isActive);
+
     const std::string versionCheckUrl = global::configuration.versionCheckUrl;
     if (!versionCheckUrl.empty()) {
         global::versionChecker.requestLatestVersion(versionCheckUrl);
@@ -280,7 +285,15 @@ void OpenSpaceEngine::initialize() {
     LINFOC("Commit", std::string(OPENSPACE_GIT_FULL));
 
     // Register modules
-    global::moduleEngine.initialize(global::configuration.moduleConfigurations);
+    {
+        performance::StartupTracer::ScopedSpan span(
+            global::startupTracer,
+            "Module initialization",
+            performance::StartupTracer::Category::Engine,
+            ""
+        );
+        global::moduleEngine.initialize(global::configuration.moduleConfigurations);
+    }
 
     // After registering the modules, the documentations for the available classes
     // can be added as well
@@ -671,7 +684,15 @@ void OpenSpaceEngine::initializeGL() {
     LDEBUG("Initializing Rendering Engine");
     global::renderEngine.initializeGL();
 
-    global::moduleEngine.initializeGL();
+    {
+        performance::StartupTracer::ScopedSpan span(
+            global::startupTracer,
+            "Module OpenGL initialization",
+            performance::StartupTracer::Category::Engine,
+            ""
+        );
+        global::moduleEngine.initializeGL();
+    }
 
     for (const std::function<void()>& func : global::callback::initializeGL) {
         ZoneScopedN("[Module] initializeGL")
@@ -704,6 +725,11 @@ void OpenSpaceEngine::loadSingleAsset(const std::string& assetPath) {
     if (assetPath.empty()) {
         return;
     }
+
+    using StartupTracer = performance::StartupTracer;
+    global::startupTracer.setEnabled(global::configuration.startupTrace.isActive);
+    defer { global::startupTracer.setEnabled(false); };
+
     if (_scene) {
         ZoneScopedN("Reset scene")
 
@@ -716,19 +742,50 @@ void OpenSpaceEngine::loadSingleAsset(const std::string& assetPath) {
         global::navigationHandler.setCamera(nullptr);
         _scene->clear();
         global::rootPropertyOwner.removePropertySubOwner(_scene.get());
+
+        // Only trace the loading of the new scene and not the previous one
+        global::startupTracer.clear();
     }
 
     std::unique_ptr<SceneInitializer> sceneInitializer;
+    // Owned by the scene, which outlives this function
+    MultiThreadedSceneInitializer* multiThreadedInitializer = nullptr;
     if (global::configuration.useMultithreadedInitialization) {
         unsigned int nAvailableThreads = std::thread::hardware_concurrency();
         unsigned int nThreads = nAvailableThreads == 0 ? 2 : nAvailableThreads - 1;
-        sceneInitializer = std::make_unique<MultiThreadedSceneInitializer>(nThreads);
+
+        // The costs are specific to the nodes and the camera focus of each scene
+        std::string costCacheFile = FileSys.cacheManager()->cachedFilename(
+            "sceneinitialization.json",
+            assetPath,
+            ghoul::filesystem::CacheManager::Persistent::Yes
+        );
+        std::unique_ptr<MultiThreadedSceneInitializer> initializer =
+            std::make_unique<MultiThreadedSceneInitializer>(
+                nThreads,
+                std::move(costCacheFile)
+            );
+        multiThreadedInitializer = initializer.get();
+        sceneInitializer = std::move(initializer);
     }
     else {
         sceneInitializer = std::make_unique<SingleThreadedSceneInitializer>();
     }
 
-    _scene = std::make_unique<Scene>(std::move(sceneInitializer));
+    unsigned int nUpdateThreads = 0;
+    if (global::configuration.useMultithreadedUpdate) {
+        unsigned int nAvailableThreads = std::thread::hardware_concurrency();
+        nUpdateThreads = nAvailableThreads == 0 ? 2 : nAvailableThreads - 1;
+    }
+
+    const std::chrono::microseconds initializeGLBudget(
+        static_cast<int64_t>(global::configuration.initializeGLBudget * 1000.0)
+    );
+    _scene = std::make_unique<Scene>(
+        std::move(sceneInitializer),
+        nUpdateThreads,
+        initializeGLBudget
+    );
     global::renderEngine.setScene(_scene.get());
 
     global::rootPropertyOwner.addPropertySubOwner(_scene.get());
@@ -754,7 +811,16 @@ void OpenSpaceEngine::loadSingleAsset(const std::string& assetPath) {
     _loadingScreen->setPhase(LoadingScreen::Phase::Construction);
     _loadingScreen->postMessage("Loading assets");
 
-    _assetManager->update();
+    {
+        StartupTracer::ScopedSpan span(
+            global::startupTracer,
+            "Asset loading",
+            StartupTracer::Category::Engine,
+            ""
+        );
+        _assetManager->update();
+    }
+    const StartupTracer::Clock::time_point syncBegin = StartupTracer::Clock::now();
 
     _loadingScreen->setPhase(LoadingScreen::Phase::Synchronization);
     _loadingScreen->postMessage("Synchronizing assets");
@@ -831,6 +897,16 @@ void OpenSpaceEngine::loadSingleAsset(const std::string& assetPath) {
                     LoadingScreen::ItemStatus::Finished,
                     progressInfo
                 );
+                // All synchronizations are started by the first asset update and
+                // run in the background, so the end is the first time we see it done
+                global::startupTracer.addSpan(
+                    (*it)->name(),
+                    StartupTracer::Category::Synchronization,
+                    "",
+                    syncBegin,
+                    StartupTracer::Clock::now(),
+                    true
+                );
                 it = resourceSyncs.erase(it);
             }
         }
@@ -839,12 +915,35 @@ void OpenSpaceEngine::loadSingleAsset(const std::string& assetPath) {
         _loadingScreen = nullptr;
         return;
     }
+    global::startupTracer.addSpan(
+        "Synchronization",
+        StartupTracer::Category::Engine,
+        "",
+        syncBegin,
+        StartupTracer::Clock::now()
+    );
 
     _loadingScreen->setPhase(LoadingScreen::Phase::Initialization);
 
     _loadingScreen->postMessage("Initializing scene");
-    while (_scene->isInitializing()) {
-        _loadingScreen->render();
+    {
+        StartupTracer::ScopedSpan span(
+            global::startupTracer,
+            "Scene initialization",
+            StartupTracer::Category::Engine,
+            ""
+        );
+        while (_scene->isInitializing()) {
+            _loadingScreen->render();
+            // Overlap the OpenGL initialization with the nodes that are still
+            // initializing on the worker threads
+            _scene->initializeNodesGL();
+        }
+    }
+
+    if (multiThreadedInitializer) {
+        // The navigation state that the scene sets is only applied in the next frame
+        multiThreadedInitializer->saveCosts(global::navigationHandler.nextAnchorNode());
     }
 
     _loadingScreen->postMessage("Initializing OpenGL");
@@ -852,7 +951,29 @@ void OpenSpaceEngine::loadSingleAsset(const std::string& assetPath) {
 
     _loadingScreen = nullptr;
 
-    global::renderEngine.updateScene();
+    {
+        StartupTracer::ScopedSpan span(
+            global::startupTracer,
+            "First scene update",
+            StartupTracer::Category::Engine,
+            ""
+        );
+        global::renderEngine.updateScene();
+    }
+
+    if (global::startupTracer.isEnabled()) {
+        const configuration::Configuration::StartupTrace& trace =
+            global::configuration.startupTrace;
+        global::startupTracer.logSummary(static_cast<size_t>(trace.summaryCount));
+        if (!trace.file.empty()) {
+            try {
+                global::startupTracer.writeChromeTrace(absPath(trace.file));
+            }
+            catch (const ghoul::RuntimeError& e) {
+                LERRORC(e.component, e.message);
+            }
+        }
+    }
 
     global::syncEngine.addSyncables(global::timeManager.getSyncables());
     if (_scene && _scene->camera()) {
@@ -1190,6 +1311,10 @@ void OpenSpaceEngine::postSynchronizationPreDraw() {
         func();
     }
 
+    // All property changes of this frame have happened by now, so the listeners that
+    // asked for a single notification per frame can be informed
+    properties::Property::notifyDeferredChangeListeners();
+
     // Testing this every frame has minimal impact on the performance --- abock
     // Debug build: 1-2 us ; Release build: <= 1 us
     using ghoul::logging::LogManager;
@@ -1556,6 +1681,16 @@ scripting::LuaLibrary OpenSpaceEngine::luaLibrary() {
                 "Returns the zero-based identifier for this OpenSpace instance in a "
                 "cluster configuration. If this instance is not part of a cluster, this "
                 "identifier is always 0."
+            },
+            {
+                "writeStartupTrace",
+                &luascriptfunctions::writeStartupTrace,
+                {},
+                "string",
+                "Writes the startup trace that was recorded while loading the current "
+                "scene into the provided file in the Chrome trace event format. The "
+                "trace is only recorded if the 'StartupTrace' setting is activated in "
+                "the configuration file."
             }
         },
         {
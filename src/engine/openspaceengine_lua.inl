@@ -24,6 +24,7 @@
 
 #include <openspace/engine/downloadmanager.h>
 #include <openspace/engine/globals.h>
+#include <openspace/performance/startuptracer.h>
 #include <openspace/properties/triggerproperty.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/scenegraphnode.h>
@@ -278,4 +279,36 @@ int clusterId(lua_State* L) {
     return 1;
 }
 
+/**
+ * \ingroup LuaScripts
+ * writeStartupTrace(string):
+ * Writes the recorded startup trace into the provided file
+ */
+int writeStartupTrace(lua_State* L) {
+    ghoul::lua::checkArgumentsAndThrow(L, 1, "lua::writeStartupTrace");
+
+    const std::string path = ghoul::lua::value<std::string>(
+        L,
+        1,
+        ghoul::lua::PopValue::Yes
+    );
+
+    if (global::startupTracer.spans().empty()) {
+        return ghoul::lua::luaError(
+            L,
+            "No startup trace was recorded. Activate 'StartupTrace' in the configuration"
+        );
+    }
+
+    try {
+        global::startupTracer.writeChromeTrace(absPath(path));
+    }
+    catch (const ghoul::RuntimeError& e) {
+        return ghoul::lua::luaError(L, e.message);
+    }
+
+    ghoul_assert(lua_gettop(L) == 0, "Incorrect number of items left on stack");
+    return 0;
+}
+
 } // namespace openspace::luascriptfunctions
@@ -325,6 +325,16 @@ const SceneGraphNode* NavigationHandler::anchorNode() const {
     return _orbitalNavigator.anchorNode();
 }
 
+const SceneGraphNode* NavigationHandler::nextAnchorNode() const {
+    if (_pendingNavigationState.has_value()) {
+        const SceneGraphNode* anchor = sceneGraphNode(_pendingNavigationState->anchor);
+        if (anchor) {
+            return anchor;
+        }
+    }
+    return anchorNode();
+}
+
 Camera* NavigationHandler::camera() const {
     return _camera;
 }
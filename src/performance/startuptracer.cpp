@@ -0,0 +1,326 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/performance/startuptracer.h>
+
+#include <openspace/json.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+namespace {
+    constexpr const char* _loggerCat = "StartupTracer";
+
+    const char* categoryName(openspace::performance::StartupTracer::Category category) {
+        using Category = openspace::performance::StartupTracer::Category;
+        switch (category) {
+            case Category::Engine:          return "Engine";
+            case Category::Module:          return "Module";
+            case Category::Asset:           return "Asset";
+            case Category::Synchronization: return "Synchronization";
+            case Category::Node:            return "Node";
+            default:                        throw ghoul::MissingCaseException();
+        }
+    }
+
+    double milliseconds(std::chrono::microseconds us) {
+        return std::chrono::duration<double, std::milli>(us).count();
+    }
+} // namespace
+
+namespace openspace::performance {
+
+StartupTracer::ScopedSpan::ScopedSpan(StartupTracer& tracer, std::string name,
+                                      Category category, std::string stage)
+    : _tracer(tracer)
+    , _isActive(tracer.isEnabled())
+    , _category(category)
+{
+    if (_isActive) {
+        _name = std::move(name);
+        _stage = std::move(stage);
+        _begin = Clock::now();
+    }
+}
+
+StartupTracer::ScopedSpan::~ScopedSpan() {
+    if (_isActive) {
+        _tracer.addSpan(
+            std::move(_name),
+            _category,
+            std::move(_stage),
+            _begin,
+            Clock::now()
+        );
+    }
+}
+
+StartupTracer::StartupTracer()
+    : _origin(Clock::now())
+{}
+
+void StartupTracer::setEnabled(bool enabled) {
+    if (enabled) {
+        // Register the calling thread first so that it gets the identifier 0, which is
+        // labeled as the main thread in the trace
+        std::lock_guard<std::mutex> lock(_mutex);
+        threadId(std::this_thread::get_id());
+    }
+    _isEnabled = enabled;
+}
+
+bool StartupTracer::isEnabled() const {
+    return _isEnabled;
+}
+
+void StartupTracer::addSpan(std::string name, Category category, std::string stage,
+                            Clock::time_point begin, Clock::time_point end,
+                            bool isAsynchronous)
+{
+    if (!_isEnabled) {
+        return;
+    }
+
+    using namespace std::chrono;
+    Span span = {
+        std::move(name),
+        std::move(stage),
+        category,
+        -1,
+        duration_cast<microseconds>(begin - _origin),
+        duration_cast<microseconds>(end - _origin)
+    };
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!isAsynchronous) {
+        span.threadId = threadId(std::this_thread::get_id());
+    }
+    _spans.push_back(std::move(span));
+}
+
+std::vector<StartupTracer::Span> StartupTracer::spans() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _spans;
+}
+
+void StartupTracer::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _spans.clear();
+}
+
+std::vector<std::pair<std::string, std::chrono::microseconds>> StartupTracer::slowest(
+                                                                    Category category,
+                                                                    size_t n) const
+{
+    std::vector<Span> spans;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::copy_if(
+            _spans.begin(),
+            _spans.end(),
+            std::back_inserter(spans),
+            [category](const Span& s) { return s.category == category; }
+        );
+    }
+
+    // Spans on the same thread are nested, for example the span of an asset contains the
+    // spans of the assets it requires. To not rank a parent above the children it is
+    // waiting for, each span only counts its self time, which is its duration without
+    // the spans that are directly nested in it. Sorting the spans by their beginning,
+    // and the longer span first if they begin at the same time, places every span after
+    // the spans that contain it
+    std::sort(
+        spans.begin(),
+        spans.end(),
+        [](const Span& lhs, const Span& rhs) {
+            if (lhs.threadId != rhs.threadId) {
+                return lhs.threadId < rhs.threadId;
+            }
+            if (lhs.begin != rhs.begin) {
+                return lhs.begin < rhs.begin;
+            }
+            return lhs.end > rhs.end;
+        }
+    );
+
+    std::vector<std::chrono::microseconds> selfTimes(spans.size());
+    // The indices of the spans that contain the current span, the innermost one last
+    std::vector<size_t> parents;
+    for (size_t i = 0; i < spans.size(); ++i) {
+        const Span& s = spans[i];
+        selfTimes[i] = s.end - s.begin;
+        if (s.threadId < 0) {
+            // Asynchronous spans can overlap arbitrarily and are never nested
+            continue;
+        }
+
+        while (!parents.empty() && (spans[parents.back()].threadId != s.threadId ||
+                                    spans[parents.back()].end < s.end))
+        {
+            parents.pop_back();
+        }
+        if (!parents.empty()) {
+            selfTimes[parents.back()] -= s.end - s.begin;
+        }
+        parents.push_back(i);
+    }
+
+    std::unordered_map<std::string, std::chrono::microseconds> durations;
+    for (size_t i = 0; i < spans.size(); ++i) {
+        durations[spans[i].name] += selfTimes[i];
+    }
+
+    std::vector<std::pair<std::string, std::chrono::microseconds>> result(
+        durations.begin(),
+        durations.end()
+    );
+    const size_t nResults = std::min(n, result.size());
+    std::partial_sort(
+        result.begin(),
+        result.begin() + nResults,
+        result.end(),
+        [](const std::pair<std::string, std::chrono::microseconds>& lhs,
+           const std::pair<std::string, std::chrono::microseconds>& rhs)
+        {
+            return lhs.second > rhs.second ||
+                (lhs.second == rhs.second && lhs.first < rhs.first);
+        }
+    );
+    result.resize(nResults);
+    return result;
+}
+
+std::string StartupTracer::chromeTrace() const {
+    nlohmann::json events = nlohmann::json::array();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const std::pair<const std::thread::id, int>& p : _threadIds) {
+        const std::string threadName =
+            p.second == 0 ? "Main" : fmt::format("Worker {}", p.second);
+        events.push_back({
+            { "name", "thread_name" },
+            { "ph", "M" },
+            { "pid", 0 },
+            { "tid", p.second },
+            { "args", { { "name", threadName } } }
+        });
+    }
+
+    for (size_t i = 0; i < _spans.size(); ++i) {
+        const Span& s = _spans[i];
+        const std::string name = s.stage.empty() ? s.name : s.name + " (" + s.stage + ")";
+        if (s.threadId >= 0) {
+            // A complete event on the thread the span was recorded on
+            events.push_back({
+                { "name", name },
+                { "cat", categoryName(s.category) },
+                { "ph", "X" },
+                { "ts", s.begin.count() },
+                { "dur", (s.end - s.begin).count() },
+                { "pid", 0 },
+                { "tid", s.threadId }
+            });
+        }
+        else {
+            // Asynchronous spans can overlap arbitrarily, so they are written as a pair
+            // of async events that get their own track in the viewer
+            events.push_back({
+                { "name", name },
+                { "cat", categoryName(s.category) },
+                { "ph", "b" },
+                { "id", i },
+                { "ts", s.begin.count() },
+                { "pid", 0 },
+                { "tid", 0 }
+            });
+            events.push_back({
+                { "name", name },
+                { "cat", categoryName(s.category) },
+                { "ph", "e" },
+                { "id", i },
+                { "ts", s.end.count() },
+                { "pid", 0 },
+                { "tid", 0 }
+            });
+        }
+    }
+
+    nlohmann::json trace = {
+        { "traceEvents", std::move(events) },
+        { "displayTimeUnit", "ms" }
+    };
+    return trace.dump();
+}
+
+void StartupTracer::writeChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.good()) {
+        throw ghoul::RuntimeError(
+            fmt::format("Could not open file '{}' for writing", path),
+            "StartupTracer"
+        );
+    }
+    file << chromeTrace();
+    LINFO(fmt::format("Wrote startup trace to '{}'", path));
+}
+
+void StartupTracer::logSummary(size_t n) const {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const Span& s : _spans) {
+            if (s.category == Category::Engine) {
+                const double ms = milliseconds(s.end - s.begin);
+                LINFO(fmt::format("{}: {:.1f} ms", s.name, ms));
+            }
+        }
+    }
+
+    for (Category c : { Category::Module, Category::Asset, Category::Node }) {
+        std::vector<std::pair<std::string, std::chrono::microseconds>> entries =
+            slowest(c, n);
+        if (entries.empty()) {
+            continue;
+        }
+
+        LINFO(fmt::format("Slowest {} entries of category '{}':", n, categoryName(c)));
+        for (const std::pair<std::string, std::chrono::microseconds>& e : entries) {
+            LINFO(fmt::format("  {:.1f} ms: {}", milliseconds(e.second), e.first));
+        }
+    }
+}
+
+int StartupTracer::threadId(std::thread::id id) {
+    // The caller holds the mutex
+    auto it = _threadIds.find(id);
+    if (it == _threadIds.end()) {
+        it = _threadIds.emplace(id, static_cast<int>(_threadIds.size())).first;
+    }
+    return it->second;
+}
+
+} // namespace openspace::performance
@@ -29,6 +29,7 @@
 #include <ghoul/lua/ghoul_lua.h>
 
 #include <algorithm>
+#include <mutex>
 
 #include <ghoul/logging/logmanager.h>
 
@@ -39,6 +40,14 @@ namespace {
 
     constexpr const char* _metaDataKeyViewPrefix = "view.";
 
+    // Properties whose deferred onChange callbacks have to be called in the next call to
+    // Property::notifyDeferredChangeListeners and the properties whose callbacks are
+    // currently being called by it. A property that is destroyed in the meantime removes
+    // itself from the former and replaces itself with a nullptr in the latter
+    std::mutex DeferredNotificationMutex;
+    std::vector<openspace::properties::Property*> DeferredNotifications;
+    std::vector<openspace::properties::Property*> ActiveDeferredNotifications;
+
 } // namespace
 
 namespace openspace::properties {
@@ -114,6 +123,20 @@ Property::Property(PropertyInfo info)
 
 Property::~Property() {
     notifyDeleteListeners();
+
+    if (_hasDeferredNotification) {
+        std::lock_guard<std::mutex> lock(DeferredNotificationMutex);
+        DeferredNotifications.erase(
+            std::remove(DeferredNotifications.begin(), DeferredNotifications.end(), this),
+            DeferredNotifications.end()
+        );
+        std::replace(
+            ActiveDeferredNotifications.begin(),
+            ActiveDeferredNotifications.end(),
+            this,
+            static_cast<Property*>(nullptr)
+        );
+    }
 }
 
 const std::string& Property::identifier() const {
@@ -172,6 +195,14 @@ bool Property::setStringValue(std::string) { // NOLINT
     return false;
 }
 
+bool Property::getBinaryValue(std::string&) const {
+    return false;
+}
+
+bool Property::setBinaryValue(std::string_view) {
+    return false;
+}
+
 const std::string& Property::guiName() const {
     return _guiName;
 }
@@ -237,11 +268,18 @@ std::string Property::jsonValue() const {
     return getStringValue();
 }
 
-Property::OnChangeHandle Property::onChange(std::function<void()> callback) {
+Property::OnChangeHandle Property::onChange(std::function<void()> callback,
+                                           DeferNotification deferNotification)
+{
     ghoul_assert(callback, "The callback must not be empty");
 
     OnChangeHandle handle = _currentHandleValue++;
-    _onChangeCallbacks.emplace_back(handle, std::move(callback));
+    if (deferNotification) {
+        _onChangeDeferredCallbacks.emplace_back(handle, std::move(callback));
+    }
+    else {
+        _onChangeCallbacks.emplace_back(handle, std::move(callback));
+    }
     return handle;
 }
 
@@ -256,22 +294,73 @@ Property::OnChangeHandle Property::onDelete(std::function<void()> callback) {
 void Property::removeOnChange(OnChangeHandle handle) {
     if (handle == OnChangeHandleAll) {
         _onChangeCallbacks.clear();
+        _onChangeDeferredCallbacks.clear();
     }
     else {
+        auto matchesHandle =
+            [handle](const std::pair<OnChangeHandle, std::function<void()>>& p) {
+                return p.first == handle;
+            };
+
         auto it = std::find_if(
             _onChangeCallbacks.begin(),
             _onChangeCallbacks.end(),
-            [handle](const std::pair<OnChangeHandle, std::function<void()>>& p) {
-                return p.first == handle;
-            }
+            matchesHandle
+        );
+        if (it != _onChangeCallbacks.end()) {
+            _onChangeCallbacks.erase(it);
+            return;
+        }
+
+        auto jt = std::find_if(
+            _onChangeDeferredCallbacks.begin(),
+            _onChangeDeferredCallbacks.end(),
+            matchesHandle
         );
 
         ghoul_assert(
-            it != _onChangeCallbacks.end(),
+            jt != _onChangeDeferredCallbacks.end(),
             "handle must be a valid callback handle"
         );
 
-        _onChangeCallbacks.erase(it);
+        _onChangeDeferredCallbacks.erase(jt);
+    }
+}
+
+void Property::notifyDeferredChangeListeners() {
+    {
+        std::lock_guard<std::mutex> lock(DeferredNotificationMutex);
+        ghoul_assert(
+            ActiveDeferredNotifications.empty(),
+            "Deferred notifications must not be dispatched recursively"
+        );
+        std::swap(ActiveDeferredNotifications, DeferredNotifications);
+    }
+
+    // The callbacks might destroy other properties that are still waiting, so the list
+    // is checked again under the lock for every property. A property stays marked until
+    // its callbacks are called, so that further changes until then are coalesced, while
+    // changes caused by its own callbacks are notified in the next frame
+    for (size_t i = 0; ; ++i) {
+        Property* prop = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(DeferredNotificationMutex);
+            if (i >= ActiveDeferredNotifications.size()) {
+                ActiveDeferredNotifications.clear();
+                break;
+            }
+            prop = ActiveDeferredNotifications[i];
+            if (prop) {
+                prop->_hasDeferredNotification = false;
+            }
+        }
+
+        if (prop) {
+            using Callback = std::pair<OnChangeHandle, std::function<void()>>;
+            for (const Callback& p : prop->_onChangeDeferredCallbacks) {
+                p.second();
+            }
+        }
     }
 }
 
@@ -304,6 +393,14 @@ void Property::notifyChangeListeners() {
     for (const std::pair<OnChangeHandle, std::function<void()>>& p : _onChangeCallbacks) {
         p.second();
     }
+
+    if (!_onChangeDeferredCallbacks.empty()) {
+        std::lock_guard<std::mutex> lock(DeferredNotificationMutex);
+        if (!_hasDeferredNotification) {
+            _hasDeferredNotification = true;
+            DeferredNotifications.push_back(this);
+        }
+    }
 }
 
 void Property::notifyDeleteListeners() {
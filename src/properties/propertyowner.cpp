@@ -31,14 +31,44 @@
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/invariants.h>
 #include <algorithm>
+#include <mutex>
 #include <numeric>
+#include <unordered_map>
 
 namespace {
     constexpr const char* _loggerCat = "PropertyOwner";
+
+    bool startsWith(std::string_view s, std::string_view prefix) {
+        return s.substr(0, prefix.size()) == prefix;
+    }
 } // namespace
 
 namespace openspace::properties {
 
+struct PropertyOwner::UriIndex {
+    void add(std::string uri, Property* prop) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = properties.insert_or_assign(std::move(uri), prop).first;
+        sortedProperties[it->first] = prop;
+    }
+
+    void remove(const std::string& uri, const Property* prop) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = properties.find(uri);
+        if (it != properties.end() && it->second == prop) {
+            sortedProperties.erase(it->first);
+            properties.erase(it);
+        }
+    }
+
+    std::mutex mutex;
+    // Used for looking up single URIs
+    std::unordered_map<std::string, Property*> properties;
+    // The same URIs in lexicographical order, so that all URIs with a common prefix are
+    // adjacent. The keys refer to the keys in properties, which never move
+    std::map<std::string_view, Property*> sortedProperties;
+};
+
 PropertyOwner::PropertyOwner(PropertyOwnerInfo info)
     : DocumentationGenerator(
         "Property Owners",
@@ -84,31 +114,46 @@ std::vector<Property*> PropertyOwner::propertiesRecursive() const {
 }
 
 Property* PropertyOwner::property(const std::string& uri) const {
+    if (_uriIndex) {
+        std::lock_guard<std::mutex> lock(_uriIndex->mutex);
+        const auto it = _uriIndex->properties.find(uri);
+        return it != _uriIndex->properties.end() ? it->second : nullptr;
+    }
+    else {
+        return findProperty(uri);
+    }
+}
+
+Property* PropertyOwner::findProperty(std::string_view uri) const {
     auto it = std::find_if(
         _properties.begin(),
         _properties.end(),
-        [&uri](Property* prop) { return prop->identifier() == uri; }
+        [uri](Property* prop) { return prop->identifier() == uri; }
     );
 
-    if (it == _properties.end() || (*it)->identifier() != uri) {
+    if (it == _properties.end()) {
         // if we do not own the searched property, it must consist of a concatenated
         // name and we can delegate it to a subowner
         const size_t ownerSeparator = uri.find(URISeparator);
-        if (ownerSeparator == std::string::npos) {
+        if (ownerSeparator == std::string_view::npos) {
             // if we do not own the property and there is no separator, it does not exist
             return nullptr;
         }
         else {
-            const std::string ownerName = uri.substr(0, ownerSeparator);
-            const std::string propertyName = uri.substr(ownerSeparator + 1);
-
-            PropertyOwner* owner = propertySubOwner(ownerName);
-            if (!owner) {
+            const std::string_view ownerName = uri.substr(0, ownerSeparator);
+            const std::string_view propertyName = uri.substr(ownerSeparator + 1);
+
+            auto owner = std::find_if(
+                _subOwners.begin(),
+                _subOwners.end(),
+                [ownerName](PropertyOwner* o) { return o->identifier() == ownerName; }
+            );
+            if (owner == _subOwners.end()) {
                 return nullptr;
             }
             else {
                 // Recurse into the subOwner
-                return owner->property(propertyName);
+                return (*owner)->findProperty(propertyName);
             }
         }
     }
@@ -117,6 +162,86 @@ Property* PropertyOwner::property(const std::string& uri) const {
     }
 }
 
+std::vector<Property*> PropertyOwner::propertiesWithUriPrefix(
+                                                         const std::string& prefix) const
+{
+    std::vector<Property*> result;
+
+    if (_uriIndex) {
+        std::lock_guard<std::mutex> lock(_uriIndex->mutex);
+        for (auto it = _uriIndex->sortedProperties.lower_bound(prefix);
+             it != _uriIndex->sortedProperties.end() && startsWith(it->first, prefix);
+             ++it)
+        {
+            result.push_back(it->second);
+        }
+        return result;
+    }
+
+    // Without an index, we only descend into the sub-owners whose URIs are compatible
+    // with the prefix
+    std::vector<std::pair<std::string, Property*>> matches;
+    std::function<void(const PropertyOwner*, const std::string&)> collect =
+        [&](const PropertyOwner* owner, const std::string& ownerPrefix)
+    {
+        for (Property* p : owner->properties()) {
+            std::string uri = ownerPrefix + p->identifier();
+            if (startsWith(uri, prefix)) {
+                matches.emplace_back(std::move(uri), p);
+            }
+        }
+        for (const PropertyOwner* o : owner->propertySubOwners()) {
+            const std::string subPrefix = ownerPrefix + o->identifier() + URISeparator;
+            if (startsWith(subPrefix, prefix) || startsWith(prefix, subPrefix)) {
+                collect(o, subPrefix);
+            }
+        }
+    };
+    collect(this, "");
+
+    std::sort(matches.begin(), matches.end());
+    result.reserve(matches.size());
+    for (const std::pair<std::string, Property*>& m : matches) {
+        result.push_back(m.second);
+    }
+    return result;
+}
+
+void PropertyOwner::createUriIndex() {
+    ghoul_precondition(_owner == nullptr, "PropertyOwner must not have an owner");
+
+    _uriIndex = std::make_shared<UriIndex>();
+    addToIndex(this, "");
+}
+
+std::string PropertyOwner::indexUriPrefix() const {
+    std::string prefix;
+    for (const PropertyOwner* o = this; o && o != _indexRoot; o = o->owner()) {
+        prefix = o->identifier() + URISeparator + prefix;
+    }
+    return prefix;
+}
+
+void PropertyOwner::addToIndex(PropertyOwner* root, const std::string& uriPrefix) {
+    _indexRoot = root;
+    for (Property* p : _properties) {
+        root->_uriIndex->add(uriPrefix + p->identifier(), p);
+    }
+    for (PropertyOwner* o : _subOwners) {
+        o->addToIndex(root, uriPrefix + o->identifier() + URISeparator);
+    }
+}
+
+void PropertyOwner::removeFromIndex(const std::string& uriPrefix) {
+    for (Property* p : _properties) {
+        _indexRoot->_uriIndex->remove(uriPrefix + p->identifier(), p);
+    }
+    for (PropertyOwner* o : _subOwners) {
+        o->removeFromIndex(uriPrefix + o->identifier() + URISeparator);
+    }
+    _indexRoot = nullptr;
+}
+
 bool PropertyOwner::hasProperty(const std::string& uri) const {
     return property(uri) != nullptr;
 }
@@ -204,6 +329,9 @@ void PropertyOwner::addProperty(Property* prop) {
         else {
             _properties.push_back(prop);
             prop->setPropertyOwner(this);
+            if (_indexRoot) {
+                _indexRoot->_uriIndex->add(indexUriPrefix() + prop->identifier(), prop);
+            }
         }
     }
 }
@@ -249,6 +377,12 @@ void PropertyOwner::addPropertySubOwner(openspace::properties::PropertyOwner* ow
         else {
             _subOwners.push_back(owner);
             owner->setPropertyOwner(this);
+            if (_indexRoot) {
+                owner->addToIndex(
+                    _indexRoot,
+                    indexUriPrefix() + owner->identifier() + URISeparator
+                );
+            }
         }
     }
 }
@@ -269,6 +403,9 @@ void PropertyOwner::removeProperty(Property* prop) {
 
     // If we found the property identifier, we can delete it
     if (it != _properties.end() && (*it)->identifier() == prop->identifier()) {
+        if (_indexRoot) {
+            _indexRoot->_uriIndex->remove(indexUriPrefix() + (*it)->identifier(), *it);
+        }
         (*it)->setPropertyOwner(nullptr);
         _properties.erase(it);
     }
@@ -297,6 +434,11 @@ void PropertyOwner::removePropertySubOwner(openspace::properties::PropertyOwner*
 
     // If we found the propertyowner, we can delete it
     if (it != _subOwners.end() && (*it)->identifier() == owner->identifier()) {
+        if (_indexRoot) {
+            (*it)->removeFromIndex(
+                indexUriPrefix() + (*it)->identifier() + URISeparator
+            );
+        }
         _subOwners.erase(it);
     }
     else {
@@ -320,7 +462,17 @@ void PropertyOwner::setIdentifier(std::string identifier) {
         "Identifier must contain any whitespaces"
     );
 
-    _identifier = std::move(identifier);
+    if (_indexRoot && _indexRoot != this) {
+        // The URIs of all Propertys below this owner change with the identifier
+        PropertyOwner* root = _indexRoot;
+        const std::string ownerPrefix = _owner->indexUriPrefix();
+        removeFromIndex(ownerPrefix + _identifier + URISeparator);
+        _identifier = std::move(identifier);
+        addToIndex(root, ownerPrefix + _identifier + URISeparator);
+    }
+    else {
+        _identifier = std::move(identifier);
+    }
 }
 
 const std::string& PropertyOwner::identifier() const {
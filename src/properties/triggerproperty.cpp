@@ -43,6 +43,16 @@ void TriggerProperty::set(std::any) {
     notifyChangeListeners();
 }
 
+bool TriggerProperty::getBinaryValue(std::string& value) const {
+    value.clear();
+    return true;
+}
+
+bool TriggerProperty::setBinaryValue(std::string_view) {
+    notifyChangeListeners();
+    return true;
+}
+
 std::string TriggerProperty::toJson() const {
     std::string result = "{";
     result += "\"" + std::string(DescriptionKey) + "\": " + generateBaseJsonDescription();
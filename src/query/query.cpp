@@ -71,4 +71,16 @@ std::vector<properties::Property*> allProperties() {
     return properties;
 }
 
+std::vector<properties::Property*> propertiesWithUriPrefix(const std::string& prefix) {
+    std::vector<properties::Property*> properties =
+        global::rootPropertyOwner.propertiesWithUriPrefix(prefix);
+
+    std::vector<properties::Property*> p =
+        global::virtualPropertyManager.propertiesWithUriPrefix(prefix);
+
+    properties.insert(properties.end(), p.begin(), p.end());
+
+    return properties;
+}
+
 }  // namespace
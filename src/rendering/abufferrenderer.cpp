@@ -591,6 +591,7 @@ void ABufferRenderer::render(Scene* scene, Camera* camera, float blackoutFactor)
     Time time = global::timeManager.time();
     RenderData data{ *camera, psc(), time, doPerformanceMeasurements, renderBinMask, {} };
     RendererTasks tasks;
+    scene->buildRenderQueue(data);
     scene->render(data, tasks);
     _blackoutFactor = blackoutFactor;
 
@@ -1197,6 +1197,17 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
     };
     RendererTasks tasks;
 
+    {
+        // Find the visible nodes once instead of traversing the scene for every bin
+        std::unique_ptr<performance::PerformanceMeasurement> perfInternal;
+        if (doPerformanceMeasurements) {
+            perfInternal = std::make_unique<performance::PerformanceMeasurement>(
+                "FramebufferRenderer::render::buildRenderQueue"
+            );
+        }
+        scene->buildRenderQueue(data);
+    }
+
     {
         GLDebugGroup group("Background");
         data.renderBinMask = static_cast<int>(Renderable::RenderBin::Background);
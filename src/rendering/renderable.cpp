@@ -189,6 +189,14 @@ float Renderable::boundingSphere() const {
     return _boundingSphere;
 }
 
+float Renderable::cullingSphere() const {
+    return _boundingSphere;
+}
+
+bool Renderable::isCullable() const {
+    return cullingSphere() > 0.f;
+}
+
 SurfacePositionHandle Renderable::calculateSurfacePositionHandle(
                                                  const glm::dvec3& targetModelSpace) const
 {
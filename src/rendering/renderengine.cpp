@@ -58,6 +58,7 @@
 #include <ghoul/misc/stringconversion.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <limits>
 
 #ifdef GHOUL_USE_DEVIL
 #include <ghoul/io/texture/texturereaderdevil.h>
@@ -243,6 +244,38 @@ namespace {
         "Enable FXAA",
         "Enable FXAA"
     };
+
+    constexpr openspace::properties::Property::PropertyInfo SceneCullingInfo = {
+        "SceneCulling",
+        "Scene Culling",
+        "If this value is enabled, scene graph nodes whose bounding sphere is outside of "
+        "the view frustum or smaller than the minimum pixel size are not rendered. "
+        "Renderables without a bounding sphere are never culled. As the bounding sphere "
+        "of some renderables is only used for navigation and might not enclose all of "
+        "their geometry, this is disabled by default."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CullingPixelSizeInfo = {
+        "CullingMinimumPixelSize",
+        "Culling Minimum Pixel Size",
+        "The minimum radius in pixels that the bounding sphere of a scene graph node has "
+        "to cover on the screen for the node to be rendered if scene culling is enabled. "
+        "If this value is 0, nodes are only culled against the view frustum."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FrustumCulledInfo = {
+        "FrustumCulledNodes",
+        "Frustum Culled Nodes",
+        "The number of scene graph nodes that were not rendered in the last frame "
+        "because they were outside of the view frustum."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo SubPixelCulledInfo = {
+        "SubPixelCulledNodes",
+        "Sub-Pixel Culled Nodes",
+        "The number of scene graph nodes that were not rendered in the last frame "
+        "because they were smaller than the culling minimum pixel size."
+    };
 } // namespace
 
 
@@ -263,6 +296,10 @@ RenderEngine::RenderEngine()
     , _disableMasterRendering(DisableMasterInfo, false)
     , _globalBlackOutFactor(GlobalBlackoutFactorInfo, 1.f, 0.f, 1.f)
     , _enableFXAA(FXAAInfo, true)
+    , _sceneCulling(SceneCullingInfo, false)
+    , _cullingMinimumPixelSize(CullingPixelSizeInfo, 0.25f, 0.f, 10.f)
+    , _nFrustumCulledNodes(FrustumCulledInfo, 0, 0, std::numeric_limits<int>::max())
+    , _nSubPixelCulledNodes(SubPixelCulledInfo, 0, 0, std::numeric_limits<int>::max())
     , _disableHDRPipeline(DisableHDRPipelineInfo, false)
     , _hdrExposure(HDRExposureInfo, 3.7f, 0.01f, 10.f)
     , _gamma(GammaInfo, 0.95f, 0.01f, 5.f)
@@ -383,6 +420,13 @@ RenderEngine::RenderEngine()
     addProperty(_screenSpaceRotation);
     addProperty(_masterRotation);
     addProperty(_disableMasterRendering);
+
+    addProperty(_sceneCulling);
+    addProperty(_cullingMinimumPixelSize);
+    _nFrustumCulledNodes.setReadOnly(true);
+    addProperty(_nFrustumCulledNodes);
+    _nSubPixelCulledNodes.setReadOnly(true);
+    addProperty(_nSubPixelCulledNodes);
 }
 
 RenderEngine::~RenderEngine() {} // NOLINT
@@ -644,11 +688,25 @@ void RenderEngine::render(const glm::mat4& sceneMatrix, const glm::mat4& viewMat
 
     const bool masterEnabled = delegate.isMaster() ? !_disableMasterRendering : true;
     if (masterEnabled && !delegate.isGuiWindow() && _globalBlackOutFactor > 0.f) {
+        if (_scene) {
+            Scene::CullingSettings culling;
+            culling.isEnabled = _sceneCulling;
+            culling.minimumPixelSize = _cullingMinimumPixelSize;
+            culling.resolutionHeight = renderingResolution().y;
+            _scene->setCullingSettings(culling);
+        }
+
         _renderer->render(
             _scene,
             _camera,
             _globalBlackOutFactor
         );
+
+        if (_scene) {
+            const Scene::CullingStatistics stats = _scene->cullingStatistics();
+            _nFrustumCulledNodes = stats.nOutsideFrustum;
+            _nSubPixelCulledNodes = stats.nSubPixel;
+        }
     }
 
     if (_showFrameInformation) {
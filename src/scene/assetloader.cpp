@@ -24,6 +24,8 @@
 
 #include <openspace/scene/assetloader.h>
 
+#include <openspace/engine/globals.h>
+#include <openspace/performance/startuptracer.h>
 #include <openspace/scene/assetlistener.h>
 #include <openspace/util/resourcesynchronization.h>
 #include <ghoul/fmt.h>
@@ -252,6 +254,13 @@ void AssetLoader::tearDownAssetLuaTable(Asset* asset) {
 }
 
 bool AssetLoader::loadAsset(std::shared_ptr<Asset> asset) {
+    performance::StartupTracer::ScopedSpan span(
+        global::startupTracer,
+        asset->assetFilePath(),
+        performance::StartupTracer::Category::Asset,
+        "Load"
+    );
+
     int top = lua_gettop(*_luaState);
     std::shared_ptr<Asset> parentAsset = _currentAsset;
 
@@ -506,6 +515,13 @@ const std::string& AssetLoader::assetRootDirectory() const {
 }
 
 void AssetLoader::callOnInitialize(Asset* asset) {
+    performance::StartupTracer::ScopedSpan span(
+        global::startupTracer,
+        asset->assetFilePath(),
+        performance::StartupTracer::Category::Asset,
+        "Initialize"
+    );
+
     for (int init : _onInitializationFunctionRefs[asset]) {
         lua_rawgeti(*_luaState, LUA_REGISTRYINDEX, init);
         if (lua_pcall(*_luaState, 0, 0, 0) != LUA_OK) {
@@ -0,0 +1,261 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/scene/boundingspherehierarchy.h>
+
+#include <ghoul/misc/assert.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+
+namespace {
+    using Sphere = openspace::BoundingSphereHierarchy::Sphere;
+
+    // Returns the smallest sphere that contains both \p a and \p b
+    Sphere merge(const Sphere& a, const Sphere& b) {
+        const glm::dvec3 d = b.center - a.center;
+        const double distance = glm::length(d);
+        if (distance + b.radius <= a.radius) {
+            return a;
+        }
+        if (distance + a.radius <= b.radius) {
+            return b;
+        }
+
+        // The small relative increase makes sure that rounding errors do not cause the
+        // result to cut off parts of the two spheres
+        const double radius = (distance + a.radius + b.radius) / 2.0;
+        return {
+            a.center + d * ((radius - a.radius) / distance),
+            radius * (1.0 + 1e-12)
+        };
+    }
+} // namespace
+
+namespace openspace {
+
+void BoundingSphereHierarchy::build(std::vector<Sphere> spheres) {
+    _spheres = std::move(spheres);
+    _nodes.clear();
+    _builtRadiusSum = 0.0;
+    if (_spheres.empty()) {
+        return;
+    }
+
+    // A binary tree with n leaves has 2n - 1 nodes
+    _nodes.reserve(2 * _spheres.size() - 1);
+    std::vector<size_t> items(_spheres.size());
+    std::iota(items.begin(), items.end(), 0);
+    buildNode(items.begin(), items.end());
+
+    for (const Node& node : _nodes) {
+        if (node.nItems > 1) {
+            _builtRadiusSum += node.sphere.radius;
+        }
+    }
+}
+
+void BoundingSphereHierarchy::buildNode(std::vector<size_t>::iterator begin,
+                                        std::vector<size_t>::iterator end)
+{
+    const size_t index = _nodes.size();
+    _nodes.push_back(Node());
+    const size_t nItems = static_cast<size_t>(std::distance(begin, end));
+    _nodes[index].nItems = nItems;
+
+    if (nItems == 1) {
+        _nodes[index].item = *begin;
+        _nodes[index].sphere = _spheres[*begin];
+        return;
+    }
+
+    // Split the items at the median of their centers along the axis of largest extent
+    glm::dvec3 minimum = _spheres[*begin].center;
+    glm::dvec3 maximum = _spheres[*begin].center;
+    for (auto it = begin; it != end; ++it) {
+        minimum = glm::min(minimum, _spheres[*it].center);
+        maximum = glm::max(maximum, _spheres[*it].center);
+    }
+    const glm::dvec3 extent = maximum - minimum;
+    int axis = 0;
+    if (extent.y > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z > extent[axis]) {
+        axis = 2;
+    }
+
+    const auto middle = begin + nItems / 2;
+    std::nth_element(
+        begin,
+        middle,
+        end,
+        [this, axis](size_t lhs, size_t rhs) {
+            return _spheres[lhs].center[axis] < _spheres[rhs].center[axis];
+        }
+    );
+
+    buildNode(begin, middle);
+    _nodes[index].right = _nodes.size();
+    buildNode(middle, end);
+
+    _nodes[index].sphere = merge(
+        _nodes[index + 1].sphere,
+        _nodes[_nodes[index].right].sphere
+    );
+}
+
+void BoundingSphereHierarchy::setSphere(size_t item, const Sphere& sphere) {
+    ghoul_assert(item < _spheres.size(), "Item out of range");
+    ghoul_assert(sphere.radius >= 0.0, "Radius must not be negative");
+
+    _spheres[item] = sphere;
+}
+
+void BoundingSphereHierarchy::refit() {
+    // Children are stored after their parents, so going backwards updates all children
+    // before the parent that contains them
+    double radiusSum = 0.0;
+    for (size_t i = _nodes.size(); i > 0; --i) {
+        Node& node = _nodes[i - 1];
+        if (node.nItems == 1) {
+            node.sphere = _spheres[node.item];
+        }
+        else {
+            node.sphere = merge(_nodes[i].sphere, _nodes[node.right].sphere);
+            radiusSum += node.sphere.radius;
+        }
+    }
+
+    if (radiusSum > 2.0 * _builtRadiusSum) {
+        build(std::move(_spheres));
+    }
+}
+
+void BoundingSphereHierarchy::cull(const glm::dmat4& viewProjection,
+                                   const glm::dvec3& cameraPosition,
+                                   double pixelsPerUnit, double minimumPixelSize,
+                                   std::vector<Visibility>& result) const
+{
+    result.assign(_spheres.size(), Visibility::Visible);
+    if (_nodes.empty()) {
+        return;
+    }
+
+    // The left, right, bottom, and top planes of the frustum, pointing inwards. They
+    // all pass through the camera, so together they also exclude everything behind it
+    auto row = [&viewProjection](int i) {
+        return glm::dvec4(
+            viewProjection[0][i],
+            viewProjection[1][i],
+            viewProjection[2][i],
+            viewProjection[3][i]
+        );
+    };
+    const glm::dvec4 row0 = row(0);
+    const glm::dvec4 row1 = row(1);
+    const glm::dvec4 row3 = row(3);
+    std::array<glm::dvec4, 4> planes;
+    planes[0] = row3 + row0;
+    planes[1] = row3 - row0;
+    planes[2] = row3 + row1;
+    planes[3] = row3 - row1;
+    for (glm::dvec4& plane : planes) {
+        plane /= glm::length(glm::dvec3(plane));
+    }
+
+    // A subtree with n items consists of 2n - 1 nodes that are stored consecutively
+    auto setSubtree = [this, &result](size_t node, Visibility visibility) {
+        const size_t end = node + 2 * _nodes[node].nItems - 1;
+        for (size_t i = node; i < end; ++i) {
+            if (_nodes[i].nItems == 1) {
+                result[_nodes[i].item] = visibility;
+            }
+        }
+    };
+
+    struct Entry {
+        size_t node;
+        // The planes that the sphere of the node still intersects. If the parent is
+        // completely inside a plane, so are all of its children
+        int planeMask;
+    };
+    std::vector<Entry> stack = { { 0, 0b1111 } };
+    while (!stack.empty()) {
+        const Entry entry = stack.back();
+        stack.pop_back();
+        const Node& node = _nodes[entry.node];
+        const Sphere& sphere = node.sphere;
+
+        bool isOutside = false;
+        int planeMask = entry.planeMask;
+        for (int i = 0; i < 4; ++i) {
+            if ((planeMask & (1 << i)) == 0) {
+                continue;
+            }
+            const double distance =
+                glm::dot(glm::dvec3(planes[i]), sphere.center) + planes[i].w;
+            if (distance < -sphere.radius) {
+                isOutside = true;
+                break;
+            }
+            if (distance >= sphere.radius) {
+                planeMask &= ~(1 << i);
+            }
+        }
+        if (isOutside) {
+            setSubtree(entry.node, Visibility::OutsideFrustum);
+            continue;
+        }
+
+        // A sphere that is contained in another sphere never covers a larger angle as
+        // seen from a camera outside of them, so the angular radius of an inner node is
+        // an upper bound for all of its items
+        if (minimumPixelSize > 0.0) {
+            const glm::dvec3 toCenter = sphere.center - cameraPosition;
+            const double distanceSquared = glm::dot(toCenter, toCenter);
+            const double radiusSquared = sphere.radius * sphere.radius;
+            if (distanceSquared > radiusSquared) {
+                const double tanAngle =
+                    sphere.radius / std::sqrt(distanceSquared - radiusSquared);
+                if (tanAngle * pixelsPerUnit < minimumPixelSize) {
+                    setSubtree(entry.node, Visibility::SubPixel);
+                    continue;
+                }
+            }
+        }
+
+        if (node.nItems > 1) {
+            stack.push_back({ node.right, planeMask });
+            stack.push_back({ entry.node + 1, planeMask });
+        }
+    }
+}
+
+size_t BoundingSphereHierarchy::nItems() const {
+    return _spheres.size();
+}
+
+} // namespace openspace
@@ -97,4 +97,8 @@ void Rotation::update(const UpdateData& data) {
     _needsUpdate = false;
 }
 
+bool Rotation::isThreadSafe() const {
+    return false;
+}
+
 } // namespace openspace
@@ -92,4 +92,8 @@ void Scale::update(const UpdateData& data) {
     _needsUpdate = false;
 }
 
+bool Scale::isThreadSafe() const {
+    return false;
+}
+
 } // namespace openspace
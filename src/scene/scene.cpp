@@ -34,10 +34,13 @@
 #include <openspace/scene/sceneinitializer.h>
 #include <openspace/scripting/lualibrary.h>
 #include <openspace/util/camera.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <stack>
 
@@ -48,6 +51,10 @@ namespace {
     constexpr const char* KeyIdentifier = "Identifier";
     constexpr const char* KeyParent = "Parent";
 
+    // Synced with Renderable::RenderBin
+    constexpr const int NumRenderBins = 4;
+    constexpr const int TransparentRenderBin = 2;
+
     constexpr const char* renderBinToString(int renderBin) {
         // Synced with Renderable::RenderBin
         if (renderBin == 1) {
@@ -74,12 +81,18 @@ Scene::InvalidSceneError::InvalidSceneError(std::string msg, std::string comp)
     : ghoul::RuntimeError(std::move(msg), std::move(comp))
 {}
 
-Scene::Scene(std::unique_ptr<SceneInitializer> initializer)
+Scene::Scene(std::unique_ptr<SceneInitializer> initializer, unsigned int nUpdateThreads,
+             std::chrono::microseconds initializeGLBudget)
     : properties::PropertyOwner({"Scene", "Scene"})
     , _initializer(std::move(initializer))
+    , _initializeGLBudget(initializeGLBudget)
 {
     _rootDummy.setIdentifier(SceneGraphNode::RootNodeIdentifier);
     _rootDummy.setScene(this);
+
+    if (nUpdateThreads > 0) {
+        _updatePool = std::make_unique<ThreadPool>(nUpdateThreads);
+    }
 }
 
 Scene::~Scene() {
@@ -126,6 +139,10 @@ void Scene::unregisterNode(SceneGraphNode* node) {
         _topologicallySortedNodes.end()
     );
     _nodesByIdentifier.erase(node->identifier());
+    _nodesToInitializeGL.erase(
+        std::remove(_nodesToInitializeGL.begin(), _nodesToInitializeGL.end(), node),
+        _nodesToInitializeGL.end()
+    );
     // Just try to remove all properties; if the property doesn't exist, the
     // removeInterpolation will not do anything
     for (properties::Property* p : node->properties()) {
@@ -143,6 +160,10 @@ void Scene::updateNodeRegistry() {
     ZoneScoped
 
     sortTopologically();
+    if (_updatePool) {
+        buildUpdateGraph();
+    }
+    _isBoundingSphereHierarchyDirty = true;
     _dirtyNodeRegistry = false;
 }
 
@@ -223,12 +244,174 @@ void Scene::sortTopologically() {
     _topologicallySortedNodes = nodes;
 }
 
+void Scene::buildUpdateGraph() {
+    std::unordered_map<SceneGraphNode*, size_t> indices;
+    for (size_t i = 0; i < _topologicallySortedNodes.size(); ++i) {
+        indices[_topologicallySortedNodes[i]] = i;
+    }
+
+    _updateTasks.clear();
+    _updateTasks.resize(_topologicallySortedNodes.size());
+    for (size_t i = 0; i < _topologicallySortedNodes.size(); ++i) {
+        SceneGraphNode* node = _topologicallySortedNodes[i];
+        _updateTasks[i].node = node;
+
+        std::vector<SceneGraphNode*> inputs = node->dependencies();
+        if (node->parent()) {
+            inputs.push_back(node->parent());
+        }
+        for (SceneGraphNode* input : inputs) {
+            // Nodes with circular dependencies are not part of the sorted nodes and are
+            // never updated, so there is nothing to wait for
+            const auto it = indices.find(input);
+            if (it != indices.end()) {
+                _updateTasks[it->second].outputs.push_back(i);
+                _updateTasks[i].nInputs++;
+            }
+        }
+    }
+    _remainingUpdateInputs = std::make_unique<std::atomic<size_t>[]>(
+        _updateTasks.size()
+    );
+}
+
+void Scene::updateTransformsConcurrently(const UpdateData& data) {
+    ZoneScoped
+
+    for (size_t i = 0; i < _updateTasks.size(); ++i) {
+        _updateTasks[i].isConcurrent = _updateTasks[i].node->isUpdateThreadSafe();
+        _remainingUpdateInputs[i] = _updateTasks[i].nInputs;
+    }
+
+    // A node that has to be updated on the main thread holds back all nodes that need
+    // its transformation. As inputs always come before their outputs in the topological
+    // order, a single pass is enough to propagate this
+    size_t nConcurrent = 0;
+    for (const UpdateTask& task : _updateTasks) {
+        if (task.isConcurrent) {
+            nConcurrent++;
+        }
+        else {
+            for (size_t output : task.outputs) {
+                _updateTasks[output].isConcurrent = false;
+            }
+        }
+    }
+    if (nConcurrent == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_updateMutex);
+        _nRemainingUpdateTasks = nConcurrent;
+    }
+
+    // The calling thread takes care of the first node that is ready instead of waiting
+    size_t first = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i < _updateTasks.size(); ++i) {
+        if (!_updateTasks[i].isConcurrent || _updateTasks[i].nInputs > 0) {
+            continue;
+        }
+        if (first == std::numeric_limits<size_t>::max()) {
+            first = i;
+        }
+        else {
+            _updatePool->enqueue([this, i, &data]() { runUpdateTask(i, data); });
+        }
+    }
+    runUpdateTask(first, data);
+
+    std::unique_lock<std::mutex> lock(_updateMutex);
+    _updateCondition.wait(lock, [this]() { return _nRemainingUpdateTasks == 0; });
+    if (_updateException) {
+        std::exception_ptr e = _updateException;
+        _updateException = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+void Scene::runUpdateTask(size_t task, const UpdateData& data) {
+    constexpr const size_t NoTask = std::numeric_limits<size_t>::max();
+
+    while (task != NoTask) {
+        try {
+            _updateTasks[task].node->updateTransform(data);
+        }
+        catch (const ghoul::RuntimeError& e) {
+            LERRORC(e.component, e.what());
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(_updateMutex);
+            if (!_updateException) {
+                _updateException = std::current_exception();
+            }
+        }
+
+        // Continue with the first output that became ready on this thread, which saves
+        // a trip through the thread pool for long chains of nodes
+        size_t next = NoTask;
+        for (size_t output : _updateTasks[task].outputs) {
+            if (!_updateTasks[output].isConcurrent) {
+                continue;
+            }
+            if (--_remainingUpdateInputs[output] > 0) {
+                continue;
+            }
+            if (next == NoTask) {
+                next = output;
+            }
+            else {
+                _updatePool->enqueue([this, output, &data]() {
+                    runUpdateTask(output, data);
+                });
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_updateMutex);
+            _nRemainingUpdateTasks--;
+            if (_nRemainingUpdateTasks == 0) {
+                _updateCondition.notify_one();
+            }
+        }
+        task = next;
+    }
+}
+
 void Scene::initializeNode(SceneGraphNode* node) {
     _initializer->initializeNode(node);
 }
 
 bool Scene::isInitializing() const {
-    return _initializer->isInitializing();
+    return _initializer->isInitializing() || !_nodesToInitializeGL.empty();
+}
+
+void Scene::initializeNodesGL() {
+    ZoneScoped
+
+    std::vector<SceneGraphNode*> initializedNodes = _initializer->takeInitializedNodes();
+    _nodesToInitializeGL.insert(
+        _nodesToInitializeGL.end(),
+        initializedNodes.begin(),
+        initializedNodes.end()
+    );
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point begin = Clock::now();
+    while (!_nodesToInitializeGL.empty()) {
+        SceneGraphNode* node = _nodesToInitializeGL.front();
+        _nodesToInitializeGL.pop_front();
+        try {
+            node->initializeGL();
+        } catch (const ghoul::RuntimeError& e) {
+            LERRORC(e.component, e.message);
+        }
+
+        const bool hasBudget = _initializeGLBudget.count() > 0;
+        if (hasBudget && Clock::now() - begin >= _initializeGLBudget) {
+            break;
+        }
+    }
 }
 
 /*
@@ -303,66 +486,189 @@ void Scene::initializeGL() {
 void Scene::update(const UpdateData& data) {
     ZoneScoped
 
-    std::vector<SceneGraphNode*> initializedNodes = _initializer->takeInitializedNodes();
+    initializeNodesGL();
 
-    for (SceneGraphNode* node : initializedNodes) {
-        try {
-            node->initializeGL();
-        } catch (const ghoul::RuntimeError& e) {
-            LERRORC(e.component, e.message);
-        }
-    }
     if (_dirtyNodeRegistry) {
         updateNodeRegistry();
     }
-    for (SceneGraphNode* node : _topologicallySortedNodes) {
+
+    // Measuring the performance requires glFinish calls, which have to happen on the
+    // main thread
+    const bool isConcurrent = _updatePool && !data.doPerformanceMeasurement;
+    if (isConcurrent) {
+        ghoul_assert(
+            _updateTasks.size() == _topologicallySortedNodes.size(),
+            "Update tasks are out of sync with the scene graph nodes"
+        );
+        updateTransformsConcurrently(data);
+    }
+
+    for (size_t i = 0; i < _topologicallySortedNodes.size(); ++i) {
+        SceneGraphNode* node = _topologicallySortedNodes[i];
         try {
             LTRACE("Scene::update(begin '" + node->identifier() + "')");
-            node->update(data);
+            if (isConcurrent && _updateTasks[i].isConcurrent) {
+                node->updateRenderable(data);
+            }
+            else {
+                node->update(data);
+            }
             LTRACE("Scene::update(end '" + node->identifier() + "')");
         }
         catch (const ghoul::RuntimeError& e) {
             LERRORC(e.component, e.what());
         }
     }
+
+    updateBoundingSphereHierarchy();
 }
 
-void Scene::render(const RenderData& data, RendererTasks& tasks) {
+void Scene::updateBoundingSphereHierarchy() {
     ZoneScoped
-    ZoneName(
-        renderBinToString(data.renderBinMask),
-        strlen(renderBinToString(data.renderBinMask))
-    )
 
-    for (SceneGraphNode* node : _topologicallySortedNodes) {
-        try {
-            LTRACE("Scene::render(begin '" + node->identifier() + "')");
-            node->render(data, tasks);
-            LTRACE("Scene::render(end '" + node->identifier() + "')");
+    auto sphere = [](const SceneGraphNode* node) {
+        return BoundingSphereHierarchy::Sphere{
+            node->worldPosition(),
+            node->isCullable() ? node->worldCullingSphere() : 0.0
+        };
+    };
+
+    if (_isBoundingSphereHierarchyDirty) {
+        std::vector<BoundingSphereHierarchy::Sphere> spheres;
+        spheres.reserve(_topologicallySortedNodes.size());
+        for (const SceneGraphNode* node : _topologicallySortedNodes) {
+            spheres.push_back(sphere(node));
         }
-        catch (const ghoul::RuntimeError& e) {
-            LERRORC(e.component, e.what());
+        _boundingSphereHierarchy.build(std::move(spheres));
+        _isBoundingSphereHierarchyDirty = false;
+    }
+    else {
+        for (size_t i = 0; i < _topologicallySortedNodes.size(); ++i) {
+            _boundingSphereHierarchy.setSphere(i, sphere(_topologicallySortedNodes[i]));
+        }
+        _boundingSphereHierarchy.refit();
+    }
+}
+
+void Scene::buildRenderQueue(const RenderData& data) {
+    ZoneScoped
+
+    for (std::vector<RenderQueueItem>& queue : _renderQueues) {
+        queue.clear();
+    }
+    _cullingStatistics = CullingStatistics();
+
+    const glm::dvec3 cameraPosition = data.camera.positionVec3();
+
+    // The hierarchy is only out of sync if the scene changed without an update
+    const bool isCulling = _cullingSettings.isEnabled &&
+        _boundingSphereHierarchy.nItems() == _topologicallySortedNodes.size();
+    if (isCulling) {
+        const glm::dmat4 projection = glm::dmat4(
+            data.camera.sgctInternal.projectionMatrix()
+        );
+        _boundingSphereHierarchy.cull(
+            projection * data.camera.combinedViewMatrix(),
+            cameraPosition,
+            projection[1][1] * _cullingSettings.resolutionHeight / 2.0,
+            _cullingSettings.minimumPixelSize,
+            _visibilities
+        );
+    }
+
+    for (size_t i = 0; i < _topologicallySortedNodes.size(); ++i) {
+        SceneGraphNode* node = _topologicallySortedNodes[i];
+        if (!node->isRenderedAt(data.time)) {
+            continue;
         }
-        if (global::callback::webBrowserPerformanceHotfix) {
-            (*global::callback::webBrowserPerformanceHotfix)();
+
+        if (isCulling && node->isCullable()) {
+            if (_visibilities[i] == BoundingSphereHierarchy::Visibility::OutsideFrustum) {
+                _cullingStatistics.nOutsideFrustum++;
+                continue;
+            }
+            if (_visibilities[i] == BoundingSphereHierarchy::Visibility::SubPixel) {
+                _cullingStatistics.nSubPixel++;
+                continue;
+            }
         }
-        
-        {
-            ZoneScopedN("Get Error Hack")
-
-            // @TODO(abock 2019-08-19) This glGetError call is a hack to prevent the GPU
-            // thread and the CPU thread from diverging too much, particularly the
-            // uploading of a lot of textures for the globebrowsing planets can cause a
-            // hard stuttering effect. Asking for a glGetError after every rendering call
-            // will force the threads to implicitly synchronize and thus prevent the
-            // stuttering.  The better solution would be to reduce the number of uploads
-            // per frame, use a staggered buffer, or something else like that preventing a
-            // large spike in uploads
-            glGetError();
+
+        const int bin = static_cast<int>(node->renderable()->renderBin());
+        for (int iBin = 0; iBin < NumRenderBins; ++iBin) {
+            if (bin == (1 << iBin)) {
+                _renderQueues[iBin].push_back({
+                    node,
+                    glm::distance(cameraPosition, node->worldPosition())
+                });
+                break;
+            }
+        }
+    }
+
+    // Transparent objects have to be rendered back to front
+    std::stable_sort(
+        _renderQueues[TransparentRenderBin].begin(),
+        _renderQueues[TransparentRenderBin].end(),
+        [](const RenderQueueItem& lhs, const RenderQueueItem& rhs) {
+            return lhs.distance > rhs.distance;
+        }
+    );
+}
+
+void Scene::setCullingSettings(CullingSettings settings) {
+    _cullingSettings = settings;
+}
+
+Scene::CullingStatistics Scene::cullingStatistics() const {
+    return _cullingStatistics;
+}
+
+void Scene::render(const RenderData& data, RendererTasks& tasks) {
+    for (int i = 0; i < NumRenderBins; ++i) {
+        const int bin = 1 << i;
+        if ((data.renderBinMask & bin) == 0) {
+            continue;
+        }
+
+        ZoneScoped
+        ZoneName(renderBinToString(bin), strlen(renderBinToString(bin)))
+
+        for (const RenderQueueItem& item : _renderQueues[i]) {
+            renderNode(item.node, data, tasks);
         }
     }
 }
 
+void Scene::renderNode(SceneGraphNode* node, const RenderData& data,
+                       RendererTasks& tasks)
+{
+    try {
+        LTRACE("Scene::render(begin '" + node->identifier() + "')");
+        node->render(data, tasks);
+        LTRACE("Scene::render(end '" + node->identifier() + "')");
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERRORC(e.component, e.what());
+    }
+    if (global::callback::webBrowserPerformanceHotfix) {
+        (*global::callback::webBrowserPerformanceHotfix)();
+    }
+
+    {
+        ZoneScopedN("Get Error Hack")
+
+        // @TODO(abock 2019-08-19) This glGetError call is a hack to prevent the GPU
+        // thread and the CPU thread from diverging too much, particularly the
+        // uploading of a lot of textures for the globebrowsing planets can cause a
+        // hard stuttering effect. Asking for a glGetError after every rendering call
+        // will force the threads to implicitly synchronize and thus prevent the
+        // stuttering.  The better solution would be to reduce the number of uploads
+        // per frame, use a staggered buffer, or something else like that preventing a
+        // large spike in uploads
+        glGetError();
+    }
+}
+
 void Scene::clear() {
     LINFO("Clearing current scene graph");
     _rootDummy.clearChildren();
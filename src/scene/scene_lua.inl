@@ -160,6 +160,13 @@ std::string extractUriWithoutGroupName(std::string uri) {
     return uri.substr(pos);
 }
 
+// Returns the part of the URI before the first wildcard or other regular expression
+// character, which all matching properties have in common. The separators are treated
+// as literal characters, as identifiers cannot contain them
+std::string literalUriPrefix(const std::string& uri) {
+    return uri.substr(0, uri.find_first_of("*?+()[]{}|^$\\"));
+}
+
 } // namespace
 } // namespace openspace
 
@@ -274,6 +281,10 @@ int property_setValue(lua_State* L) {
     }
 
     if (optimization.empty()) {
+        // Only the properties that start with the literal part of the URI can match, which
+        // are found without testing every property against the regular expression
+        const std::string prefix = literalUriPrefix(uriOrRegex);
+
         // Replace all wildcards * with the correct regex (.*)
         size_t startPos = uriOrRegex.find("*");
         while (startPos != std::string::npos) {
@@ -293,7 +304,7 @@ int property_setValue(lua_State* L) {
             applyRegularExpression(
                 L,
                 uriOrRegex,
-                allProperties(),
+                propertiesWithUriPrefix(prefix),
                 interpolationDuration,
                 groupName,
                 easingMethod
@@ -27,15 +27,23 @@
 #include <modules/base/scale/staticscale.h>
 #include <modules/base/rotation/staticrotation.h>
 #include <modules/base/translation/statictranslation.h>
+#include <openspace/engine/configuration.h>
 #include <openspace/engine/globals.h>
 #include <openspace/engine/windowdelegate.h>
+#include <openspace/performance/startuptracer.h>
 #include <openspace/rendering/renderable.h>
 #include <openspace/scene/scene.h>
 #include <openspace/scene/timeframe.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/opengl/ghoul_gl.h>
+#include <algorithm>
+#include <memory>
+#include <thread>
+
 #include "scenegraphnode_doc.inl"
 
 namespace {
@@ -50,6 +58,17 @@ namespace {
     constexpr const char* KeyTransformScale = "Transform.Scale";
 
     constexpr const char* KeyTimeFrame = "TimeFrame";
+    constexpr const char* KeyConcurrentUpdate = "ConcurrentUpdate";
+
+    // The threads on which deferred renderables are initialized when they are enabled.
+    // Enabling many renderables at once queues their initializations instead of starting
+    // a thread for each of them
+    openspace::ThreadPool& initializationPool() {
+        static openspace::ThreadPool pool(
+            std::max(std::thread::hardware_concurrency() / 2, 1u)
+        );
+        return pool;
+    }
 
     constexpr openspace::properties::Property::PropertyInfo ComputeScreenSpaceInfo =
     {
@@ -117,6 +136,17 @@ namespace {
         openspace::properties::Property::Visibility::Hidden
     };
 
+    constexpr openspace::properties::Property::PropertyInfo LoadingStateInfo = {
+        "RenderableLoadingState",
+        "Renderable Loading State",
+        "The initialization state of the renderable of this scene graph node. If the "
+        "initialization of disabled renderables is deferred, this is 'Deferred' until "
+        "the renderable is enabled for the first time, 'Loading' while it initializes "
+        "in the background, and 'Ready' afterwards. If the initialization fails, the "
+        "value is 'Failed' and the initialization is retried the next time the "
+        "renderable is enabled."
+    };
+
 } // namespace
 
 namespace openspace {
@@ -241,6 +271,8 @@ std::unique_ptr<SceneGraphNode> SceneGraphNode::createFromDictionary(
             return nullptr;
         }
         result->addPropertySubOwner(result->_renderable.get());
+        result->_renderableLoadingState.setReadOnly(true);
+        result->addProperty(result->_renderableLoadingState);
         LDEBUG(fmt::format(
             "Successfully created renderable for '{}'", result->identifier()
         ));
@@ -271,6 +303,10 @@ std::unique_ptr<SceneGraphNode> SceneGraphNode::createFromDictionary(
         result->addProperty(result->_guiPath);
     }
 
+    if (dictionary.hasKey(KeyConcurrentUpdate)) {
+        result->_allowsConcurrentUpdate = dictionary.value<bool>(KeyConcurrentUpdate);
+    }
+
     if (dictionary.hasKey(KeyFixedBoundingSphere)) {
         result->_fixedBoundingSphere = static_cast<float>(
             dictionary.value<double>(KeyFixedBoundingSphere)
@@ -286,6 +322,7 @@ std::unique_ptr<SceneGraphNode> SceneGraphNode::createFromDictionary(
 SceneGraphNode::SceneGraphNode()
     : properties::PropertyOwner({ "" })
     , _guiHidden(GuiHiddenInfo)
+    , _renderableLoadingState(LoadingStateInfo, "Loading")
     , _guiPath(GuiPathInfo)
     , _guiDisplayName(GuiNameInfo)
     , _transform {
@@ -310,16 +347,44 @@ SceneGraphNode::SceneGraphNode()
     addProperty(_visibilityDistance);
 }
 
-SceneGraphNode::~SceneGraphNode() {} // NOLINT
+SceneGraphNode::~SceneGraphNode() { // NOLINT
+    // The initialization runs on a shared pool, so it would otherwise outlive the
+    // renderable it is initializing
+    if (_renderableInitialization.valid()) {
+        _renderableInitialization.wait();
+    }
+}
 
 void SceneGraphNode::initialize() {
     ZoneScoped
     ZoneName(identifier().c_str(), identifier().size())
 
+    performance::StartupTracer::ScopedSpan span(
+        global::startupTracer,
+        identifier(),
+        performance::StartupTracer::Category::Node,
+        "Initialize"
+    );
+
     LDEBUG(fmt::format("Initializing: {}", identifier()));
 
     if (_renderable) {
-        _renderable->initialize();
+        if (global::configuration.deferDisabledRenderables &&
+            !_renderable->isEnabled())
+        {
+            // Only pay for the renderable if it is ever shown
+            _renderableState = RenderableState::Deferred;
+            _renderableLoadingState = "Deferred";
+            _renderable->onEnabledChange([this](bool isEnabled) {
+                if (isEnabled && _renderableState == RenderableState::Deferred) {
+                    startRenderableInitialization();
+                }
+            });
+        }
+        else {
+            _renderable->initialize();
+            _renderableState = RenderableState::Initialized;
+        }
     }
 
     if (_transform.translation) {
@@ -340,10 +405,19 @@ void SceneGraphNode::initializeGL() {
     ZoneScoped
     ZoneName(identifier().c_str(), identifier().size())
 
+    performance::StartupTracer::ScopedSpan span(
+        global::startupTracer,
+        identifier(),
+        performance::StartupTracer::Category::Node,
+        "InitializeGL"
+    );
+
     LDEBUG(fmt::format("Initializing GL: {}", identifier()));
 
-    if (_renderable) {
+    if (_renderable && _renderableState == RenderableState::Initialized) {
         _renderable->initializeGL();
+        _renderableState = RenderableState::GLInitialized;
+        _renderableLoadingState = "Ready";
     }
     _state = State::GLInitialized;
 
@@ -358,7 +432,8 @@ void SceneGraphNode::deinitialize() {
 
     setScene(nullptr);
 
-    if (_renderable) {
+    waitForRenderableInitialization();
+    if (_renderable && _renderableState != RenderableState::Deferred) {
         _renderable->deinitialize();
     }
     clearChildren();
@@ -373,13 +448,83 @@ void SceneGraphNode::deinitializeGL() {
 
     LDEBUG(fmt::format("Deinitializing GL: {}", identifier()));
 
-    if (_renderable) {
+    waitForRenderableInitialization();
+    if (_renderable && _renderableState == RenderableState::GLInitialized) {
         _renderable->deinitializeGL();
+        _renderableState = RenderableState::Initialized;
     }
 
     LDEBUG(fmt::format("Finished deinitializing GL: {}", identifier()));
 }
 
+void SceneGraphNode::startRenderableInitialization() {
+    ghoul_assert(_renderable, "No renderable to initialize");
+    ghoul_assert(
+        _renderableState == RenderableState::Deferred,
+        "Renderable must not have been initialized"
+    );
+
+    LDEBUG(fmt::format("Initializing deferred renderable: {}", identifier()));
+
+    _renderableState = RenderableState::Initializing;
+    _renderableLoadingState = "Loading";
+    auto task = std::make_shared<std::packaged_task<void()>>(
+        [this]() { _renderable->initialize(); }
+    );
+    _renderableInitialization = task->get_future();
+    initializationPool().enqueue([task]() { (*task)(); });
+}
+
+void SceneGraphNode::finishRenderableInitialization() {
+    using namespace std::chrono_literals;
+    if (_renderableInitialization.wait_for(0s) != std::future_status::ready) {
+        return;
+    }
+
+    try {
+        _renderableInitialization.get();
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERRORC(e.component, e.message);
+        // Try again the next time the renderable is enabled
+        _renderableState = RenderableState::Deferred;
+        _renderableLoadingState = "Failed";
+        return;
+    }
+    _renderableState = RenderableState::Initialized;
+
+    // If the node itself is not OpenGL-initialized yet, its initializeGL will continue
+    // with the renderable
+    if (_state == State::GLInitialized) {
+        try {
+            _renderable->initializeGL();
+            _renderableState = RenderableState::GLInitialized;
+            _renderableLoadingState = "Ready";
+        }
+        catch (const ghoul::RuntimeError& e) {
+            // The renderable stays initialized, so that it is deinitialized correctly
+            LERRORC(e.component, e.message);
+            _renderableLoadingState = "Failed";
+        }
+    }
+}
+
+void SceneGraphNode::waitForRenderableInitialization() {
+    if (_renderableState != RenderableState::Initializing) {
+        return;
+    }
+
+    _renderableInitialization.wait();
+    try {
+        _renderableInitialization.get();
+        _renderableState = RenderableState::Initialized;
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERRORC(e.component, e.message);
+        _renderableState = RenderableState::Deferred;
+    }
+}
+
 void SceneGraphNode::traversePreOrder(const std::function<void(SceneGraphNode*)>& fn) {
     fn(this);
     for (std::unique_ptr<SceneGraphNode>& child : _children) {
@@ -395,15 +540,23 @@ void SceneGraphNode::traversePostOrder(const std::function<void(SceneGraphNode*)
 }
 
 void SceneGraphNode::update(const UpdateData& data) {
+    // updateRenderable returns early if the transformation was not updated, but it
+    // still has to check for a renderable that finished its deferred initialization
+    updateTransform(data);
+    updateRenderable(data);
+}
+
+bool SceneGraphNode::updateTransform(const UpdateData& data) {
     ZoneScoped
     ZoneName(identifier().c_str(), identifier().size())
 
+    _isTransformUpdated = false;
     State s = _state;
     if (s != State::Initialized && _state != State::GLInitialized) {
-        return;
+        return false;
     }
     if (!isTimeFrameActive(data.time)) {
-        return;
+        return false;
     }
 
     if (_transform.translation) {
@@ -453,35 +606,42 @@ void SceneGraphNode::update(const UpdateData& data) {
             _transform.scale->update(data);
         }
     }
-    UpdateData newUpdateData = data;
 
     // Assumes _worldRotationCached and _worldScaleCached have been calculated for parent
     _worldPositionCached = calculateWorldPosition();
     _worldRotationCached = calculateWorldRotation();
     _worldScaleCached = calculateWorldScale();
 
-    newUpdateData.modelTransform.translation = _worldPositionCached;
-    newUpdateData.modelTransform.rotation = _worldRotationCached;
-    newUpdateData.modelTransform.scale = _worldScaleCached;
-
-    glm::dmat4 translation = glm::translate(
-        glm::dmat4(1.0),
-        newUpdateData.modelTransform.translation
-    );
-    glm::dmat4 rotation = glm::dmat4(newUpdateData.modelTransform.rotation);
+    glm::dmat4 translation = glm::translate(glm::dmat4(1.0), _worldPositionCached);
+    glm::dmat4 rotation = glm::dmat4(_worldRotationCached);
     glm::dmat4 scaling = glm::scale(
         glm::dmat4(1.0),
-        glm::dvec3(
-            newUpdateData.modelTransform.scale,
-            newUpdateData.modelTransform.scale,
-            newUpdateData.modelTransform.scale
-        )
+        glm::dvec3(_worldScaleCached, _worldScaleCached, _worldScaleCached)
     );
 
     _modelTransformCached = translation * rotation * scaling;
     _inverseModelTransformCached = glm::inverse(_modelTransformCached);
+    _isTransformUpdated = true;
+    return true;
+}
+
+void SceneGraphNode::updateRenderable(const UpdateData& data) {
+    if (_renderableState == RenderableState::Initializing) {
+        finishRenderableInitialization();
+    }
 
-    if (_renderable && _renderable->isReady()) {
+    if (!_isTransformUpdated) {
+        return;
+    }
+
+    UpdateData newUpdateData = data;
+    newUpdateData.modelTransform.translation = _worldPositionCached;
+    newUpdateData.modelTransform.rotation = _worldRotationCached;
+    newUpdateData.modelTransform.scale = _worldScaleCached;
+
+    const bool isInitialized = _renderableState == RenderableState::Initialized ||
+                               _renderableState == RenderableState::GLInitialized;
+    if (_renderable && isInitialized && _renderable->isReady()) {
         if (data.doPerformanceMeasurement) {
             glFinish();
             auto start = std::chrono::high_resolution_clock::now();
@@ -498,14 +658,44 @@ void SceneGraphNode::update(const UpdateData& data) {
     }
 }
 
+bool SceneGraphNode::isUpdateThreadSafe() const {
+    return _allowsConcurrentUpdate &&
+        (!_transform.translation || _transform.translation->isThreadSafe()) &&
+        (!_transform.rotation || _transform.rotation->isThreadSafe()) &&
+        (!_transform.scale || _transform.scale->isThreadSafe());
+}
+
+bool SceneGraphNode::isRenderedAt(const Time& time) const {
+    return _state == State::GLInitialized &&
+           _renderableState == RenderableState::GLInitialized &&
+           _renderable &&
+           _renderable->isVisible() &&
+           _renderable->isReady() &&
+           _renderable->isEnabled() &&
+           isTimeFrameActive(time);
+}
+
+bool SceneGraphNode::isCullable() const {
+    // The screen space values are computed while rendering, so they would not be updated
+    // for culled nodes
+    return _renderable && _renderable->isCullable() &&
+           _renderable->cullingSphere() > 0.f && !_computeScreenSpaceValues;
+}
+
+double SceneGraphNode::worldCullingSphere() const {
+    if (!_renderable) {
+        return 0.0;
+    }
+    // The culling sphere is not always specified in the scaled model coordinates, so
+    // only scales that enlarge the sphere are applied to be on the safe side
+    const double radius = static_cast<double>(_renderable->cullingSphere());
+    return radius * std::max(_worldScaleCached, 1.0);
+}
+
 void SceneGraphNode::render(const RenderData& data, RendererTasks& tasks) {
     ZoneScoped
     ZoneName(identifier().c_str(), identifier().size())
 
-    if (_state != State::GLInitialized) {
-        return;
-    }
-
     RenderData newData = {
         data.camera,
         data.time,
@@ -514,20 +704,6 @@ void SceneGraphNode::render(const RenderData& data, RendererTasks& tasks) {
         { _worldPositionCached, _worldRotationCached, _worldScaleCached }
     };
 
-    if (!isTimeFrameActive(data.time)) {
-        return;
-    }
-
-    bool visible = _renderable &&
-                   _renderable->isVisible() &&
-                   _renderable->isReady() &&
-                   _renderable->isEnabled() &&
-                   _renderable->matchesRenderBinMask(data.renderBinMask);
-
-    if (!visible) {
-        return;
-    }
-
     if (data.doPerformanceMeasurement) {
         glFinish();
         auto start = std::chrono::high_resolution_clock::now();
@@ -104,6 +104,15 @@ documentation::Documentation SceneGraphNode::Documentation() {
             Optional::Yes,
             "Specifies the time frame for when this node should be active."
         },
+        {
+            "ConcurrentUpdate",
+            new BoolVerifier,
+            Optional::Yes,
+            "If this value is 'false', the translation, rotation, and scale of this node "
+            "are always updated on the main thread, even if they could be updated "
+            "concurrently with other nodes. This can be used for components that are "
+            "not safe to be used from multiple threads. Defaults to 'true'."
+        },
         {
             "GUI",
             new TableVerifier({
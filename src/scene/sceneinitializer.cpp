@@ -26,9 +26,20 @@
 
 #include <openspace/engine/globals.h>
 #include <openspace/engine/openspaceengine.h>
+#include <openspace/json.h>
 #include <openspace/rendering/loadingscreen.h>
 #include <openspace/scene/scenegraphnode.h>
+#include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <algorithm>
+#include <fstream>
+
+namespace {
+    constexpr const char* _loggerCat = "SceneInitializer";
+
+    constexpr const int CostCacheVersion = 1;
+} // namespace
 
 namespace openspace {
 
@@ -46,40 +57,69 @@ bool SingleThreadedSceneInitializer::isInitializing() const {
     return false;
 }
 
-MultiThreadedSceneInitializer::MultiThreadedSceneInitializer(unsigned int nThreads)
-    : _threadPool(nThreads)
-{}
+MultiThreadedSceneInitializer::MultiThreadedSceneInitializer(unsigned int nThreads,
+                                                             std::string costCacheFile)
+    : _costCacheFile(std::move(costCacheFile))
+    , _threadPool(nThreads)
+{
+    if (_costCacheFile.empty()) {
+        return;
+    }
 
-void MultiThreadedSceneInitializer::initializeNode(SceneGraphNode* node) {
-    auto initFunction = [this, node]() {
-        LoadingScreen* loadingScreen = global::openSpaceEngine.loadingScreen();
-
-        LoadingScreen::ProgressInfo progressInfo;
-        progressInfo.progress = 1.f;
-        if (loadingScreen) {
-            loadingScreen->updateItem(
-                node->identifier(),
-                node->guiName(),
-                LoadingScreen::ItemStatus::Initializing,
-                progressInfo
-            );
+    std::ifstream file(_costCacheFile);
+    if (!file.good()) {
+        // There is no information from a previous run
+        return;
+    }
+
+    try {
+        const nlohmann::json json = nlohmann::json::parse(file);
+        if (json.value("version", 0) != CostCacheVersion) {
+            LWARNING(fmt::format(
+                "Ignoring outdated initialization costs in '{}'", _costCacheFile
+            ));
+            return;
         }
 
-        node->initialize();
-        std::lock_guard<std::mutex> g(_mutex);
-        _initializedNodes.push_back(node);
-        _initializingNodes.erase(node);
-
-        if (loadingScreen) {
-            loadingScreen->updateItem(
-                node->identifier(),
-                node->guiName(),
-                LoadingScreen::ItemStatus::Finished,
-                progressInfo
-            );
+        for (const nlohmann::json& focus : json.at("focus")) {
+            _focusNodes.insert(focus.get<std::string>());
         }
-    };
 
+        const nlohmann::json& costs = json.at("costs");
+        std::chrono::microseconds totalCost = std::chrono::microseconds(0);
+        for (auto it = costs.begin(); it != costs.end(); ++it) {
+            const std::chrono::microseconds cost(it.value().get<int64_t>());
+            _expectedCosts[it.key()] = cost;
+            totalCost += cost;
+        }
+        // Nodes that were not part of the previous run are assumed to be average
+        if (!_expectedCosts.empty()) {
+            _defaultCost = totalCost / static_cast<int64_t>(_expectedCosts.size());
+        }
+    }
+    catch (const nlohmann::json::exception& e) {
+        LWARNING(fmt::format(
+            "Could not read initialization costs from '{}': {}", _costCacheFile, e.what()
+        ));
+        _focusNodes.clear();
+        _expectedCosts.clear();
+    }
+}
+
+bool MultiThreadedSceneInitializer::hasLowerPriority(const PendingNode& lhs,
+                                                     const PendingNode& rhs)
+{
+    // Nodes the camera focus depends on come first, then the most expensive nodes
+    if (lhs.isFocus != rhs.isFocus) {
+        return rhs.isFocus;
+    }
+    if (lhs.cost != rhs.cost) {
+        return lhs.cost < rhs.cost;
+    }
+    return lhs.index > rhs.index;
+}
+
+void MultiThreadedSceneInitializer::initializeNode(SceneGraphNode* node) {
     LoadingScreen::ProgressInfo progressInfo;
     progressInfo.progress = 0.f;
 
@@ -94,9 +134,69 @@ void MultiThreadedSceneInitializer::initializeNode(SceneGraphNode* node) {
         );
     }
 
+    {
+        std::lock_guard<std::mutex> g(_mutex);
+        _initializingNodes.insert(node);
+
+        const auto it = _expectedCosts.find(node->identifier());
+        PendingNode pending = {
+            node,
+            _focusNodes.find(node->identifier()) != _focusNodes.end(),
+            it != _expectedCosts.end() ? it->second : _defaultCost,
+            _nAddedNodes
+        };
+        _nAddedNodes++;
+        _pendingNodes.push_back(std::move(pending));
+        std::push_heap(_pendingNodes.begin(), _pendingNodes.end(), hasLowerPriority);
+    }
+
+    // Every task initializes whichever node has the highest priority at the time the
+    // task starts, so nodes added later can still overtake nodes that are waiting
+    _threadPool.enqueue([this]() { initializeNextNode(); });
+}
+
+void MultiThreadedSceneInitializer::initializeNextNode() {
+    SceneGraphNode* node = nullptr;
+    {
+        std::lock_guard<std::mutex> g(_mutex);
+        ghoul_assert(!_pendingNodes.empty(), "No node left for the initialization task");
+        std::pop_heap(_pendingNodes.begin(), _pendingNodes.end(), hasLowerPriority);
+        node = _pendingNodes.back().node;
+        _pendingNodes.pop_back();
+    }
+
+    LoadingScreen* loadingScreen = global::openSpaceEngine.loadingScreen();
+
+    LoadingScreen::ProgressInfo progressInfo;
+    progressInfo.progress = 1.f;
+    if (loadingScreen) {
+        loadingScreen->updateItem(
+            node->identifier(),
+            node->guiName(),
+            LoadingScreen::ItemStatus::Initializing,
+            progressInfo
+        );
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point begin = Clock::now();
+    node->initialize();
+    const std::chrono::microseconds cost =
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - begin);
+
     std::lock_guard<std::mutex> g(_mutex);
-    _initializingNodes.insert(node);
-    _threadPool.enqueue(initFunction);
+    _measuredCosts[node->identifier()] = cost;
+    _initializedNodes.push_back(node);
+    _initializingNodes.erase(node);
+
+    if (loadingScreen) {
+        loadingScreen->updateItem(
+            node->identifier(),
+            node->guiName(),
+            LoadingScreen::ItemStatus::Finished,
+            progressInfo
+        );
+    }
 }
 
 std::vector<SceneGraphNode*> MultiThreadedSceneInitializer::takeInitializedNodes() {
@@ -110,4 +210,59 @@ bool MultiThreadedSceneInitializer::isInitializing() const {
     return !_initializingNodes.empty();
 }
 
+void MultiThreadedSceneInitializer::saveCosts(const SceneGraphNode* focus) const {
+    if (_costCacheFile.empty()) {
+        return;
+    }
+
+    // The focus node can only be shown once its parents and dependencies have been
+    // initialized as well
+    nlohmann::json focusNodes = nlohmann::json::array();
+    std::vector<const SceneGraphNode*> toVisit;
+    std::unordered_set<const SceneGraphNode*> visited;
+    if (focus) {
+        toVisit.push_back(focus);
+    }
+    while (!toVisit.empty()) {
+        const SceneGraphNode* n = toVisit.back();
+        toVisit.pop_back();
+        if (!visited.insert(n).second) {
+            continue;
+        }
+
+        focusNodes.push_back(n->identifier());
+        if (n->parent()) {
+            toVisit.push_back(n->parent());
+        }
+        for (const SceneGraphNode* dependency : n->dependencies()) {
+            toVisit.push_back(dependency);
+        }
+    }
+
+    nlohmann::json costs = nlohmann::json::object();
+    {
+        std::lock_guard<std::mutex> g(_mutex);
+        for (const std::pair<const std::string, std::chrono::microseconds>& p :
+             _measuredCosts)
+        {
+            costs[p.first] = p.second.count();
+        }
+    }
+
+    const nlohmann::json json = {
+        { "version", CostCacheVersion },
+        { "focus", std::move(focusNodes) },
+        { "costs", std::move(costs) }
+    };
+
+    std::ofstream file(_costCacheFile);
+    if (!file.good()) {
+        LWARNING(fmt::format(
+            "Could not write initialization costs to '{}'", _costCacheFile
+        ));
+        return;
+    }
+    file << json.dump();
+}
+
 } // namespace openspace
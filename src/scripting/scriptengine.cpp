@@ -28,6 +28,10 @@
 #include <openspace/engine/globals.h>
 #include <openspace/interaction/sessionrecording.h>
 #include <openspace/network/parallelpeer.h>
+#include <openspace/properties/property.h>
+#include <openspace/query/query.h>
+#include <openspace/rendering/renderengine.h>
+#include <openspace/scene/scene.h>
 #include <openspace/util/syncbuffer.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
@@ -684,17 +688,28 @@ void ScriptEngine::preSync(bool isMaster) {
         QueueItem item = std::move(_incomingScripts.front());
         _incomingScripts.pop();
 
-        _scriptsToSync.push_back(item.script);
+        // Scripts and property sets are synchronized in the same queue, so that they are
+        // applied on all nodes in the order in which they were queued
+        const bool isPropertySet = !item.uri.empty();
+        _scriptsToSync.push_back({ item.uri, isPropertySet ? item.value : item.script });
+
+        // Neither the parallel connection nor the session recording know about the
+        // binary property sets, so we have to fall back to a script for them
+        const std::string script = isPropertySet ?
+            fmt::format(
+                "openspace.setPropertyValueSingle('{}', {});", item.uri, item.luaValue
+            ) :
+            item.script;
         const bool remoteScripting = item.remoteScripting;
 
         // Not really a received script but the master also needs to run the script...
-        _masterScriptQueue.push(item);
+        _masterScriptQueue.push(std::move(item));
 
         if (global::parallelPeer.isHost() && remoteScripting) {
-            global::parallelPeer.sendScript(item.script);
+            global::parallelPeer.sendScript(script);
         }
         if (global::sessionRecording.isRecording()) {
-            global::sessionRecording.saveScriptKeyframe(item.script);
+            global::sessionRecording.saveScriptKeyframe(script);
         }
     }
 }
@@ -704,8 +719,9 @@ void ScriptEngine::encode(SyncBuffer* syncBuffer) {
 
     size_t nScripts = _scriptsToSync.size();
     syncBuffer->encode(nScripts);
-    for (const std::string& s : _scriptsToSync) {
-        syncBuffer->encode(s);
+    for (const SyncItem& item : _scriptsToSync) {
+        syncBuffer->encode(item.uri);
+        syncBuffer->encode(item.value);
     }
     _scriptsToSync.clear();
 }
@@ -718,9 +734,10 @@ void ScriptEngine::decode(SyncBuffer* syncBuffer) {
     syncBuffer->decode(nScripts);
 
     for (size_t i = 0; i < nScripts; ++i) {
-        std::string script;
-        syncBuffer->decode(script);
-        _slaveScriptQueue.push(std::move(script));
+        SyncItem item;
+        syncBuffer->decode(item.uri);
+        syncBuffer->decode(item.value);
+        _slaveScriptQueue.push(std::move(item));
     }
 }
 
@@ -729,11 +746,15 @@ void ScriptEngine::postSync(bool isMaster) {
 
     if (isMaster) {
         while (!_masterScriptQueue.empty()) {
-            std::string script = std::move(_masterScriptQueue.front().script);
-            ScriptCallback callback = std::move(_masterScriptQueue.front().callback);
+            QueueItem item = std::move(_masterScriptQueue.front());
             _masterScriptQueue.pop();
+            if (!item.uri.empty()) {
+                applyPropertySet(item.uri, item.value);
+                continue;
+            }
+
             try {
-                runScript(script, callback);
+                runScript(item.script, item.callback);
             }
             catch (const ghoul::RuntimeError& e) {
                 LERRORC(e.component, e.message);
@@ -744,9 +765,15 @@ void ScriptEngine::postSync(bool isMaster) {
     else {
         std::lock_guard<std::mutex> guard(_slaveScriptsMutex);
         while (!_slaveScriptQueue.empty()) {
+            SyncItem item = std::move(_slaveScriptQueue.front());
+            _slaveScriptQueue.pop();
+            if (!item.uri.empty()) {
+                applyPropertySet(item.uri, item.value);
+                continue;
+            }
+
             try {
-                runScript(_slaveScriptQueue.front());
-                _slaveScriptQueue.pop();
+                runScript(item.value);
             }
             catch (const ghoul::RuntimeError& e) {
                 LERRORC(e.component, e.message);
@@ -766,4 +793,40 @@ void ScriptEngine::queueScript(const std::string& script,
     }
 }
 
+void ScriptEngine::queuePropertySet(std::string uri, std::string binaryValue,
+                                    std::string luaValue,
+                                    RemoteScripting remoteScripting)
+{
+    ZoneScoped
+
+    if (!uri.empty()) {
+        QueueItem item;
+        item.remoteScripting = remoteScripting;
+        item.uri = std::move(uri);
+        item.value = std::move(binaryValue);
+        item.luaValue = std::move(luaValue);
+        _incomingScripts.push(std::move(item));
+    }
+}
+
+void ScriptEngine::applyPropertySet(const std::string& uri, std::string_view value) {
+    properties::Property* prop = property(uri);
+    if (!prop) {
+        LERROR(fmt::format("Property with URI '{}' was not found", uri));
+        return;
+    }
+
+    // Mirror openspace.setPropertyValueSingle without an interpolation duration
+    Scene* scene = global::renderEngine.scene();
+    if (scene) {
+        scene->removePropertyInterpolation(prop);
+    }
+    if (!prop->setBinaryValue(value)) {
+        LERROR(fmt::format(
+            "Property '{}' does not accept the binary value of size {}",
+            uri, value.size()
+        ));
+    }
+}
+
 } // namespace openspace::scripting
@@ -25,6 +25,8 @@
 #include <openspace/util/openspacemodule.h>
 
 #include <openspace/documentation/documentation.h>
+#include <openspace/engine/globals.h>
+#include <openspace/performance/startuptracer.h>
 #include <openspace/scripting/lualibrary.h>
 #include <ghoul/fmt.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -52,6 +54,12 @@ void OpenSpaceModule::initialize(const ModuleEngine* moduleEngine,
 {
     ZoneScoped
     ZoneName(identifier().c_str(), identifier().size())
+    performance::StartupTracer::ScopedSpan span(
+        global::startupTracer,
+        identifier(),
+        performance::StartupTracer::Category::Module,
+        "Initialize"
+    );
 
     std::string upperIdentifier = identifier();
     std::transform(
@@ -78,6 +86,12 @@ void OpenSpaceModule::initialize(const ModuleEngine* moduleEngine,
 void OpenSpaceModule::initializeGL() {
     ZoneScoped
     ZoneName(identifier().c_str(), identifier().size())
+    performance::StartupTracer::ScopedSpan span(
+        global::startupTracer,
+        identifier(),
+        performance::StartupTracer::Category::Module,
+        "InitializeGL"
+    );
 
     internalInitializeGL();
 }
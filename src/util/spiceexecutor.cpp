@@ -0,0 +1,174 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/spiceexecutor.h>
+
+#include <memory>
+
+namespace openspace {
+
+SpiceExecutor::SpiceExecutor() {
+    _thread = std::thread([this]() { processJobs(); });
+}
+
+SpiceExecutor::~SpiceExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+}
+
+std::future<std::vector<SpiceExecutor::Result>> SpiceExecutor::submit(
+                                                              std::vector<Request> batch)
+{
+    auto task = std::make_shared<std::packaged_task<std::vector<Result>()>>(
+        [this, b = std::move(batch)]() { return evaluate(b); }
+    );
+    std::future<std::vector<Result>> result = task->get_future();
+    enqueue([task]() { (*task)(); });
+    return result;
+}
+
+std::vector<SpiceExecutor::Result> SpiceExecutor::execute(
+                                                        const std::vector<Request>& batch)
+{
+    return run([this, &batch]() { return evaluate(batch); });
+}
+
+bool SpiceExecutor::isSpiceThread() const {
+    return std::this_thread::get_id() == _thread.get_id();
+}
+
+void SpiceExecutor::enqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(std::move(job));
+    }
+    _condition.notify_one();
+}
+
+void SpiceExecutor::processJobs() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]() { return _isStopping || !_jobs.empty(); });
+            // All jobs that were submitted before the destruction are still finished, as
+            // their callers are waiting for them
+            if (_jobs.empty()) {
+                return;
+            }
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+        job();
+    }
+}
+
+std::vector<SpiceExecutor::Result> SpiceExecutor::evaluate(
+                                                  const std::vector<Request>& batch) const
+{
+    const SpiceManager& spice = SpiceManager::ref();
+
+    struct Evaluator {
+        const SpiceManager& spice;
+
+        Result operator()(const PositionRequest& r) const {
+            PositionResult res;
+            if (r.query) {
+                res.position = spice.targetPosition(*r.query, r.time, res.lightTime);
+            }
+            else {
+                res.position = spice.targetPosition(
+                    r.target,
+                    r.observer,
+                    r.referenceFrame,
+                    r.aberrationCorrection,
+                    r.time,
+                    res.lightTime
+                );
+            }
+            return { res, nullptr };
+        }
+
+        Result operator()(const StateRequest& r) const {
+            return {
+                spice.targetState(
+                    r.target,
+                    r.observer,
+                    r.referenceFrame,
+                    r.aberrationCorrection,
+                    r.time
+                ),
+                nullptr
+            };
+        }
+
+        Result operator()(const TransformMatrixRequest& r) const {
+            if (r.estimateUncovered) {
+                return { spice.positionTransformMatrix(r.from, r.to, r.time), nullptr };
+            }
+            else {
+                return { spice.frameTransformationMatrix(r.from, r.to, r.time), nullptr };
+            }
+        }
+
+        Result operator()(const FieldOfViewRequest& r) const {
+            return { spice.fieldOfView(r.instrument), nullptr };
+        }
+
+        Result operator()(const SurfaceInterceptRequest& r) const {
+            return {
+                spice.surfaceIntercept(
+                    r.target,
+                    r.observer,
+                    r.fovFrame,
+                    r.referenceFrame,
+                    r.aberrationCorrection,
+                    r.time,
+                    r.direction
+                ),
+                nullptr
+            };
+        }
+    };
+
+    std::vector<Result> results;
+    results.reserve(batch.size());
+    for (const Request& request : batch) {
+        try {
+            results.push_back(std::visit(Evaluator{ spice }, request));
+        }
+        catch (...) {
+            Result result;
+            result.exception = std::current_exception();
+            results.push_back(std::move(result));
+        }
+    }
+    return results;
+}
+
+} // namespace openspace
@@ -25,12 +25,18 @@
 #include <openspace/util/spicemanager.h>
 
 #include <openspace/scripting/lualibrary.h>
+#include <openspace/util/spiceexecutor.h>
 #include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/misc/assert.h>
 #include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <string_view>
 #include "SpiceUsr.h"
 #include "SpiceZpr.h"
 
@@ -65,6 +71,166 @@ namespace {
         }
     }
 
+    struct CalendarDate {
+        int year = 0;
+        int month = 0;
+        int day = 0;
+        int hour = 0;
+        int minute = 0;
+        double second = 0.0;
+    };
+
+    // Reads a number with between minDigits and maxDigits digits starting at pos and
+    // advances pos past it
+    bool readNumber(std::string_view str, size_t& pos, size_t minDigits,
+                    size_t maxDigits, int& value)
+    {
+        value = 0;
+        size_t nDigits = 0;
+        while (pos < str.size() && nDigits < maxDigits &&
+               str[pos] >= '0' && str[pos] <= '9')
+        {
+            value = value * 10 + (str[pos] - '0');
+            ++pos;
+            ++nDigits;
+        }
+        return nDigits >= minDigits;
+    }
+
+    // Returns the month [1, 12] for a three letter month abbreviation or 0 if the
+    // abbreviation is unknown
+    int monthFromName(std::string_view name) {
+        constexpr const char* Months[] = {
+            "JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+            "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"
+        };
+        for (int i = 0; i < 12; ++i) {
+            bool equal = true;
+            for (int j = 0; j < 3; ++j) {
+                const char c = name[j];
+                const char upper = (c >= 'a' && c <= 'z') ? c - 'a' + 'A' : c;
+                equal &= (upper == Months[i][j]);
+            }
+            if (equal) {
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+
+    bool isLeapYear(int year) {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    int daysInMonth(int year, int month) {
+        constexpr const int Days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        return (month == 2 && isLeapYear(year)) ? 29 : Days[month - 1];
+    }
+
+    // Number of days between 2000-01-01 and the passed date of the Gregorian calendar
+    long long daysSinceJ2000(int year, int month, int day) {
+        // http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+        const int y = month <= 2 ? year - 1 : year;
+        const int era = y / 400;
+        const int yoe = y - era * 400;
+        const int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return static_cast<long long>(era) * 146097 + doe - 719468 - 10957;
+    }
+
+    // Parses the UTC calendar dates that we encounter most often: YYYY-MM-DD,
+    // YYYY-MON-DD, or YYYY MON DD, optionally followed by a space (or a 'T' for
+    // YYYY-MM-DD) and hh:mm or hh:mm:ss.fff. Every other format, including leap
+    // seconds and time system or time zone labels, is rejected so that it is handled by
+    // str2et_c instead
+    bool parseCalendarDate(std::string_view str, CalendarDate& date) {
+        while (!str.empty() && str.front() == ' ') {
+            str.remove_prefix(1);
+        }
+        while (!str.empty() && str.back() == ' ') {
+            str.remove_suffix(1);
+        }
+
+        size_t pos = 0;
+        if (!readNumber(str, pos, 4, 4, date.year) || date.year < 1000) {
+            return false;
+        }
+        if (pos == str.size() || (str[pos] != '-' && str[pos] != ' ')) {
+            return false;
+        }
+        const char separator = str[pos];
+        ++pos;
+
+        if (pos + 3 <= str.size() && std::isalpha(static_cast<unsigned char>(str[pos])))
+        {
+            date.month = monthFromName(str.substr(pos, 3));
+            pos += 3;
+        }
+        else if (separator == '-') {
+            readNumber(str, pos, 2, 2, date.month);
+        }
+        const bool isIso = date.month != 0 && separator == '-' &&
+                           std::isdigit(static_cast<unsigned char>(str[pos - 1]));
+        if (date.month < 1 || date.month > 12) {
+            return false;
+        }
+        if (pos == str.size() || str[pos] != separator) {
+            return false;
+        }
+        ++pos;
+        if (!readNumber(str, pos, 1, 2, date.day) || date.day < 1 ||
+            date.day > daysInMonth(date.year, date.month))
+        {
+            return false;
+        }
+
+        if (pos == str.size()) {
+            return true;
+        }
+        // SPICE only accepts the 'T' separator for ISO dates
+        if ((str[pos] != 'T' || !isIso) && str[pos] != ' ') {
+            return false;
+        }
+        ++pos;
+
+        if (!readNumber(str, pos, 1, 2, date.hour) || date.hour > 23) {
+            return false;
+        }
+        if (pos == str.size() || str[pos] != ':') {
+            return false;
+        }
+        ++pos;
+        if (!readNumber(str, pos, 2, 2, date.minute) || date.minute > 59) {
+            return false;
+        }
+        if (pos == str.size()) {
+            return true;
+        }
+        if (str[pos] != ':') {
+            return false;
+        }
+        ++pos;
+
+        // Seconds are two digits with an optional fraction
+        const size_t secondsBegin = pos;
+        int wholeSeconds = 0;
+        if (!readNumber(str, pos, 2, 2, wholeSeconds) || wholeSeconds > 59) {
+            return false;
+        }
+        if (pos < str.size() && str[pos] == '.') {
+            ++pos;
+            while (pos < str.size() && str[pos] >= '0' && str[pos] <= '9') {
+                ++pos;
+            }
+        }
+        if (pos != str.size()) {
+            return false;
+        }
+        const std::string seconds(str.substr(secondsBegin));
+        date.second = std::strtod(seconds.c_str(), nullptr);
+        return date.second < 60.0;
+    }
+
     const char* toString(openspace::SpiceManager::FieldOfViewMethod m) {
         using SM = openspace::SpiceManager;
         switch (m) {
@@ -174,9 +340,15 @@ SpiceManager::SpiceManager() {
     erract_c("SET", 0, const_cast<char*>("REPORT")); // NOLINT
     // But we do not want SPICE to print the errors, we will fetch them ourselves
     errprt_c("SET", 0, const_cast<char*>("NONE")); // NOLINT
+
+    _executor = std::make_unique<SpiceExecutor>();
 }
 
 SpiceManager::~SpiceManager() {
+    // Stopping the executor finishes all pending batches, so afterwards no other thread
+    // is inside CSPICE and we can clean up on this thread
+    _executor = nullptr;
+
     for (const KernelInformation& i : _loadedKernels) {
         unload_c(i.path.c_str());
     }
@@ -206,6 +378,10 @@ SpiceManager& SpiceManager::ref() {
     return *_instance;
 }
 
+SpiceExecutor& SpiceManager::executor() {
+    return *_executor;
+}
+
 SpiceManager::KernelHandle SpiceManager::loadKernel(std::string filePath) {
     ghoul_assert(!filePath.empty(), "Empty file path");
     ghoul_assert(
@@ -220,151 +396,212 @@ SpiceManager::KernelHandle SpiceManager::loadKernel(std::string filePath) {
         )
     );
 
-    std::string path = absPath(std::move(filePath));
-    const auto it = std::find_if(
-        _loadedKernels.begin(),
-        _loadedKernels.end(),
-        [path](const KernelInformation& info) { return info.path == path; }
-    );
+    return _executor->run([&]() -> SpiceManager::KernelHandle {
+        std::string path = absPath(std::move(filePath));
+        const auto it = std::find_if(
+            _loadedKernels.begin(),
+            _loadedKernels.end(),
+            [path](const KernelInformation& info) { return info.path == path; }
+        );
 
-    if (it != _loadedKernels.end()) {
-        it->refCount++;
-        return it->id;
-    }
+        if (it != _loadedKernels.end()) {
+            it->refCount++;
+            return it->id;
+        }
 
-    // We need to set the current directory as meta-kernels are usually defined relative
-    // to the directory they reside in. The directory change is not necessary for regular
-    // kernels
-    ghoul::filesystem::Directory currentDirectory = FileSys.currentDirectory();
-    using RawPath = ghoul::filesystem::File::RawPath;
-    std::string fileDirectory = ghoul::filesystem::File(
-        path,
-        RawPath::Yes
-    ).directoryName();
-    FileSys.setCurrentDirectory(fileDirectory);
-
-    LINFO(fmt::format("Loading SPICE kernel '{}'", path));
-    // Load the kernel
-    furnsh_c(path.c_str());
-
-    // Reset the current directory to the previous one
-    FileSys.setCurrentDirectory(currentDirectory);
-
-    throwOnSpiceError("Kernel loading");
-
-    std::string fileExtension = ghoul::filesystem::File(
-        path,
-        RawPath::Yes
-    ).fileExtension();
-    if (fileExtension == "bc" || fileExtension == "BC") {
-        findCkCoverage(path); // binary ck kernel
-    }
-    else if (fileExtension == "bsp" || fileExtension == "BSP") {
-        findSpkCoverage(path); // binary spk kernel
-    }
+        // We need to set the current directory as meta-kernels are usually defined
+        // relative to the directory they reside in. The directory change is not necessary
+        // for regular kernels
+        ghoul::filesystem::Directory currentDirectory = FileSys.currentDirectory();
+        using RawPath = ghoul::filesystem::File::RawPath;
+        std::string fileDirectory = ghoul::filesystem::File(
+            path,
+            RawPath::Yes
+        ).directoryName();
+        FileSys.setCurrentDirectory(fileDirectory);
+
+        LINFO(fmt::format("Loading SPICE kernel '{}'", path));
+        // Load the kernel
+        furnsh_c(path.c_str());
+
+        // Reset the current directory to the previous one
+        FileSys.setCurrentDirectory(currentDirectory);
+
+        throwOnSpiceError("Kernel loading");
+
+        std::string fileExtension = ghoul::filesystem::File(
+            path,
+            RawPath::Yes
+        ).fileExtension();
+        if (fileExtension == "bc" || fileExtension == "BC") {
+            findCkCoverage(path); // binary ck kernel
+        }
+        else if (fileExtension == "bsp" || fileExtension == "BSP") {
+            findSpkCoverage(path); // binary spk kernel
+        }
 
-    KernelHandle kernelId = ++_lastAssignedKernel;
-    ghoul_assert(kernelId != 0, fmt::format("Kernel Handle wrapped around to 0"));
-    _loadedKernels.push_back({std::move(path), kernelId, 1});
-    return kernelId;
+        KernelHandle kernelId = ++_lastAssignedKernel;
+        ghoul_assert(kernelId != 0, fmt::format("Kernel Handle wrapped around to 0"));
+        _loadedKernels.push_back({std::move(path), kernelId, 1});
+        ++_kernelGeneration;
+        loadLeapSeconds();
+        return kernelId;
+    });
 }
 
 void SpiceManager::unloadKernel(KernelHandle kernelId) {
     ghoul_assert(kernelId <= _lastAssignedKernel, "Invalid unassigned kernel");
     ghoul_assert(kernelId != KernelHandle(0), "Invalid zero handle");
 
-    const auto it = std::find_if(
-        _loadedKernels.begin(),
-        _loadedKernels.end(),
-        [&kernelId](const KernelInformation& info) { return info.id == kernelId; }
-    );
+    return _executor->run([&]() -> void {
+        const auto it = std::find_if(
+            _loadedKernels.begin(),
+            _loadedKernels.end(),
+            [&kernelId](const KernelInformation& info) { return info.id == kernelId; }
+        );
 
-    if (it != _loadedKernels.end()) {
-        // If there was only one part interested in the kernel, we can unload it
-        if (it->refCount == 1) {
-            // No need to check for errors as we do not allow empty path names
-            LINFO(fmt::format("Unloading SPICE kernel '{}'", it->path));
-            unload_c(it->path.c_str());
-            _loadedKernels.erase(it);
-        }
-        // Otherwise, we hold on to it, but reduce the reference counter by 1
-        else {
-            it->refCount--;
-            LDEBUG(fmt::format("Reducing reference counter to: {}", it->refCount));
+        if (it != _loadedKernels.end()) {
+            // If there was only one part interested in the kernel, we can unload it
+            if (it->refCount == 1) {
+                // No need to check for errors as we do not allow empty path names
+                LINFO(fmt::format("Unloading SPICE kernel '{}'", it->path));
+                unload_c(it->path.c_str());
+                _loadedKernels.erase(it);
+                ++_kernelGeneration;
+                loadLeapSeconds();
+            }
+            // Otherwise, we hold on to it, but reduce the reference counter by 1
+            else {
+                it->refCount--;
+                LDEBUG(fmt::format("Reducing reference counter to: {}", it->refCount));
+            }
         }
-    }
+    });
 }
 
 void SpiceManager::unloadKernel(std::string filePath) {
     ghoul_assert(!filePath.empty(), "Empty filename");
 
-    std::string path = absPath(std::move(filePath));
+    return _executor->run([&]() -> void {
+        std::string path = absPath(std::move(filePath));
 
-    const auto it = std::find_if(
-        _loadedKernels.begin(),
-        _loadedKernels.end(),
-        [&path](const KernelInformation& info) { return info.path == path; }
-    );
+        const auto it = std::find_if(
+            _loadedKernels.begin(),
+            _loadedKernels.end(),
+            [&path](const KernelInformation& info) { return info.path == path; }
+        );
 
-    if (it == _loadedKernels.end()) {
-        if (_useExceptions) {
-            throw SpiceException(
-                fmt::format("'{}' did not correspond to a loaded kernel", path)
-            );
-        }
-        else {
-            return;
-        }
-    }
-    else {
-        // If there was only one part interested in the kernel, we can unload it
-        if (it->refCount == 1) {
-            LINFO(fmt::format("Unloading SPICE kernel '{}'", path));
-            unload_c(path.c_str());
-            _loadedKernels.erase(it);
+        if (it == _loadedKernels.end()) {
+            if (_useExceptions) {
+                throw SpiceException(
+                    fmt::format("'{}' did not correspond to a loaded kernel", path)
+                );
+            }
+            else {
+                return;
+            }
         }
         else {
-            // Otherwise, we hold on to it, but reduce the reference counter by 1
-            it->refCount--;
-            LDEBUG(fmt::format("Reducing reference counter to: {}", it->refCount));
+            // If there was only one part interested in the kernel, we can unload it
+            if (it->refCount == 1) {
+                LINFO(fmt::format("Unloading SPICE kernel '{}'", path));
+                unload_c(path.c_str());
+                _loadedKernels.erase(it);
+                ++_kernelGeneration;
+                loadLeapSeconds();
+            }
+            else {
+                // Otherwise, we hold on to it, but reduce the reference counter by 1
+                it->refCount--;
+                LDEBUG(fmt::format("Reducing reference counter to: {}", it->refCount));
+            }
         }
-    }
+    });
 }
 
 bool SpiceManager::hasSpkCoverage(const std::string& target, double et) const {
     ghoul_assert(!target.empty(), "Empty target");
 
-    const int id = naifId(target);
-    const auto it = _spkIntervals.find(id);
-    if (it != _spkIntervals.end()) {
-        const std::vector<std::pair<double, double>>& intervalVector = it->second;
-        for (const std::pair<double, double>& vecElement : intervalVector) {
-            if ((vecElement.first < et) && (vecElement.second > et)) {
-                return true;
+    return _executor->run([&]() -> bool {
+        const int id = naifId(target);
+        const auto it = _spkIntervals.find(id);
+        if (it != _spkIntervals.end()) {
+            const std::vector<std::pair<double, double>>& intervalVector = it->second;
+            for (const std::pair<double, double>& vecElement : intervalVector) {
+                if ((vecElement.first < et) && (vecElement.second > et)) {
+                    return true;
+                }
             }
         }
-    }
-    return false;
+        return false;
+    });
 }
 
 bool SpiceManager::hasCkCoverage(const std::string& frame, double et) const {
     ghoul_assert(!frame.empty(), "Empty target");
 
-    const int id = frameId(frame);
-    const auto it = _ckIntervals.find(id);
-    if (it != _ckIntervals.end()) {
-        const std::vector<std::pair<double, double>>& intervalVector = it->second;
-        for (const std::pair<double, double>& i : intervalVector) {
-            if ((i.first < et) && (i.second > et)) {
-                return true;
+    return _executor->run([&]() -> bool {
+        const int id = frameId(frame);
+        const auto it = _ckIntervals.find(id);
+        if (it != _ckIntervals.end()) {
+            const std::vector<std::pair<double, double>>& intervalVector = it->second;
+            for (const std::pair<double, double>& i : intervalVector) {
+                if ((i.first < et) && (i.second > et)) {
+                    return true;
+                }
             }
         }
-    }
-    return false;
+        return false;
+    });
+}
+
+std::vector<std::pair<double, double>> SpiceManager::spkCoverage(
+                                                          const std::string& target) const
+{
+    ghoul_assert(!target.empty(), "Empty target");
+
+    return _executor->run([&]() -> std::vector<std::pair<double, double>> {
+        const auto it = _spkIntervals.find(naifId(target));
+        if (it != _spkIntervals.end()) {
+            return it->second;
+        }
+        return {};
+    });
+}
+
+std::vector<std::pair<double, double>> SpiceManager::ckCoverage(
+                                                           const std::string& frame) const
+{
+    ghoul_assert(!frame.empty(), "Empty frame");
+
+    return _executor->run([&]() -> std::vector<std::pair<double, double>> {
+        const auto it = _ckIntervals.find(frameId(frame));
+        if (it != _ckIntervals.end()) {
+            return it->second;
+        }
+        return {};
+    });
+}
+
+std::vector<std::string> SpiceManager::loadedKernels() const {
+    return _executor->run([&]() -> std::vector<std::string> {
+        std::vector<std::string> result;
+        result.reserve(_loadedKernels.size());
+        for (const KernelInformation& info : _loadedKernels) {
+            result.push_back(info.path);
+        }
+        return result;
+    });
+}
+
+unsigned int SpiceManager::kernelGeneration() const {
+    return _kernelGeneration;
 }
 
 bool SpiceManager::hasValue(int naifId, const std::string& item) const {
-    return bodfnd_c(naifId, item.c_str());
+    return _executor->run([&]() -> bool {
+        return bodfnd_c(naifId, item.c_str());
+    });
 }
 
 bool SpiceManager::hasValue(const std::string& body, const std::string& item) const {
@@ -378,42 +615,54 @@ bool SpiceManager::hasValue(const std::string& body, const std::string& item) co
 int SpiceManager::naifId(const std::string& body) const {
     ghoul_assert(!body.empty(), "Empty body");
 
-    SpiceBoolean success;
-    SpiceInt id;
-    bods2c_c(body.c_str(), &id, &success);
-    if (!success && _useExceptions) {
-        throw SpiceException(fmt::format("Could not find NAIF ID of body '{}'", body));
-    }
-    return id;
+    return _executor->run([&]() -> int {
+        SpiceBoolean success;
+        SpiceInt id;
+        bods2c_c(body.c_str(), &id, &success);
+        if (!success && _useExceptions) {
+            throw SpiceException(
+                fmt::format("Could not find NAIF ID of body '{}'", body)
+            );
+        }
+        return id;
+    });
 }
 
 bool SpiceManager::hasNaifId(const std::string& body) const {
     ghoul_assert(!body.empty(), "Empty body");
 
-    SpiceBoolean success;
-    SpiceInt id;
-    bods2c_c(body.c_str(), &id, &success);
-    reset_c();
-    return success;
+    return _executor->run([&]() -> bool {
+        SpiceBoolean success;
+        SpiceInt id;
+        bods2c_c(body.c_str(), &id, &success);
+        reset_c();
+        return success;
+    });
 }
 
 int SpiceManager::frameId(const std::string& frame) const {
     ghoul_assert(!frame.empty(), "Empty frame");
 
-    SpiceInt id;
-    namfrm_c(frame.c_str(), &id);
-    if (id == 0 && _useExceptions) {
-        throw SpiceException(fmt::format("Could not find NAIF ID of frame '{}'", frame));
-    }
-    return id;
+    return _executor->run([&]() -> int {
+        SpiceInt id;
+        namfrm_c(frame.c_str(), &id);
+        if (id == 0 && _useExceptions) {
+            throw SpiceException(
+                fmt::format("Could not find NAIF ID of frame '{}'", frame)
+            );
+        }
+        return id;
+    });
 }
 
 bool SpiceManager::hasFrameId(const std::string& frame) const {
     ghoul_assert(!frame.empty(), "Empty frame");
 
-    SpiceInt id;
-    namfrm_c(frame.c_str(), &id);
-    return id != 0;
+    return _executor->run([&]() -> bool {
+        SpiceInt id;
+        namfrm_c(frame.c_str(), &id);
+        return id != 0;
+    });
 }
 
 void getValueInternal(const std::string& body, const std::string& value, int size,
@@ -432,25 +681,33 @@ void getValueInternal(const std::string& body, const std::string& value, int siz
 void SpiceManager::getValue(const std::string& body, const std::string& value,
                             double& v) const
 {
-    getValueInternal(body, value, 1, &v);
+    return _executor->run([&]() -> void {
+        getValueInternal(body, value, 1, &v);
+    });
 }
 
 void SpiceManager::getValue(const std::string& body, const std::string& value,
                             glm::dvec2& v) const
 {
-    getValueInternal(body, value, 2, glm::value_ptr(v));
+    return _executor->run([&]() -> void {
+        getValueInternal(body, value, 2, glm::value_ptr(v));
+    });
 }
 
 void SpiceManager::getValue(const std::string& body, const std::string& value,
                             glm::dvec3& v) const
 {
-    getValueInternal(body, value, 3, glm::value_ptr(v));
+    return _executor->run([&]() -> void {
+        getValueInternal(body, value, 3, glm::value_ptr(v));
+    });
 }
 
 void SpiceManager::getValue(const std::string& body, const std::string& value,
                             glm::dvec4& v) const
 {
-    getValueInternal(body, value, 4, glm::value_ptr(v));
+    return _executor->run([&]() -> void {
+        getValueInternal(body, value, 4, glm::value_ptr(v));
+    });
 }
 
 void SpiceManager::getValue(const std::string& body, const std::string& value,
@@ -458,28 +715,123 @@ void SpiceManager::getValue(const std::string& body, const std::string& value,
 {
     ghoul_assert(!v.empty(), "Array for values has to be preallocaed");
 
-    getValueInternal(body, value, static_cast<int>(v.size()), v.data());
+    return _executor->run([&]() -> void {
+        getValueInternal(body, value, static_cast<int>(v.size()), v.data());
+    });
 }
 
 double SpiceManager::spacecraftClockToET(const std::string& craft, double craftTicks) {
     ghoul_assert(!craft.empty(), "Empty craft");
 
-    int craftId = naifId(craft);
-    double et;
-    sct2e_c(craftId, craftTicks, &et);
-    throwOnSpiceError(fmt::format(
-        "Error transforming spacecraft clock of '{}' at time {}", craft, craftTicks
-    ));
-    return et;
+    return _executor->run([&]() -> double {
+        int craftId = naifId(craft);
+        double et;
+        sct2e_c(craftId, craftTicks, &et);
+        throwOnSpiceError(fmt::format(
+            "Error transforming spacecraft clock of '{}' at time {}", craft, craftTicks
+        ));
+        return et;
+    });
 }
 
 double SpiceManager::ephemerisTimeFromDate(const std::string& timeString) const {
     ghoul_assert(!timeString.empty(), "Empty timeString");
 
+    // The native conversion does not touch CSPICE and thus runs on the calling thread
     double et;
-    str2et_c(timeString.c_str(), &et);
-    throwOnSpiceError(fmt::format("Error converting date '{}'", timeString));
-    return et;
+    if (ephemerisTimeFromCalendarDate(timeString, et)) {
+        return et;
+    }
+
+    return _executor->run([&]() -> double {
+        str2et_c(timeString.c_str(), &et);
+        throwOnSpiceError(fmt::format("Error converting date '{}'", timeString));
+        return et;
+    });
+}
+
+bool SpiceManager::ephemerisTimeFromCalendarDate(const std::string& timeString,
+                                                 double& ephemerisTime) const
+{
+    const std::shared_ptr<const LeapSeconds> leapSeconds = std::atomic_load(
+        &_leapSeconds
+    );
+    if (!leapSeconds || leapSeconds->deltaAt.empty()) {
+        return false;
+    }
+
+    CalendarDate date;
+    if (!parseCalendarDate(timeString, date)) {
+        return false;
+    }
+
+    // Formal UTC seconds past J2000, that is without leap seconds, at the beginning of
+    // the day. Leap seconds are only inserted at the end of a day, so the difference
+    // between TAI and UTC is the same for the whole day
+    const double dayBegin = static_cast<double>(
+        daysSinceJ2000(date.year, date.month, date.day) * 86400 - 43200
+    );
+    const auto it = std::upper_bound(
+        leapSeconds->deltaAt.begin(),
+        leapSeconds->deltaAt.end(),
+        dayBegin,
+        [](double t, const std::pair<double, double>& p) { return t < p.first; }
+    );
+    if (it == leapSeconds->deltaAt.begin()) {
+        // Dates before the first entry of the table are left to SPICE
+        return false;
+    }
+    const double deltaAt = std::prev(it)->second;
+
+    // The conversion from TAI to TDB is described in the documentation of deltet_c
+    const double utc = dayBegin + (date.hour * 3600 + date.minute * 60) + date.second;
+    const double tdt = utc + deltaAt + leapSeconds->deltaTa;
+    const double m = leapSeconds->m0 + leapSeconds->m1 * tdt;
+    const double e = m + leapSeconds->eb * std::sin(m);
+    ephemerisTime = tdt + leapSeconds->k * std::sin(e);
+    return true;
+}
+
+void SpiceManager::loadLeapSeconds() {
+    std::atomic_store(&_leapSeconds, std::shared_ptr<const LeapSeconds>());
+
+    SpiceBoolean found = SPICEFALSE;
+    SpiceInt n = 0;
+    SpiceChar type = 'N';
+    dtpool_c("DELTET/DELTA_AT", &found, &n, &type);
+    if (!found || type != 'N' || n < 2 || n % 2 != 0) {
+        return;
+    }
+    std::vector<double> deltaAt(n);
+    gdpool_c("DELTET/DELTA_AT", 0, n, &n, deltaAt.data(), &found);
+
+    auto value = [](const char* name, double* v, SpiceInt size) {
+        SpiceInt count = 0;
+        SpiceBoolean f = SPICEFALSE;
+        gdpool_c(name, 0, size, &count, v, &f);
+        return f && count == size;
+    };
+    double m[2];
+    LeapSeconds ls;
+    const bool success = found &&
+        value("DELTET/DELTA_T_A", &ls.deltaTa, 1) && value("DELTET/K", &ls.k, 1) &&
+        value("DELTET/EB", &ls.eb, 1) && value("DELTET/M", m, 2);
+    if (failed_c()) {
+        reset_c();
+        return;
+    }
+    if (!success) {
+        return;
+    }
+
+    ls.m0 = m[0];
+    ls.m1 = m[1];
+    // The kernel pool stores the table as pairs of the difference and the date
+    for (SpiceInt i = 0; i < n; i += 2) {
+        ls.deltaAt.emplace_back(deltaAt[i + 1], deltaAt[i]);
+    }
+    std::sort(ls.deltaAt.begin(), ls.deltaAt.end());
+    std::atomic_store(&_leapSeconds, std::make_shared<const LeapSeconds>(std::move(ls)));
 }
 
 std::string SpiceManager::dateFromEphemerisTime(double ephemerisTime,
@@ -487,16 +839,18 @@ std::string SpiceManager::dateFromEphemerisTime(double ephemerisTime,
 {
     ghoul_assert(!formatString.empty(), "Format is empty");
 
-    constexpr const int BufferSize = 256;
-    SpiceChar buffer[BufferSize];
-    timout_c(ephemerisTime, formatString.c_str(), BufferSize - 1, buffer);
-    throwOnSpiceError(
-        fmt::format("Error converting ephemeris time '{}' to date with format '{}'",
-            ephemerisTime, formatString
-        )
-    );
+    return _executor->run([&]() -> std::string {
+        constexpr const int BufferSize = 256;
+        SpiceChar buffer[BufferSize];
+        timout_c(ephemerisTime, formatString.c_str(), BufferSize - 1, buffer);
+        throwOnSpiceError(
+            fmt::format("Error converting ephemeris time '{}' to date with format '{}'",
+                ephemerisTime, formatString
+            )
+        );
 
-    return std::string(buffer);
+        return std::string(buffer);
+    });
 }
 
 glm::dvec3 SpiceManager::targetPosition(const std::string& target,
@@ -509,60 +863,64 @@ glm::dvec3 SpiceManager::targetPosition(const std::string& target,
     ghoul_assert(!observer.empty(), "Observer is not empty");
     ghoul_assert(!referenceFrame.empty(), "Reference frame is not empty");
 
-    bool targetHasCoverage = hasSpkCoverage(target, ephemerisTime);
-    bool observerHasCoverage = hasSpkCoverage(observer, ephemerisTime);
-    if (!targetHasCoverage && !observerHasCoverage) {
-        if (_useExceptions) {
-            throw SpiceException(
-                fmt::format(
-                    "Neither target '{}' nor observer '{}' has SPK coverage at time {}",
-                    target, observer, ephemerisTime
-                )
+    return _executor->run([&]() -> glm::dvec3 {
+        bool targetHasCoverage = hasSpkCoverage(target, ephemerisTime);
+        bool observerHasCoverage = hasSpkCoverage(observer, ephemerisTime);
+        if (!targetHasCoverage && !observerHasCoverage) {
+            if (_useExceptions) {
+                throw SpiceException(
+                    fmt::format(
+                        "Neither target '{}' nor observer '{}' has SPK coverage at "
+                        "time {}",
+                        target, observer, ephemerisTime
+                    )
+                );
+            }
+            else {
+                return glm::dvec3();
+            }
+        }
+        else if (targetHasCoverage && observerHasCoverage) {
+            glm::dvec3 position = glm::dvec3(0.0);
+            spkpos_c(
+                target.c_str(),
+                ephemerisTime,
+                referenceFrame.c_str(),
+                aberrationCorrection,
+                observer.c_str(),
+                glm::value_ptr(position),
+                &lightTime
             );
+            throwOnSpiceError(fmt::format(
+                "Error getting position from '{}' to '{}' in reference frame '{}' at "
+                "time {}",
+                target, observer, referenceFrame, ephemerisTime
+            ));
+            return position;
+        }
+        else if (targetHasCoverage) {
+            // observer has no coverage
+            return getEstimatedPosition(
+                observer,
+                target,
+                referenceFrame,
+                aberrationCorrection,
+                ephemerisTime,
+                lightTime
+            ) * -1.0;
         }
         else {
-            return glm::dvec3();
+            // target has no coverage
+            return getEstimatedPosition(
+                target,
+                observer,
+                referenceFrame,
+                aberrationCorrection,
+                ephemerisTime,
+                lightTime
+            );
         }
-    }
-    else if (targetHasCoverage && observerHasCoverage) {
-        glm::dvec3 position = glm::dvec3(0.0);
-        spkpos_c(
-            target.c_str(),
-            ephemerisTime,
-            referenceFrame.c_str(),
-            aberrationCorrection,
-            observer.c_str(),
-            glm::value_ptr(position),
-            &lightTime
-        );
-        throwOnSpiceError(fmt::format(
-            "Error getting position from '{}' to '{}' in reference frame '{}' at time {}",
-            target, observer, referenceFrame, ephemerisTime
-        ));
-        return position;
-    }
-    else if (targetHasCoverage) {
-        // observer has no coverage
-        return getEstimatedPosition(
-            observer,
-            target,
-            referenceFrame,
-            aberrationCorrection,
-            ephemerisTime,
-            lightTime
-        ) * -1.0;
-    }
-    else {
-        // target has no coverage
-        return getEstimatedPosition(
-            target,
-            observer,
-            referenceFrame,
-            aberrationCorrection,
-            ephemerisTime,
-            lightTime
-        );
-    }
+    });
 }
 
 glm::dvec3 SpiceManager::targetPosition(const std::string& target,
@@ -582,6 +940,101 @@ glm::dvec3 SpiceManager::targetPosition(const std::string& target,
     );
 }
 
+SpiceManager::PositionQuery SpiceManager::positionQuery(
+                                                                const std::string& target,
+                                                              const std::string& observer,
+                                                        const std::string& referenceFrame,
+                                       AberrationCorrection aberrationCorrection) const
+{
+    ghoul_assert(!target.empty(), "Target is not empty");
+    ghoul_assert(!observer.empty(), "Observer is not empty");
+    ghoul_assert(!referenceFrame.empty(), "Reference frame is not empty");
+
+    return _executor->run([&]() -> SpiceManager::PositionQuery {
+        PositionQuery query;
+        query.target = target;
+        query.observer = observer;
+        query.referenceFrame = referenceFrame;
+        query.aberrationCorrection = aberrationCorrection;
+        query.targetId = naifId(target);
+        query.observerId = naifId(observer);
+        query.frameId = frameId(referenceFrame);
+        return query;
+    });
+}
+
+glm::dvec3 SpiceManager::targetPosition(const PositionQuery& query, double ephemerisTime,
+                                        double& lightTime) const
+{
+    return _executor->run([&]() -> glm::dvec3 {
+        if (query.coverageGeneration != _spkCoverageGeneration) {
+            using Intervals = std::vector<std::pair<double, double>>;
+            auto coverage = [this](int id) -> const Intervals* {
+                const auto it = _spkIntervals.find(id);
+                return it != _spkIntervals.end() ? &it->second : nullptr;
+            };
+            query.targetCoverage = coverage(query.targetId);
+            query.observerCoverage = coverage(query.observerId);
+            query.coverageGeneration = _spkCoverageGeneration;
+        }
+
+        using Intervals = std::vector<std::pair<double, double>>;
+        auto isCovered = [ephemerisTime](const Intervals* c) {
+            if (!c) {
+                return false;
+            }
+            for (const std::pair<double, double>& i : *c) {
+                if ((i.first < ephemerisTime) && (i.second > ephemerisTime)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        const bool targetHasCoverage = isCovered(query.targetCoverage);
+        const bool observerHasCoverage = isCovered(query.observerCoverage);
+        if (targetHasCoverage && observerHasCoverage) {
+            glm::dvec3 position = glm::dvec3(0.0);
+            spkezp_c(
+                query.targetId,
+                ephemerisTime,
+                query.referenceFrame.c_str(),
+                query.aberrationCorrection,
+                query.observerId,
+                glm::value_ptr(position),
+                &lightTime
+            );
+            // Only build the error message if something actually went wrong
+            if (failed_c()) {
+                throwOnSpiceError(fmt::format(
+                    "Error getting position from '{}' to '{}' in reference frame '{}' at "
+                    "time {}",
+                    query.target, query.observer, query.referenceFrame, ephemerisTime
+                ));
+            }
+            return position;
+        }
+        else {
+            // The remaining cases are rare and handled by the name-based lookup
+            return targetPosition(
+                query.target,
+                query.observer,
+                query.referenceFrame,
+                query.aberrationCorrection,
+                ephemerisTime,
+                lightTime
+            );
+        }
+    });
+}
+
+glm::dvec3 SpiceManager::targetPosition(const PositionQuery& query,
+                                        double ephemerisTime) const
+{
+    double unused = 0.0;
+    return targetPosition(query, ephemerisTime, unused);
+}
+
 glm::dmat3 SpiceManager::frameTransformationMatrix(const std::string& from,
                                                    const std::string& to,
                                                    double ephemerisTime) const
@@ -589,24 +1042,26 @@ glm::dmat3 SpiceManager::frameTransformationMatrix(const std::string& from,
     ghoul_assert(!from.empty(), "From must not be empty");
     ghoul_assert(!to.empty(), "To must not be empty");
 
-    // get rotation matrix from frame A - frame B
-    glm::dmat3 transform;
-    pxform_c(
-        from.c_str(),
-        to.c_str(),
-        ephemerisTime,
-        reinterpret_cast<double(*)[3]>(glm::value_ptr(transform))
-    );
+    return _executor->run([&]() -> glm::dmat3 {
+        // get rotation matrix from frame A - frame B
+        glm::dmat3 transform;
+        pxform_c(
+            from.c_str(),
+            to.c_str(),
+            ephemerisTime,
+            reinterpret_cast<double(*)[3]>(glm::value_ptr(transform))
+        );
 
-    throwOnSpiceError(
-        fmt::format("Error converting from frame '{}' to frame '{}' at time '{}'",
-            from, to, ephemerisTime
-        )
-    );
+        throwOnSpiceError(
+            fmt::format("Error converting from frame '{}' to frame '{}' at time '{}'",
+                from, to, ephemerisTime
+            )
+        );
 
-    // The rox-major, column-major order are switched in GLM and SPICE, so we have to
-    // transpose the matrix before we can return it
-    return glm::transpose(transform);
+        // The rox-major, column-major order are switched in GLM and SPICE, so we have to
+        // transpose the matrix before we can return it
+        return glm::transpose(transform);
+    });
 }
 
 SpiceManager::SurfaceInterceptResult SpiceManager::surfaceIntercept(
@@ -625,33 +1080,35 @@ SpiceManager::SurfaceInterceptResult SpiceManager::surfaceIntercept(
     ghoul_assert(!referenceFrame.empty(), "Reference frame must not be empty");
     ghoul_assert(directionVector != glm::dvec3(0.0), "Direction vector must not be zero");
 
-    const std::string ComputationMethod = "ELLIPSOID";
+    return _executor->run([&]() -> SpiceManager::SurfaceInterceptResult {
+        const std::string ComputationMethod = "ELLIPSOID";
 
-    SurfaceInterceptResult result;
+        SurfaceInterceptResult result;
 
-    SpiceBoolean found;
-    sincpt_c(ComputationMethod.c_str(),
-        target.c_str(),
-        ephemerisTime,
-        referenceFrame.c_str(),
-        aberrationCorrection,
-        observer.c_str(),
-        fovFrame.c_str(),
-        glm::value_ptr(directionVector),
-        glm::value_ptr(result.surfaceIntercept),
-        &result.interceptEpoch,
-        glm::value_ptr(result.surfaceVector),
-        &found
-    );
-    result.interceptFound = (found == SPICETRUE);
+        SpiceBoolean found;
+        sincpt_c(ComputationMethod.c_str(),
+            target.c_str(),
+            ephemerisTime,
+            referenceFrame.c_str(),
+            aberrationCorrection,
+            observer.c_str(),
+            fovFrame.c_str(),
+            glm::value_ptr(directionVector),
+            glm::value_ptr(result.surfaceIntercept),
+            &result.interceptEpoch,
+            glm::value_ptr(result.surfaceVector),
+            &found
+        );
+        result.interceptFound = (found == SPICETRUE);
 
-    throwOnSpiceError(fmt::format(
-        "Error retrieving surface intercept on target '{}' viewed from observer '{}' in "
-        "reference frame '{}' at time '{}'",
-        target, observer, referenceFrame, ephemerisTime
-    ));
+        throwOnSpiceError(fmt::format(
+            "Error retrieving surface intercept on target '{}' viewed from observer '{}' "
+            "in reference frame '{}' at time '{}'",
+            target, observer, referenceFrame, ephemerisTime
+        ));
 
-    return result;
+        return result;
+    });
 }
 
 bool SpiceManager::isTargetInFieldOfView(const std::string& target,
@@ -668,23 +1125,25 @@ bool SpiceManager::isTargetInFieldOfView(const std::string& target,
     ghoul_assert(!referenceFrame.empty(), "Reference frame must not be empty");
     ghoul_assert(!instrument.empty(), "Instrument must not be empty");
 
-    int visible;
-    fovtrg_c(instrument.c_str(),
-        target.c_str(),
-        toString(method),
-        referenceFrame.c_str(),
-        aberrationCorrection,
-        observer.c_str(),
-        &ephemerisTime,
-        &visible
-    );
+    return _executor->run([&]() -> bool {
+        int visible;
+        fovtrg_c(instrument.c_str(),
+            target.c_str(),
+            toString(method),
+            referenceFrame.c_str(),
+            aberrationCorrection,
+            observer.c_str(),
+            &ephemerisTime,
+            &visible
+        );
 
-    throwOnSpiceError(fmt::format(
-        "Checking if target '{}' is in view of instrument '{}' failed",
-        target, instrument
-    ));
+        throwOnSpiceError(fmt::format(
+            "Checking if target '{}' is in view of instrument '{}' failed",
+            target, instrument
+        ));
 
-    return visible == SPICETRUE;
+        return visible == SPICETRUE;
+    });
 }
 
 SpiceManager::TargetStateResult SpiceManager::targetState(const std::string& target,
@@ -697,30 +1156,32 @@ SpiceManager::TargetStateResult SpiceManager::targetState(const std::string& tar
     ghoul_assert(!observer.empty(), "Observer must not be empty");
     ghoul_assert(!referenceFrame.empty(), "Reference frame must not be empty");
 
-    TargetStateResult result;
-    result.lightTime = 0.0;
+    return _executor->run([&]() -> SpiceManager::TargetStateResult {
+        TargetStateResult result;
+        result.lightTime = 0.0;
 
-    double buffer[6];
+        double buffer[6];
 
-    spkezr_c(
-        target.c_str(),
-        ephemerisTime,
-        referenceFrame.c_str(),
-        aberrationCorrection,
-        observer.c_str(),
-        buffer,
-        &result.lightTime
-    );
+        spkezr_c(
+            target.c_str(),
+            ephemerisTime,
+            referenceFrame.c_str(),
+            aberrationCorrection,
+            observer.c_str(),
+            buffer,
+            &result.lightTime
+        );
 
-    throwOnSpiceError(fmt::format(
-        "Error retrieving state of target '{}' viewed from observer '{}' in reference "
-        "frame '{}' at time '{}'",
-        target, observer, referenceFrame, ephemerisTime
-    ));
+        throwOnSpiceError(fmt::format(
+            "Error retrieving state of target '{}' viewed from observer '{}' in "
+            "reference frame '{}' at time '{}'",
+            target, observer, referenceFrame, ephemerisTime
+        ));
 
-    memmove(glm::value_ptr(result.position), buffer, sizeof(double) * 3);
-    memmove(glm::value_ptr(result.velocity), buffer + 3, sizeof(double) * 3);
-    return result;
+        memmove(glm::value_ptr(result.position), buffer, sizeof(double) * 3);
+        memmove(glm::value_ptr(result.velocity), buffer + 3, sizeof(double) * 3);
+        return result;
+    });
 }
 
 SpiceManager::TransformMatrix SpiceManager::stateTransformMatrix(
@@ -731,19 +1192,21 @@ SpiceManager::TransformMatrix SpiceManager::stateTransformMatrix(
     ghoul_assert(!sourceFrame.empty(), "sourceFrame must not be empty");
     ghoul_assert(!destinationFrame.empty(), "toFrame must not be empty");
 
-    TransformMatrix m;
-    sxform_c(
-        sourceFrame.c_str(),
-        destinationFrame.c_str(),
-        ephemerisTime,
-        reinterpret_cast<double(*)[6]>(m.data())
-    );
-    throwOnSpiceError(fmt::format(
-        "Error retrieved state transform matrix from frame '{}' to frame '{}' at time "
-        "'{}'",
-        sourceFrame, destinationFrame, ephemerisTime
-    ));
-    return m;
+    return _executor->run([&]() -> SpiceManager::TransformMatrix {
+        TransformMatrix m;
+        sxform_c(
+            sourceFrame.c_str(),
+            destinationFrame.c_str(),
+            ephemerisTime,
+            reinterpret_cast<double(*)[6]>(m.data())
+        );
+        throwOnSpiceError(fmt::format(
+            "Error retrieved state transform matrix from frame '{}' to frame '{}' at "
+            "time '{}'",
+            sourceFrame, destinationFrame, ephemerisTime
+        ));
+        return m;
+    });
 }
 
 glm::dmat3 SpiceManager::positionTransformMatrix(const std::string& sourceFrame,
@@ -753,26 +1216,28 @@ glm::dmat3 SpiceManager::positionTransformMatrix(const std::string& sourceFrame,
     ghoul_assert(!sourceFrame.empty(), "sourceFrame must not be empty");
     ghoul_assert(!destinationFrame.empty(), "destinationFrame must not be empty");
 
-    glm::dmat3 result;
-    pxform_c(
-        sourceFrame.c_str(),
-        destinationFrame.c_str(),
-        ephemerisTime,
-        reinterpret_cast<double(*)[3]>(glm::value_ptr(result))
-    );
-
-    throwOnSpiceError("");
-    SpiceBoolean success = !(failed_c());
-    reset_c();
-    if (!success) {
-        result = getEstimatedTransformMatrix(
-            sourceFrame,
-            destinationFrame,
-            ephemerisTime
+    return _executor->run([&]() -> glm::dmat3 {
+        glm::dmat3 result;
+        pxform_c(
+            sourceFrame.c_str(),
+            destinationFrame.c_str(),
+            ephemerisTime,
+            reinterpret_cast<double(*)[3]>(glm::value_ptr(result))
         );
-    }
 
-    return glm::transpose(result);
+        throwOnSpiceError("");
+        SpiceBoolean success = !(failed_c());
+        reset_c();
+        if (!success) {
+            result = getEstimatedTransformMatrix(
+                sourceFrame,
+                destinationFrame,
+                ephemerisTime
+            );
+        }
+
+        return glm::transpose(result);
+    });
 }
 
 glm::dmat3 SpiceManager::positionTransformMatrix(const std::string& sourceFrame,
@@ -783,21 +1248,23 @@ glm::dmat3 SpiceManager::positionTransformMatrix(const std::string& sourceFrame,
     ghoul_assert(!sourceFrame.empty(), "sourceFrame must not be empty");
     ghoul_assert(!destinationFrame.empty(), "destinationFrame must not be empty");
 
-    glm::dmat3 result;
+    return _executor->run([&]() -> glm::dmat3 {
+        glm::dmat3 result;
 
-    pxfrm2_c(
-        sourceFrame.c_str(),
-        destinationFrame.c_str(),
-        ephemerisTimeFrom,
-        ephemerisTimeTo,
-        reinterpret_cast<double(*)[3]>(glm::value_ptr(result))
-    );
-    throwOnSpiceError(fmt::format(
-        "Error retrieving position transform matrix from '{}' at time '{}' to frame '{}' "
-        "at time '{}'",
-        sourceFrame, ephemerisTimeFrom, destinationFrame, ephemerisTimeTo
-    ));
-    return glm::transpose(result);
+        pxfrm2_c(
+            sourceFrame.c_str(),
+            destinationFrame.c_str(),
+            ephemerisTimeFrom,
+            ephemerisTimeTo,
+            reinterpret_cast<double(*)[3]>(glm::value_ptr(result))
+        );
+        throwOnSpiceError(fmt::format(
+            "Error retrieving position transform matrix from '{}' at time '{}' to frame "
+            "'{}' at time '{}'",
+            sourceFrame, ephemerisTimeFrom, destinationFrame, ephemerisTimeTo
+        ));
+        return glm::transpose(result);
+    });
 }
 
 SpiceManager::FieldOfViewResult
@@ -808,49 +1275,51 @@ SpiceManager::fieldOfView(const std::string& instrument) const
 }
 
 SpiceManager::FieldOfViewResult SpiceManager::fieldOfView(int instrument) const {
-    constexpr int MaxBoundsSize = 64;
-    constexpr int BufferSize = 128;
-
-    FieldOfViewResult res;
-
-    SpiceInt nrReturned;
-    double boundsArr[MaxBoundsSize][3];
-    char fovShapeBuffer[BufferSize];
-    char frameNameBuffer[BufferSize];
-    getfov_c(instrument,                        // instrument id
-        MaxBoundsSize,                          // maximum size for the bounds vector
-        BufferSize,                             // maximum size for the fov shape buffer
-        BufferSize,                             // maximum size for the frame name buffer
-        fovShapeBuffer,                         // the fov shape buffer
-        frameNameBuffer,                        // the frame name buffer
-        glm::value_ptr(res.boresightVector),    // the boresight vector
-        &nrReturned,                            // the number of returned array values
-        boundsArr                               // the bounds
-    );
+    return _executor->run([&]() -> SpiceManager::FieldOfViewResult {
+        constexpr int MaxBoundsSize = 64;
+        constexpr int BufferSize = 128;
+
+        FieldOfViewResult res;
+
+        SpiceInt nrReturned;
+        double boundsArr[MaxBoundsSize][3];
+        char fovShapeBuffer[BufferSize];
+        char frameNameBuffer[BufferSize];
+        getfov_c(instrument,                    // instrument id
+            MaxBoundsSize,                      // maximum size for the bounds vector
+            BufferSize,                         // maximum size for the fov shape buffer
+            BufferSize,                         // maximum size for the frame name buffer
+            fovShapeBuffer,                     // the fov shape buffer
+            frameNameBuffer,                    // the frame name buffer
+            glm::value_ptr(res.boresightVector), // the boresight vector
+            &nrReturned,                        // the number of returned array values
+            boundsArr                           // the bounds
+        );
 
-    bool failed = throwOnSpiceError(fmt::format(
-        "Error getting field-of-view parameters for instrument '{}'", instrument
-    ));
-    if (failed) {
-        return res;
-    }
+        bool failed = throwOnSpiceError(fmt::format(
+            "Error getting field-of-view parameters for instrument '{}'", instrument
+        ));
+        if (failed) {
+            return res;
+        }
 
-    res.bounds.reserve(nrReturned);
-    for (int i = 0; i < nrReturned; ++i) {
-        res.bounds.emplace_back(boundsArr[i][0], boundsArr[i][1], boundsArr[i][2]);
-    }
+        res.bounds.reserve(nrReturned);
+        for (int i = 0; i < nrReturned; ++i) {
+            res.bounds.emplace_back(boundsArr[i][0], boundsArr[i][1], boundsArr[i][2]);
+        }
 
-    std::string shape = std::string(fovShapeBuffer);
-    static const std::map<std::string, FieldOfViewResult::Shape> Map = {
-        { "POLYGON", FieldOfViewResult::Shape::Polygon },
-        { "RECTANGLE" , FieldOfViewResult::Shape::Rectangle },
-        { "CIRCLE", FieldOfViewResult::Shape::Circle },
-        { "ELLIPSE", FieldOfViewResult::Shape::Ellipse }
-    };
-    res.shape = Map.at(shape);
-    res.frameName = std::string(frameNameBuffer);
+        std::string shape = std::string(fovShapeBuffer);
+        static const std::map<std::string, FieldOfViewResult::Shape> Map = {
+            { "POLYGON", FieldOfViewResult::Shape::Polygon },
+            { "RECTANGLE" , FieldOfViewResult::Shape::Rectangle },
+            { "CIRCLE", FieldOfViewResult::Shape::Circle },
+            { "ELLIPSE", FieldOfViewResult::Shape::Ellipse }
+        };
+        res.shape = Map.at(shape);
+        res.frameName = std::string(frameNameBuffer);
 
-    return res;
+        return res;
+    });
 }
 
 SpiceManager::TerminatorEllipseResult SpiceManager::terminatorEllipse(
@@ -869,30 +1338,33 @@ SpiceManager::TerminatorEllipseResult SpiceManager::terminatorEllipse(
     ghoul_assert(!lightSource.empty(), "Light source must not be empty");
     ghoul_assert(numberOfTerminatorPoints >= 1, "Terminator points must be >= 1");
 
-    TerminatorEllipseResult res;
+    return _executor->run([&]() -> SpiceManager::TerminatorEllipseResult {
+        TerminatorEllipseResult res;
 
-    // Warning: This assumes std::vector<glm::dvec3> to have all values memory contiguous
-    res.terminatorPoints.resize(numberOfTerminatorPoints);
+        // Warning: This assumes std::vector<glm::dvec3> to have all values memory
+        // contiguous
+        res.terminatorPoints.resize(numberOfTerminatorPoints);
 
-    edterm_c(
-        toString(terminatorType),
-        lightSource.c_str(),
-        target.c_str(),
-        ephemerisTime,
-        frame.c_str(),
-        aberrationCorrection,
-        observer.c_str(),
-        numberOfTerminatorPoints,
-        &res.targetEphemerisTime,
-        glm::value_ptr(res.observerPosition),
-        reinterpret_cast<double(*)[3]>(res.terminatorPoints.data())
-    );
-    throwOnSpiceError(fmt::format(
-        "Error getting terminator ellipse for target '{}' from observer '{}' in frame "
-        "'{}' with light source '{}' at time '{}'",
-        target, observer, frame, lightSource, ephemerisTime
-    ));
-    return res;
+        edterm_c(
+            toString(terminatorType),
+            lightSource.c_str(),
+            target.c_str(),
+            ephemerisTime,
+            frame.c_str(),
+            aberrationCorrection,
+            observer.c_str(),
+            numberOfTerminatorPoints,
+            &res.targetEphemerisTime,
+            glm::value_ptr(res.observerPosition),
+            reinterpret_cast<double(*)[3]>(res.terminatorPoints.data())
+        );
+        throwOnSpiceError(fmt::format(
+            "Error getting terminator ellipse for target '{}' from observer '{}' in "
+            "frame '{}' with light source '{}' at time '{}'",
+            target, observer, frame, lightSource, ephemerisTime
+        ));
+        return res;
+    });
 }
 
 void SpiceManager::findCkCoverage(const std::string& path) {
@@ -994,6 +1466,7 @@ void SpiceManager::findSpkCoverage(const std::string& path) {
             _spkIntervals[obj].emplace_back(b, e);
         }
     }
+    ++_spkCoverageGeneration;
 }
 
 glm::dvec3 SpiceManager::getEstimatedPosition(const std::string& target,
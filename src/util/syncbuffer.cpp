@@ -65,12 +65,10 @@ std::string SyncBuffer::decode() {
         _dataStream.data() + _decodeOffset,
         sizeof(int32_t)
     );
-    std::vector<char> tmp(length + 1);
     _decodeOffset += sizeof(int32_t);
-    memcpy(tmp.data(), _dataStream.data() + _decodeOffset, length);
+    // Construct with an explicit length as binary property values may contain zeros
+    std::string ret(_dataStream.data() + _decodeOffset, length);
     _decodeOffset += length;
-    tmp[length] = '\0';
-    std::string ret(tmp.data());
     return ret;
 }
 
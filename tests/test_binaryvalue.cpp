@@ -0,0 +1,130 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "catch2/catch.hpp"
+
+#include <openspace/properties/binaryvalue.h>
+#include <openspace/properties/optionproperty.h>
+#include <openspace/properties/stringlistproperty.h>
+#include <openspace/properties/triggerproperty.h>
+#include <openspace/properties/vector/dvec3property.h>
+
+using namespace openspace::properties;
+
+TEST_CASE("BinaryValue: Scalar", "[binaryvalue]") {
+    std::string data;
+    REQUIRE(encodeBinaryValue(2.5, data));
+    REQUIRE(data.size() == sizeof(double));
+
+    double value = 0.0;
+    REQUIRE(decodeBinaryValue(data, value));
+    REQUIRE(value == 2.5);
+
+    float wrongType = 1.f;
+    REQUIRE_FALSE(decodeBinaryValue(data, wrongType));
+    REQUIRE(wrongType == 1.f);
+}
+
+TEST_CASE("BinaryValue: String", "[binaryvalue]") {
+    const std::string original = std::string("ab\0cd", 5);
+
+    std::string data;
+    REQUIRE(encodeBinaryValue(original, data));
+
+    std::string value;
+    REQUIRE(decodeBinaryValue(data, value));
+    REQUIRE(value == original);
+}
+
+TEST_CASE("BinaryValue: String List", "[binaryvalue]") {
+    const std::vector<std::string> original = { "a", "", "long string", "d" };
+
+    std::string data;
+    REQUIRE(encodeBinaryValue(original, data));
+
+    std::vector<std::string> value;
+    REQUIRE(decodeBinaryValue(data, value));
+    REQUIRE(value == original);
+
+    std::vector<std::string> empty = { "x" };
+    REQUIRE(decodeBinaryValue(std::string_view(), empty));
+    REQUIRE(empty.empty());
+
+    std::vector<std::string> truncated = { "x" };
+    REQUIRE_FALSE(decodeBinaryValue(std::string_view(data).substr(0, 6), truncated));
+    REQUIRE(truncated == std::vector<std::string>{ "x" });
+}
+
+TEST_CASE("BinaryValue: Vector", "[binaryvalue]") {
+    const std::vector<int> original = { 1, -2, 3 };
+
+    std::string data;
+    REQUIRE(encodeBinaryValue(original, data));
+
+    std::vector<int> value;
+    REQUIRE(decodeBinaryValue(data, value));
+    REQUIRE(value == original);
+
+    REQUIRE_FALSE(decodeBinaryValue(std::string_view(data).substr(0, 5), value));
+}
+
+TEST_CASE("BinaryValue: Property Roundtrip", "[binaryvalue]") {
+    DVec3Property source({ "id", "gui", "desc" }, glm::dvec3(1.0, 2.0, 3.0));
+    DVec3Property target({ "id", "gui", "desc" });
+    bool hasChanged = false;
+    target.onChange([&hasChanged]() { hasChanged = true; });
+
+    std::string data;
+    REQUIRE(source.getBinaryValue(data));
+    REQUIRE(target.setBinaryValue(data));
+    REQUIRE(target.value() == glm::dvec3(1.0, 2.0, 3.0));
+    REQUIRE(hasChanged);
+
+    StringListProperty list({ "id", "gui", "desc" });
+    REQUIRE_FALSE(list.setBinaryValue("abc"));
+    REQUIRE(list.value().empty());
+}
+
+TEST_CASE("BinaryValue: Option Property", "[binaryvalue]") {
+    OptionProperty p({ "id", "gui", "desc" });
+    p.addOptions({ { 1, "a" }, { 2, "b" } });
+    p = 1;
+
+    std::string data;
+    REQUIRE(encodeBinaryValue(2, data));
+    REQUIRE(p.setBinaryValue(data));
+    REQUIRE(p.option().value == 2);
+}
+
+TEST_CASE("BinaryValue: Trigger Property", "[binaryvalue]") {
+    TriggerProperty p({ "id", "gui", "desc" });
+    int nTriggers = 0;
+    p.onChange([&nTriggers]() { ++nTriggers; });
+
+    std::string data = "ignored";
+    REQUIRE(p.getBinaryValue(data));
+    REQUIRE(data.empty());
+    REQUIRE(p.setBinaryValue(data));
+    REQUIRE(nTriggers == 1);
+}
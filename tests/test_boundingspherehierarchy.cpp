@@ -0,0 +1,200 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "catch2/catch.hpp"
+
+#include <openspace/scene/boundingspherehierarchy.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <array>
+#include <cmath>
+#include <random>
+
+namespace {
+    using BSH = openspace::BoundingSphereHierarchy;
+
+    struct View {
+        glm::dmat4 viewProjection;
+        glm::dvec3 position;
+        double pixelsPerUnit;
+    };
+
+    View createView(glm::dvec3 position, glm::dvec3 target) {
+        const glm::dmat4 projection = glm::perspective(glm::radians(60.0), 1.5, 1.0, 1e6);
+        const glm::dmat4 view = glm::lookAt(position, target, glm::dvec3(0.0, 0.0, 1.0));
+        return { projection * view, position, projection[1][1] * 1080.0 / 2.0 };
+    }
+
+    // Tests a single sphere against the frustum without the hierarchy
+    bool isCulled(const View& view, const BSH::Sphere& sphere, double minimumPixelSize) {
+        const glm::dmat4& m = view.viewProjection;
+        auto row = [&m](int i) { return glm::dvec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+        const std::array<glm::dvec4, 4> planes = {
+            row(3) + row(0), row(3) - row(0), row(3) + row(1), row(3) - row(1)
+        };
+        for (const glm::dvec4& plane : planes) {
+            const glm::dvec3 normal = glm::dvec3(plane);
+            const double distance =
+                (glm::dot(normal, sphere.center) + plane.w) / glm::length(normal);
+            if (distance < -sphere.radius) {
+                return true;
+            }
+        }
+
+        const double distance = glm::distance(view.position, sphere.center);
+        if (minimumPixelSize > 0.0 && distance > sphere.radius) {
+            const double tanAngle = sphere.radius /
+                std::sqrt(distance * distance - sphere.radius * sphere.radius);
+            return tanAngle * view.pixelsPerUnit < minimumPixelSize;
+        }
+        return false;
+    }
+
+    std::vector<BSH::Sphere> randomSpheres(std::mt19937& gen, size_t n) {
+        std::uniform_real_distribution<double> position(-1000.0, 1000.0);
+        std::exponential_distribution<double> radius(0.5);
+
+        std::vector<BSH::Sphere> spheres(n);
+        for (BSH::Sphere& s : spheres) {
+            s.center = glm::dvec3(position(gen), position(gen), position(gen));
+            s.radius = radius(gen);
+        }
+        return spheres;
+    }
+
+    void checkAgainstBruteForce(const BSH& hierarchy,
+                                const std::vector<BSH::Sphere>& spheres,
+                                const View& view, double minimumPixelSize)
+    {
+        std::vector<BSH::Visibility> result;
+        hierarchy.cull(
+            view.viewProjection,
+            view.position,
+            view.pixelsPerUnit,
+            minimumPixelSize,
+            result
+        );
+        REQUIRE(result.size() == spheres.size());
+
+        for (size_t i = 0; i < spheres.size(); ++i) {
+            const bool culled = result[i] != BSH::Visibility::Visible;
+            REQUIRE(culled == isCulled(view, spheres[i], minimumPixelSize));
+        }
+    }
+} // namespace
+
+TEST_CASE("BoundingSphereHierarchy: Empty", "[boundingspherehierarchy]") {
+    BSH hierarchy;
+    hierarchy.build({});
+    hierarchy.refit();
+    REQUIRE(hierarchy.nItems() == 0);
+
+    const View view = createView(glm::dvec3(0.0), glm::dvec3(1.0, 0.0, 0.0));
+    std::vector<BSH::Visibility> result;
+    hierarchy.cull(view.viewProjection, view.position, view.pixelsPerUnit, 1.0, result);
+    REQUIRE(result.empty());
+}
+
+TEST_CASE("BoundingSphereHierarchy: Single", "[boundingspherehierarchy]") {
+    BSH hierarchy;
+    hierarchy.build({ { glm::dvec3(100.0, 0.0, 0.0), 1.0 } });
+
+    const View view = createView(glm::dvec3(0.0), glm::dvec3(1.0, 0.0, 0.0));
+    std::vector<BSH::Visibility> result;
+    hierarchy.cull(view.viewProjection, view.position, view.pixelsPerUnit, 1.0, result);
+    REQUIRE(result.size() == 1);
+    REQUIRE(result[0] == BSH::Visibility::Visible);
+
+    // Behind the camera
+    hierarchy.setSphere(0, { glm::dvec3(-100.0, 0.0, 0.0), 1.0 });
+    hierarchy.refit();
+    hierarchy.cull(view.viewProjection, view.position, view.pixelsPerUnit, 1.0, result);
+    REQUIRE(result[0] == BSH::Visibility::OutsideFrustum);
+
+    // In front of the camera, but too far away to cover a pixel
+    hierarchy.setSphere(0, { glm::dvec3(1e5, 0.0, 0.0), 1.0 });
+    hierarchy.refit();
+    hierarchy.cull(view.viewProjection, view.position, view.pixelsPerUnit, 1.0, result);
+    REQUIRE(result[0] == BSH::Visibility::SubPixel);
+
+    // Without a minimum size, nothing is too small
+    hierarchy.cull(view.viewProjection, view.position, view.pixelsPerUnit, 0.0, result);
+    REQUIRE(result[0] == BSH::Visibility::Visible);
+
+    // The camera is inside the sphere
+    hierarchy.setSphere(0, { glm::dvec3(-1.0, 0.0, 0.0), 2.0 });
+    hierarchy.refit();
+    hierarchy.cull(view.viewProjection, view.position, view.pixelsPerUnit, 1.0, result);
+    REQUIRE(result[0] == BSH::Visibility::Visible);
+}
+
+TEST_CASE("BoundingSphereHierarchy: Matches brute force", "[boundingspherehierarchy]") {
+    std::mt19937 gen(1337);
+    std::vector<BSH::Sphere> spheres = randomSpheres(gen, 2500);
+
+    BSH hierarchy;
+    hierarchy.build(spheres);
+    REQUIRE(hierarchy.nItems() == spheres.size());
+
+    std::uniform_real_distribution<double> position(-1500.0, 1500.0);
+    for (int i = 0; i < 25; ++i) {
+        const View view = createView(
+            glm::dvec3(position(gen), position(gen), position(gen)),
+            glm::dvec3(position(gen), position(gen), position(gen))
+        );
+        checkAgainstBruteForce(hierarchy, spheres, view, 0.0);
+        checkAgainstBruteForce(hierarchy, spheres, view, 1.0);
+        checkAgainstBruteForce(hierarchy, spheres, view, 5.0);
+    }
+}
+
+TEST_CASE("BoundingSphereHierarchy: Refit", "[boundingspherehierarchy]") {
+    std::mt19937 gen(42);
+    std::vector<BSH::Sphere> spheres = randomSpheres(gen, 1000);
+
+    BSH hierarchy;
+    hierarchy.build(spheres);
+
+    // Small movements keep the structure of the hierarchy, while replacing all spheres
+    // makes the refitted bounds loose enough to trigger a rebuild. Both have to produce
+    // the same results as testing every sphere
+    std::normal_distribution<double> offset(0.0, 5.0);
+    for (int i = 0; i < 10; ++i) {
+        for (size_t j = 0; j < spheres.size(); ++j) {
+            spheres[j].center += glm::dvec3(offset(gen), offset(gen), offset(gen));
+            hierarchy.setSphere(j, spheres[j]);
+        }
+        hierarchy.refit();
+
+        const View view = createView(glm::dvec3(0.0), spheres[i].center);
+        checkAgainstBruteForce(hierarchy, spheres, view, 1.0);
+    }
+
+    spheres = randomSpheres(gen, spheres.size());
+    for (size_t j = 0; j < spheres.size(); ++j) {
+        hierarchy.setSphere(j, spheres[j]);
+    }
+    hierarchy.refit();
+    const View view = createView(glm::dvec3(0.0), spheres[0].center);
+    checkAgainstBruteForce(hierarchy, spheres, view, 1.0);
+}
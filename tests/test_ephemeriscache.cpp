@@ -0,0 +1,135 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_SPACE_ENABLED
+
+#include "catch2/catch.hpp"
+
+#include <modules/space/ephemeriscache.h>
+#include <openspace/util/spicemanager.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <chrono>
+#include <thread>
+
+namespace {
+    void loadKernels() {
+        using openspace::SpiceManager;
+        SpiceManager::ref().loadKernel(
+            absPath("${TESTDIR}/SpiceTest/spicekernels/naif0008.tls")
+        );
+        SpiceManager::ref().loadKernel(
+            absPath("${TESTDIR}/SpiceTest/spicekernels/981005_PLTEPH-DE405S.bsp")
+        );
+        SpiceManager::ref().loadKernel(
+            absPath("${TESTDIR}/SpiceTest/spicekernels/cpck05Mar2004.tpc")
+        );
+    }
+
+    // The segments are fitted in the background, so a lookup fails until the segment
+    // that contains the time has been fitted
+    template <typename Func>
+    bool waitForFit(Func lookup) {
+        for (int i = 0; i < 1000; ++i) {
+            if (lookup()) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+} // namespace
+
+TEST_CASE("EphemerisCache: Position", "[ephemeriscache]") {
+    using namespace openspace;
+    SpiceManager::initialize();
+    loadKernels();
+
+    constexpr const double Tolerance = 1e-5; // km
+    const double et = SpiceManager::ref().ephemerisTimeFromDate("2004 jun 11 19:32:00");
+
+    std::shared_ptr<EphemerisCache> cache = EphemerisCache::positionCache(
+        "EARTH",
+        "SUN",
+        "J2000",
+        Tolerance
+    );
+    REQUIRE(
+        cache == EphemerisCache::positionCache("EARTH", "SUN", "J2000", Tolerance)
+    );
+
+    for (int i = 0; i < 500; ++i) {
+        const double t = et + i * 1234.5;
+        const glm::dvec3 reference = SpiceManager::ref().targetPosition(
+            "EARTH", "SUN", "J2000", {}, t
+        );
+
+        glm::dvec3 position = glm::dvec3(0.0);
+        REQUIRE(waitForFit([&]() { return cache->position(t, position); }));
+        REQUIRE(std::abs(position.x - reference.x) <= Tolerance);
+        REQUIRE(std::abs(position.y - reference.y) <= Tolerance);
+        REQUIRE(std::abs(position.z - reference.z) <= Tolerance);
+    }
+
+    // Outside of the coverage of the kernel, the SpiceManager has to be used
+    glm::dvec3 position = glm::dvec3(0.0);
+    REQUIRE_FALSE(cache->position(-1e11, position));
+
+    cache = nullptr;
+    SpiceManager::deinitialize();
+}
+
+TEST_CASE("EphemerisCache: Rotation", "[ephemeriscache]") {
+    using namespace openspace;
+    SpiceManager::initialize();
+    loadKernels();
+
+    constexpr const double Tolerance = 1e-9;
+    const double et = SpiceManager::ref().ephemerisTimeFromDate("2004 jun 11 19:32:00");
+
+    std::shared_ptr<EphemerisCache> cache = EphemerisCache::rotationCache(
+        "IAU_EARTH",
+        "J2000",
+        Tolerance
+    );
+
+    for (int i = 0; i < 500; ++i) {
+        const double t = et + i * 1234.5;
+        const glm::dmat3 reference = SpiceManager::ref().positionTransformMatrix(
+            "IAU_EARTH", "J2000", t
+        );
+
+        glm::dmat3 rotation = glm::dmat3(1.0);
+        REQUIRE(waitForFit([&]() { return cache->rotation(t, rotation); }));
+        for (int j = 0; j < 3; ++j) {
+            for (int k = 0; k < 3; ++k) {
+                REQUIRE(std::abs(rotation[j][k] - reference[j][k]) <= Tolerance);
+            }
+        }
+    }
+
+    cache = nullptr;
+    SpiceManager::deinitialize();
+}
+
+#endif // OPENSPACE_MODULE_SPACE_ENABLED
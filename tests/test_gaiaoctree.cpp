@@ -0,0 +1,219 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_GAIA_ENABLED
+
+#include "catch2/catch.hpp"
+
+#include <modules/gaia/rendering/octreemanager.h>
+#include <openspace/util/distanceconstants.h>
+#include <ghoul/glm.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <random>
+#include <thread>
+
+namespace {
+    constexpr const int MaxDist = 2; // [kPc]
+    constexpr const int MaxStarsPerNode = 100;
+    constexpr const int NumStars = 200000;
+    constexpr const long long MaxNodesInStream = 4096;
+    const glm::vec2 ScreenSize = glm::vec2(1920.f, 1080.f);
+
+    // Builds a synthetic octree with stars that are concentrated towards the origin
+    void buildSyntheticOctree(openspace::OctreeManager& octree) {
+        octree.initOctree(0, MaxDist, MaxStarsPerNode);
+
+        std::mt19937 gen(1337);
+        std::normal_distribution<float> pos(0.f, MaxDist / 4.f);
+        std::uniform_real_distribution<float> mag(-5.f, 15.f);
+        std::uniform_real_distribution<float> color(-0.5f, 3.f);
+        std::normal_distribution<float> vel(0.f, 30.f);
+
+        std::vector<float> values(8);
+        for (int i = 0; i < NumStars; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                values[j] = glm::clamp(
+                    pos(gen),
+                    -static_cast<float>(MaxDist) + 0.001f,
+                    static_cast<float>(MaxDist) - 0.001f
+                );
+            }
+            values[3] = mag(gen);
+            values[4] = color(gen);
+            values[5] = vel(gen);
+            values[6] = vel(gen);
+            values[7] = vel(gen);
+            octree.insert(values);
+        }
+        octree.sliceLodData();
+        octree.initBufferIndexStack(MaxNodesInStream, false, true);
+    }
+
+    // A recorded camera path: a fly-in from outside of the tree towards the center
+    // followed by a full turn around the up axis from inside the tree
+    std::vector<glm::dmat4> cameraPath(int nFrames) {
+        const double kPc = 1000.0 * openspace::distanceconstants::Parsec;
+        const glm::dmat4 projection = glm::perspective(
+            glm::radians(60.0),
+            static_cast<double>(ScreenSize.x) / static_cast<double>(ScreenSize.y),
+            1.0,
+            1e25
+        );
+
+        std::vector<glm::dmat4> mvps;
+        mvps.reserve(nFrames);
+        const int nFlyIn = nFrames / 2;
+        for (int i = 0; i < nFlyIn; ++i) {
+            const double t = static_cast<double>(i) / nFlyIn;
+            const glm::dvec3 eye = glm::mix(
+                glm::dvec3(3.0 * MaxDist, 0.5, 0.3),
+                glm::dvec3(0.1, 0.05, 0.02),
+                t
+            ) * kPc;
+            const glm::dmat4 view = glm::lookAt(
+                eye,
+                glm::dvec3(0.0),
+                glm::dvec3(0.0, 0.0, 1.0)
+            );
+            mvps.push_back(projection * view);
+        }
+        for (int i = nFlyIn; i < nFrames; ++i) {
+            const double t = static_cast<double>(i - nFlyIn) / (nFrames - nFlyIn);
+            const double angle = glm::two_pi<double>() * t;
+            const glm::dvec3 eye = glm::dvec3(0.1, 0.05, 0.02) * kPc;
+            const glm::dvec3 dir = glm::dvec3(std::cos(angle), std::sin(angle), 0.1);
+            const glm::dmat4 view = glm::lookAt(
+                eye,
+                eye + dir,
+                glm::dvec3(0.0, 0.0, 1.0)
+            );
+            mvps.push_back(projection * view);
+        }
+        return mvps;
+    }
+} // namespace
+
+TEST_CASE("GaiaOctree: Parallel traversal matches serial", "[gaiaoctree]") {
+    using namespace openspace;
+
+    OctreeManager serial;
+    buildSyntheticOctree(serial);
+    serial.setParallelTraversal(false);
+
+    OctreeManager parallel;
+    buildSyntheticOctree(parallel);
+    parallel.setParallelTraversal(true);
+
+    for (const glm::dmat4& mvp : cameraPath(120)) {
+        int serialDelta = 0;
+        const OctreeManager::StagingArena& s = serial.traverseData(
+            mvp,
+            ScreenSize,
+            serialDelta,
+            gaia::RenderOption::Motion,
+            250.f
+        );
+        int parallelDelta = 0;
+        const OctreeManager::StagingArena& p = parallel.traverseData(
+            mvp,
+            ScreenSize,
+            parallelDelta,
+            gaia::RenderOption::Motion,
+            250.f
+        );
+
+        REQUIRE(serialDelta == parallelDelta);
+        REQUIRE(s.data == p.data);
+        REQUIRE(s.dirtyChunks.size() == p.dirtyChunks.size());
+        for (size_t i = 0; i < s.dirtyChunks.size(); ++i) {
+            REQUIRE(s.dirtyChunks[i].bufferIndex == p.dirtyChunks[i].bufferIndex);
+            REQUIRE(s.dirtyChunks[i].offset == p.dirtyChunks[i].offset);
+            REQUIRE(s.dirtyChunks[i].size == p.dirtyChunks[i].size);
+        }
+        REQUIRE(serial.numFreeSpotsInBuffer() == parallel.numFreeSpotsInBuffer());
+        REQUIRE(serial.biggestChunkIndexInUse() == parallel.biggestChunkIndexInUse());
+    }
+}
+
+TEST_CASE("GaiaOctree: Benchmark traversal", "[.][benchmark][gaiaoctree]") {
+    using namespace openspace;
+
+    OctreeManager serial;
+    buildSyntheticOctree(serial);
+    serial.setParallelTraversal(false);
+
+    OctreeManager parallel;
+    buildSyntheticOctree(parallel);
+    parallel.setParallelTraversal(true);
+
+    using Duration = std::chrono::duration<double, std::milli>;
+    auto traverse = [](OctreeManager& octree, const glm::dmat4& mvp, int& deltaStars,
+                       Duration& duration) -> const OctreeManager::StagingArena&
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        const OctreeManager::StagingArena& arena = octree.traverseData(
+            mvp,
+            ScreenSize,
+            deltaStars,
+            gaia::RenderOption::Motion,
+            250.f
+        );
+        duration += std::chrono::high_resolution_clock::now() - start;
+        return arena;
+    };
+
+    const std::vector<glm::dmat4> path = cameraPath(1000);
+    Duration serialTime = Duration(0.0);
+    Duration parallelTime = Duration(0.0);
+    for (const glm::dmat4& mvp : path) {
+        int serialDelta = 0;
+        const OctreeManager::StagingArena& s = traverse(
+            serial,
+            mvp,
+            serialDelta,
+            serialTime
+        );
+        int parallelDelta = 0;
+        const OctreeManager::StagingArena& p = traverse(
+            parallel,
+            mvp,
+            parallelDelta,
+            parallelTime
+        );
+
+        REQUIRE(serialDelta == parallelDelta);
+        REQUIRE(s.data == p.data);
+        REQUIRE(s.dirtyChunks.size() == p.dirtyChunks.size());
+    }
+
+    INFO(serial.totalNodes() << " nodes, " << path.size() << " frames");
+    INFO("Serial:   " << serialTime.count() / path.size() << " ms/frame");
+    INFO("Parallel: " << parallelTime.count() / path.size() << " ms/frame");
+    if (std::thread::hardware_concurrency() > 1) {
+        REQUIRE(parallelTime < serialTime);
+    }
+}
+
+#endif // OPENSPACE_MODULE_GAIA_ENABLED
@@ -0,0 +1,257 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+
+#ifdef OPENSPACE_MODULE_SPACE_ENABLED
+
+#include "catch2/catch.hpp"
+
+#include <modules/space/kepler.h>
+#include <modules/space/translation/keplertranslation.h>
+#include <openspace/util/updatestructures.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/glm.h>
+#include <ghoul/misc/exception.h>
+#include <fstream>
+#include <random>
+
+namespace {
+    constexpr const unsigned int NumSegments = 120;
+
+    // Creates orbits with random elements in the ranges that are found in TLE files
+    openspace::kepler::Elements randomOrbits(int nOrbits, double maxEccentricity) {
+        std::mt19937 gen(1337);
+        std::uniform_real_distribution<double> eccentricity(0.0, maxEccentricity);
+        std::uniform_real_distribution<double> semiMajorAxis(6600.0, 42000.0);
+        std::uniform_real_distribution<double> angle(0.0, 360.0);
+        std::uniform_real_distribution<double> epoch(0.0, 6e8);
+
+        openspace::kepler::Elements elements;
+        elements.reserve(nOrbits);
+        for (int i = 0; i < nOrbits; ++i) {
+            openspace::kepler::Parameters p;
+            p.eccentricity = eccentricity(gen);
+            p.semiMajorAxis = semiMajorAxis(gen);
+            p.inclination = angle(gen) / 2.0;
+            p.ascendingNode = angle(gen);
+            p.argumentOfPeriapsis = angle(gen);
+            p.meanAnomaly = angle(gen);
+            p.epoch = epoch(gen);
+            // Kepler's third law with the gravitational parameter of Earth [km^3 / s^2]
+            p.period = glm::two_pi<double>() *
+                std::sqrt(std::pow(p.semiMajorAxis, 3.0) / 398600.4418);
+            p.meanMotion = 86400.0 / p.period;
+            elements.push_back(p);
+        }
+        return elements;
+    }
+} // namespace
+
+TEST_CASE("Kepler: Eccentric anomaly solves Kepler's equation", "[kepler]") {
+    std::vector<double> meanAnomalies;
+    for (int i = -1000; i <= 1000; ++i) {
+        meanAnomalies.push_back(i * 0.0123);
+    }
+    std::vector<double> eccentricAnomalies(meanAnomalies.size());
+
+    for (double e : { 0.0, 0.001, 0.1, 0.19, 0.2, 0.5, 0.89, 0.9, 0.95, 0.99 }) {
+        openspace::kepler::computeEccentricAnomalies(
+            e,
+            meanAnomalies.data(),
+            eccentricAnomalies.data(),
+            meanAnomalies.size()
+        );
+
+        for (size_t i = 0; i < meanAnomalies.size(); ++i) {
+            const double ea = eccentricAnomalies[i];
+            const double m = ea - e * std::sin(ea);
+            // Compare the angles on the unit circle to account for the range reduction
+            REQUIRE(std::cos(m) == Approx(std::cos(meanAnomalies[i])).margin(1e-12));
+            REQUIRE(std::sin(m) == Approx(std::sin(meanAnomalies[i])).margin(1e-12));
+        }
+    }
+}
+
+TEST_CASE("Kepler: Read TLE file", "[kepler]") {
+    using namespace openspace;
+
+    const std::string file = absPath("${TEMPORARY}/test_kepler.tle");
+    {
+        std::ofstream f(file);
+        f << "ISS (ZARYA)\n"
+          << "1 25544U 98067A   20001.50000000  .00000874  00000-0  23776-4 0  9991\n"
+          << "2 25544  51.6443 100.2355 0005010 153.0587 317.5846 15.49522358205903\n"
+          << "SAT B\r\n"
+          << "1 00002U 00000A   99365.25000000  .00000000  00000-0  00000-0 0  9990\r\n"
+          << "2 00002  98.0000 200.0000 1000000  10.0000  20.0000  1.00000000000000\r\n";
+    }
+
+    std::shared_ptr<const kepler::Elements> elements = kepler::readTleFile(file);
+    REQUIRE(elements->size() == 2);
+
+    const kepler::Parameters iss = elements->at(0);
+    REQUIRE(iss.inclination == Approx(51.6443));
+    REQUIRE(iss.ascendingNode == Approx(100.2355));
+    REQUIRE(iss.eccentricity == Approx(0.000501));
+    REQUIRE(iss.argumentOfPeriapsis == Approx(153.0587));
+    REQUIRE(iss.meanAnomaly == Approx(317.5846));
+    REQUIRE(iss.meanMotion == Approx(15.49522358));
+    REQUIRE(iss.epoch == Approx(kepler::epochFromSubstring("20001.50000000")));
+    REQUIRE(iss.period == Approx(86400.0 / 15.49522358));
+    REQUIRE(iss.semiMajorAxis == Approx(kepler::calculateSemiMajorAxis(15.49522358)));
+
+    const kepler::Parameters b = elements->at(1);
+    REQUIRE(b.eccentricity == Approx(0.1));
+    REQUIRE(b.epoch == Approx(kepler::epochFromSubstring("99365.25000000")));
+
+    // Consumers of the same file share the catalog while it is in use
+    REQUIRE(kepler::readTleFile(file) == elements);
+
+    // The second load after the catalog was released comes from the binary cache
+    elements = nullptr;
+    std::shared_ptr<const kepler::Elements> cached = kepler::readTleFile(file);
+    REQUIRE(cached->size() == 2);
+    REQUIRE(cached->eccentricity[1] == Approx(0.1));
+    REQUIRE(cached->epoch[0] == iss.epoch);
+}
+
+TEST_CASE("Kepler: Read malformed TLE file", "[kepler]") {
+    using namespace openspace;
+
+    const std::string file = absPath("${TEMPORARY}/test_kepler_malformed.tle");
+    {
+        std::ofstream f(file);
+        f << "COMMENT\n"
+          << "ISS (ZARYA)\n"
+          << "1 25544U 98067A   20001.50000000  .00000874  00000-0  23776-4 0  9991\n"
+          << "2 25544  51.6443 100.2355 0005010 153.0587 317.5846 15.49522358205903\n"
+          << "SAT B\n"
+          << "1 00002U 00000A   99365.25000000  .00000000  00000-0  00000-0 0  9990\n"
+          << "2 00002  98.0000 200.0000 1000000  10.0000  20.0000  1.00000000000000\n";
+    }
+
+    // The extra line shifts the entries, so the groups of three lines are malformed and
+    // skipped instead of failing the whole file
+    std::shared_ptr<const kepler::Elements> elements = kepler::readTleFile(file);
+    REQUIRE(elements->empty());
+
+    // Single entries can still be read from any line
+    const kepler::Parameters b = kepler::readTleEntry(file, 5);
+    REQUIRE(b.eccentricity == Approx(0.1));
+    REQUIRE(b.epoch == Approx(kepler::epochFromSubstring("99365.25000000")));
+
+    REQUIRE_THROWS_AS(kepler::readTleEntry(file, 1), ghoul::RuntimeError);
+    REQUIRE_THROWS_AS(kepler::readTleEntry(file, 6), ghoul::RuntimeError);
+}
+
+TEST_CASE("Kepler: Read SBDB file", "[kepler]") {
+    using namespace openspace;
+
+    const std::string file = absPath("${TEMPORARY}/test_kepler.csv");
+    {
+        std::ofstream f(file);
+        f << "full_name,epoch_cal,e,a,i,om,w,ma,per\n"
+          << "\"     1 Ceres (A801 AA)\",20200531.0000000,.0763,2.769,10.59,80.31,"
+          << "73.6,-77.37,1681.6\n"
+          << "\"  Comet, Hyperbolic\",20200531.5000000,1.2,-5.0,40,10,20,30,\n"
+          << "\"     2 Pallas (A802 FA)\",20200531.5000000,.2299,2.773,34.84,173.02,"
+          << "310.2,396.5,1684.6\r\n";
+    }
+
+    std::shared_ptr<const kepler::Elements> elements = kepler::readSbdbFile(file);
+    // The hyperbolic orbit is skipped
+    REQUIRE(elements->size() == 2);
+
+    const kepler::Parameters ceres = elements->at(0);
+    REQUIRE(ceres.eccentricity == Approx(0.0763));
+    REQUIRE(ceres.semiMajorAxis == Approx(2.769 * 1.496e8));
+    REQUIRE(ceres.inclination == Approx(10.59));
+    REQUIRE(ceres.ascendingNode == Approx(80.31));
+    REQUIRE(ceres.argumentOfPeriapsis == Approx(73.6));
+    REQUIRE(ceres.meanAnomaly == Approx(360.0 - 77.37));
+    REQUIRE(ceres.period == Approx(1681.6 * 86400.0));
+    REQUIRE(ceres.epoch == Approx(kepler::epochFromYMDdSubstring("20200531.0000000")));
+
+    const kepler::Parameters pallas = elements->at(1);
+    REQUIRE(pallas.meanAnomaly == Approx(36.5));
+    REQUIRE(pallas.epoch == Approx(ceres.epoch + 43200.0));
+
+    // The second load after the catalog was released comes from the binary cache
+    elements = nullptr;
+    std::shared_ptr<const kepler::Elements> cached = kepler::readSbdbFile(file);
+    REQUIRE(cached->size() == 2);
+    REQUIRE(cached->period[1] == Approx(1684.6 * 86400.0));
+}
+
+TEST_CASE("Kepler: Batch propagation matches KeplerTranslation", "[kepler]") {
+    using namespace openspace;
+
+    const kepler::Elements elements = randomOrbits(1000, 0.05);
+
+    std::vector<glm::dvec3> batch(elements.size() * (NumSegments + 1));
+    kepler::computeOrbitPositions(
+        elements,
+        NumSegments,
+        [&batch](size_t orbit, const glm::dvec3* positions) {
+            std::copy(
+                positions,
+                positions + NumSegments + 1,
+                batch.begin() + orbit * (NumSegments + 1)
+            );
+        }
+    );
+
+    KeplerTranslation translation;
+    for (size_t i = 0; i < elements.size(); ++i) {
+        translation.setKeplerElements(
+            elements.eccentricity[i],
+            elements.semiMajorAxis[i],
+            elements.inclination[i],
+            elements.ascendingNode[i],
+            elements.argumentOfPeriapsis[i],
+            elements.meanAnomaly[i],
+            elements.period[i],
+            elements.epoch[i]
+        );
+
+        // The per-object solver stops after a fixed number of fixed-point iterations,
+        // so the results only agree to a fraction of the semi-major axis
+        const double tolerance = 1e-6 * elements.semiMajorAxis[i] * 1000.0;
+        for (unsigned int j = 0; j <= NumSegments; ++j) {
+            const double timeOffset = elements.period[i] * static_cast<double>(j) /
+                                      static_cast<double>(NumSegments);
+            const glm::dvec3 reference = translation.position({
+                {},
+                Time(timeOffset + elements.epoch[i]),
+                Time(0.0),
+                false
+            });
+
+            const glm::dvec3 p = batch[i * (NumSegments + 1) + j];
+            REQUIRE(glm::distance(p, reference) < tolerance);
+        }
+    }
+}
+
+#endif // OPENSPACE_MODULE_SPACE_ENABLED
@@ -0,0 +1,346 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_BASE_ENABLED
+
+#include "catch2/catch.hpp"
+
+#include <modules/base/luafunction.h>
+#include <modules/base/translation/luatranslation.h>
+#include <openspace/util/updatestructures.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/lua/ghoul_lua.h>
+#include <ghoul/lua/lua_helper.h>
+#include <ghoul/lua/luastate.h>
+#include <ghoul/misc/dictionary.h>
+#include <ghoul/misc/exception.h>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <thread>
+
+namespace {
+    std::string writeScript(const std::string& name, const std::string& content) {
+        const std::string file = absPath("${TEMPORARY}/" + name);
+        std::ofstream f(file);
+        f << content;
+        return file;
+    }
+
+    // A translation along an inclined circle, as it would be written by hand
+    constexpr const char* CircleScript = R"(
+-- Moves along a circle with a radius of 1000 km once per day
+function translation(time, previousTime, wallTime)
+    local radius = 1000000
+    local angle = 2 * math.pi * (time % 86400) / 86400
+    local x = radius * math.cos(angle)
+    local y = radius * math.sin(angle)
+    return x, y * math.cos(0.25), y * math.sin(0.25)
+end
+)";
+
+    constexpr const double Arguments[][3] = {
+        { 0.0, -1.0, 0.0 },
+        { 1234.5, 1234.0, 1e12 },
+        { -6.3e8, -6.3e8, 5e11 },
+        { 6.3e8, 6.3e8 - 0.5, 2e12 }
+    };
+
+    void requireSameResults(const std::string& file, const std::string& name,
+                            int nResults)
+    {
+        using namespace openspace;
+
+        LuaFunction compiled(name, 3, nResults);
+        compiled.load(file, LuaFunction::AllowCompilation::Yes);
+        REQUIRE(compiled.isCompiled());
+
+        LuaFunction lua(name, 3, nResults);
+        lua.load(file, LuaFunction::AllowCompilation::No);
+        REQUIRE_FALSE(lua.isCompiled());
+
+        for (const double (&arguments)[3] : Arguments) {
+            std::vector<double> compiledResults(nResults);
+            std::vector<double> luaResults(nResults);
+            REQUIRE(compiled.evaluate(arguments, compiledResults.data()));
+            REQUIRE(lua.evaluate(arguments, luaResults.data()));
+            for (int i = 0; i < nResults; ++i) {
+                REQUIRE(compiledResults[i] == Approx(luaResults[i]));
+            }
+        }
+    }
+} // namespace
+
+TEST_CASE("LuaFunction: Compiled matches Lua", "[luafunction]") {
+    requireSameResults(
+        writeScript("test_luafunction_circle.lua", CircleScript),
+        "translation",
+        3
+    );
+
+    requireSameResults(
+        writeScript(
+            "test_luafunction_operators.lua",
+            "function scale(t, p, w)\n"
+            "  --[[ precedence and associativity ]]\n"
+            "  local a = -2 ^ 2 + 2 ^ 3 ^ 2 - (t - p) * 3 / 4\n"
+            "  local b = (t % 7) + (-t % 7) + (t % -7)\n"
+            "  a = a + math.max(1, b, 2) - math.min(t, p) + math.fmod(-7, 3)\n"
+            "  return a + math.atan(1, 2) + math.log(8, 2) + math.log(100, 10)\n"
+            "end\n"
+        ),
+        "scale",
+        1
+    );
+
+    requireSameResults(
+        writeScript(
+            "test_luafunction_rotation.lua",
+            "function rotation(t)\n"
+            "  local c = math.cos(t * 1e-5); local s = math.sin(t * 1e-5)\n"
+            "  return c, s, 0, -s, c, 0, 0, 0, 1\n"
+            "end\n"
+        ),
+        "rotation",
+        9
+    );
+}
+
+TEST_CASE("LuaFunction: Falls back to Lua", "[luafunction]") {
+    using namespace openspace;
+
+    const std::string file = writeScript(
+        "test_luafunction_fallback.lua",
+        "local offset = 2\n"
+        "function scale(t)\n"
+        "  if t > 0 then return t * offset end\n"
+        "  return -t\n"
+        "end\n"
+    );
+
+    LuaFunction function("scale", 3, 1);
+    function.load(file, LuaFunction::AllowCompilation::Yes);
+    REQUIRE(function.isLoaded());
+    REQUIRE_FALSE(function.isCompiled());
+
+    const double positive[3] = { 3.0, 0.0, 0.0 };
+    const double negative[3] = { -5.0, 0.0, 0.0 };
+    double result = 0.0;
+    REQUIRE(function.evaluate(positive, &result));
+    REQUIRE(result == 6.0);
+    REQUIRE(function.evaluate(negative, &result));
+    REQUIRE(result == 5.0);
+}
+
+TEST_CASE("LuaFunction: Errors", "[luafunction]") {
+    using namespace openspace;
+
+    LuaFunction function("translation", 3, 3);
+    const double arguments[3] = { 0.0, 0.0, 0.0 };
+    double results[3];
+    REQUIRE_FALSE(function.evaluate(arguments, results));
+
+    const std::string missing = writeScript(
+        "test_luafunction_missing.lua",
+        "function scale(t) return t end\n"
+    );
+    REQUIRE_THROWS_AS(
+        function.load(missing, LuaFunction::AllowCompilation::Yes),
+        ghoul::RuntimeError
+    );
+    REQUIRE_FALSE(function.isLoaded());
+
+    // Returning too few values is not compiled and fails at evaluation
+    const std::string tooFew = writeScript(
+        "test_luafunction_toofew.lua",
+        "function translation(t) return t, t end\n"
+    );
+    function.load(tooFew, LuaFunction::AllowCompilation::Yes);
+    REQUIRE_FALSE(function.isCompiled());
+    REQUIRE_FALSE(function.evaluate(arguments, results));
+}
+
+TEST_CASE("LuaFunction: Concurrent evaluation", "[luafunction]") {
+    using namespace openspace;
+
+    const std::string file = writeScript("test_luafunction_circle.lua", CircleScript);
+    LuaFunction function("translation", 3, 3);
+    function.load(file, LuaFunction::AllowCompilation::No);
+
+    constexpr const int NumEvaluations = 2000;
+    std::vector<double> reference(NumEvaluations * 3);
+    for (int i = 0; i < NumEvaluations; ++i) {
+        const double arguments[3] = { i * 60.0, 0.0, 0.0 };
+        REQUIRE(function.evaluate(arguments, &reference[i * 3]));
+    }
+
+    constexpr const int NumThreads = 4;
+    std::vector<double> results(NumThreads * NumEvaluations * 3);
+    // Not std::vector<bool> as its elements cannot be written from different threads
+    std::vector<char> success(NumThreads, 1);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NumThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < NumEvaluations; ++i) {
+                const double arguments[3] = { i * 60.0, 0.0, 0.0 };
+                double* r = &results[(t * NumEvaluations + i) * 3];
+                if (!function.evaluate(arguments, r)) {
+                    success[t] = 0;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < NumThreads; ++t) {
+        REQUIRE(success[t]);
+        for (int i = 0; i < NumEvaluations * 3; ++i) {
+            REQUIRE(results[t * NumEvaluations * 3 + i] == reference[i]);
+        }
+    }
+}
+
+TEST_CASE("LuaFunction: Reload while evaluating", "[luafunction]") {
+    using namespace openspace;
+
+    const std::string file = writeScript("test_luafunction_circle.lua", CircleScript);
+    LuaFunction function("translation", 3, 3);
+    function.load(file, LuaFunction::AllowCompilation::No);
+
+    constexpr const int NumEvaluations = 2000;
+    std::vector<double> reference(NumEvaluations * 3);
+    for (int i = 0; i < NumEvaluations; ++i) {
+        const double arguments[3] = { i * 60.0, 0.0, 0.0 };
+        REQUIRE(function.evaluate(arguments, &reference[i * 3]));
+    }
+
+    // Every evaluation sees either the previous or the reloaded script, which compute
+    // the same values, and never a script that is only partially loaded
+    constexpr const int NumThreads = 4;
+    std::vector<char> success(NumThreads, 1);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NumThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < NumEvaluations; ++i) {
+                const double arguments[3] = { i * 60.0, 0.0, 0.0 };
+                double r[3];
+                if (!function.evaluate(arguments, r) ||
+                    std::abs(r[0] - reference[i * 3]) > 1e-6 ||
+                    std::abs(r[1] - reference[i * 3 + 1]) > 1e-6 ||
+                    std::abs(r[2] - reference[i * 3 + 2]) > 1e-6)
+                {
+                    success[t] = 0;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 20; ++i) {
+        // Alternate between the compiled program and the Lua states
+        function.load(file, LuaFunction::AllowCompilation(i % 2 == 0));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < NumThreads; ++t) {
+        REQUIRE(success[t]);
+    }
+}
+
+TEST_CASE("LuaFunction: Benchmark LuaTranslation", "[.][benchmark][luafunction]") {
+    using namespace openspace;
+
+    constexpr const int NumNodes = 1000;
+    constexpr const int NumFrames = 100;
+    const std::string file = writeScript("test_luafunction_circle.lua", CircleScript);
+
+    using Duration = std::chrono::duration<double, std::milli>;
+
+    // The previous implementation executed the script on every evaluation
+    std::vector<glm::dvec3> reference(NumNodes * NumFrames);
+    ghoul::lua::LuaState state;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < NumFrames; ++frame) {
+        for (int i = 0; i < NumNodes; ++i) {
+            ghoul::lua::runScriptFile(state, file);
+            lua_getglobal(state, "translation");
+            lua_pushnumber(state, frame * 10.0);
+            lua_pushnumber(state, frame * 10.0);
+            lua_pushnumber(state, 0.0);
+            lua_pcall(state, 3, 3, 0);
+            reference[frame * NumNodes + i] = glm::dvec3(
+                lua_tonumber(state, -3),
+                lua_tonumber(state, -2),
+                lua_tonumber(state, -1)
+            );
+            lua_settop(state, 0);
+        }
+    }
+    const Duration scriptTime = std::chrono::high_resolution_clock::now() - start;
+
+    auto measure = [&](bool compile, Duration& duration) {
+        ghoul::Dictionary dictionary;
+        dictionary.setValue("Type", std::string("LuaTranslation"));
+        dictionary.setValue("Script", file);
+        dictionary.setValue("CompileScript", compile);
+
+        std::vector<std::unique_ptr<LuaTranslation>> nodes;
+        for (int i = 0; i < NumNodes; ++i) {
+            nodes.push_back(std::make_unique<LuaTranslation>(dictionary));
+        }
+
+        std::vector<glm::dvec3> positions(NumNodes * NumFrames);
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < NumFrames; ++frame) {
+            const UpdateData data = { {}, Time(frame * 10.0), Time(frame * 10.0), false };
+            for (int i = 0; i < NumNodes; ++i) {
+                positions[frame * NumNodes + i] = nodes[i]->position(data);
+            }
+        }
+        duration = std::chrono::high_resolution_clock::now() - begin;
+        return positions;
+    };
+
+    Duration luaTime;
+    const std::vector<glm::dvec3> lua = measure(false, luaTime);
+    Duration compiledTime;
+    const std::vector<glm::dvec3> compiled = measure(true, compiledTime);
+
+    for (size_t i = 0; i < reference.size(); ++i) {
+        REQUIRE(lua[i] == reference[i]);
+        REQUIRE(compiled[i].x == Approx(reference[i].x).margin(1e-6));
+        REQUIRE(compiled[i].y == Approx(reference[i].y).margin(1e-6));
+        REQUIRE(compiled[i].z == Approx(reference[i].z).margin(1e-6));
+    }
+
+    INFO("Script per call: " << scriptTime.count() / NumFrames << " ms/frame");
+    INFO("Lua reference:   " << luaTime.count() / NumFrames << " ms/frame");
+    INFO("Compiled:        " << compiledTime.count() / NumFrames << " ms/frame");
+    REQUIRE(luaTime < scriptTime);
+    REQUIRE(compiledTime < luaTime);
+}
+
+#endif // OPENSPACE_MODULE_BASE_ENABLED
@@ -0,0 +1,130 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "catch2/catch.hpp"
+
+#include <openspace/properties/scalar/floatproperty.h>
+#include <memory>
+
+using namespace openspace::properties;
+
+TEST_CASE("Property: Immediate Notification", "[property]") {
+    FloatProperty p({ "id", "gui", "desc" });
+    int nCalls = 0;
+    p.onChange([&nCalls]() { ++nCalls; });
+
+    p = 1.f;
+    p = 2.f;
+    REQUIRE(nCalls == 2);
+
+    Property::notifyDeferredChangeListeners();
+    REQUIRE(nCalls == 2);
+}
+
+TEST_CASE("Property: Deferred Notification", "[property]") {
+    FloatProperty p({ "id", "gui", "desc" });
+    int nCalls = 0;
+    float lastValue = 0.f;
+    p.onChange(
+        [&]() {
+            ++nCalls;
+            lastValue = p;
+        },
+        Property::DeferNotification::Yes
+    );
+
+    p = 1.f;
+    p = 2.f;
+    p = 3.f;
+    REQUIRE(nCalls == 0);
+
+    Property::notifyDeferredChangeListeners();
+    REQUIRE(nCalls == 1);
+    REQUIRE(lastValue == 3.f);
+
+    // Without a change, there is no notification
+    Property::notifyDeferredChangeListeners();
+    REQUIRE(nCalls == 1);
+
+    p = 4.f;
+    Property::notifyDeferredChangeListeners();
+    REQUIRE(nCalls == 2);
+    REQUIRE(lastValue == 4.f);
+}
+
+TEST_CASE("Property: Deferred Notification Removed", "[property]") {
+    FloatProperty p({ "id", "gui", "desc" });
+    int nCalls = 0;
+    Property::OnChangeHandle h = p.onChange(
+        [&nCalls]() { ++nCalls; },
+        Property::DeferNotification::Yes
+    );
+
+    p = 1.f;
+    p.removeOnChange(h);
+    Property::notifyDeferredChangeListeners();
+    REQUIRE(nCalls == 0);
+}
+
+TEST_CASE("Property: Deferred Notification Destroyed", "[property]") {
+    int nCalls = 0;
+    auto p1 = std::make_unique<FloatProperty>(Property::PropertyInfo{ "a", "a", "" });
+    auto p2 = std::make_unique<FloatProperty>(Property::PropertyInfo{ "b", "b", "" });
+
+    // The first callback destroys the second property before it is notified
+    p1->onChange([&]() { p2 = nullptr; }, Property::DeferNotification::Yes);
+    p2->onChange([&nCalls]() { ++nCalls; }, Property::DeferNotification::Yes);
+
+    *p1 = 1.f;
+    *p2 = 1.f;
+    Property::notifyDeferredChangeListeners();
+    REQUIRE(p2 == nullptr);
+    REQUIRE(nCalls == 0);
+
+    // A property that is destroyed while waiting is not notified either
+    auto p3 = std::make_unique<FloatProperty>(Property::PropertyInfo{ "c", "c", "" });
+    p3->onChange([&nCalls]() { ++nCalls; }, Property::DeferNotification::Yes);
+    *p3 = 1.f;
+    p3 = nullptr;
+    Property::notifyDeferredChangeListeners();
+    REQUIRE(nCalls == 0);
+}
+
+TEST_CASE("Property: Deferred Notification Chained", "[property]") {
+    FloatProperty p1({ "a", "a", "" });
+    FloatProperty p2({ "b", "b", "" });
+    int nCalls = 0;
+
+    // Changes caused by a deferred callback are notified in the next frame
+    p1.onChange([&p2]() { p2 = p2 + 1.f; }, Property::DeferNotification::Yes);
+    p2.onChange([&nCalls]() { ++nCalls; }, Property::DeferNotification::Yes);
+
+    p1 = 1.f;
+    Property::notifyDeferredChangeListeners();
+    REQUIRE(p2 == 1.f);
+    REQUIRE(nCalls == 0);
+
+    Property::notifyDeferredChangeListeners();
+    REQUIRE(nCalls == 1);
+}
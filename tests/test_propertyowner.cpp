@@ -0,0 +1,287 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "catch2/catch.hpp"
+
+#include <openspace/properties/propertyowner.h>
+#include <openspace/properties/scalar/boolproperty.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace openspace::properties;
+
+    constexpr const char* PropertyNames[] = {
+        "Enabled", "Opacity", "Color", "Size", "Fade"
+    };
+    constexpr const char* OwnerNames[] = {
+        "Renderable", "Translation", "Rotation", "Scale", "Labels"
+    };
+
+    // Owns a hierarchy of PropertyOwners, each of which has all of the PropertyNames
+    struct Hierarchy {
+        Hierarchy(int nNodes, int nLevels, bool createIndex);
+
+        PropertyOwner* createOwner(std::string identifier, PropertyOwner& parent,
+            int nLevels);
+
+        PropertyOwner root = PropertyOwner({ "" });
+        std::vector<std::unique_ptr<PropertyOwner>> owners;
+        std::vector<std::unique_ptr<BoolProperty>> properties;
+        std::vector<std::string> uris;
+    };
+
+    Hierarchy::Hierarchy(int nNodes, int nLevels, bool createIndex) {
+        if (createIndex) {
+            root.createUriIndex();
+        }
+        PropertyOwner* scene = createOwner("Scene", root, 0);
+        for (int i = 0; i < nNodes; ++i) {
+            createOwner("Node" + std::to_string(i), *scene, nLevels);
+        }
+        for (const std::unique_ptr<BoolProperty>& p : properties) {
+            uris.push_back(p->fullyQualifiedIdentifier());
+        }
+    }
+
+    PropertyOwner* Hierarchy::createOwner(std::string identifier, PropertyOwner& parent,
+                                          int nLevels)
+    {
+        owners.push_back(std::make_unique<PropertyOwner>(
+            PropertyOwner::PropertyOwnerInfo{ std::move(identifier) }
+        ));
+        PropertyOwner* owner = owners.back().get();
+
+        // Add the sub-owners before and the properties after attaching the owner to test
+        // both ways of getting into the index
+        for (int i = 0; i < nLevels; ++i) {
+            createOwner(OwnerNames[i % 5], *owner, nLevels - 1);
+        }
+        parent.addPropertySubOwner(owner);
+        for (const char* name : PropertyNames) {
+            properties.push_back(std::make_unique<BoolProperty>(
+                Property::PropertyInfo{ name, name, "" }
+            ));
+            owner->addProperty(properties.back().get());
+        }
+        return owner;
+    }
+
+    void requireSameLookup(const Hierarchy& indexed, const Hierarchy& traversed,
+                           const std::string& uri)
+    {
+        Property* lhs = indexed.root.property(uri);
+        Property* rhs = traversed.root.property(uri);
+        REQUIRE((lhs == nullptr) == (rhs == nullptr));
+        if (lhs) {
+            REQUIRE(lhs->fullyQualifiedIdentifier() == rhs->fullyQualifiedIdentifier());
+        }
+    }
+
+    void requireSamePrefix(const Hierarchy& indexed, const Hierarchy& traversed,
+                           const std::string& prefix)
+    {
+        std::vector<Property*> lhs = indexed.root.propertiesWithUriPrefix(prefix);
+        std::vector<Property*> rhs = traversed.root.propertiesWithUriPrefix(prefix);
+        REQUIRE(lhs.size() == rhs.size());
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            REQUIRE(
+                lhs[i]->fullyQualifiedIdentifier() == rhs[i]->fullyQualifiedIdentifier()
+            );
+        }
+    }
+} // namespace
+
+TEST_CASE("PropertyOwner: Lookup", "[propertyowner]") {
+    Hierarchy indexed(5, 2, true);
+    Hierarchy traversed(5, 2, false);
+
+    for (const std::string& uri : indexed.uris) {
+        REQUIRE(indexed.root.property(uri) != nullptr);
+        REQUIRE(indexed.root.property(uri)->fullyQualifiedIdentifier() == uri);
+        requireSameLookup(indexed, traversed, uri);
+    }
+
+    const std::vector<std::string> missing = {
+        "", "Scene", "Scene.", "Scene.Node0", "Scene.Node0.", "Scene.Node5.Enabled",
+        "Scene.Node0.Renderable", "Scene.Node0.Enabled.Enabled", ".Scene.Node0.Enabled",
+        "Scene..Node0.Enabled", "Scene.Node0.Renderable.Translation.Enabled"
+    };
+    for (const std::string& uri : missing) {
+        REQUIRE(indexed.root.property(uri) == nullptr);
+        requireSameLookup(indexed, traversed, uri);
+    }
+}
+
+TEST_CASE("PropertyOwner: Index after changes", "[propertyowner]") {
+    Hierarchy indexed(5, 2, true);
+    Hierarchy traversed(5, 2, false);
+
+    auto modify = [](Hierarchy& h) {
+        PropertyOwner* scene = h.root.propertySubOwner("Scene");
+        PropertyOwner* node1 = scene->propertySubOwner("Node1");
+        PropertyOwner* node2 = scene->propertySubOwner("Node2");
+        PropertyOwner* node3 = scene->propertySubOwner("Node3");
+
+        // Removing an owner removes all of its properties
+        scene->removePropertySubOwner(node1);
+
+        // Removing a single property
+        node2->removeProperty(node2->property("Opacity"));
+        PropertyOwner* renderable = node2->propertySubOwner("Renderable");
+        renderable->removeProperty(renderable->property("Color"));
+
+        // Renaming an owner changes the URIs of all properties below it
+        node3->setIdentifier("Renamed");
+
+        // Moving an owner to a different parent
+        scene->removePropertySubOwner(node2);
+        node3->addPropertySubOwner(node2);
+    };
+    modify(indexed);
+    modify(traversed);
+
+    std::vector<std::string> uris = indexed.uris;
+    uris.push_back("Scene.Renamed.Enabled");
+    uris.push_back("Scene.Renamed.Renderable.Enabled");
+    uris.push_back("Scene.Renamed.Node2.Enabled");
+    uris.push_back("Scene.Renamed.Node2.Opacity");
+    uris.push_back("Scene.Renamed.Node2.Renderable.Color");
+    uris.push_back("Scene.Renamed.Node2.Translation.Size");
+    for (const std::string& uri : uris) {
+        requireSameLookup(indexed, traversed, uri);
+    }
+
+    REQUIRE(indexed.root.property("Scene.Node1.Enabled") == nullptr);
+    REQUIRE(indexed.root.property("Scene.Node3.Enabled") == nullptr);
+    REQUIRE(indexed.root.property("Scene.Renamed.Enabled") != nullptr);
+    REQUIRE(indexed.root.property("Scene.Renamed.Node2.Opacity") == nullptr);
+    REQUIRE(indexed.root.property("Scene.Renamed.Node2.Renderable.Enabled") != nullptr);
+}
+
+TEST_CASE("PropertyOwner: Prefix", "[propertyowner]") {
+    Hierarchy indexed(12, 2, true);
+    Hierarchy traversed(12, 2, false);
+
+    const std::vector<std::string> prefixes = {
+        "", "S", "Scene", "Scene.", "Scene.Node1", "Scene.Node1.", "Scene.Node11.",
+        "Scene.Node1.Renderable.", "Scene.Node1.Renderable.Enabled", "Scene.Node1.E",
+        "Scene.Node12", "Foo", "Scene.Node1.Enabled.Foo"
+    };
+    for (const std::string& prefix : prefixes) {
+        requireSamePrefix(indexed, traversed, prefix);
+    }
+
+    REQUIRE(indexed.root.propertiesWithUriPrefix("").size() == indexed.uris.size());
+    // Each node owns 5 properties and 4 sub-owners with 5 properties each. The prefix
+    // without the separator also matches Node10 and Node11
+    REQUIRE(indexed.root.propertiesWithUriPrefix("Scene.Node1").size() == 3 * 25);
+    REQUIRE(indexed.root.propertiesWithUriPrefix("Scene.Node1.").size() == 25);
+    REQUIRE(indexed.root.propertiesWithUriPrefix("Scene.Node1.E").size() == 1);
+    REQUIRE(indexed.root.propertiesWithUriPrefix("Foo").empty());
+}
+
+TEST_CASE("PropertyOwner: Benchmark URI lookup", "[.][benchmark][propertyowner]") {
+    // About the number of properties in a full profile
+    constexpr const int NumNodes = 300;
+    constexpr const int NumLookups = 100000;
+
+    Hierarchy indexed(NumNodes, 3, true);
+    Hierarchy traversed(NumNodes, 3, false);
+
+    std::mt19937 gen(1337);
+    std::uniform_int_distribution<size_t> dist(0, indexed.uris.size() - 1);
+    std::vector<std::string> uris;
+    for (int i = 0; i < NumLookups; ++i) {
+        uris.push_back(indexed.uris[dist(gen)]);
+    }
+
+    using Duration = std::chrono::duration<double, std::milli>;
+    auto lookup = [&uris](const PropertyOwner& root, Duration& duration) {
+        std::vector<Property*> result;
+        result.reserve(uris.size());
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const std::string& uri : uris) {
+            result.push_back(root.property(uri));
+        }
+        duration = std::chrono::high_resolution_clock::now() - start;
+        return result;
+    };
+
+    Duration traversedTime;
+    const std::vector<Property*> traversedResult = lookup(traversed.root, traversedTime);
+    Duration indexedTime;
+    const std::vector<Property*> indexedResult = lookup(indexed.root, indexedTime);
+
+    for (size_t i = 0; i < uris.size(); ++i) {
+        REQUIRE(traversedResult[i]);
+        REQUIRE(indexedResult[i]);
+        REQUIRE(
+            indexedResult[i]->fullyQualifiedIdentifier() ==
+            traversedResult[i]->fullyQualifiedIdentifier()
+        );
+    }
+
+    // A wildcard URI as it is passed to setPropertyValue, once matched against all
+    // properties and once against the properties with the URI's prefix
+    const std::regex regex("Scene.Node42.(.*).Enabled");
+    auto match = [&regex](const std::vector<Property*>& properties) {
+        std::vector<std::string> result;
+        for (Property* p : properties) {
+            std::string uri = p->fullyQualifiedIdentifier();
+            if (std::regex_match(uri, regex)) {
+                result.push_back(std::move(uri));
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    const std::vector<std::string> allMatches = match(
+        traversed.root.propertiesRecursive()
+    );
+    const Duration allTime = std::chrono::high_resolution_clock::now() - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    const std::vector<std::string> prefixMatches = match(
+        indexed.root.propertiesWithUriPrefix("Scene.Node42.")
+    );
+    const Duration prefixTime = std::chrono::high_resolution_clock::now() - start;
+
+    REQUIRE_FALSE(allMatches.empty());
+    REQUIRE(prefixMatches == allMatches);
+
+    INFO("Traversal: " << traversedTime.count() << " ms");
+    INFO("Index:     " << indexedTime.count() << " ms");
+    INFO("Wildcard against all properties: " << allTime.count() << " ms");
+    INFO("Wildcard against prefix:         " << prefixTime.count() << " ms");
+    REQUIRE(indexedTime < traversedTime);
+    REQUIRE(prefixTime < allTime);
+}
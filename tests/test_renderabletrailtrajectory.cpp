@@ -0,0 +1,147 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_BASE_ENABLED
+
+#include "catch2/catch.hpp"
+
+#include <modules/base/rendering/renderabletrailtrajectory.h>
+#include <ghoul/glm.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+    using Trail = openspace::RenderableTrailTrajectory;
+
+    constexpr const double Period = 1000.0;
+
+    // An eccentric orbit that moves quickly and curves sharply around the periapsis and
+    // is almost straight and slow around the apoapsis
+    glm::dvec3 orbitPosition(double t) {
+        constexpr const double e = 0.9;
+        const double meanAnomaly = 2.0 * glm::pi<double>() * t / Period;
+        double E = meanAnomaly;
+        for (int i = 0; i < 50; ++i) {
+            E -= (E - e * std::sin(E) - meanAnomaly) / (1.0 - e * std::cos(E));
+        }
+        return glm::dvec3(std::cos(E) - e, std::sqrt(1.0 - e * e) * std::sin(E), 0.0);
+    }
+
+    // The largest distance between the orbit and the line through the samples
+    double maximumError(const std::vector<double>& timeStamps,
+                        const std::vector<glm::dvec3>& positions)
+    {
+        double result = 0.0;
+        for (double t = timeStamps.front(); t <= timeStamps.back(); t += Period / 1e5) {
+            const auto it = std::upper_bound(timeStamps.begin(), timeStamps.end(), t);
+            const size_t i = std::min<size_t>(
+                std::distance(timeStamps.begin(), it),
+                timeStamps.size() - 1
+            );
+            const glm::dvec3 a = positions[i - 1];
+            const glm::dvec3 b = positions[i];
+            const glm::dvec3 p = orbitPosition(t);
+            const double l = glm::dot(b - a, b - a);
+            const double f = l > 0.0 ? glm::dot(p - a, b - a) / l : 0.0;
+            const glm::dvec3 closest = a + glm::clamp(f, 0.0, 1.0) * (b - a);
+            result = std::max(result, glm::distance(p, closest));
+        }
+        return result;
+    }
+} // namespace
+
+TEST_CASE("RenderableTrailTrajectory: Adaptive sampling", "[renderabletrailtrajectory]") {
+    Trail::AdaptiveSettings settings;
+    settings.minimumInterval = Period / 1e5;
+    settings.maximumAngle = 2.0;
+    settings.maximumError = 1e-4;
+    settings.maximumVertices = 1000000;
+
+    const Trail::AdaptiveSamples adaptive = Trail::computeAdaptiveSamples(
+        orbitPosition,
+        0.0,
+        Period,
+        settings
+    );
+    REQUIRE(adaptive.timeStamps.size() == adaptive.positions.size());
+    REQUIRE(adaptive.timeStamps.front() == 0.0);
+    REQUIRE(adaptive.timeStamps.back() == Period);
+
+    SECTION("Minimum interval") {
+        // With these tolerances the subdivision is only stopped by the minimum interval
+        settings.minimumInterval = Period / 1e3;
+        settings.maximumAngle = 1e-6;
+        settings.maximumError = 1e-12;
+        const Trail::AdaptiveSamples finest = Trail::computeAdaptiveSamples(
+            orbitPosition,
+            0.0,
+            Period,
+            settings
+        );
+        for (size_t i = 1; i < finest.timeStamps.size(); ++i) {
+            const double dt = finest.timeStamps[i] - finest.timeStamps[i - 1];
+            REQUIRE(dt >= settings.minimumInterval * (1.0 - 1e-9));
+        }
+    }
+
+    SECTION("Fewer samples at equal error") {
+        const double adaptiveError = maximumError(
+            adaptive.timeStamps,
+            adaptive.positions
+        );
+
+        // Find the number of equidistant samples that is needed to reach the same error
+        size_t nUniform = adaptive.timeStamps.size();
+        double uniformError = std::numeric_limits<double>::max();
+        while (uniformError > adaptiveError) {
+            nUniform += nUniform / 4;
+            std::vector<double> timeStamps(nUniform);
+            std::vector<glm::dvec3> positions(nUniform);
+            for (size_t i = 0; i < nUniform; ++i) {
+                timeStamps[i] = Period * i / (nUniform - 1);
+                positions[i] = orbitPosition(timeStamps[i]);
+            }
+            uniformError = maximumError(timeStamps, positions);
+        }
+
+        REQUIRE(adaptive.timeStamps.size() * 2 < nUniform);
+    }
+
+    SECTION("Vertex limit") {
+        settings.maximumVertices = 101;
+        const Trail::AdaptiveSamples limited = Trail::computeAdaptiveSamples(
+            orbitPosition,
+            0.0,
+            Period,
+            settings
+        );
+        REQUIRE(limited.timeStamps.size() <= 101);
+        REQUIRE(limited.timeStamps.front() == 0.0);
+        REQUIRE(limited.timeStamps.back() == Period);
+    }
+}
+
+#endif // OPENSPACE_MODULE_BASE_ENABLED
@@ -0,0 +1,189 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_BASE_ENABLED
+
+#include "catch2/catch.hpp"
+
+#include <openspace/engine/configuration.h>
+#include <openspace/engine/globals.h>
+#include <openspace/rendering/renderable.h>
+#include <openspace/scene/scenegraphnode.h>
+#include <openspace/util/time.h>
+#include <openspace/util/updatestructures.h>
+#include <ghoul/misc/dictionary.h>
+#include <ghoul/misc/exception.h>
+#include <atomic>
+#include <thread>
+
+namespace {
+    class CountingRenderable : public openspace::Renderable {
+    public:
+        CountingRenderable(bool isEnabled)
+            : openspace::Renderable(ghoul::Dictionary())
+        {
+            _enabled = isEnabled;
+        }
+
+        void initialize() override { ++nInitialize; }
+        void initializeGL() override {
+            ++nInitializeGL;
+            if (failInitializeGL) {
+                throw ghoul::RuntimeError("Failed", "CountingRenderable");
+            }
+        }
+        void deinitialize() override { ++nDeinitialize; }
+        void deinitializeGL() override { ++nDeinitializeGL; }
+        void update(const openspace::UpdateData&) override { ++nUpdate; }
+        bool isReady() const override { return true; }
+
+        void setEnabled(bool isEnabled) { _enabled = isEnabled; }
+
+        std::atomic_int nInitialize = 0;
+        int nInitializeGL = 0;
+        int nDeinitialize = 0;
+        int nDeinitializeGL = 0;
+        int nUpdate = 0;
+        bool failInitializeGL = false;
+    };
+
+    // Restores the configuration value when the test is finished
+    struct DeferDisabledRenderables {
+        DeferDisabledRenderables(bool value)
+            : previous(openspace::global::configuration.deferDisabledRenderables)
+        {
+            openspace::global::configuration.deferDisabledRenderables = value;
+        }
+        ~DeferDisabledRenderables() {
+            openspace::global::configuration.deferDisabledRenderables = previous;
+        }
+        bool previous;
+    };
+} // namespace
+
+TEST_CASE("SceneGraphNode: Disabled Renderable", "[scenegraphnode]") {
+    using namespace openspace;
+    DeferDisabledRenderables defer(false);
+
+    SceneGraphNode node;
+    std::unique_ptr<CountingRenderable> r = std::make_unique<CountingRenderable>(false);
+    CountingRenderable* renderable = r.get();
+    node.setRenderable(std::move(r));
+
+    node.initialize();
+    node.initializeGL();
+    CHECK(renderable->nInitialize == 1);
+    CHECK(renderable->nInitializeGL == 1);
+}
+
+TEST_CASE("SceneGraphNode: Deferred Renderable", "[scenegraphnode]") {
+    using namespace openspace;
+    DeferDisabledRenderables defer(true);
+
+    SceneGraphNode node;
+    std::unique_ptr<CountingRenderable> r = std::make_unique<CountingRenderable>(false);
+    CountingRenderable* renderable = r.get();
+    node.setRenderable(std::move(r));
+
+    node.initialize();
+    node.initializeGL();
+    CHECK(renderable->nInitialize == 0);
+    CHECK(renderable->nInitializeGL == 0);
+
+    const UpdateData data = { {}, Time(0.0), Time(0.0), false };
+    node.update(data);
+    CHECK(renderable->nUpdate == 0);
+    CHECK_FALSE(node.isRenderedAt(Time(0.0)));
+
+    // Enabling the renderable starts the initialization in the background and the
+    // update that sees it finished continues with the initializeGL
+    renderable->setEnabled(true);
+    while (renderable->nInitialize == 0) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < 1000 && renderable->nInitializeGL == 0; ++i) {
+        node.update(data);
+        std::this_thread::yield();
+    }
+    CHECK(renderable->nInitialize == 1);
+    CHECK(renderable->nInitializeGL == 1);
+    CHECK(node.isRenderedAt(Time(0.0)));
+
+    // Further changes do not initialize the renderable again
+    renderable->setEnabled(false);
+    renderable->setEnabled(true);
+    node.update(data);
+    CHECK(renderable->nInitialize == 1);
+    CHECK(renderable->nInitializeGL == 1);
+}
+
+TEST_CASE("SceneGraphNode: Deferred Renderable Fails GL", "[scenegraphnode]") {
+    using namespace openspace;
+    DeferDisabledRenderables defer(true);
+
+    SceneGraphNode node;
+    std::unique_ptr<CountingRenderable> r = std::make_unique<CountingRenderable>(false);
+    CountingRenderable* renderable = r.get();
+    renderable->failInitializeGL = true;
+    node.setRenderable(std::move(r));
+
+    node.initialize();
+    node.initializeGL();
+
+    const UpdateData data = { {}, Time(0.0), Time(0.0), false };
+    renderable->setEnabled(true);
+    while (renderable->nInitialize == 0) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < 1000 && renderable->nInitializeGL == 0; ++i) {
+        node.update(data);
+        std::this_thread::yield();
+    }
+    CHECK(renderable->nInitialize == 1);
+    CHECK(renderable->nInitializeGL == 1);
+    CHECK_FALSE(node.isRenderedAt(Time(0.0)));
+
+    // The renderable was initialized, but its OpenGL resources never were
+    node.deinitializeGL();
+    node.deinitialize();
+    CHECK(renderable->nDeinitializeGL == 0);
+    CHECK(renderable->nDeinitialize == 1);
+}
+
+TEST_CASE("SceneGraphNode: Enabled Renderable Not Deferred", "[scenegraphnode]") {
+    using namespace openspace;
+    DeferDisabledRenderables defer(true);
+
+    SceneGraphNode node;
+    std::unique_ptr<CountingRenderable> r = std::make_unique<CountingRenderable>(true);
+    CountingRenderable* renderable = r.get();
+    node.setRenderable(std::move(r));
+
+    node.initialize();
+    node.initializeGL();
+    CHECK(renderable->nInitialize == 1);
+    CHECK(renderable->nInitializeGL == 1);
+}
+
+#endif // OPENSPACE_MODULE_BASE_ENABLED
@@ -0,0 +1,253 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_BASE_ENABLED
+
+#include "catch2/catch.hpp"
+
+#include <openspace/json.h>
+#include <openspace/rendering/renderable.h>
+#include <openspace/scene/scene.h>
+#include <openspace/scene/scenegraphnode.h>
+#include <openspace/scene/sceneinitializer.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/misc/dictionary.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace {
+    std::unique_ptr<openspace::SceneGraphNode> createNode(const std::string& identifier)
+    {
+        ghoul::Dictionary dictionary;
+        dictionary.setValue("Identifier", identifier);
+        return openspace::SceneGraphNode::createFromDictionary(dictionary);
+    }
+
+    // Records the order in which the renderables are initialized and can optionally
+    // block the initialization until it is released
+    class RecordingRenderable : public openspace::Renderable {
+    public:
+        RecordingRenderable(std::string identifier, std::vector<std::string>& order,
+                            std::mutex& mutex)
+            : openspace::Renderable(ghoul::Dictionary())
+            , _identifier(std::move(identifier))
+            , _order(order)
+            , _mutex(mutex)
+        {
+            _enabled = true;
+        }
+
+        void initialize() override {
+            if (gate.valid()) {
+                isWaiting = true;
+                gate.wait();
+            }
+            std::lock_guard<std::mutex> g(_mutex);
+            _order.push_back(_identifier);
+        }
+        void initializeGL() override {}
+        void deinitialize() override {}
+        void deinitializeGL() override {}
+        bool isReady() const override { return true; }
+
+        std::shared_future<void> gate;
+        std::atomic_bool isWaiting = false;
+
+    private:
+        std::string _identifier;
+        std::vector<std::string>& _order;
+        std::mutex& _mutex;
+    };
+} // namespace
+
+TEST_CASE("SceneInitializer: Cost Cache", "[sceneinitializer]") {
+    using namespace openspace;
+
+    const std::string file = absPath("${TEMPORARY}/test_sceneinitializer.json");
+    std::remove(file.c_str());
+
+    std::unique_ptr<MultiThreadedSceneInitializer> init =
+        std::make_unique<MultiThreadedSceneInitializer>(2, file);
+    MultiThreadedSceneInitializer* initializer = init.get();
+    Scene scene(std::move(init));
+
+    // Root -> A -> B, Root -> C, Root -> D, and B depends on C
+    scene.attachNode(createNode("A"));
+    scene.attachNode(createNode("C"));
+    scene.attachNode(createNode("D"));
+    SceneGraphNode* a = scene.sceneGraphNode("A");
+    REQUIRE(a);
+    a->attachChild(createNode("B"));
+    SceneGraphNode* b = scene.sceneGraphNode("B");
+    REQUIRE(b);
+    b->addDependency(*scene.sceneGraphNode("C"));
+
+    for (const char* identifier : { "A", "B", "C", "D" }) {
+        scene.initializeNode(scene.sceneGraphNode(identifier));
+    }
+    while (initializer->isInitializing()) {
+        std::this_thread::yield();
+    }
+    REQUIRE(initializer->takeInitializedNodes().size() == 4);
+
+    initializer->saveCosts(b);
+
+    std::ifstream f(file);
+    REQUIRE(f.good());
+    const nlohmann::json json = nlohmann::json::parse(f);
+
+    std::vector<std::string> focus = json["focus"].get<std::vector<std::string>>();
+    std::sort(focus.begin(), focus.end());
+    const std::vector<std::string> expected = {
+        "A", "B", "C", SceneGraphNode::RootNodeIdentifier
+    };
+    CHECK(focus == expected);
+
+    const nlohmann::json& costs = json["costs"];
+    CHECK(costs.size() == 4);
+    for (const char* identifier : { "A", "B", "C", "D" }) {
+        CHECK(costs.contains(identifier));
+    }
+
+    // A second initializer that reads the costs still initializes all nodes
+    std::unique_ptr<MultiThreadedSceneInitializer> second =
+        std::make_unique<MultiThreadedSceneInitializer>(2, file);
+    for (const char* identifier : { "A", "B", "C", "D" }) {
+        second->initializeNode(scene.sceneGraphNode(identifier));
+    }
+    while (second->isInitializing()) {
+        std::this_thread::yield();
+    }
+    CHECK(second->takeInitializedNodes().size() == 4);
+}
+
+TEST_CASE("SceneInitializer: Invalid Cost Cache", "[sceneinitializer]") {
+    using namespace openspace;
+
+    const std::string file = absPath("${TEMPORARY}/test_sceneinitializer_invalid.json");
+    {
+        std::ofstream f(file);
+        f << "{ \"version\": 1, \"costs\": ";
+    }
+
+    MultiThreadedSceneInitializer initializer(2, file);
+    std::unique_ptr<SceneGraphNode> node = createNode("A");
+    initializer.initializeNode(node.get());
+    while (initializer.isInitializing()) {
+        std::this_thread::yield();
+    }
+    CHECK(initializer.takeInitializedNodes().size() == 1);
+}
+
+TEST_CASE("SceneInitializer: Priority Order", "[sceneinitializer]") {
+    using namespace openspace;
+
+    const std::string file = absPath("${TEMPORARY}/test_sceneinitializer_order.json");
+    {
+        const nlohmann::json json = {
+            { "version", 1 },
+            { "focus", nlohmann::json::array({ "F1", "F2" }) },
+            { "costs", { { "A", 300 }, { "B", 100 }, { "C", 200 }, { "F1", 10 },
+                         { "F2", 50 } } }
+        };
+        std::ofstream f(file);
+        f << json.dump();
+    }
+
+    std::vector<std::string> order;
+    std::mutex orderMutex;
+    std::vector<std::unique_ptr<SceneGraphNode>> nodes;
+    auto createRecordingNode = [&](const std::string& identifier) {
+        std::unique_ptr<SceneGraphNode> node = createNode(identifier);
+        std::unique_ptr<RecordingRenderable> r =
+            std::make_unique<RecordingRenderable>(identifier, order, orderMutex);
+        RecordingRenderable* renderable = r.get();
+        node->setRenderable(std::move(r));
+        nodes.push_back(std::move(node));
+        return renderable;
+    };
+
+    MultiThreadedSceneInitializer initializer(1, file);
+
+    // The single worker is kept busy by the gate node until all other nodes are
+    // queued, so that the order only depends on the priorities of the queued nodes
+    std::promise<void> release;
+    RecordingRenderable* gate = createRecordingNode("Gate");
+    gate->gate = release.get_future().share();
+    initializer.initializeNode(nodes.back().get());
+    while (!gate->isWaiting) {
+        std::this_thread::yield();
+    }
+
+    for (const char* identifier : { "B", "F1", "A", "C", "F2" }) {
+        createRecordingNode(identifier);
+        initializer.initializeNode(nodes.back().get());
+    }
+    release.set_value();
+
+    while (initializer.isInitializing()) {
+        std::this_thread::yield();
+    }
+    CHECK(initializer.takeInitializedNodes().size() == 6);
+
+    // The focus nodes come first, then all other nodes with the most expensive first
+    const std::vector<std::string> expected = { "Gate", "F2", "F1", "A", "C", "B" };
+    std::lock_guard<std::mutex> g(orderMutex);
+    CHECK(order == expected);
+}
+
+TEST_CASE("SceneInitializer: OpenGL Budget", "[sceneinitializer]") {
+    using namespace openspace;
+
+    constexpr const int NumNodes = 500;
+
+    Scene scene(
+        std::make_unique<SingleThreadedSceneInitializer>(),
+        0,
+        std::chrono::microseconds(1)
+    );
+    for (int i = 0; i < NumNodes; ++i) {
+        const std::string identifier = "Node" + std::to_string(i);
+        scene.attachNode(createNode(identifier));
+        scene.initializeNode(scene.sceneGraphNode(identifier));
+    }
+
+    // Every call initializes at least one node, but not all of them at once
+    scene.initializeNodesGL();
+    CHECK(scene.isInitializing());
+    int nCalls = 1;
+    while (scene.isInitializing()) {
+        scene.initializeNodesGL();
+        ++nCalls;
+    }
+    CHECK(nCalls > 1);
+    CHECK(nCalls <= NumNodes);
+}
+
+#endif // OPENSPACE_MODULE_BASE_ENABLED
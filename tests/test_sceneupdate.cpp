@@ -0,0 +1,162 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_BASE_ENABLED
+
+#include "catch2/catch.hpp"
+
+#include <openspace/scene/scene.h>
+#include <openspace/scene/scenegraphnode.h>
+#include <openspace/scene/sceneinitializer.h>
+#include <openspace/util/updatestructures.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/misc/dictionary.h>
+#include <fstream>
+#include <random>
+
+namespace {
+    constexpr const int NumNodes = 1500;
+
+    // Creates a scene with a random hierarchy of nodes that use time-varying,
+    // stateful, and static transformations, with some additional dependencies and some
+    // nodes that opt out of concurrent updates
+    void createScene(openspace::Scene& scene, const std::string& script) {
+        using namespace openspace;
+
+        std::mt19937 gen(1337);
+        std::uniform_real_distribution<double> value(-1e6, 1e6);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        std::vector<SceneGraphNode*> nodes;
+        for (int i = 0; i < NumNodes; ++i) {
+            ghoul::Dictionary translation;
+            if (unit(gen) < 0.5) {
+                translation.setValue("Type", std::string("LuaTranslation"));
+                translation.setValue("Script", script);
+            }
+            else {
+                translation.setValue("Type", std::string("StaticTranslation"));
+                translation.setValue(
+                    "Position",
+                    glm::dvec3(value(gen), value(gen), value(gen))
+                );
+            }
+
+            ghoul::Dictionary rotation;
+            if (unit(gen) < 0.5) {
+                rotation.setValue("Type", std::string("ConstantRotation"));
+                rotation.setValue("RotationRate", unit(gen) * 1e-3);
+            }
+            else {
+                rotation.setValue("Type", std::string("StaticRotation"));
+                rotation.setValue(
+                    "Rotation",
+                    glm::dvec3(unit(gen), unit(gen), unit(gen))
+                );
+            }
+
+            ghoul::Dictionary scale;
+            scale.setValue("Type", std::string("StaticScale"));
+            scale.setValue("Scale", 0.5 + unit(gen));
+
+            ghoul::Dictionary transform;
+            transform.setValue("Translation", translation);
+            transform.setValue("Rotation", rotation);
+            transform.setValue("Scale", scale);
+
+            ghoul::Dictionary dictionary;
+            dictionary.setValue("Identifier", "Node" + std::to_string(i));
+            dictionary.setValue("Transform", transform);
+            if (unit(gen) < 0.05) {
+                dictionary.setValue("ConcurrentUpdate", false);
+            }
+
+            std::unique_ptr<SceneGraphNode> node =
+                SceneGraphNode::createFromDictionary(dictionary);
+            REQUIRE(node);
+            SceneGraphNode* n = node.get();
+
+            // Build a shallow, wide tree with a few deeper chains, like a solar system
+            if (nodes.empty() || unit(gen) < 0.1) {
+                scene.attachNode(std::move(node));
+            }
+            else {
+                std::uniform_int_distribution<size_t> parent(0, nodes.size() - 1);
+                nodes[parent(gen)]->attachChild(std::move(node));
+            }
+            if (!nodes.empty() && unit(gen) < 0.1) {
+                std::uniform_int_distribution<size_t> dependency(0, nodes.size() - 1);
+                n->addDependency(*nodes[dependency(gen)]);
+            }
+            nodes.push_back(n);
+        }
+
+        scene.initializeNode(scene.root());
+        for (SceneGraphNode* node : nodes) {
+            scene.initializeNode(node);
+        }
+    }
+
+    std::string writeScript() {
+        const std::string file = absPath("${TEMPORARY}/test_sceneupdate.lua");
+        std::ofstream f(file);
+        f << "function translation(time, previousTime)\n"
+          << "  local angle = time * 1e-4\n"
+          << "  local x = 1e5 * math.cos(angle)\n"
+          << "  return x, 1e5 * math.sin(angle), previousTime * 1e-3\n"
+          << "end\n";
+        return file;
+    }
+} // namespace
+
+TEST_CASE("SceneUpdate: Concurrent matches serial", "[sceneupdate]") {
+    using namespace openspace;
+
+    const std::string script = writeScript();
+    Scene serial(std::make_unique<SingleThreadedSceneInitializer>());
+    createScene(serial, script);
+    Scene concurrent(std::make_unique<SingleThreadedSceneInitializer>(), 4);
+    createScene(concurrent, script);
+
+    double previousTime = 0.0;
+    for (int frame = 0; frame < 20; ++frame) {
+        const double time = frame * 3600.0;
+        serial.update({ {}, Time(time), Time(previousTime), false });
+        concurrent.update({ {}, Time(time), Time(previousTime), false });
+        previousTime = time;
+
+        const std::vector<SceneGraphNode*>& serialNodes = serial.allSceneGraphNodes();
+        REQUIRE(concurrent.allSceneGraphNodes().size() == serialNodes.size());
+        for (const SceneGraphNode* s : serialNodes) {
+            const SceneGraphNode* c = concurrent.sceneGraphNode(s->identifier());
+            REQUIRE(c);
+            REQUIRE(c->worldPosition() == s->worldPosition());
+            REQUIRE(c->worldRotationMatrix() == s->worldRotationMatrix());
+            REQUIRE(c->worldScale() == s->worldScale());
+            REQUIRE(c->modelTransform() == s->modelTransform());
+        }
+    }
+}
+
+#endif // OPENSPACE_MODULE_BASE_ENABLED
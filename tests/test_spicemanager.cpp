@@ -24,8 +24,16 @@
 
 #include "catch2/catch.hpp"
 
+#include <openspace/util/spiceexecutor.h>
 #include <openspace/util/spicemanager.h>
+#include <ghoul/fmt.h>
 #include <ghoul/filesystem/filesystem.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <random>
+#include <thread>
 #include "SpiceUsr.h"
 #include "SpiceZpr.h"
 
@@ -305,6 +313,147 @@ TEST_CASE("SpiceManager: String To Ephemeris Time", "[spicemanager]") {
     openspace::SpiceManager::deinitialize();
 }
 
+namespace {
+    // Random UTC dates in all of the formats that SpiceManager converts natively
+    std::vector<std::string> randomDates(int n) {
+        constexpr const char* Months[] = {
+            "JAN", "feb", "Mar", "APR", "May", "jun", "JUL", "aug", "SEP", "Oct", "NOV",
+            "dec"
+        };
+        constexpr const int Days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+        std::mt19937 gen(1337);
+        std::uniform_int_distribution<int> year(1972, 2060);
+        std::uniform_int_distribution<int> month(0, 11);
+        std::uniform_int_distribution<int> hour(0, 23);
+        std::uniform_int_distribution<int> minute(0, 59);
+        std::uniform_int_distribution<int> millisecond(0, 59999);
+        std::uniform_int_distribution<int> format(0, 5);
+
+        std::vector<std::string> dates;
+        dates.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            const int y = year(gen);
+            const int m = month(gen);
+            const bool isLeap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+            const int nDays = (m == 1 && isLeap) ? 29 : Days[m];
+            const int d = std::uniform_int_distribution<int>(1, nDays)(gen);
+            const int h = hour(gen);
+            const int min = minute(gen);
+            const int ms = millisecond(gen);
+
+            switch (format(gen)) {
+                case 0:
+                    dates.push_back(fmt::format("{}-{:02}-{:02}", y, m + 1, d));
+                    break;
+                case 1:
+                    dates.push_back(fmt::format(
+                        "{}-{:02}-{:02}T{:02}:{:02}", y, m + 1, d, h, min
+                    ));
+                    break;
+                case 2:
+                    dates.push_back(fmt::format(
+                        "{}-{:02}-{:02}T{:02}:{:02}:{:02}.{:03}",
+                        y, m + 1, d, h, min, ms / 1000, ms % 1000
+                    ));
+                    break;
+                case 3:
+                    dates.push_back(fmt::format(
+                        "{}-{:02}-{:02} {:02}:{:02}:{:02}",
+                        y, m + 1, d, h, min, ms / 1000
+                    ));
+                    break;
+                case 4:
+                    dates.push_back(fmt::format(
+                        "{} {} {} {}:{:02}:{:02}", y, Months[m], d, h, min, ms / 1000
+                    ));
+                    break;
+                case 5:
+                    dates.push_back(fmt::format(
+                        "{}-{}-{:02} {:02}:{:02}:{:02}.{:03}",
+                        y, Months[m], d, h, min, ms / 1000, ms % 1000
+                    ));
+                    break;
+            }
+        }
+        return dates;
+    }
+} // namespace
+
+TEST_CASE("SpiceManager: Native Date Conversion", "[spicemanager]") {
+    openspace::SpiceManager::initialize();
+
+    loadLSKKernel();
+
+    for (const std::string& date : randomDates(100000)) {
+        double control = 0.0;
+        str2et_c(date.c_str(), &control);
+        REQUIRE_FALSE(failed_c());
+
+        const double et = openspace::SpiceManager::ref().ephemerisTimeFromDate(date);
+        INFO(date);
+        REQUIRE(et == Approx(control).epsilon(0.0).margin(1e-6));
+    }
+
+    // Formats that are not handled natively still have to produce SPICE's results
+    const std::vector<std::string> exotic = {
+        "JD 2451545.0",
+        "2004-163T12:00:00",
+        "2004 jun 11 19:32:00 TDB",
+        "2005-12-31T23:59:60.5",
+        "1969-07-20T20:17:40"
+    };
+    for (const std::string& date : exotic) {
+        double control = 0.0;
+        str2et_c(date.c_str(), &control);
+        REQUIRE_FALSE(failed_c());
+
+        INFO(date);
+        REQUIRE(openspace::SpiceManager::ref().ephemerisTimeFromDate(date) == control);
+    }
+
+    REQUIRE_THROWS_AS(
+        openspace::SpiceManager::ref().ephemerisTimeFromDate("not a date"),
+        openspace::SpiceManager::SpiceException
+    );
+
+    openspace::SpiceManager::deinitialize();
+}
+
+TEST_CASE("SpiceManager: Benchmark Date Conversion", "[.][benchmark][spicemanager]") {
+    openspace::SpiceManager::initialize();
+
+    loadLSKKernel();
+    const std::vector<std::string> dates = randomDates(100000);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<double> control(dates.size());
+    for (size_t i = 0; i < dates.size(); ++i) {
+        str2et_c(dates[i].c_str(), &control[i]);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double> spiceTime = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<double> native(dates.size());
+    for (size_t i = 0; i < dates.size(); ++i) {
+        native[i] = openspace::SpiceManager::ref().ephemerisTimeFromDate(dates[i]);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double> nativeTime = end - start;
+
+    for (size_t i = 0; i < dates.size(); ++i) {
+        INFO(dates[i]);
+        REQUIRE(std::abs(native[i] - control[i]) <= 1e-6);
+    }
+
+    INFO("str2et_c: " << dates.size() / spiceTime.count() << " dates/s");
+    INFO("Native:   " << dates.size() / nativeTime.count() << " dates/s");
+    REQUIRE(nativeTime < spiceTime);
+
+    openspace::SpiceManager::deinitialize();
+}
+
 TEST_CASE("SpiceManager: Get Target Position", "[spicemanager]") {
     openspace::SpiceManager::initialize();
 
@@ -336,6 +485,281 @@ TEST_CASE("SpiceManager: Get Target Position", "[spicemanager]") {
     openspace::SpiceManager::deinitialize();
 }
 
+TEST_CASE("SpiceManager: Get Target Position From Query", "[spicemanager]") {
+    openspace::SpiceManager::initialize();
+
+    using openspace::SpiceManager;
+    loadMetaKernel();
+
+    double et = 0.0;
+    char utctime[SRCLEN] = "2004 jun 11 19:32:00";
+    str2et_c(utctime, &et);
+
+    SpiceManager::AberrationCorrection corr = {
+        SpiceManager::AberrationCorrection::Type::LightTimeStellar,
+        SpiceManager::AberrationCorrection::Direction::Reception
+    };
+
+    SpiceManager::PositionQuery query;
+    REQUIRE_NOTHROW(
+        query = SpiceManager::ref().positionQuery("EARTH", "CASSINI", "J2000", corr)
+    );
+    REQUIRE(query.targetId == 399);
+    REQUIRE(query.observerId == -82);
+
+    for (int i = 0; i < 10; ++i) {
+        const double t = et + i * 3600.0;
+        double lightTime = 0.0;
+        const glm::dvec3 reference = SpiceManager::ref().targetPosition(
+            "EARTH", "CASSINI", "J2000", corr, t, lightTime
+        );
+
+        double queryLightTime = 0.0;
+        glm::dvec3 position = glm::dvec3(0.0);
+        REQUIRE_NOTHROW(
+            position = SpiceManager::ref().targetPosition(query, t, queryLightTime)
+        );
+        REQUIRE(position.x == reference.x);
+        REQUIRE(position.y == reference.y);
+        REQUIRE(position.z == reference.z);
+        REQUIRE(queryLightTime == lightTime);
+    }
+
+    REQUIRE_THROWS_AS(
+        SpiceManager::ref().positionQuery("NOT A BODY", "CASSINI", "J2000", corr),
+        SpiceManager::SpiceException
+    );
+
+    openspace::SpiceManager::deinitialize();
+}
+
+TEST_CASE("SpiceManager: Benchmark Target Position", "[.][benchmark][spicemanager]") {
+    openspace::SpiceManager::initialize();
+
+    using openspace::SpiceManager;
+    loadMetaKernel();
+
+    double et = 0.0;
+    char utctime[SRCLEN] = "2004 jun 11 19:32:00";
+    str2et_c(utctime, &et);
+
+    constexpr const int NumQueries = 100000;
+    const SpiceManager::AberrationCorrection corr;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<glm::dvec3> names(NumQueries);
+    for (int i = 0; i < NumQueries; ++i) {
+        names[i] = SpiceManager::ref().targetPosition(
+            "EARTH", "SUN", "GALACTIC", corr, et + i
+        );
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double> namesTime = end - start;
+
+    const SpiceManager::PositionQuery query = SpiceManager::ref().positionQuery(
+        "EARTH", "SUN", "GALACTIC", corr
+    );
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<glm::dvec3> queries(NumQueries);
+    for (int i = 0; i < NumQueries; ++i) {
+        queries[i] = SpiceManager::ref().targetPosition(query, et + i);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double> queryTime = end - start;
+
+    for (int i = 0; i < NumQueries; ++i) {
+        REQUIRE(queries[i] == names[i]);
+    }
+
+    INFO("Names: " << NumQueries / namesTime.count() << " positions/s");
+    INFO("Query: " << NumQueries / queryTime.count() << " positions/s");
+    REQUIRE(queryTime < namesTime);
+
+    openspace::SpiceManager::deinitialize();
+}
+
+TEST_CASE("SpiceManager: Executor", "[spicemanager]") {
+    openspace::SpiceManager::initialize();
+
+    using openspace::SpiceExecutor;
+    using openspace::SpiceManager;
+    loadMetaKernel();
+
+    double et = 0.0;
+    char utctime[SRCLEN] = "2004 jun 11 19:32:00";
+    str2et_c(utctime, &et);
+
+    const SpiceManager::AberrationCorrection corr = {
+        SpiceManager::AberrationCorrection::Type::LightTimeStellar,
+        SpiceManager::AberrationCorrection::Direction::Reception
+    };
+
+    auto makeBatch = [&](double t) {
+        SpiceExecutor::PositionRequest position;
+        position.target = "EARTH";
+        position.observer = "CASSINI";
+        position.referenceFrame = "J2000";
+        position.aberrationCorrection = corr;
+        position.time = t;
+
+        SpiceExecutor::TransformMatrixRequest matrix;
+        matrix.from = "CASSINI_HGA";
+        matrix.to = "J2000";
+        matrix.time = t;
+
+        SpiceExecutor::PositionRequest invalid;
+        invalid.target = "NOT A BODY";
+        invalid.observer = "CASSINI";
+        invalid.referenceFrame = "J2000";
+        invalid.time = t;
+
+        SpiceExecutor::FieldOfViewRequest fov;
+        fov.instrument = "CASSINI_ISS_NAC";
+
+        return std::vector<SpiceExecutor::Request>{ position, matrix, invalid, fov };
+    };
+
+    auto check = [&](double t, const std::vector<SpiceExecutor::Result>& results) {
+        REQUIRE(results.size() == 4);
+
+        double lightTime = 0.0;
+        const glm::dvec3 position = SpiceManager::ref().targetPosition(
+            "EARTH", "CASSINI", "J2000", corr, t, lightTime
+        );
+        const SpiceExecutor::PositionResult& p =
+            results[0].get<SpiceExecutor::PositionResult>();
+        REQUIRE(p.position == position);
+        REQUIRE(p.lightTime == lightTime);
+
+        const glm::dmat3 matrix = SpiceManager::ref().frameTransformationMatrix(
+            "CASSINI_HGA", "J2000", t
+        );
+        REQUIRE(results[1].get<glm::dmat3>() == matrix);
+
+        // A failing request does not affect the other requests of the batch
+        REQUIRE_THROWS_AS(
+            results[2].get<SpiceExecutor::PositionResult>(),
+            SpiceManager::SpiceException
+        );
+
+        const SpiceManager::FieldOfViewResult fov = SpiceManager::ref().fieldOfView(
+            "CASSINI_ISS_NAC"
+        );
+        REQUIRE(results[3].get<SpiceManager::FieldOfViewResult>().bounds == fov.bounds);
+    };
+
+    SpiceExecutor& executor = SpiceManager::ref().executor();
+
+    // Synchronous execution
+    check(et, executor.execute(makeBatch(et)));
+
+    // Batches executed from multiple threads are evaluated one at a time
+    constexpr const int NumThreads = 4;
+    constexpr const int NumBatches = 25;
+    std::vector<std::vector<SpiceExecutor::Result>> results(NumThreads * NumBatches);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NumThreads; ++i) {
+        threads.emplace_back([&, i]() {
+            for (int j = 0; j < NumBatches; ++j) {
+                const int index = i * NumBatches + j;
+                results[index] = executor.execute(makeBatch(et + index * 60.0));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        check(et + i * 60.0, results[i]);
+    }
+
+    // Submitted batches are executed on the executor's thread in submission order
+    std::vector<std::future<std::vector<SpiceExecutor::Result>>> futures;
+    for (int i = 0; i < NumBatches; ++i) {
+        futures.push_back(executor.submit(makeBatch(et + i * 60.0)));
+    }
+    // A job that is enqueued after the batches only runs once all of them are finished
+    bool allFinished = false;
+    executor.run([&]() {
+        allFinished = std::all_of(
+            futures.begin(),
+            futures.end(),
+            [](const std::future<std::vector<SpiceExecutor::Result>>& f) {
+                return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }
+        );
+    });
+    REQUIRE(allFinished);
+    for (int i = 0; i < NumBatches; ++i) {
+        check(et + i * 60.0, futures[i].get());
+    }
+
+    bool ranOnSpiceThread = false;
+    executor.run([&]() { ranOnSpiceThread = executor.isSpiceThread(); });
+    REQUIRE(ranOnSpiceThread);
+    REQUIRE_FALSE(executor.isSpiceThread());
+
+    openspace::SpiceManager::deinitialize();
+}
+
+TEST_CASE("SpiceManager: Concurrent Direct Calls", "[spicemanager]") {
+    openspace::SpiceManager::initialize();
+
+    using openspace::SpiceExecutor;
+    using openspace::SpiceManager;
+    loadMetaKernel();
+
+    double et = 0.0;
+    char utctime[SRCLEN] = "2004 jun 11 19:32:00";
+    str2et_c(utctime, &et);
+
+    constexpr const int NumSamples = 500;
+    const SpiceManager::AberrationCorrection corr;
+
+    std::vector<glm::dvec3> expected(NumSamples);
+    for (int i = 0; i < NumSamples; ++i) {
+        double lightTime = 0.0;
+        expected[i] = SpiceManager::ref().targetPosition(
+            "EARTH", "CASSINI", "J2000", corr, et + i * 60.0, lightTime
+        );
+    }
+
+    // Another thread evaluates the batch while this thread calls the SpiceManager
+    // directly; both have to see the same results as the serial computation
+    std::vector<SpiceExecutor::Request> batch;
+    for (int i = 0; i < NumSamples; ++i) {
+        SpiceExecutor::PositionRequest request;
+        request.target = "EARTH";
+        request.observer = "CASSINI";
+        request.referenceFrame = "J2000";
+        request.aberrationCorrection = corr;
+        request.time = et + i * 60.0;
+        batch.push_back(request);
+    }
+    std::vector<SpiceExecutor::Result> results;
+    std::thread thread([&]() {
+        results = SpiceManager::ref().executor().execute(batch);
+    });
+
+    for (int i = NumSamples - 1; i >= 0; --i) {
+        double lightTime = 0.0;
+        const glm::dvec3 p = SpiceManager::ref().targetPosition(
+            "EARTH", "CASSINI", "J2000", corr, et + i * 60.0, lightTime
+        );
+        REQUIRE(p == expected[i]);
+        REQUIRE(SpiceManager::ref().naifId("CASSINI") == -82);
+    }
+
+    thread.join();
+    REQUIRE(results.size() == NumSamples);
+    for (int i = 0; i < NumSamples; ++i) {
+        REQUIRE(results[i].get<SpiceExecutor::PositionResult>().position == expected[i]);
+    }
+
+    openspace::SpiceManager::deinitialize();
+}
+
 TEST_CASE("SpiceManager: Get Target State", "[spicemanager]") {
     openspace::SpiceManager::initialize();
 
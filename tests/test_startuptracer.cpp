@@ -0,0 +1,203 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "catch2/catch.hpp"
+
+#include <openspace/json.h>
+#include <openspace/performance/startuptracer.h>
+#include <thread>
+
+using namespace openspace::performance;
+using namespace std::chrono_literals;
+
+namespace {
+    void addSpan(StartupTracer& tracer, std::string name, StartupTracer::Category c,
+                 std::chrono::microseconds begin, std::chrono::microseconds end,
+                 bool isAsynchronous = false)
+    {
+        const StartupTracer::Clock::time_point now = StartupTracer::Clock::now();
+        tracer.addSpan(std::move(name), c, "", now + begin, now + end, isAsynchronous);
+    }
+} // namespace
+
+TEST_CASE("StartupTracer: Disabled", "[startuptracer]") {
+    StartupTracer tracer;
+    addSpan(tracer, "a", StartupTracer::Category::Asset, 0us, 10us);
+    {
+        StartupTracer::ScopedSpan span(tracer, "b", StartupTracer::Category::Node, "");
+    }
+    REQUIRE(tracer.spans().empty());
+}
+
+TEST_CASE("StartupTracer: Scoped Span", "[startuptracer]") {
+    StartupTracer tracer;
+    tracer.setEnabled(true);
+    {
+        StartupTracer::ScopedSpan span(
+            tracer,
+            "node",
+            StartupTracer::Category::Node,
+            "Initialize"
+        );
+    }
+    tracer.setEnabled(false);
+    {
+        StartupTracer::ScopedSpan span(tracer, "b", StartupTracer::Category::Node, "");
+    }
+
+    const std::vector<StartupTracer::Span> spans = tracer.spans();
+    REQUIRE(spans.size() == 1);
+    CHECK(spans[0].name == "node");
+    CHECK(spans[0].stage == "Initialize");
+    CHECK(spans[0].category == StartupTracer::Category::Node);
+    CHECK(spans[0].threadId == 0);
+    CHECK(spans[0].end >= spans[0].begin);
+
+    tracer.clear();
+    REQUIRE(tracer.spans().empty());
+}
+
+TEST_CASE("StartupTracer: Slowest", "[startuptracer]") {
+    StartupTracer tracer;
+    tracer.setEnabled(true);
+    addSpan(tracer, "a", StartupTracer::Category::Asset, 0us, 10us);
+    addSpan(tracer, "b", StartupTracer::Category::Asset, 10us, 40us);
+    addSpan(tracer, "c", StartupTracer::Category::Asset, 40us, 45us);
+    // Different stages of the same asset are summed up
+    addSpan(tracer, "a", StartupTracer::Category::Asset, 50us, 75us);
+    // Other categories are ignored, even if the spans contain each other
+    addSpan(tracer, "d", StartupTracer::Category::Node, 0us, 100us);
+
+    const std::vector<std::pair<std::string, std::chrono::microseconds>> slowest =
+        tracer.slowest(StartupTracer::Category::Asset, 2);
+    REQUIRE(slowest.size() == 2);
+    CHECK(slowest[0].first == "a");
+    CHECK(slowest[0].second == 35us);
+    CHECK(slowest[1].first == "b");
+    CHECK(slowest[1].second == 30us);
+
+    CHECK(tracer.slowest(StartupTracer::Category::Asset, 10).size() == 3);
+    CHECK(tracer.slowest(StartupTracer::Category::Module, 10).empty());
+}
+
+TEST_CASE("StartupTracer: Slowest Nested", "[startuptracer]") {
+    StartupTracer tracer;
+    tracer.setEnabled(true);
+    // All spans need the same origin for them to be nested
+    const StartupTracer::Clock::time_point now = StartupTracer::Clock::now();
+    auto add = [&tracer, now](std::string name, std::chrono::microseconds begin,
+                              std::chrono::microseconds end, bool isAsynchronous)
+    {
+        tracer.addSpan(
+            std::move(name),
+            StartupTracer::Category::Asset,
+            "",
+            now + begin,
+            now + end,
+            isAsynchronous
+        );
+    };
+
+    // A parent asset that loads a child, which in turn loads a grandchild, and a sibling
+    add("parent", 0us, 100us, false);
+    add("child", 10us, 80us, false);
+    add("grandchild", 20us, 30us, false);
+    add("sibling", 85us, 95us, false);
+    // A span on another thread does not count as a child
+    std::thread worker([&add]() { add("worker", 10us, 50us, false); });
+    worker.join();
+    // Asynchronous spans neither
+    add("async", 40us, 45us, true);
+
+    const std::vector<std::pair<std::string, std::chrono::microseconds>> slowest =
+        tracer.slowest(StartupTracer::Category::Asset, 10);
+    REQUIRE(slowest.size() == 6);
+    CHECK(slowest[0].first == "child");
+    CHECK(slowest[0].second == 60us);
+    CHECK(slowest[1].first == "worker");
+    CHECK(slowest[1].second == 40us);
+    CHECK(slowest[2].first == "parent");
+    CHECK(slowest[2].second == 20us);
+    CHECK(slowest[3].first == "grandchild");
+    CHECK(slowest[3].second == 10us);
+    CHECK(slowest[4].first == "sibling");
+    CHECK(slowest[4].second == 10us);
+    CHECK(slowest[5].first == "async");
+    CHECK(slowest[5].second == 5us);
+}
+
+TEST_CASE("StartupTracer: Threads", "[startuptracer]") {
+    StartupTracer tracer;
+    tracer.setEnabled(true);
+
+    std::thread worker([&tracer]() {
+        StartupTracer::ScopedSpan span(tracer, "w", StartupTracer::Category::Node, "");
+    });
+    worker.join();
+    addSpan(tracer, "m", StartupTracer::Category::Node, 0us, 1us);
+    addSpan(tracer, "s", StartupTracer::Category::Synchronization, 0us, 1us, true);
+
+    const std::vector<StartupTracer::Span> spans = tracer.spans();
+    REQUIRE(spans.size() == 3);
+    CHECK(spans[0].threadId == 1);
+    CHECK(spans[1].threadId == 0);
+    CHECK(spans[2].threadId == -1);
+}
+
+TEST_CASE("StartupTracer: Chrome Trace", "[startuptracer]") {
+    StartupTracer tracer;
+    tracer.setEnabled(true);
+    const StartupTracer::Clock::time_point now = StartupTracer::Clock::now();
+    tracer.addSpan(
+        "scene/earth.asset",
+        StartupTracer::Category::Asset,
+        "Load",
+        now,
+        now + 2ms
+    );
+    addSpan(tracer, "sync", StartupTracer::Category::Synchronization, 0us, 5us, true);
+
+    const nlohmann::json trace = nlohmann::json::parse(tracer.chromeTrace());
+    REQUIRE(trace.contains("traceEvents"));
+    const nlohmann::json& events = trace["traceEvents"];
+
+    // One thread name, one complete event, and a begin/end pair for the async span
+    REQUIRE(events.size() == 4);
+    CHECK(events[0]["ph"] == "M");
+    CHECK(events[0]["args"]["name"] == "Main");
+
+    CHECK(events[1]["name"] == "scene/earth.asset (Load)");
+    CHECK(events[1]["cat"] == "Asset");
+    CHECK(events[1]["ph"] == "X");
+    CHECK(events[1]["tid"] == 0);
+    CHECK(events[1]["dur"].get<long long>() == 2000);
+
+    CHECK(events[2]["name"] == "sync");
+    CHECK(events[2]["ph"] == "b");
+    CHECK(events[3]["ph"] == "e");
+    CHECK(events[2]["id"] == events[3]["id"]);
+    CHECK(
+        events[3]["ts"].get<long long>() - events[2]["ts"].get<long long>() == 5
+    );
+}
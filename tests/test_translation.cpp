@@ -0,0 +1,144 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2020                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "catch2/catch.hpp"
+
+#include <openspace/properties/property.h>
+#include <openspace/util/time.h>
+#include <openspace/util/updatestructures.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifdef OPENSPACE_MODULE_BASE_ENABLED
+#include <modules/base/translation/statictranslation.h>
+#endif // OPENSPACE_MODULE_BASE_ENABLED
+
+#ifdef OPENSPACE_MODULE_SPACE_ENABLED
+#include <modules/space/translation/keplertranslation.h>
+#endif // OPENSPACE_MODULE_SPACE_ENABLED
+
+namespace {
+    constexpr const int NumSamples = 1000;
+    constexpr const int NumSweeps = 200;
+
+    glm::dvec3 positionAt(const openspace::Translation& translation, int i) {
+        using namespace openspace;
+        return translation.position({ {}, Time(i * 600.0), Time(0.0), false });
+    }
+
+    // Computes the positions of the translation on another thread, as a full sweep of a
+    // trail does, while the property is changed back and forth between two values on
+    // this thread. Every position has to be the one of either of the two values
+    template <typename T>
+    void requireConsistentPositions(openspace::Translation& translation,
+                                    openspace::properties::Property& property,
+                                    T first, T second)
+    {
+        REQUIRE(translation.isThreadSafe());
+
+        property.set(second);
+        std::vector<glm::dvec3> secondPositions(NumSamples);
+        for (int i = 0; i < NumSamples; ++i) {
+            secondPositions[i] = positionAt(translation, i);
+        }
+
+        property.set(first);
+        std::vector<glm::dvec3> firstPositions(NumSamples);
+        for (int i = 0; i < NumSamples; ++i) {
+            firstPositions[i] = positionAt(translation, i);
+        }
+
+        std::vector<glm::dvec3> positions(NumSamples * NumSweeps);
+        std::atomic_bool isDone = false;
+        std::thread sweep([&]() {
+            for (size_t i = 0; i < positions.size(); ++i) {
+                positions[i] = positionAt(translation, static_cast<int>(i % NumSamples));
+            }
+            isDone = true;
+        });
+        for (int i = 0; !isDone; ++i) {
+            property.set(i % 2 == 0 ? second : first);
+        }
+        sweep.join();
+
+        for (size_t i = 0; i < positions.size(); ++i) {
+            const size_t sample = i % NumSamples;
+            REQUIRE(
+                (positions[i] == firstPositions[sample] ||
+                 positions[i] == secondPositions[sample])
+            );
+        }
+    }
+} // namespace
+
+#ifdef OPENSPACE_MODULE_BASE_ENABLED
+
+TEST_CASE("StaticTranslation: Change position while sweeping", "[translation]") {
+    openspace::StaticTranslation translation;
+    requireConsistentPositions(
+        translation,
+        *translation.property("Position"),
+        glm::dvec3(1.0, 2.0, 3.0),
+        glm::dvec3(-4.0, 5.0, -6.0)
+    );
+}
+
+#endif // OPENSPACE_MODULE_BASE_ENABLED
+
+#ifdef OPENSPACE_MODULE_SPACE_ENABLED
+
+TEST_CASE("KeplerTranslation: Change elements while sweeping", "[translation]") {
+    openspace::KeplerTranslation translation;
+    translation.setKeplerElements(0.1, 7000.0, 10.0, 20.0, 30.0, 40.0, 6000.0, 0.0);
+
+    SECTION("Shape of the orbit") {
+        requireConsistentPositions(
+            translation,
+            *translation.property("Eccentricity"),
+            0.1,
+            0.5
+        );
+    }
+
+    SECTION("Orbit plane") {
+        requireConsistentPositions(
+            translation,
+            *translation.property("Inclination"),
+            10.0,
+            80.0
+        );
+    }
+
+    SECTION("Location on the orbit") {
+        requireConsistentPositions(
+            translation,
+            *translation.property("Period"),
+            6000.0,
+            9000.0
+        );
+    }
+}
+
+#endif // OPENSPACE_MODULE_SPACE_ENABLED